@@ -0,0 +1,60 @@
+-- TopologySchema.sql: relational form of a Gen topology (see TopologySchema.xsd).
+--
+-- ns-3-codegenerator reads a database with this schema in place of an XML
+-- file: the input is recognized as an SQLite 3 database from its header.
+-- The rows are read in id order (position order for the connected nodes),
+-- which plays the role of the document order of the XML format.
+--
+-- Text columns hold the same values as the XML elements of the same name.
+-- The application parameters of the "special" XML element are NULL when
+-- absent.
+
+CREATE TABLE node (
+  id INTEGER PRIMARY KEY,
+  type TEXT NOT NULL,                           -- nodeType: Pc, Router, Bridge, Station, AccessPoint
+  name TEXT NOT NULL UNIQUE,                    -- nodeNameType, may be a range: station_[0..49999]
+  enable_flowmonitor TEXT NOT NULL DEFAULT 'false'
+);
+
+CREATE TABLE network_hardware (
+  id INTEGER PRIMARY KEY,
+  type TEXT NOT NULL,                           -- hardwareType: Ap, Bridge, Hub, PointToPoint
+  name TEXT NOT NULL UNIQUE,
+  data_rate TEXT NOT NULL,
+  link_delay TEXT NOT NULL,
+  enable_trace TEXT NOT NULL DEFAULT 'false'
+);
+
+-- connectedNodes of a network hardware, in position order.
+CREATE TABLE connected_node (
+  hardware_id INTEGER NOT NULL REFERENCES network_hardware (id),
+  position INTEGER NOT NULL,
+  node_name TEXT NOT NULL,                      -- node name, member name or range
+  PRIMARY KEY (hardware_id, position)
+) WITHOUT ROWID;
+
+CREATE TABLE application (
+  id INTEGER PRIMARY KEY,
+  type TEXT NOT NULL,                           -- appType
+  name TEXT NOT NULL UNIQUE,
+  sender TEXT NOT NULL,
+  receiver TEXT NOT NULL,
+  start_time INTEGER NOT NULL,
+  end_time INTEGER NOT NULL,
+  port INTEGER,
+  interval INTEGER,
+  reading_time INTEGER,
+  packet_size INTEGER,
+  max_packet_count INTEGER,
+  packet_interval_time TEXT
+);
+
+CREATE TABLE flow (
+  id INTEGER PRIMARY KEY,
+  type TEXT NOT NULL,                           -- flowType
+  name TEXT NOT NULL UNIQUE,
+  source TEXT NOT NULL,
+  destination TEXT NOT NULL,
+  expected_delay_seconds TEXT NOT NULL,
+  expected_reliability_percent TEXT NOT NULL
+);
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file alloc-test.cxx
+ * \brief Check the number of allocations made by the code generation.
+ *
+ * The topology is read with the fast reader, then generated into a
+ * CountingCodeSink while operator new counts the allocations. The test
+ * fails if the generation makes more allocations per line of code than
+ * the bound, the lines are built in the buffers of the sinks (CodeLine).
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <stdexcept>
+
+#include "topology-fast-reader.hxx"
+
+#include "kern/code-sink.h"
+#include "kern/generator.h"
+#include "kern/topology-builder.h"
+
+#if __cplusplus >= 201103L
+#define NEW_THROW
+#define DELETE_THROW noexcept
+#else
+#define NEW_THROW throw (std::bad_alloc)
+#define DELETE_THROW throw ()
+#endif
+
+/// Default bound of the allocations per generated line ///
+static const double MAX_ALLOCATIONS_PER_LINE = 0.2;
+
+/// Number of calls to operator new ///
+static size_t allocations = 0;
+
+void *
+operator new (std::size_t size) NEW_THROW
+{
+  allocations++;
+  void *p = malloc (size > 0 ? size : 1);
+  if (!p)
+    throw std::bad_alloc ();
+  return p;
+}
+
+void *
+operator new[] (std::size_t size) NEW_THROW
+{
+  return operator new (size);
+}
+
+void
+operator delete (void *p) DELETE_THROW
+{
+  free (p);
+}
+
+void
+operator delete[] (void *p) DELETE_THROW
+{
+  free (p);
+}
+
+int
+main (int argc, char* argv[])
+{
+  if (argc < 2 || argc > 3)
+  {
+    std::cerr << "usage: " << argv[0] << " <file>.xml [max allocations per line]" << std::endl;
+    return 2;
+  }
+  double bound = argc > 2 ? atof (argv[2]) : MAX_ALLOCATIONS_PER_LINE;
+
+  try
+  {
+    Generator gen (argv[1]);
+    TopologyBuilder builder (&gen);
+    ParseTopologyFast (argv[1], builder);
+    builder.Finish ();
+
+    CountingCodeSink sink;
+    size_t before = allocations;
+    gen.GenerateCodeCpp (sink, "alloc-test.cc");
+    size_t count = allocations - before;
+
+    double perLine = sink.GetLines () > 0 ? static_cast<double> (count) / sink.GetLines () : 0;
+    std::cout << argv[1] << ": " << count << " allocations for " << sink.GetLines () << " lines ("
+              << perLine << " per line, bound " << bound << ")" << std::endl;
+    return perLine <= bound ? 0 : 1;
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << e.what () << std::endl;
+    return 2;
+  }
+}
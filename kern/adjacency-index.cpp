@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/**
+ * \file adjacency-index.cpp
+ * \brief Index of the nodes installed on the network hardwares.
+ */
+
+#include <stdexcept>
+
+#include "adjacency-index.h"
+
+AdjacencyIndex::AdjacencyIndex()
+{
+  this->m_linkBegin.push_back(0);
+}
+
+AdjacencyIndex::~AdjacencyIndex()
+{
+}
+
+void AdjacencyIndex::Clear()
+{
+  this->m_members.clear();
+  this->m_offsets.clear();
+  this->m_links.clear();
+  this->m_nextAttachment.clear();
+  this->m_linkBegin.assign(1, 0);
+  this->m_machinesNumbers.clear();
+  this->m_firstAttachment = NameIndex();
+  this->m_lastAttachment = NameIndex();
+}
+
+void AdjacencyIndex::AddNetworkHardware()
+{
+  this->m_linkBegin.push_back(this->m_members.size());
+  this->m_machinesNumbers.push_back(0);
+}
+
+void AdjacencyIndex::AddMember(const std::string &nodeName, const size_t machinesNumber)
+{
+  if(this->m_machinesNumbers.empty())
+  {
+    throw std::logic_error("Install failed! (" + nodeName + ") no network hardware.");
+  }
+
+  size_t link = this->m_machinesNumbers.size() - 1;
+  size_t member = this->m_members.size();
+  this->m_members.push_back(nodeName);
+  this->m_offsets.push_back(this->m_machinesNumbers[link]);
+  this->m_links.push_back(link);
+  this->m_nextAttachment.push_back(0);
+  this->m_linkBegin[link + 1] = member + 1;
+  this->m_machinesNumbers[link] += machinesNumber;
+
+  size_t last = 0;
+  if(this->m_lastAttachment.Find(nodeName, last))
+  {
+    this->m_nextAttachment[last] = member;
+  }
+  else
+  {
+    this->m_firstAttachment.Insert(nodeName, member);
+  }
+  this->m_lastAttachment.Set(nodeName, member);
+}
+
+size_t AdjacencyIndex::GetNNetworkHardwares() const
+{
+  return this->m_machinesNumbers.size();
+}
+
+size_t AdjacencyIndex::GetNMembers(const size_t link) const
+{
+  return this->m_linkBegin.at(link + 1) - this->m_linkBegin.at(link);
+}
+
+const std::string &AdjacencyIndex::GetMember(const size_t link, const size_t member) const
+{
+  return this->m_members.at(this->m_linkBegin.at(link) + member);
+}
+
+size_t AdjacencyIndex::GetMemberOffset(const size_t link, const size_t member) const
+{
+  return this->m_offsets.at(this->m_linkBegin.at(link) + member);
+}
+
+size_t AdjacencyIndex::GetMachinesNumber(const size_t link) const
+{
+  return this->m_machinesNumbers.at(link);
+}
+
+bool AdjacencyIndex::FindAttachment(const std::string &nodeName, size_t &link, size_t &member) const
+{
+  size_t i = 0;
+  if(!this->m_firstAttachment.Find(nodeName, i))
+  {
+    return false;
+  }
+
+  link = this->m_links[i];
+  member = i - this->m_linkBegin[link];
+  return true;
+}
+
+bool AdjacencyIndex::FindNextAttachment(size_t &link, size_t &member) const
+{
+  size_t i = this->m_nextAttachment.at(this->m_linkBegin.at(link) + member);
+  if(i == 0)
+  {
+    return false;
+  }
+
+  link = this->m_links[i];
+  member = i - this->m_linkBegin[link];
+  return true;
+}
@@ -0,0 +1,172 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/**
+ * \file adjacency-index.h
+ * \brief Index of the nodes installed on the network hardwares.
+ */
+
+#ifndef ADJACENCY_INDEX_H
+#define ADJACENCY_INDEX_H
+
+#include "name-index.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Index of the nodes installed on the network hardwares.
+ *
+ *  The index is built once, network hardware after network hardware, from
+ *  the names installed on each of them and the number of machines each
+ *  name stands for (a node population counts for all its machines). It
+ *  answers both ways: the members of a network hardware with the offset of
+ *  their first device in its NetDeviceContainer, and the network hardwares
+ *  a node is installed on.
+ *
+ *  The members of all the network hardwares are stored in one array, the
+ *  attachments of a name are chained through it.
+ */
+class AdjacencyIndex
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    AdjacencyIndex();
+
+    /**
+     * \brief Destructor.
+     */
+    ~AdjacencyIndex();
+
+    /**
+     * \brief Empty the index.
+     */
+    void Clear();
+
+    /**
+     * \brief Start the next network hardware.
+     */
+    void AddNetworkHardware();
+
+    /**
+     * \brief Install a name on the last network hardware added.
+     * \param nodeName installed name
+     * \param machinesNumber number of machines (devices) it stands for
+     */
+    void AddMember(const std::string &nodeName, const size_t machinesNumber);
+
+    /**
+     * \brief Get the number of network hardwares.
+     * \return number of network hardwares
+     */
+    size_t GetNNetworkHardwares() const;
+
+    /**
+     * \brief Get the number of members of a network hardware.
+     * \param link network hardware index
+     * \return number of names installed on it
+     */
+    size_t GetNMembers(const size_t link) const;
+
+    /**
+     * \brief Get a member of a network hardware.
+     * \param link network hardware index
+     * \param member member index, in install order
+     * \return installed name
+     */
+    const std::string &GetMember(const size_t link, const size_t member) const;
+
+    /**
+     * \brief Get the device offset of a member of a network hardware.
+     * \param link network hardware index
+     * \param member member index, in install order
+     * \return number of machines installed before the member
+     */
+    size_t GetMemberOffset(const size_t link, const size_t member) const;
+
+    /**
+     * \brief Get the number of devices of a network hardware.
+     * \param link network hardware index
+     * \return number of machines installed on it
+     */
+    size_t GetMachinesNumber(const size_t link) const;
+
+    /**
+     * \brief Find the first network hardware a name is installed on.
+     * \param nodeName installed name
+     * \param link index of the network hardware
+     * \param member index of the name in its members
+     * \return false if the name is not installed
+     */
+    bool FindAttachment(const std::string &nodeName, size_t &link, size_t &member) const;
+
+    /**
+     * \brief Find the next network hardware a name is installed on.
+     * \param link index of the network hardware, updated
+     * \param member index of the name in its members, updated
+     * \return false if there is no other attachment
+     */
+    bool FindNextAttachment(size_t &link, size_t &member) const;
+
+  private:
+    /**
+     * \brief Installed names of all the network hardwares.
+     */
+    std::vector<std::string> m_members;
+
+    /**
+     * \brief Device offset of each member in its network hardware.
+     */
+    std::vector<size_t> m_offsets;
+
+    /**
+     * \brief Network hardware of each member.
+     */
+    std::vector<size_t> m_links;
+
+    /**
+     * \brief Next attachment of the same name, 0 if none (member 0 is never a next one).
+     */
+    std::vector<size_t> m_nextAttachment;
+
+    /**
+     * \brief First member of each network hardware, followed by the member count.
+     */
+    std::vector<size_t> m_linkBegin;
+
+    /**
+     * \brief Number of devices of each network hardware.
+     */
+    std::vector<size_t> m_machinesNumbers;
+
+    /**
+     * \brief First attachment of each name.
+     */
+    NameIndex m_firstAttachment;
+
+    /**
+     * \brief Last attachment of each name, to chain the next one.
+     */
+    NameIndex m_lastAttachment;
+};
+
+#endif /* ADJACENCY_INDEX_H */
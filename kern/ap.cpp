@@ -27,12 +27,18 @@
 
 #include "ap.h"
 
-Ap::Ap(const std::string &type, const size_t &indice, const std::string &apNode) : NetworkHardware(type, indice)
+Ap::Ap(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &apNode) : NetworkHardware(symbols, type, indice)
 {
   this->Install(apNode);
   this->SetNetworkHardwareName(std::string("ap_" + this->GetIndice()));
   this->SetNdcName(std::string("ndc_" + this->GetNetworkHardwareName()));
   this->SetAllNodeContainer(std::string("all_" + this->GetNetworkHardwareName()));
+  this->m_wifiPhyName = this->InternName("wifiPhy_");
+  this->m_wifiChannelName = this->InternName("wifiChannel_");
+  this->m_ssidName = this->InternName("ssid_");
+  this->m_wifiName = this->InternName("wifi_");
+  this->m_wifiMacName = this->InternName("wifiMac_");
+  this->m_mobilityName = this->InternName("mobility_");
   this->m_apNode = apNode;
   this->m_mobility = false;
   this->m_apName = std::string("wifi-default-" + this->GetIndice());
@@ -83,79 +89,64 @@ std::vector<std::string> Ap::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Ap::GenerateNetworkHardwareCpp()
+void Ap::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> generatedLink;
   /* creation of the link. */
 
-  generatedLink.push_back("");
-  generatedLink.push_back("YansWifiPhyHelper wifiPhy_" + this->GetNetworkHardwareName() + " = YansWifiPhyHelper::Default ();");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "YansWifiPhyHelper " << this->GetSymbolName(this->m_wifiPhyName) << " = YansWifiPhyHelper::Default ();");
 
-  generatedLink.push_back("");
-  generatedLink.push_back("YansWifiChannelHelper wifiChannel_" + this->GetNetworkHardwareName() + " = YansWifiChannelHelper::Default ();");
-  generatedLink.push_back("wifiPhy_" + this->GetNetworkHardwareName() + ".SetChannel (wifiChannel_" + this->GetNetworkHardwareName() + ".Create ());");
-
-  return generatedLink;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "YansWifiChannelHelper " << this->GetSymbolName(this->m_wifiChannelName) << " = YansWifiChannelHelper::Default ();");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_wifiPhyName) << ".SetChannel (" << this->GetSymbolName(this->m_wifiChannelName) << ".Create ());");
 }
 
-std::vector<std::string> Ap::GenerateNetDeviceCpp()
+void Ap::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> ndc;
-
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp(); //all station nodes !
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
+  this->GroupAsNodeContainerCpp(sink); //all station nodes !
 
-  ndc.push_back("");
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + ";");
-  ndc.push_back("NetDeviceContainer " + this->m_ndcStaName + ";");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetNdcName() << ";");
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->m_ndcStaName << ";");
 
-  ndc.push_back("");
-  ndc.push_back("Ssid ssid_" + this->GetNetworkHardwareName() + " = Ssid (\"" + this->m_apName + "\");");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "Ssid " << this->GetSymbolName(this->m_ssidName) << " = Ssid (\"" << this->m_apName << "\");");
 
-  ndc.push_back("");
-  ndc.push_back("WifiHelper wifi_" + this->GetNetworkHardwareName() + " = WifiHelper ();");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "WifiHelper " << this->GetSymbolName(this->m_wifiName) << " = WifiHelper ();");
 
-  ndc.push_back("");
-  ndc.push_back("NqosWifiMacHelper wifiMac_" + this->GetNetworkHardwareName() + " = NqosWifiMacHelper::Default ();");
-  ndc.push_back("wifi_" + this->GetNetworkHardwareName() + ".SetRemoteStationManager (\"ns3::ArfWifiManager\");");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "NqosWifiMacHelper " << this->GetSymbolName(this->m_wifiMacName) << " = NqosWifiMacHelper::Default ();");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_wifiName) << ".SetRemoteStationManager (\"ns3::ArfWifiManager\");");
 
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + ".SetType (\"ns3::ApWifiMac\", ");
-  ndc.push_back("   \"Ssid\", SsidValue (ssid_" + this->GetNetworkHardwareName() + "), ");
-  ndc.push_back("   \"BeaconGeneration\", BooleanValue (true),"); 
-  ndc.push_back("   \"BeaconInterval\", TimeValue (Seconds (2.5)));");
-  ndc.push_back(this->GetNdcName() + ".Add (wifi_" + this->GetNetworkHardwareName() + ".Install (wifiPhy_" + this->GetNetworkHardwareName() + ", wifiMac_" + this->GetNetworkHardwareName() + ", " + this->m_apNode + "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_wifiMacName) << ".SetType (\"ns3::ApWifiMac\", ");
+  sink.WriteLine(CodeLine(sink) << "   \"Ssid\", SsidValue (" << this->GetSymbolName(this->m_ssidName) << "), ");
+  sink.WriteLine("   \"BeaconGeneration\", BooleanValue (true),"); 
+  sink.WriteLine("   \"BeaconInterval\", TimeValue (Seconds (2.5)));");
+  sink.WriteLine(CodeLine(sink) << this->GetNdcName() << ".Add (" << this->GetSymbolName(this->m_wifiName) << ".Install (" << this->GetSymbolName(this->m_wifiPhyName) << ", " << this->GetSymbolName(this->m_wifiMacName) << ", " << this->m_apNode << "));");
 
-  ndc.push_back("wifiMac_" + this->GetNetworkHardwareName() + ".SetType (\"ns3::StaWifiMac\",");
-  ndc.push_back("   \"Ssid\", SsidValue (ssid_" + this->GetNetworkHardwareName() + "), ");
-  ndc.push_back("   \"ActiveProbing\", BooleanValue (false));");
-  ndc.push_back(this->m_ndcStaName + ".Add (wifi_" + this->GetNetworkHardwareName() + ".Install (wifiPhy_" + this->GetNetworkHardwareName() + ", wifiMac_" + this->GetNetworkHardwareName() + ", " + this->GetAllNodeContainer() + " ));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_wifiMacName) << ".SetType (\"ns3::StaWifiMac\",");
+  sink.WriteLine(CodeLine(sink) << "   \"Ssid\", SsidValue (" << this->GetSymbolName(this->m_ssidName) << "), ");
+  sink.WriteLine("   \"ActiveProbing\", BooleanValue (false));");
+  sink.WriteLine(CodeLine(sink) << this->m_ndcStaName << ".Add (" << this->GetSymbolName(this->m_wifiName) << ".Install (" << this->GetSymbolName(this->m_wifiPhyName) << ", " << this->GetSymbolName(this->m_wifiMacName) << ", " << this->GetAllNodeContainer() << " ));");
 
 
-  ndc.push_back("");
-  ndc.push_back("MobilityHelper mobility_" + this->GetNetworkHardwareName() + ";");
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".SetMobilityModel (\"ns3::ConstantPositionMobilityModel\");");
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".Install (" + this->m_apNode + ");"); 
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "MobilityHelper " << this->GetSymbolName(this->m_mobilityName) << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_mobilityName) << ".SetMobilityModel (\"ns3::ConstantPositionMobilityModel\");");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_mobilityName) << ".Install (" << this->m_apNode << ");"); 
 
   if(this->m_mobility)//if random walk is activated.
   {
-    ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".SetMobilityModel (\"ns3::RandomWalk2dMobilityModel\",\"Bounds\", RectangleValue (Rectangle (-50, 50, -50, 50)));");
+    sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_mobilityName) << ".SetMobilityModel (\"ns3::RandomWalk2dMobilityModel\",\"Bounds\", RectangleValue (Rectangle (-50, 50, -50, 50)));");
   }
-  ndc.push_back("mobility_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_mobilityName) << ".Install (" << this->GetAllNodeContainer() << ");");
 }
 
-std::vector<std::string> Ap::GenerateTraceCpp()
+void Ap::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> trace;
-
   if(this->GetTrace())
   {
-    trace.push_back("wifiPhy_" + this->GetNetworkHardwareName() + ".EnablePcap (\"" + this->GetNetworkHardwareName() + "\", " + this->GetNdcName() + ".Get(0));");
+    sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_wifiPhyName) << ".EnablePcap (\"" << this->GetNetworkHardwareName() << "\", " << this->GetNdcName() << ".Get(0));");
   }
-
-  return trace;
-}  
+}
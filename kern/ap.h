@@ -70,14 +70,45 @@ class Ap : public NetworkHardware
     //
     std::string m_ndcStaName;
 
+    /**
+     * \brief Wifi physical layer helper name.
+     */
+    Symbol m_wifiPhyName;
+
+    /**
+     * \brief Wifi channel helper name.
+     */
+    Symbol m_wifiChannelName;
+
+    /**
+     * \brief Ssid name.
+     */
+    Symbol m_ssidName;
+
+    /**
+     * \brief Wifi helper name.
+     */
+    Symbol m_wifiName;
+
+    /**
+     * \brief Wifi MAC helper name.
+     */
+    Symbol m_wifiMacName;
+
+    /**
+     * \brief Mobility helper name.
+     */
+    Symbol m_mobilityName;
+
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice the Ap number
      * \param apNode the node which is the ap name
      * \param type the link type
      */
-    Ap(const std::string &type, const size_t &indice, const std::string &apNode);
+    Ap(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &apNode);
 
     /**
      * \brief Destructor.
@@ -128,21 +159,21 @@ class Ap : public NetworkHardware
 
     /**
      * \brief Generate the build link C++ code.
-     * \return build link code.
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate build of the net device container C++ code.
-     * \return net device container
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Generate the trace line C++ code.
-     * \return trace line
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
+    virtual void GenerateTraceCpp(CodeSink &sink);
     
 };
 
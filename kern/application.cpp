@@ -30,12 +30,15 @@
 
 #include "utils.h"
 
-Application::Application(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime)
+Application::Application(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime)
 {
-  this->m_applicationType = type;
+  this->m_symbols = &symbols;
+  this->m_applicationType = symbols.Intern(type);
   this->m_indice = indice;
-  this->m_senderNode = senderNode;
-  this->m_receiverNode = receiverNode;
+  this->m_indiceName = utils::integerToString(indice);
+  this->m_appName = symbols.Intern("");
+  this->m_senderNode = symbols.Intern(senderNode);
+  this->m_receiverNode = symbols.Intern(receiverNode);
   this->m_startTime = startTime;
   this->m_endTime = endTime;
 }
@@ -44,44 +47,111 @@ Application::~Application()
 {
 }
 
-std::string Application::GetIndice()
+bool Application::GenerateTableRowCpp(CodeTable &table, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  return utils::integerToString(this->m_indice);
+  (void)table;
+  (void)netDeviceContainer;
+  (void)numberIntoNetDevice;
+
+  return false;
+}
+
+/**
+ * \brief Parse a decimal index.
+ * \param text text
+ * \param begin position of the first digit
+ * \param end position after the last digit
+ * \param index index
+ * \return false if the text is not a number there
+ */
+static bool ParseIndex(const std::string &text, const size_t begin, const size_t end, size_t &index)
+{
+  if(begin >= end || end - begin > 18)
+  {
+    return false;
+  }
+
+  index = 0;
+  for(size_t i = begin; i < end; i++)
+  {
+    if(text[i] < '0' || text[i] > '9')
+    {
+      return false;
+    }
+    index = index * 10 + (text[i] - '0');
+  }
+
+  return true;
+}
+
+bool Application::FindInstallNode(const std::string &node, std::string &container, size_t &index)
+{
+  if(node.compare(0, 14, "NodeContainer(") == 0)
+  {
+    size_t get = node.rfind(".Get(");
+    if(get == std::string::npos || get <= 14 || node.compare(node.size() - 2, 2, "))") != 0
+       || !ParseIndex(node, get + 5, node.size() - 2, index))
+    {
+      return false;
+    }
+    container = node.substr(14, get - 14);
+    return true;
+  }
+
+  if(node.compare(0, 5, "term_") == 0 && ParseIndex(node, 5, node.size(), index))
+  {
+    container = "all_hub_0";
+    return true;
+  }
+
+  if(node.compare(0, 8, "station_") == 0 && ParseIndex(node, 8, node.size(), index))
+  {
+    container = "all_ap_0";
+    return true;
+  }
+
+  return false;
+}
+
+const std::string &Application::GetIndice() const
+{
+  return this->m_indiceName;
 }
 
 void Application::SetIndice(const size_t &indice)
 {
   this->m_indice = indice;
+  this->m_indiceName = utils::integerToString(indice);
 }
 
-std::string Application::GetAppName()
+const std::string &Application::GetAppName() const
 {
-  return this->m_appName;
+  return this->m_symbols->GetName(this->m_appName);
 }
 
 void Application::SetAppName(const std::string &appName)
 {
-  this->m_appName = appName;
+  this->m_appName = this->m_symbols->Intern(appName);
 }
 
-std::string Application::GetSenderNode()
+const std::string &Application::GetSenderNode() const
 {
-  return this->m_senderNode;
+  return this->m_symbols->GetName(this->m_senderNode);
 }
 
 void Application::SetSenderNode(const std::string &senderNode)
 {
-  this->m_senderNode = senderNode;
+  this->m_senderNode = this->m_symbols->Intern(senderNode);
 }
 
-std::string Application::GetReceiverNode()
+const std::string &Application::GetReceiverNode() const
 {
-  return this->m_receiverNode;
+  return this->m_symbols->GetName(this->m_receiverNode);
 }
 
 void Application::SetReceiverNode(const std::string &receiverNode)
 {
-  this->m_receiverNode = receiverNode;
+  this->m_receiverNode = this->m_symbols->Intern(receiverNode);
 }
 
 std::string Application::GetStartTime()
@@ -89,6 +159,11 @@ std::string Application::GetStartTime()
   return utils::integerToString(this->m_startTime);
 }
 
+size_t Application::GetStartTimeNumber()
+{
+  return this->m_startTime;
+}
+
 void Application::SetStartTime(const size_t &startTime)
 {
   this->m_startTime = startTime;
@@ -109,8 +184,8 @@ void Application::SetEndTime(const size_t &endTime)
   this->m_endTime = endTime;
 }
 
-std::string Application::GetApplicationType()
+const std::string &Application::GetApplicationType() const
 {
-  return this->m_applicationType;
+  return this->m_symbols->GetName(this->m_applicationType);
 }
 
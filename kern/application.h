@@ -32,6 +32,11 @@
 #include <string>
 #include <vector>
 
+#include "code-sink.h"
+#include "symbol-table.h"
+
+class CodeTable;
+
 /**
  * \ingroup generator
  * \brief The main class of applications.
@@ -53,31 +58,43 @@
  *      ~NewApplication();
  *      
  *      virtual std::vector<std::string> GenerateHeader();
- *      virtual std::vector<std::string> GenerateApplicationCpp(std::string, size_t);
+ *      virtual void GenerateApplicationCpp(CodeSink &, const std::string &, size_t);
+ *      # and if its applications may be rows of a table
+ *      virtual bool GenerateTableRowCpp(CodeTable &, const std::string &, size_t);
  *    }
  */
 class Application
 {
   private:
+    /**
+     * \brief Table holding the names.
+     */
+    SymbolTable *m_symbols;
+
     /**
      * \brief Application number.
      */
     size_t m_indice;
 
+    /**
+     * \brief Indice as a string, as returned by GetIndice.
+     */
+    std::string m_indiceName;
+
     /**
      * \brief Application name.
      */
-    std::string m_appName;
+    Symbol m_appName;
 
     /**
      * \brief Pinger sender node.
      */
-    std::string m_senderNode;
+    Symbol m_senderNode;
 
     /**
      * \brief Pinger receiver node.
      */
-    std::string m_receiverNode;
+    Symbol m_receiverNode;
 
     /**
      * \brief Application start time.
@@ -92,11 +109,12 @@ class Application
     /**
      * \brief Application type.
      */
-    std::string m_applicationType;
+    Symbol m_applicationType;
 
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param type application type
      * \param indice application number
      * \param senderNode sender node
@@ -104,7 +122,7 @@ class Application
      * \param startTime application start time
      * \param endTime application end time
      */
-    Application(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime);
+    Application(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime);
 
     /**
      * \brief Destructor.
@@ -119,18 +137,44 @@ class Application
 
     /**
      * \brief Generate the application C++ code.
+     * \param sink sink of the code
      * \param netDeviceContainer is the ns3 net device containe
      * \param numberIntoNetDevice is the place from the sender node in the assigned ip network
      * \param numberIntoNetDevice example sender node is 192.168.0.5, then the number is 5
-     * \return code from the application
      */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice) = 0;
+    virtual void GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice) = 0;
+
+    /**
+     * \brief Generate the application as a row of the table of its type.
+     *
+     * The types without table, and the applications whose nodes are not
+     * found in a container, are only generated by GenerateApplicationCpp.
+     *
+     * \param table table of the applications
+     * \param netDeviceContainer is the ns3 net device container of the receiver
+     * \param numberIntoNetDevice is the place from the receiver node in the net device container
+     * \return false if no row was generated
+     */
+    virtual bool GenerateTableRowCpp(CodeTable &table, const std::string &netDeviceContainer, size_t numberIntoNetDevice);
+
+    /**
+     * \brief Find the node container a helper installs an application node from.
+     *
+     * "NodeContainer(x.Get(i))" is the machine i of x, "term_i" and
+     * "station_i" are the node i of all_hub_0 and all_ap_0.
+     *
+     * \param node sender or receiver node
+     * \param container node container name
+     * \param index index of the node in the container
+     * \return false if the node is none of these
+     */
+    static bool FindInstallNode(const std::string &node, std::string &container, size_t &index);
 
     /**
      * \brief Get application number.
      * \return application number
      */
-    std::string GetIndice();
+    const std::string &GetIndice() const;
 
     /**
      * \brief Get application number.
@@ -142,7 +186,7 @@ class Application
      * \brief Get application node name.
      * \return application node name
      */
-    std::string GetAppName();
+    const std::string &GetAppName() const;
 
     /**
      * \brief Set application name.
@@ -154,7 +198,7 @@ class Application
      * \brief Get sender node name.
      * \return sender node name
      */
-    std::string GetSenderNode();
+    const std::string &GetSenderNode() const;
 
     /**
      * \brief Set sender node name.
@@ -166,7 +210,7 @@ class Application
      * \brief Get receiver node name.
      * \return receiver node name
      */
-    std::string GetReceiverNode();
+    const std::string &GetReceiverNode() const;
 
     /**
      * \brief Set receiver node name.
@@ -180,6 +224,12 @@ class Application
      */
     std::string GetStartTime();
 
+    /**
+     * \brief Get application start time.
+     * \return start time formatted into number
+     */
+    size_t GetStartTimeNumber();
+
     /**
      * \brief Set application start time.
      * \param startTime application start time
@@ -208,7 +258,7 @@ class Application
      * \brief Get application type.
      * \return application type
      */
-    std::string GetApplicationType();
+    const std::string &GetApplicationType() const;
 };
 
 #endif /* APPLICATION_H */
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file arena.cpp
+ * \brief Memory of the model objects, released in bulk.
+ */
+
+#include "arena.h"
+
+#include <new>
+
+/**
+ * \brief Alignment of the allocations.
+ */
+static const size_t ALIGNMENT = 16;
+
+Arena::Arena()
+{
+  this->m_next = 0;
+  this->m_end = 0;
+  this->m_nAllocations = 0;
+  this->m_allocatedSize = 0;
+  this->m_reservedSize = 0;
+}
+
+Arena::~Arena()
+{
+  for(size_t i = 0; i < this->m_blocks.size(); i++)
+  {
+    ::operator delete(this->m_blocks[i]);
+  }
+}
+
+void *Arena::Allocate(const size_t size)
+{
+  size_t alignedSize = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  if(alignedSize == 0)
+  {
+    alignedSize = ALIGNMENT;
+  }
+
+  if(static_cast<size_t>(this->m_end - this->m_next) < alignedSize)
+  {
+    size_t blockSize = alignedSize > BLOCK_SIZE ? alignedSize : BLOCK_SIZE;
+    /* operator new returns memory aligned for any type. */
+    char *block = static_cast<char *>(::operator new(blockSize));
+    this->m_blocks.push_back(block);
+    this->m_reservedSize += blockSize;
+    if(blockSize > BLOCK_SIZE)
+    {
+      /* keep filling the current block. */
+      this->m_nAllocations++;
+      this->m_allocatedSize += alignedSize;
+      return block;
+    }
+    this->m_next = block;
+    this->m_end = block + blockSize;
+  }
+
+  void *res = this->m_next;
+  this->m_next += alignedSize;
+  this->m_nAllocations++;
+  this->m_allocatedSize += alignedSize;
+  return res;
+}
+
+size_t Arena::GetNAllocations() const
+{
+  return this->m_nAllocations;
+}
+
+size_t Arena::GetAllocatedSize() const
+{
+  return this->m_allocatedSize;
+}
+
+size_t Arena::GetNBlocks() const
+{
+  return this->m_blocks.size();
+}
+
+size_t Arena::GetReservedSize() const
+{
+  return this->m_reservedSize;
+}
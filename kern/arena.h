@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file arena.h
+ * \brief Memory of the model objects, released in bulk.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Memory of the model objects, released in bulk.
+ *
+ *  The objects are placed one after the other in blocks of BLOCK_SIZE
+ *  bytes, an allocation is a pointer increment and the objects created
+ *  together stay next to each other. The memory is only given back when the
+ *  arena is destroyed, objects are destroyed with Destroy, which runs their
+ *  destructor (releasing what they own) without freeing their memory.
+ *
+ *  Objects are created with the placement form of new:
+ *    Node *node = new (arena) Node(...);
+ */
+class Arena
+{
+  public:
+    /**
+     * \brief Size of the blocks, larger objects get a block of their own.
+     */
+    static const size_t BLOCK_SIZE = 64 * 1024;
+
+    /**
+     * \brief Constructor.
+     */
+    Arena();
+
+    /**
+     * \brief Destructor, releases all the blocks.
+     */
+    ~Arena();
+
+    /**
+     * \brief Allocate memory.
+     * \param size number of bytes
+     * \return memory aligned for any object
+     */
+    void *Allocate(const size_t size);
+
+    /**
+     * \brief Destroy an object created in the arena.
+     * \param object object, may be null
+     */
+    template <class T>
+    void Destroy(T *object)
+    {
+      if(object)
+      {
+        object->~T();
+      }
+    }
+
+    /**
+     * \brief Get the number of allocations.
+     * \return number of allocations
+     */
+    size_t GetNAllocations() const;
+
+    /**
+     * \brief Get the number of bytes allocated.
+     * \return bytes allocated, padding included
+     */
+    size_t GetAllocatedSize() const;
+
+    /**
+     * \brief Get the number of blocks.
+     * \return number of blocks
+     */
+    size_t GetNBlocks() const;
+
+    /**
+     * \brief Get the size of the blocks.
+     * \return bytes reserved by the arena
+     */
+    size_t GetReservedSize() const;
+
+  private:
+    /**
+     * \brief Copy constructor, not implemented.
+     */
+    Arena(const Arena &);
+
+    /**
+     * \brief Assignment, not implemented.
+     */
+    Arena &operator=(const Arena &);
+
+    /**
+     * \brief Blocks.
+     */
+    std::vector<char *> m_blocks;
+
+    /**
+     * \brief Next free byte of the current block.
+     */
+    char *m_next;
+
+    /**
+     * \brief End of the current block.
+     */
+    char *m_end;
+
+    /**
+     * \brief Number of allocations.
+     */
+    size_t m_nAllocations;
+
+    /**
+     * \brief Bytes allocated.
+     */
+    size_t m_allocatedSize;
+
+    /**
+     * \brief Bytes reserved by the blocks.
+     */
+    size_t m_reservedSize;
+};
+
+/**
+ * \brief Create an object in an arena.
+ * \param size object size
+ * \param arena arena
+ * \return memory of the object
+ */
+inline void *operator new(size_t size, Arena &arena)
+{
+  return arena.Allocate(size);
+}
+
+/**
+ * \brief Called when the constructor of an object created in an arena throws.
+ *
+ * The memory is released with the arena.
+ */
+inline void operator delete(void *, Arena &)
+{
+}
+
+#endif /* ARENA_H */
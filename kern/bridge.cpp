@@ -30,11 +30,15 @@
 
 #include "utils.h"
 
-Bridge::Bridge(const std::string &type, const size_t &indice, const std::string &nodeBridge) : NetworkHardware(type, indice)
+Bridge::Bridge(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &nodeBridge) : NetworkHardware(symbols, type, indice)
 {
   this->SetNetworkHardwareName(std::string("bridge_" + this->GetIndice()));
   this->SetNdcName(std::string("ndc_" + this->GetNetworkHardwareName()));
   this->SetAllNodeContainer(std::string("all_" + this->GetNetworkHardwareName()));
+  this->m_csmaName = this->InternName("csma_");
+  this->m_terminalDevicesName = this->InternName("terminalDevices_");
+  this->m_bridgeDevicesName = this->InternName("BridgeDevices_");
+  this->m_bridgeName = this->InternName("bridge_");
   this->m_nodeBridge = nodeBridge;
 }
 
@@ -61,62 +65,48 @@ std::vector<std::string> Bridge::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Bridge::GenerateNetworkHardwareCpp()
+void Bridge::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> generatedLink;
   /* creation of the link. */
-  generatedLink.push_back("");
-  generatedLink.push_back("CsmaHelper csma_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\",  TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
-
-  return generatedLink;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "CsmaHelper " << this->GetSymbolName(this->m_csmaName) << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".SetChannelAttribute (\"DataRate\", DataRateValue (" << this->GetDataRate() << "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".SetChannelAttribute (\"Delay\",  TimeValue (" << CodeTime(this->GetNetworkHardwareDelay()) << "));");
 }
 
-std::vector<std::string> Bridge::GenerateNetDeviceCpp()
+void Bridge::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> ndc;
-  //ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
+  //sink.WriteLine("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
 
-  ndc.push_back("NetDeviceContainer terminalDevices_" + this->GetNetworkHardwareName() + ";");
-  ndc.push_back("NetDeviceContainer BridgeDevices_" + this->GetNetworkHardwareName() + ";");
+  size_t members = this->GroupAsNodeContainerCpp(sink);
 
-  ndc.push_back("for (int i = 0; i < " + utils::integerToString(allNodes.size() - 1) + "; i++)");
-  ndc.push_back("{");
-  ndc.push_back(" NetDeviceContainer link = csma_" + this->GetNetworkHardwareName() + ".Install(NodeContainer(" + this->GetAllNodeContainer() + ".Get(i), " + this->m_nodeBridge + "));");
-  ndc.push_back(" terminalDevices_" + this->GetNetworkHardwareName() + ".Add (link.Get(0));");
-  ndc.push_back(" BridgeDevices_" + this->GetNetworkHardwareName() + ".Add (link.Get(1));");
-  ndc.push_back("}");
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetSymbolName(this->m_terminalDevicesName) << ";");
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetSymbolName(this->m_bridgeDevicesName) << ";");
 
-  ndc.push_back("BridgeHelper bridge_" + this->GetNetworkHardwareName() + ";");
-  ndc.push_back("bridge_" + this->GetNetworkHardwareName() + ".Install (" + this->m_nodeBridge + ".Get(0), BridgeDevices_" + this->GetNetworkHardwareName() + ");");
+  sink.WriteLine(CodeLine(sink) << "for (int i = 0; i < " << members << "; i++)");
+  sink.WriteLine("{");
+  sink.WriteLine(CodeLine(sink) << " NetDeviceContainer link = " << this->GetSymbolName(this->m_csmaName) << ".Install(NodeContainer(" << this->GetAllNodeContainer() << ".Get(i), " << this->m_nodeBridge << "));");
+  sink.WriteLine(CodeLine(sink) << " " << this->GetSymbolName(this->m_terminalDevicesName) << ".Add (link.Get(0));");
+  sink.WriteLine(CodeLine(sink) << " " << this->GetSymbolName(this->m_bridgeDevicesName) << ".Add (link.Get(1));");
+  sink.WriteLine("}");
 
-  ndc.push_back("NetDeviceContainer ndc_" + this->GetNetworkHardwareName() + " = terminalDevices_" + this->GetNetworkHardwareName() + ";"); 
+  sink.WriteLine(CodeLine(sink) << "BridgeHelper " << this->GetSymbolName(this->m_bridgeName) << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_bridgeName) << ".Install (" << this->m_nodeBridge << ".Get(0), " << this->GetSymbolName(this->m_bridgeDevicesName) << ");");
 
-  return ndc;
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetNdcName() << " = " << this->GetSymbolName(this->m_terminalDevicesName) << ";"); 
 }
 
-std::vector<std::string> Bridge::GenerateTraceCpp()
+void Bridge::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> trace;
-
   if(this->GetTrace())
   {
     if(this->GetPromisc())
     {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", true);");
+      sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".EnablePcapAll (\"" << this->GetSymbolName(this->m_csmaName) << "\", true);");
     }
     else
     {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", false);");
+      sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".EnablePcapAll (\"" << this->GetSymbolName(this->m_csmaName) << "\", false);");
     }
   }
-
-  return trace;
 }
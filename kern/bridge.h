@@ -55,14 +55,35 @@ class Bridge : public NetworkHardware
      */
     std::string m_nodeBridge;
 
+    /**
+     * \brief Csma helper name.
+     */
+    Symbol m_csmaName;
+
+    /**
+     * \brief Net device container of the terminals.
+     */
+    Symbol m_terminalDevicesName;
+
+    /**
+     * \brief Net device container of the bridge ports.
+     */
+    Symbol m_bridgeDevicesName;
+
+    /**
+     * \brief Bridge helper name.
+     */
+    Symbol m_bridgeName;
+
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice bridge number
      * \param nodeBridge node name
      * \param type link type
      */
-    Bridge(const std::string &type, const size_t &indice, const std::string &nodeBridge);
+    Bridge(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &nodeBridge);
 
     /**
      * \brief Destructor.
@@ -89,21 +110,21 @@ class Bridge : public NetworkHardware
 
     /**
      * \brief Generate build link C++ code.
-     * \return build link code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate build of the net device container for C++.
-     * \return net device container code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Generate trace line for C++.
-     * \return trace line code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
+    virtual void GenerateTraceCpp(CodeSink &sink);
     
 };
 
@@ -0,0 +1,370 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file code-sink.cpp
+ * \brief Destinations of the generated code.
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "code-sink.h"
+#include "utils.h"
+
+CodeSink::~CodeSink()
+{
+}
+
+void CodeSink::WriteLine(const char *data, const size_t size)
+{
+  this->Write(data, size);
+  this->Write("\n", 1);
+}
+
+void CodeSink::WriteLine(const std::string &line)
+{
+  this->WriteLine(line.data(), line.size());
+}
+
+void CodeSink::WriteLine(const char *line)
+{
+  this->WriteLine(line, strlen(line));
+}
+
+StreamCodeSink::StreamCodeSink(std::ostream &stream)
+{
+  this->m_stream = &stream;
+}
+
+StreamCodeSink::~StreamCodeSink()
+{
+}
+
+void StreamCodeSink::Write(const char *data, const size_t size)
+{
+  this->m_stream->write(data, size);
+}
+
+const size_t FileCodeSink::DEFAULT_BUFFER_SIZE;
+
+FileCodeSink::FileCodeSink(const std::string &fileName, const size_t bufferSize)
+{
+  this->m_fileName = fileName;
+  this->m_bufferSize = bufferSize > 0 ? bufferSize : 1;
+  this->m_used = 0;
+  this->m_size = 0;
+
+  void *buffer = 0;
+  if(posix_memalign(&buffer, 4096, this->m_bufferSize) != 0)
+  {
+    throw std::bad_alloc();
+  }
+  this->m_buffer = static_cast<char*>(buffer);
+
+  this->m_fd = open(fileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+  if(this->m_fd < 0)
+  {
+    int err = errno;
+    free(this->m_buffer);
+    throw std::runtime_error(fileName + ": " + strerror(err));
+  }
+}
+
+FileCodeSink::~FileCodeSink()
+{
+  if(this->m_fd >= 0)
+  {
+    try
+    {
+      this->Flush();
+    }
+    catch(const std::exception &)
+    {
+    }
+    close(this->m_fd);
+  }
+  free(this->m_buffer);
+}
+
+void FileCodeSink::Write(const char *data, const size_t size)
+{
+  this->m_size += size;
+  if(this->m_used + size <= this->m_bufferSize)
+  {
+    memcpy(this->m_buffer + this->m_used, data, size);
+    this->m_used += size;
+    return;
+  }
+
+  this->Flush();
+  if(size >= this->m_bufferSize)
+  {
+    this->WriteFile(data, size);
+  }
+  else
+  {
+    memcpy(this->m_buffer, data, size);
+    this->m_used = size;
+  }
+}
+
+void FileCodeSink::Close()
+{
+  if(this->m_fd < 0)
+  {
+    return;
+  }
+
+  this->Flush();
+  int fd = this->m_fd;
+  this->m_fd = -1;
+  if(close(fd) != 0)
+  {
+    throw std::runtime_error(this->m_fileName + ": " + strerror(errno));
+  }
+}
+
+uint64_t FileCodeSink::GetSize() const
+{
+  return this->m_size;
+}
+
+void FileCodeSink::Flush()
+{
+  size_t used = this->m_used;
+  this->m_used = 0;
+  this->WriteFile(this->m_buffer, used);
+}
+
+void FileCodeSink::WriteFile(const char *data, size_t size)
+{
+  if(this->m_fd < 0)
+  {
+    throw std::runtime_error(this->m_fileName + ": file closed");
+  }
+
+  while(size > 0)
+  {
+    ssize_t n = write(this->m_fd, data, size);
+    if(n < 0)
+    {
+      if(errno == EINTR)
+      {
+        continue;
+      }
+      throw std::runtime_error(this->m_fileName + ": " + strerror(errno));
+    }
+    data += n;
+    size -= n;
+  }
+}
+
+StringCodeSink::StringCodeSink()
+{
+}
+
+StringCodeSink::~StringCodeSink()
+{
+}
+
+void StringCodeSink::Write(const char *data, const size_t size)
+{
+  this->m_text.append(data, size);
+}
+
+const std::string &StringCodeSink::GetText() const
+{
+  return this->m_text;
+}
+
+CountingCodeSink::CountingCodeSink()
+{
+  this->m_size = 0;
+  this->m_lines = 0;
+  this->m_hash = utils::hashBytes(0, 0);
+}
+
+CountingCodeSink::~CountingCodeSink()
+{
+}
+
+void CountingCodeSink::Write(const char *data, const size_t size)
+{
+  this->m_size += size;
+  for(size_t i = 0; i < size; i++)
+  {
+    if(data[i] == '\n')
+    {
+      this->m_lines++;
+    }
+  }
+  this->m_hash = utils::hashBytes(data, size, this->m_hash);
+}
+
+uint64_t CountingCodeSink::GetSize() const
+{
+  return this->m_size;
+}
+
+uint64_t CountingCodeSink::GetLines() const
+{
+  return this->m_lines;
+}
+
+uint64_t CountingCodeSink::GetHash() const
+{
+  return this->m_hash;
+}
+
+IndentedCodeSink::IndentedCodeSink(CodeSink &target, const std::string &indent, const std::string &separator)
+{
+  this->m_target = &target;
+  this->m_indent = indent;
+  this->m_separator = separator;
+}
+
+IndentedCodeSink::~IndentedCodeSink()
+{
+}
+
+void IndentedCodeSink::Write(const char *data, const size_t size)
+{
+  this->FlushPreamble();
+  this->m_target->Write(data, size);
+}
+
+void IndentedCodeSink::WriteLine(const char *data, const size_t size)
+{
+  this->FlushPreamble();
+  this->m_indented.assign(this->m_indent).append(data, size);
+  this->m_target->WriteLine(this->m_indented.data(), this->m_indented.size());
+  if(!this->m_separator.empty())
+  {
+    this->m_target->Write(this->m_separator.data(), this->m_separator.size());
+  }
+}
+
+void IndentedCodeSink::SetPreamble(const std::string &preamble)
+{
+  this->m_preamble = preamble;
+}
+
+void IndentedCodeSink::FlushPreamble()
+{
+  if(!this->m_preamble.empty())
+  {
+    this->m_target->Write(this->m_preamble.data(), this->m_preamble.size());
+    this->m_preamble.clear();
+  }
+}
+
+CodeLine::CodeLine(CodeSink &sink)
+{
+  this->m_line = &sink.m_line;
+  this->m_line->clear();
+}
+
+CodeLine &CodeLine::operator<<(const std::string &text)
+{
+  this->m_line->append(text);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const char *text)
+{
+  this->m_line->append(text);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const char c)
+{
+  this->m_line->push_back(c);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const int nb)
+{
+  this->AppendInteger(nb < 0 ? 0ULL - nb : nb, nb < 0);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const unsigned int nb)
+{
+  this->AppendInteger(nb, false);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const long nb)
+{
+  this->AppendInteger(nb < 0 ? 0ULL - nb : nb, nb < 0);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const unsigned long nb)
+{
+  this->AppendInteger(nb, false);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const long long nb)
+{
+  this->AppendInteger(nb < 0 ? 0ULL - nb : nb, nb < 0);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const unsigned long long nb)
+{
+  this->AppendInteger(nb, false);
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const CodeSeconds &seconds)
+{
+  char text[utils::TIME_CHARS];
+  this->m_line->append(text, utils::secondsToChars(seconds.m_nanoseconds, text));
+  return *this;
+}
+
+CodeLine &CodeLine::operator<<(const CodeTime &time)
+{
+  char text[utils::TIME_CHARS];
+  this->m_line->append(text, utils::timeToChars(time.m_nanoseconds, text));
+  return *this;
+}
+
+CodeLine::operator const std::string &() const
+{
+  return *this->m_line;
+}
+
+void CodeLine::AppendInteger(const unsigned long long nb, const bool negative)
+{
+  if(negative)
+  {
+    this->m_line->push_back('-');
+  }
+  char digits[utils::INTEGER_CHARS];
+  this->m_line->append(digits, utils::integerToChars(nb, digits));
+}
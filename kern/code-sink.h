@@ -0,0 +1,570 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file code-sink.h
+ * \brief Destinations of the generated code.
+ */
+
+#ifndef CODE_SINK_H
+#define CODE_SINK_H
+
+#include <stdint.h>
+#include <iostream>
+#include <string>
+
+/**
+ * \ingroup generator
+ * \brief Destination of the generated code.
+ *
+ *  The generator and the model elements write each line of code into a
+ *  sink as soon as it is built, nothing is kept once it is written. The
+ *  code is written line by line with WriteLine so the sinks which decorate
+ *  another one see the lines. The lines made of several parts are built
+ *  with CodeLine in a buffer of the sink.
+ *
+ *  Implementations:
+ *    - StreamCodeSink, into a stream (file, standard output)
+ *    - FileCodeSink, into a file
+ *    - StringCodeSink, into a string
+ *    - CountingCodeSink, counts and hashes the code
+ *    - IndentedCodeSink, indents the lines written into another sink
+ */
+class CodeSink
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~CodeSink();
+
+    /**
+     * \brief Write raw code.
+     * \param data code
+     * \param size number of bytes
+     */
+    virtual void Write(const char *data, const size_t size) = 0;
+
+    /**
+     * \brief Write a line of code.
+     * \param data line, without end of line
+     * \param size number of bytes
+     */
+    virtual void WriteLine(const char *data, const size_t size);
+
+    /**
+     * \brief Write a line of code.
+     * \param line line, without end of line
+     */
+    void WriteLine(const std::string &line);
+
+    /**
+     * \brief Write a line of code.
+     * \param line null terminated line, without end of line
+     */
+    void WriteLine(const char *line);
+
+  private:
+    friend class CodeLine;
+
+    /**
+     * \brief Buffer of the line built by CodeLine, kept from one line to the other.
+     */
+    std::string m_line;
+};
+
+/**
+ * \ingroup generator
+ * \brief Sink writing into a stream.
+ */
+class StreamCodeSink : public CodeSink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param stream stream written, it must outlive the sink
+     */
+    StreamCodeSink(std::ostream &stream);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~StreamCodeSink();
+
+    /**
+     * \brief Write raw code.
+     * \param data code
+     * \param size number of bytes
+     */
+    virtual void Write(const char *data, const size_t size);
+
+  private:
+    /**
+     * \brief Stream written.
+     */
+    std::ostream *m_stream;
+};
+
+/**
+ * \ingroup generator
+ * \brief Sink writing into a file through a large buffer.
+ *
+ *  The code is copied into a page aligned buffer which is written with
+ *  one write(2) when it is full, the code larger than the buffer is written
+ *  directly. There is no formatting nor locking of a stream on the way.
+ */
+class FileCodeSink : public CodeSink
+{
+  public:
+    /**
+     * \brief Default buffer size, 1 MB.
+     */
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    /**
+     * \brief Constructor.
+     *
+     * The file is created, or truncated if it exists.
+     * \param fileName file written
+     * \param bufferSize buffer size in bytes
+     * \throw std::runtime_error if the file cannot be opened
+     */
+    FileCodeSink(const std::string &fileName, const size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * \brief Destructor.
+     *
+     * The file is closed if Close was not called, write errors are lost.
+     */
+    virtual ~FileCodeSink();
+
+    /**
+     * \brief Write raw code.
+     * \param data code
+     * \param size number of bytes
+     * \throw std::runtime_error if the file cannot be written
+     */
+    virtual void Write(const char *data, const size_t size);
+
+    /**
+     * \brief Write the buffer and close the file.
+     * \throw std::runtime_error if the file cannot be written
+     */
+    void Close();
+
+    /**
+     * \brief Get the number of bytes written.
+     * \return number of bytes, buffered ones included
+     */
+    uint64_t GetSize() const;
+
+  private:
+    /**
+     * \brief Copy constructor, not implemented.
+     */
+    FileCodeSink(const FileCodeSink &);
+
+    /**
+     * \brief Assignment, not implemented.
+     */
+    FileCodeSink &operator=(const FileCodeSink &);
+
+    /**
+     * \brief Write the buffer into the file.
+     */
+    void Flush();
+
+    /**
+     * \brief Write bytes into the file.
+     * \param data bytes
+     * \param size number of bytes
+     */
+    void WriteFile(const char *data, size_t size);
+
+    /**
+     * \brief File name, for the errors.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief File descriptor, -1 once closed.
+     */
+    int m_fd;
+
+    /**
+     * \brief Buffer.
+     */
+    char *m_buffer;
+
+    /**
+     * \brief Buffer size.
+     */
+    size_t m_bufferSize;
+
+    /**
+     * \brief Bytes in the buffer.
+     */
+    size_t m_used;
+
+    /**
+     * \brief Bytes written.
+     */
+    uint64_t m_size;
+};
+
+/**
+ * \ingroup generator
+ * \brief Sink keeping the code in memory.
+ */
+class StringCodeSink : public CodeSink
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    StringCodeSink();
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~StringCodeSink();
+
+    /**
+     * \brief Write raw code.
+     * \param data code
+     * \param size number of bytes
+     */
+    virtual void Write(const char *data, const size_t size);
+
+    /**
+     * \brief Get the code written.
+     * \return code
+     */
+    const std::string &GetText() const;
+
+  private:
+    /**
+     * \brief Code written.
+     */
+    std::string m_text;
+};
+
+/**
+ * \ingroup generator
+ * \brief Sink counting the code and dropping it.
+ *
+ *  It gives the size of the code without writing it and its hash, with
+ *  utils::hashBytes, to compare two generations.
+ */
+class CountingCodeSink : public CodeSink
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    CountingCodeSink();
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~CountingCodeSink();
+
+    /**
+     * \brief Write raw code.
+     * \param data code
+     * \param size number of bytes
+     */
+    virtual void Write(const char *data, const size_t size);
+
+    /**
+     * \brief Get the number of bytes written.
+     * \return number of bytes
+     */
+    uint64_t GetSize() const;
+
+    /**
+     * \brief Get the number of lines written.
+     * \return number of end of lines
+     */
+    uint64_t GetLines() const;
+
+    /**
+     * \brief Get the hash of the code written.
+     * \return hash
+     */
+    uint64_t GetHash() const;
+
+  private:
+    /**
+     * \brief Number of bytes written.
+     */
+    uint64_t m_size;
+
+    /**
+     * \brief Number of end of lines written.
+     */
+    uint64_t m_lines;
+
+    /**
+     * \brief Hash of the bytes written.
+     */
+    uint64_t m_hash;
+};
+
+/**
+ * \ingroup generator
+ * \brief Sink indenting the lines written into another sink.
+ *
+ *  Each line is written into the target sink as a line after the
+ *  indentation, so these sinks can be nested, and is followed by the raw
+ *  separator. A preamble, the comment heading a section for instance, can
+ *  be set to be written before the first line only, so nothing is written
+ *  for an empty section.
+ */
+class IndentedCodeSink : public CodeSink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param target sink written
+     * \param indent text written before each line
+     * \param separator raw text written after each line
+     */
+    IndentedCodeSink(CodeSink &target, const std::string &indent, const std::string &separator = "");
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~IndentedCodeSink();
+
+    /**
+     * \brief Write raw code into the target sink.
+     * \param data code
+     * \param size number of bytes
+     */
+    virtual void Write(const char *data, const size_t size);
+
+    using CodeSink::WriteLine;
+
+    /**
+     * \brief Write an indented line of code.
+     * \param data line, without end of line
+     * \param size number of bytes
+     */
+    virtual void WriteLine(const char *data, const size_t size);
+
+    /**
+     * \brief Set the text written before the first line.
+     * \param preamble raw text
+     */
+    void SetPreamble(const std::string &preamble);
+
+  private:
+    /**
+     * \brief Write the preamble if it is pending.
+     */
+    void FlushPreamble();
+
+    /**
+     * \brief Sink written.
+     */
+    CodeSink *m_target;
+
+    /**
+     * \brief Text written before each line.
+     */
+    std::string m_indent;
+
+    /**
+     * \brief Raw text written after each line.
+     */
+    std::string m_separator;
+
+    /**
+     * \brief Buffer of the indented line, kept from one line to the other.
+     */
+    std::string m_indented;
+
+    /**
+     * \brief Text written before the first line.
+     */
+    std::string m_preamble;
+};
+
+/**
+ * \ingroup generator
+ * \brief Duration written in seconds by CodeLine, "0.25".
+ */
+struct CodeSeconds
+{
+  /**
+   * \brief Constructor.
+   * \param nanoseconds duration
+   */
+  explicit CodeSeconds(const uint64_t nanoseconds) : m_nanoseconds(nanoseconds)
+  {
+  }
+
+  /**
+   * \brief Duration in nanoseconds.
+   */
+  uint64_t m_nanoseconds;
+};
+
+/**
+ * \ingroup generator
+ * \brief Duration written as an ns-3 Time expression by CodeLine, "MilliSeconds (2)".
+ */
+struct CodeTime
+{
+  /**
+   * \brief Constructor.
+   * \param nanoseconds duration
+   */
+  explicit CodeTime(const uint64_t nanoseconds) : m_nanoseconds(nanoseconds)
+  {
+  }
+
+  /**
+   * \brief Duration in nanoseconds.
+   */
+  uint64_t m_nanoseconds;
+};
+
+/**
+ * \ingroup generator
+ * \brief Builder of a line of code.
+ *
+ *  The parts are appended into the line buffer of the sink, which keeps its
+ *  capacity from one line to the other, and the numbers are written without
+ *  stream, so a line costs no allocation once the buffer is large enough.
+ *  The types of the parts are checked by the compiler, there is no format
+ *  string.
+ *
+ *  Usage:
+ *    sink.WriteLine(CodeLine(sink) << "NodeContainer " << name << ".Create (" << number << ");");
+ *
+ *  Only one line is built at a time for a sink.
+ */
+class CodeLine
+{
+  public:
+    /**
+     * \brief Constructor, start an empty line.
+     * \param sink sink the line is written into
+     */
+    explicit CodeLine(CodeSink &sink);
+
+    /**
+     * \brief Append text.
+     * \param text text
+     * \return this line
+     */
+    CodeLine &operator<<(const std::string &text);
+
+    /**
+     * \brief Append text.
+     * \param text null terminated text
+     * \return this line
+     */
+    CodeLine &operator<<(const char *text);
+
+    /**
+     * \brief Append a character.
+     * \param c character
+     * \return this line
+     */
+    CodeLine &operator<<(const char c);
+
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb integer
+     * \return this line
+     */
+    CodeLine &operator<<(const int nb);
+
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb integer
+     * \return this line
+     */
+    CodeLine &operator<<(const unsigned int nb);
+
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb integer
+     * \return this line
+     */
+    CodeLine &operator<<(const long nb);
+
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb integer
+     * \return this line
+     */
+    CodeLine &operator<<(const unsigned long nb);
+
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb integer
+     * \return this line
+     */
+    CodeLine &operator<<(const long long nb);
+
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb integer
+     * \return this line
+     */
+    CodeLine &operator<<(const unsigned long long nb);
+
+    /**
+     * \brief Append a duration in seconds.
+     * \param seconds duration
+     * \return this line
+     */
+    CodeLine &operator<<(const CodeSeconds &seconds);
+
+    /**
+     * \brief Append a duration as an ns-3 Time expression.
+     * \param time duration
+     * \return this line
+     */
+    CodeLine &operator<<(const CodeTime &time);
+
+    /**
+     * \brief Get the line built.
+     * \return line, valid until the next line of the sink
+     */
+    operator const std::string &() const;
+
+  private:
+    /**
+     * \brief Append an integer in decimal.
+     * \param nb absolute value
+     * \param negative true if the integer is negative
+     */
+    void AppendInteger(const unsigned long long nb, const bool negative);
+
+    /**
+     * \brief Line buffer of the sink.
+     */
+    std::string *m_line;
+};
+
+#endif /* CODE_SINK_H */
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file code-table.cpp
+ * \brief Elements generated as rows of constant tables.
+ */
+
+#include <cstring>
+
+#include "code-table.h"
+
+CodeTable::CodeTable(CodeSink &sink)
+{
+  this->m_sink = &sink;
+  this->m_type = 0;
+}
+
+CodeTable::~CodeTable()
+{
+}
+
+CodeSink &CodeTable::GetSink()
+{
+  return *this->m_sink;
+}
+
+void CodeTable::Begin(const CodeTableType &type)
+{
+  if(this->m_type == &type)
+  {
+    return;
+  }
+
+  this->End();
+  this->m_type = &type;
+  this->m_sink->WriteLine("{");
+  WriteText(*this->m_sink, type.row);
+  this->m_sink->WriteLine(CodeLine(*this->m_sink) << "static const " << type.rowName << " table[] =");
+  this->m_sink->WriteLine("{");
+}
+
+size_t CodeTable::AddNodeContainer(const std::string &container)
+{
+  size_t index = this->m_nodes.size();
+  if(!this->m_nodeIndex.Insert(container, index))
+  {
+    this->m_nodeIndex.Find(container, index);
+    return index;
+  }
+
+  this->m_nodes.push_back(container);
+  return index;
+}
+
+size_t CodeTable::AddInterfaces(const std::string &ifaces)
+{
+  size_t index = this->m_ifaces.size();
+  if(!this->m_ifaceIndex.Insert(ifaces, index))
+  {
+    this->m_ifaceIndex.Find(ifaces, index);
+    return index;
+  }
+
+  this->m_ifaces.push_back(ifaces);
+  return index;
+}
+
+void CodeTable::End()
+{
+  if(!this->m_type)
+  {
+    return;
+  }
+
+  this->m_sink->WriteLine("};");
+  this->WriteArray("NodeContainer *nodes[] =", this->m_nodes);
+  this->WriteArray("Ipv4InterfaceContainer *ifaces[] =", this->m_ifaces);
+  WriteText(*this->m_sink, this->m_type->builder);
+  this->m_sink->WriteLine("}");
+
+  this->m_type = 0;
+  this->m_nodes.clear();
+  this->m_nodeIndex = NameIndex();
+  this->m_ifaces.clear();
+  this->m_ifaceIndex = NameIndex();
+}
+
+void CodeTable::WriteText(CodeSink &sink, const char *text)
+{
+  while(*text)
+  {
+    const char *end = strchr(text, '\n');
+    size_t size = end ? end - text : strlen(text);
+    sink.WriteLine(text, size);
+    text += end ? size + 1 : size;
+  }
+}
+
+void CodeTable::WriteArray(const char *declaration, const std::vector<std::string> &names)
+{
+  /* a table of flows refers to no container, an array may not be empty. */
+  if(names.empty())
+  {
+    return;
+  }
+
+  this->m_sink->WriteLine(declaration);
+  this->m_sink->WriteLine("{");
+  for(size_t i = 0; i < names.size(); i++)
+  {
+    this->m_sink->WriteLine(CodeLine(*this->m_sink) << "  &" << names[i] << ",");
+  }
+  this->m_sink->WriteLine("};");
+}
@@ -0,0 +1,173 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file code-table.h
+ * \brief Elements generated as rows of constant tables.
+ */
+
+#ifndef CODE_TABLE_H
+#define CODE_TABLE_H
+
+#include <string>
+#include <vector>
+
+#include "code-sink.h"
+#include "name-index.h"
+
+/**
+ * \ingroup generator
+ * \brief Layout of a table: the structure of its rows and the loop walking them.
+ */
+struct CodeTableType
+{
+  /**
+   * \brief Name of the row structure.
+   */
+  const char *rowName;
+
+  /**
+   * \brief Definition of the row structure, lines ended by '\\n'.
+   */
+  const char *row;
+
+  /**
+   * \brief Loop building the elements of the rows of "table", lines ended by '\\n'.
+   *
+   * The rows refer to the node containers of the "nodes" array and to the
+   * interface containers of the "ifaces" array by index.
+   */
+  const char *builder;
+};
+
+/**
+ * \ingroup generator
+ * \brief Elements generated as rows of constant tables walked by a builder loop.
+ *
+ *  Instead of one block of code per element, the consecutive elements of
+ *  the same table type are written as the rows of a static const array of
+ *  plain structures, followed by the loop which calls the ns-3 helpers for
+ *  each row. The compiler only sees data for each element, the code is the
+ *  same whatever the size of the topology.
+ *
+ *  The containers of the program are not constants, a row refers to them
+ *  by index in the arrays of pointers written after the table, which only
+ *  list the containers of its rows. Each table is a block of its own.
+ *
+ *  Usage:
+ *    table.Begin(UDP_ECHO_TABLE);
+ *    CodeSink &sink = table.GetSink();
+ *    sink.WriteLine(CodeLine(sink) << "  { " << table.AddNodeContainer(container) << ", " << ... << " },");
+ *    ...
+ *    table.End();
+ */
+class CodeTable
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param sink sink of the code
+     */
+    CodeTable(CodeSink &sink);
+
+    /**
+     * \brief Destructor.
+     */
+    ~CodeTable();
+
+    /**
+     * \brief Get the sink the rows are written into.
+     * \return sink of the code
+     */
+    CodeSink &GetSink();
+
+    /**
+     * \brief Start a table, unless the current one is of the same type.
+     *
+     * The current table of another type is ended first.
+     *
+     * \param type table type
+     */
+    void Begin(const CodeTableType &type);
+
+    /**
+     * \brief Get the index of a node container in the "nodes" array.
+     * \param container node container name
+     * \return index
+     */
+    size_t AddNodeContainer(const std::string &container);
+
+    /**
+     * \brief Get the index of an interface container in the "ifaces" array.
+     * \param ifaces interface container name
+     * \return index
+     */
+    size_t AddInterfaces(const std::string &ifaces);
+
+    /**
+     * \brief End the current table, if any, with its arrays and its builder loop.
+     */
+    void End();
+
+    /**
+     * \brief Write lines ended by '\\n'.
+     * \param sink sink of the code
+     * \param text lines
+     */
+    static void WriteText(CodeSink &sink, const char *text);
+
+  private:
+    /**
+     * \brief Write an array of pointers to containers.
+     * \param declaration declaration of the array
+     * \param names container names
+     */
+    void WriteArray(const char *declaration, const std::vector<std::string> &names);
+
+    /**
+     * \brief Sink of the code.
+     */
+    CodeSink *m_sink;
+
+    /**
+     * \brief Type of the current table, null if there is none.
+     */
+    const CodeTableType *m_type;
+
+    /**
+     * \brief Node containers of the current table.
+     */
+    std::vector<std::string> m_nodes;
+
+    /**
+     * \brief Index of m_nodes.
+     */
+    NameIndex m_nodeIndex;
+
+    /**
+     * \brief Interface containers of the current table.
+     */
+    std::vector<std::string> m_ifaces;
+
+    /**
+     * \brief Index of m_ifaces.
+     */
+    NameIndex m_ifaceIndex;
+};
+
+#endif /* CODE_TABLE_H */
@@ -0,0 +1,395 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file compressed-file.cpp
+ * \brief Sequential reader of gzip and zstd compressed files.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <zlib.h>
+#include <zstd.h>
+
+#include "compressed-file.h"
+
+/**
+ * \brief Size of the compressed reads.
+ */
+static const size_t COMPRESSED_INPUT_SIZE = 256 * 1024;
+
+/**
+ * \brief Size of the decompressed blocks.
+ */
+static const size_t DECOMPRESSED_BLOCK_SIZE = 1 << 20;
+
+/**
+ * \brief Decompressed blocks kept ahead of the reader.
+ */
+static const size_t READ_AHEAD_BLOCKS = 4;
+
+CompressedFile::Format CompressedFile::Detect(const std::string &fileName)
+{
+  unsigned char magic[4];
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    return NONE;
+  }
+  ssize_t n = read(fd, magic, sizeof(magic));
+  close(fd);
+
+  if(n >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+  {
+    return GZIP;
+  }
+  if(n == 4 && magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd)
+  {
+    return ZSTD;
+  }
+  return NONE;
+}
+
+CompressedFile::CompressedFile()
+{
+  this->m_format = NONE;
+  this->m_fd = -1;
+  this->m_stream = 0;
+  this->m_inputPos = 0;
+  this->m_inputSize = 0;
+  this->m_frameEnd = false;
+  this->m_running = false;
+  this->m_end = false;
+  this->m_stop = false;
+  this->m_current = 0;
+  this->m_currentPos = 0;
+  this->m_position = 0;
+  pthread_mutex_init(&this->m_mutex, 0);
+  pthread_cond_init(&this->m_filled, 0);
+  pthread_cond_init(&this->m_drained, 0);
+}
+
+CompressedFile::~CompressedFile()
+{
+  this->Close();
+  pthread_cond_destroy(&this->m_drained);
+  pthread_cond_destroy(&this->m_filled);
+  pthread_mutex_destroy(&this->m_mutex);
+}
+
+void CompressedFile::Open(const std::string &fileName)
+{
+  this->Close();
+
+  this->m_fileName = fileName;
+  this->m_format = Detect(fileName);
+  if(this->m_format == NONE)
+  {
+    throw std::runtime_error(fileName + ": not a gzip or zstd file");
+  }
+
+  this->m_fd = open(fileName.c_str(), O_RDONLY);
+  if(this->m_fd < 0)
+  {
+    throw std::runtime_error(fileName + ": " + strerror(errno));
+  }
+  posix_fadvise(this->m_fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+  if(this->m_format == GZIP)
+  {
+    z_stream *z = new z_stream;
+    memset(z, 0, sizeof(*z));
+    /* 15 + 16: gzip header, the largest window. */
+    if(inflateInit2(z, 15 + 16) != Z_OK)
+    {
+      delete z;
+      this->Close();
+      throw std::runtime_error(fileName + ": cannot initialize zlib");
+    }
+    this->m_stream = z;
+  }
+  else
+  {
+    ZSTD_DStream *z = ZSTD_createDStream();
+    if(!z || ZSTD_isError(ZSTD_initDStream(z)))
+    {
+      ZSTD_freeDStream(z);
+      this->Close();
+      throw std::runtime_error(fileName + ": cannot initialize zstd");
+    }
+    this->m_stream = z;
+  }
+
+  this->m_input.resize(COMPRESSED_INPUT_SIZE);
+  this->m_inputPos = 0;
+  this->m_inputSize = 0;
+  this->m_frameEnd = false;
+  this->m_end = false;
+  this->m_stop = false;
+  this->m_error.clear();
+  this->m_position = 0;
+
+  if(pthread_create(&this->m_thread, 0, &CompressedFile::ReadAhead, this) != 0)
+  {
+    this->Close();
+    throw std::runtime_error(fileName + ": cannot start the read-ahead thread");
+  }
+  this->m_running = true;
+}
+
+void CompressedFile::Close()
+{
+  if(this->m_running)
+  {
+    pthread_mutex_lock(&this->m_mutex);
+    this->m_stop = true;
+    pthread_cond_signal(&this->m_drained);
+    pthread_mutex_unlock(&this->m_mutex);
+    pthread_join(this->m_thread, 0);
+    this->m_running = false;
+  }
+
+  for(size_t i = 0; i < this->m_blocks.size(); i++)
+  {
+    delete this->m_blocks.at(i);
+  }
+  this->m_blocks.clear();
+  delete this->m_current;
+  this->m_current = 0;
+  this->m_currentPos = 0;
+
+  if(this->m_stream)
+  {
+    if(this->m_format == GZIP)
+    {
+      inflateEnd(static_cast<z_stream*>(this->m_stream));
+      delete static_cast<z_stream*>(this->m_stream);
+    }
+    else
+    {
+      ZSTD_freeDStream(static_cast<ZSTD_DStream*>(this->m_stream));
+    }
+    this->m_stream = 0;
+  }
+
+  if(this->m_fd >= 0)
+  {
+    close(this->m_fd);
+    this->m_fd = -1;
+  }
+}
+
+size_t CompressedFile::Read(char *buffer, const size_t size)
+{
+  size_t n = 0;
+  while(n < size)
+  {
+    if(this->m_current && this->m_currentPos == this->m_current->size())
+    {
+      delete this->m_current;
+      this->m_current = 0;
+    }
+
+    if(!this->m_current)
+    {
+      pthread_mutex_lock(&this->m_mutex);
+      /* hand what we have to the caller rather than waiting for more. */
+      if(n > 0 && this->m_blocks.empty())
+      {
+        pthread_mutex_unlock(&this->m_mutex);
+        break;
+      }
+      while(this->m_blocks.empty() && !this->m_end)
+      {
+        pthread_cond_wait(&this->m_filled, &this->m_mutex);
+      }
+      if(!this->m_blocks.empty())
+      {
+        this->m_current = this->m_blocks.front();
+        this->m_blocks.pop_front();
+        this->m_currentPos = 0;
+        pthread_cond_signal(&this->m_drained);
+      }
+      std::string error = this->m_error;
+      pthread_mutex_unlock(&this->m_mutex);
+
+      if(!this->m_current)
+      {
+        if(!error.empty())
+        {
+          throw std::runtime_error(this->m_fileName + ": " + error);
+        }
+        break;
+      }
+    }
+
+    size_t len = this->m_current->size() - this->m_currentPos;
+    if(len > size - n)
+    {
+      len = size - n;
+    }
+    memcpy(buffer + n, this->m_current->data() + this->m_currentPos, len);
+    this->m_currentPos += len;
+    n += len;
+  }
+
+  this->m_position += n;
+  return n;
+}
+
+size_t CompressedFile::GetPosition() const
+{
+  return this->m_position;
+}
+
+void *CompressedFile::ReadAhead(void *file)
+{
+  static_cast<CompressedFile*>(file)->Decompress();
+  return 0;
+}
+
+void CompressedFile::Decompress()
+{
+  std::string error;
+  bool more = true;
+  while(more)
+  {
+    std::string *block = new std::string;
+    try
+    {
+      more = this->DecompressBlock(*block);
+    }
+    catch(const std::exception &e)
+    {
+      error = e.what();
+      more = false;
+    }
+
+    pthread_mutex_lock(&this->m_mutex);
+    while(this->m_blocks.size() >= READ_AHEAD_BLOCKS && !this->m_stop)
+    {
+      pthread_cond_wait(&this->m_drained, &this->m_mutex);
+    }
+    if(this->m_stop)
+    {
+      more = false;
+      delete block;
+    }
+    else if(block->empty())
+    {
+      delete block;
+    }
+    else
+    {
+      this->m_blocks.push_back(block);
+    }
+    if(!more)
+    {
+      this->m_error = error;
+      this->m_end = true;
+    }
+    pthread_cond_signal(&this->m_filled);
+    pthread_mutex_unlock(&this->m_mutex);
+  }
+}
+
+bool CompressedFile::FillInput()
+{
+  ssize_t n;
+  do
+  {
+    n = read(this->m_fd, &this->m_input[0], this->m_input.size());
+  }
+  while(n < 0 && errno == EINTR);
+
+  if(n < 0)
+  {
+    throw std::runtime_error(strerror(errno));
+  }
+  this->m_inputPos = 0;
+  this->m_inputSize = n;
+  return n > 0;
+}
+
+bool CompressedFile::DecompressBlock(std::string &block)
+{
+  block.resize(DECOMPRESSED_BLOCK_SIZE);
+  size_t outPos = 0;
+
+  while(outPos < block.size())
+  {
+    if(this->m_inputPos == this->m_inputSize && !this->FillInput())
+    {
+      if(!this->m_frameEnd)
+      {
+        throw std::runtime_error("unexpected end of compressed data");
+      }
+      block.resize(outPos);
+      return false;
+    }
+
+    if(this->m_format == GZIP)
+    {
+      z_stream *z = static_cast<z_stream*>(this->m_stream);
+      z->next_in = reinterpret_cast<Bytef*>(&this->m_input[this->m_inputPos]);
+      z->avail_in = this->m_inputSize - this->m_inputPos;
+      z->next_out = reinterpret_cast<Bytef*>(&block[outPos]);
+      z->avail_out = block.size() - outPos;
+
+      int ret = inflate(z, Z_NO_FLUSH);
+      this->m_inputPos = this->m_inputSize - z->avail_in;
+      outPos = block.size() - z->avail_out;
+      if(ret == Z_STREAM_END)
+      {
+        /* another gzip member may follow (concatenated or parallel gzip). */
+        this->m_frameEnd = true;
+        inflateReset(z);
+      }
+      else if(ret == Z_OK || ret == Z_BUF_ERROR)
+      {
+        this->m_frameEnd = false;
+      }
+      else
+      {
+        throw std::runtime_error(std::string("gzip: ") + (z->msg ? z->msg : "corrupted data"));
+      }
+    }
+    else
+    {
+      ZSTD_inBuffer in = { &this->m_input[this->m_inputPos], this->m_inputSize - this->m_inputPos, 0 };
+      ZSTD_outBuffer out = { &block[outPos], block.size() - outPos, 0 };
+
+      size_t ret = ZSTD_decompressStream(static_cast<ZSTD_DStream*>(this->m_stream), &out, &in);
+      if(ZSTD_isError(ret))
+      {
+        throw std::runtime_error(std::string("zstd: ") + ZSTD_getErrorName(ret));
+      }
+      this->m_inputPos += in.pos;
+      outPos += out.pos;
+      /* 0: the frame is complete and flushed. */
+      this->m_frameEnd = ret == 0;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file compressed-file.h
+ * \brief Sequential reader of gzip and zstd compressed files.
+ */
+
+#ifndef COMPRESSED_FILE_H
+#define COMPRESSED_FILE_H
+
+#include <pthread.h>
+
+#include <deque>
+#include <string>
+
+/**
+ * \ingroup generator
+ * \brief Sequential reader of gzip and zstd compressed files.
+ *
+ *  The file is decompressed by a read-ahead thread into a few blocks
+ *  while the caller consumes the previous ones, so decompression overlaps
+ *  with parsing and nothing is written to disk.
+ */
+class CompressedFile
+{
+  public:
+    /**
+     * \brief Compression formats.
+     */
+    enum Format
+    {
+      NONE, /**< not compressed */
+      GZIP, /**< gzip (RFC 1952) */
+      ZSTD  /**< Zstandard (RFC 8878) */
+    };
+
+    /**
+     * \brief Find the compression format of a file from its first bytes.
+     * \param fileName file name
+     * \return compression format, NONE if the file cannot be read
+     */
+    static Format Detect(const std::string &fileName);
+
+    /**
+     * \brief Constructor.
+     */
+    CompressedFile();
+
+    /**
+     * \brief Destructor.
+     */
+    ~CompressedFile();
+
+    /**
+     * \brief Open a file and start decompressing it, closing the previous one.
+     * \param fileName file name
+     * \throw std::runtime_error if the file cannot be opened or is not compressed
+     */
+    void Open(const std::string &fileName);
+
+    /**
+     * \brief Stop decompressing and close the file.
+     */
+    void Close();
+
+    /**
+     * \brief Read decompressed bytes.
+     * \param buffer destination
+     * \param size buffer size
+     * \return number of bytes read, 0 at the end of the file
+     * \throw std::runtime_error if the file is damaged or truncated
+     */
+    size_t Read(char *buffer, const size_t size);
+
+    /**
+     * \brief Get the number of decompressed bytes read.
+     * \return number of bytes
+     */
+    size_t GetPosition() const;
+
+  private:
+    /**
+     * \brief Copy constructor (not implemented).
+     */
+    CompressedFile(const CompressedFile &);
+
+    /**
+     * \brief Assignment (not implemented).
+     */
+    CompressedFile &operator=(const CompressedFile &);
+
+    /**
+     * \brief Read-ahead thread entry point.
+     * \param file the file
+     * \return NULL
+     */
+    static void *ReadAhead(void *file);
+
+    /**
+     * \brief Decompress the file into the block queue.
+     */
+    void Decompress();
+
+    /**
+     * \brief Decompress the next block.
+     * \param block destination, filled up to its size unless the file ends
+     * \return false at the end of the file
+     */
+    bool DecompressBlock(std::string &block);
+
+    /**
+     * \brief Read the next compressed bytes.
+     * \return false at the end of the file
+     */
+    bool FillInput();
+
+    /**
+     * \brief File name, for the error messages.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Compression format.
+     */
+    Format m_format;
+
+    /**
+     * \brief File descriptor, -1 if closed.
+     */
+    int m_fd;
+
+    /**
+     * \brief Decompressor state (z_stream or ZSTD_DStream).
+     */
+    void *m_stream;
+
+    /**
+     * \brief Compressed bytes read from the file.
+     */
+    std::string m_input;
+
+    /**
+     * \brief Compressed bytes not decompressed yet.
+     */
+    size_t m_inputPos;
+
+    /**
+     * \brief Size of the compressed bytes in m_input.
+     */
+    size_t m_inputSize;
+
+    /**
+     * \brief The last compressed frame is complete.
+     */
+    bool m_frameEnd;
+
+    /**
+     * \brief Read-ahead thread.
+     */
+    pthread_t m_thread;
+
+    /**
+     * \brief The read-ahead thread is running.
+     */
+    bool m_running;
+
+    /**
+     * \brief Protect the members below.
+     */
+    pthread_mutex_t m_mutex;
+
+    /**
+     * \brief Signaled when a block is queued or the decompression ends.
+     */
+    pthread_cond_t m_filled;
+
+    /**
+     * \brief Signaled when a block is consumed or the reader stops.
+     */
+    pthread_cond_t m_drained;
+
+    /**
+     * \brief Decompressed blocks not consumed yet.
+     */
+    std::deque<std::string*> m_blocks;
+
+    /**
+     * \brief The decompression is over.
+     */
+    bool m_end;
+
+    /**
+     * \brief The reader asks the read-ahead thread to stop.
+     */
+    bool m_stop;
+
+    /**
+     * \brief Decompression error, empty if none.
+     */
+    std::string m_error;
+
+    /**
+     * \brief Block being consumed.
+     */
+    std::string *m_current;
+
+    /**
+     * \brief Bytes of m_current already consumed.
+     */
+    size_t m_currentPos;
+
+    /**
+     * \brief Decompressed bytes read.
+     */
+    size_t m_position;
+};
+
+#endif /* COMPRESSED_FILE_H */
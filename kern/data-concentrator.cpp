@@ -30,7 +30,7 @@
 
 #include "utils.h"
 
-DataConcentrator::DataConcentrator(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+DataConcentrator::DataConcentrator(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->SetAppName(std::string("dataConcentrator_" + this->GetIndice()));
 }
@@ -48,19 +48,16 @@ std::vector<std::string> DataConcentrator::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> DataConcentrator::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void DataConcentrator::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
   (void)netDeviceContainer;
   (void)numberIntoNetDevice;
 
-  apps.push_back("");
-  apps.push_back("DataConcentratorApplicationHelper dc_" + this->GetAppName() + " (clientApps_udpCosem_" + this->GetIndice() + ", iface_ndc_p2p_" + this->GetIndice() + ".GetAddress (1), iface_ndc_p2p_" + this->GetIndice() + ".GetAddress (0));");
-  apps.push_back("ApplicationContainer dcApps_" + this->GetAppName() + " = dc_" + this->GetAppName() + ".Install (ap_" + this->GetIndice() + ");");
-  apps.push_back("dcApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".001));");
-  apps.push_back("dcApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  return apps;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "DataConcentratorApplicationHelper dc_" << this->GetAppName() << " (clientApps_udpCosem_" << this->GetIndice() << ", iface_ndc_p2p_" << this->GetIndice() << ".GetAddress (1), iface_ndc_p2p_" << this->GetIndice() << ".GetAddress (0));");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer dcApps_" << this->GetAppName() << " = dc_" << this->GetAppName() << ".Install (ap_" << this->GetIndice() << ");");
+  sink.WriteLine(CodeLine(sink) << "dcApps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".001));");
+  sink.WriteLine(CodeLine(sink) << "dcApps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 }
 
 std::vector<std::string> DataConcentrator::GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice)
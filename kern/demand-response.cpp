@@ -30,7 +30,7 @@
 
 #include "utils.h"
 
-DemandResponse::DemandResponse(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+DemandResponse::DemandResponse(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->SetAppName(std::string("demandResponse_" + this->GetIndice()));
 }
@@ -48,19 +48,16 @@ std::vector<std::string> DemandResponse::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> DemandResponse::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void DemandResponse::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
   (void)netDeviceContainer;
   (void)numberIntoNetDevice;
 
-  apps.push_back("");
-  apps.push_back("DemandResponseApplicationHelper dr_" + this->GetAppName() + " (iface_ndc_hub_" + this->GetIndice() + ".GetAddress (1), mdmApps_meterDataManagement_" + this->GetIndice() + ");");
-  apps.push_back("ApplicationContainer drApps_" + this->GetAppName() + " = dr_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ");");
-  apps.push_back("drApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("drApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  return apps;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "DemandResponseApplicationHelper dr_" << this->GetAppName() << " (iface_ndc_hub_" << this->GetIndice() << ".GetAddress (1), mdmApps_meterDataManagement_" << this->GetIndice() << ");");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer drApps_" << this->GetAppName() << " = dr_" << this->GetAppName() << ".Install (" << this->GetReceiverNode() << ");");
+  sink.WriteLine(CodeLine(sink) << "drApps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "drApps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 }
 
 std::vector<std::string> DemandResponse::GenerateApplicationPython(std::string netDeviceContainer, size_t numberIntoNetDevice)
@@ -27,7 +27,7 @@
 
 #include "emu.h"
 
-Emu::Emu(const std::string &type, const size_t &indice, const std::string &emuNode, const std::string &ifaceName) : NetworkHardware(type, indice)
+Emu::Emu(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &emuNode, const std::string &ifaceName) : NetworkHardware(symbols, type, indice)
 {
   this->Install(emuNode);
   this->m_emuNode = emuNode;
@@ -35,6 +35,7 @@ Emu::Emu(const std::string &type, const size_t &indice, const std::string &emuNo
   this->SetNetworkHardwareName(std::string("emu_" + this->GetIndice()));
   this->SetNdcName(std::string("ndc_" + this->GetNetworkHardwareName()));
   this->SetAllNodeContainer(std::string("all_" + this->GetNetworkHardwareName()));
+  this->m_emuDeviceName = this->InternName("emuDevice_");
 }
 
 Emu::~Emu()
@@ -70,57 +71,39 @@ std::vector<std::string> Emu::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Emu::GenerateNetworkHardwareCpp()
+void Emu::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> generatedLink;
-  generatedLink.push_back("EmuHelper " + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back(this->GetNetworkHardwareName() + ".SetAttribute (\"DeviceName\", StringValue (emuDevice_" + this->GetNetworkHardwareName() + "));");
-
-  return generatedLink;
+  sink.WriteLine(CodeLine(sink) << "EmuHelper " << this->GetNetworkHardwareName() << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetNetworkHardwareName() << ".SetAttribute (\"DeviceName\", StringValue (" << this->GetSymbolName(this->m_emuDeviceName) << "));");
 }
 
-std::vector<std::string> Emu::GenerateNetDeviceCpp()
+void Emu::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = " + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
+  this->GroupAsNodeContainerCpp(sink);
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetNdcName() << " = " << this->GetNetworkHardwareName() << ".Install (" << this->GetAllNodeContainer() << ");");
 }
 
-std::vector<std::string> Emu::GenerateVarsCpp()
+void Emu::GenerateVarsCpp(CodeSink &sink)
 {
-  std::vector<std::string> vars;
-  vars.push_back("std::string emuDevice_" + this->GetNetworkHardwareName() + " = \"" + this->GetIfaceName() + "\";");
-  return vars;
+  sink.WriteLine(CodeLine(sink) << "std::string " << this->GetSymbolName(this->m_emuDeviceName) << " = \"" << this->GetIfaceName() << "\";");
 }
 
-std::vector<std::string> Emu::GenerateCmdLineCpp()
+void Emu::GenerateCmdLineCpp(CodeSink &sink)
 {
-  std::vector<std::string> cmdLine;
-  cmdLine.push_back("cmd.AddValue(\"deviceName_" + this->GetNetworkHardwareName() + "\", \"device name\", emuDevice_" + this->GetNetworkHardwareName() + ");");
-  return cmdLine;
+  sink.WriteLine(CodeLine(sink) << "cmd.AddValue(\"deviceName_" << this->GetNetworkHardwareName() << "\", \"device name\", " << this->GetSymbolName(this->m_emuDeviceName) << ");");
 }
 
-std::vector<std::string> Emu::GenerateTraceCpp()
+void Emu::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> trace;
-
   if(this->GetTrace())
   {
     if(this->GetPromisc())
     {
-      trace.push_back("EmuHelper::EnablePcap (\"Emu-" + this->GetNetworkHardwareName() + "\",\"" + this->m_ifaceName + "\", true);");
+      sink.WriteLine(CodeLine(sink) << "EmuHelper::EnablePcap (\"Emu-" << this->GetNetworkHardwareName() << "\",\"" << this->m_ifaceName << "\", true);");
     }
     else
     {
-      trace.push_back("EmuHelper::EnablePcap (\"Emu-" + this->GetNetworkHardwareName() + "\",\"" + this->m_ifaceName + "\", false);");
+      sink.WriteLine(CodeLine(sink) << "EmuHelper::EnablePcap (\"Emu-" << this->GetNetworkHardwareName() << "\",\"" << this->m_ifaceName << "\", false);");
     }
   }
-
-  return trace;
 }
@@ -80,15 +80,21 @@ class Emu : public NetworkHardware
      */
     std::string m_ifaceName;
 
+    /**
+     * \brief Device name variable.
+     */
+    Symbol m_emuDeviceName;
+
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice tap number
      * \param emuNode link node name
      * \param ifaceName iface name
      * \param type link type
      */
-    Emu(const std::string &type, const size_t &indice, const std::string &emuNode, const std::string &ifaceName);
+    Emu(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &emuNode, const std::string &ifaceName);
 
     /**
      * \brief Destructor.
@@ -127,35 +133,35 @@ class Emu : public NetworkHardware
 
     /**
      * \brief Generate build link C++ code.
-     * \return build link code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate build of the net device container C++ code.
-     * \return net device container code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Rewritted from base class.
-     * \return vars code
+     * \param sink sink of the code
      * \see Link
      */
-    std::vector<std::string> GenerateVarsCpp();
+    void GenerateVarsCpp(CodeSink &sink);
 
     /**
      * \brief Rewritted from base class.
-     * \return cmd line code
+     * \param sink sink of the code
      * \see Link
      */
-    virtual std::vector<std::string> GenerateCmdLineCpp();
+    virtual void GenerateCmdLineCpp(CodeSink &sink);
 
     /**
      * \brief Generate the trace line C++ code.
-     * \return trace line
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
+    virtual void GenerateTraceCpp(CodeSink &sink);
     
 };
 
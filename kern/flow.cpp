@@ -27,17 +27,20 @@
 
 #include "flow.h"
 #include "generator.h"
+#include "code-table.h"
 
 #include "utils.h"
 
-Flow::Flow(const size_t &indice, const std::string &type, const std::string &flowName, const std::string &source, const std::string &destination, const std::string &expectedDelay, const std::string &expectedReliability)
+Flow::Flow(SymbolTable &symbols, const size_t &indice, const std::string &type, const std::string &flowName, const std::string &source, const std::string &destination, const std::string &expectedDelay, const std::string &expectedReliability)
 {
+  this->m_symbols = &symbols;
   this->m_indice = indice;
-  this->m_type = type;
+  this->m_indiceName = utils::integerToString(indice);
+  this->m_type = symbols.Intern(type);
 //  this->m_modelName = modelName;
-  this->m_flowName = flowName;
-  this->m_source = source;
-  this->m_destination = destination;
+  this->m_flowName = symbols.Intern(flowName);
+  this->m_source = symbols.Intern(source);
+  this->m_destination = symbols.Intern(destination);
   this->m_expectedDelay = expectedDelay;
   this->m_expectedReliability = expectedReliability;
 }
@@ -48,22 +51,23 @@ Flow::~Flow()
 
 void Flow::SetFlowName(const std::string &flowName)
 {
-  this->m_flowName = flowName;
+  this->m_flowName = this->m_symbols->Intern(flowName);
 }
 
-std::string Flow::GetFlowName()
+const std::string &Flow::GetFlowName() const
 {
-  return this->m_flowName;
+  return this->m_symbols->GetName(this->m_flowName);
 }
 
-std::string Flow::GetIndice()
+const std::string &Flow::GetIndice() const
 {
-  return utils::integerToString(this->m_indice);
+  return this->m_indiceName;
 }
 
 void Flow::SetIndice(const size_t &indice)
 {
   this->m_indice = indice;
+  this->m_indiceName = utils::integerToString(indice);
 }
 
 std::vector<std::string> Flow::GenerateHeader()
@@ -74,17 +78,44 @@ std::vector<std::string> Flow::GenerateHeader()
   return headers; 
 }
 
-std::vector<std::string> Flow::GenerateFlowCpp()
+void Flow::GenerateFlowCpp(CodeSink &sink)
 {
-  std::vector<std::string> flows;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "query (\"UPDATE performancedata SET ExpectedReliability=" << this->m_expectedReliability << ", ExpectedDelay=" << this->m_expectedDelay << " WHERE ModelName='mymodelname'" << " AND FromNode='" << this->m_symbols->GetName(this->m_source) << "' AND ToNode='" << this->m_symbols->GetName(this->m_destination) << "'\");");
+}
 
-  flows.push_back("");
-  flows.push_back("query (\"UPDATE performancedata SET ExpectedReliability=" + this->m_expectedReliability + ", ExpectedDelay=" + this->m_expectedDelay + " WHERE ModelName='mymodelname'"  + " AND FromNode='" + this->m_source + "' AND ToNode='" + this->m_destination + "'\");");
+/**
+ * \brief Table of the flows, their expected values.
+ */
+static const CodeTableType FLOW_TABLE =
+{
+  "FlowRow",
+  "struct FlowRow\n"
+  "{\n"
+  "  const char *reliability;\n"
+  "  const char *delay;\n"
+  "  const char *from;\n"
+  "  const char *to;\n"
+  "};\n",
+  "for (size_t i = 0; i < sizeof (table) / sizeof (table[0]); ++i)\n"
+  "  {\n"
+  "  const FlowRow &row = table[i];\n"
+  "  std::ostringstream sql;\n"
+  "  sql << \"UPDATE performancedata SET ExpectedReliability=\" << row.reliability << \", ExpectedDelay=\" << row.delay\n"
+  "      << \" WHERE ModelName='mymodelname' AND FromNode='\" << row.from << \"' AND ToNode='\" << row.to << \"'\";\n"
+  "  query (sql.str ().c_str ());\n"
+  "  }\n"
+};
 
-  return flows; 
+void Flow::GenerateTableRowCpp(CodeTable &table)
+{
+  table.Begin(FLOW_TABLE);
+  CodeSink &sink = table.GetSink();
+  sink.WriteLine(CodeLine(sink) << "  { \"" << this->m_expectedReliability << "\", \"" << this->m_expectedDelay << "\", \""
+                 << this->m_symbols->GetName(this->m_source) << "\", \"" << this->m_symbols->GetName(this->m_destination) << "\" },");
 }
 
-std::string Flow::GetFlowType()
+const std::string &Flow::GetFlowType() const
 {
-  return this->m_type;
+  return this->m_symbols->GetName(this->m_type);
 }
@@ -32,6 +32,11 @@
 #include <string>
 #include <vector>
 
+#include "code-sink.h"
+#include "symbol-table.h"
+
+class CodeTable;
+
 /**
  * \ingroup generator
  * \brief Flow base class.
@@ -46,11 +51,21 @@
 class Flow 
 {
   private:
+    /**
+     * \brief Table holding the names.
+     */
+    SymbolTable *m_symbols;
+
     /**
      * \brief Flow number.
      */
     size_t m_indice;
 
+    /**
+     * \brief Indice as a string, as returned by GetIndice.
+     */
+    std::string m_indiceName;
+
     /**
      * \brief Model name.
      */
@@ -59,17 +74,17 @@ class Flow
     /**
      * \brief Flow name.
      */
-    std::string m_flowName;
+    Symbol m_flowName;
 
     /**
      * \brief Flow source.
      */
-    std::string m_source;
+    Symbol m_source;
 
     /**
      * \brief Flow source.
      */
-    std::string m_destination;
+    Symbol m_destination;
 
     /**
      * \brief Flow source.
@@ -89,17 +104,18 @@ class Flow
     /**
      * \brief Flow type.
      */
-    std::string m_type;
+    Symbol m_type;
 
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice number of the flow
      * \param type type of the flow (pc, router, ...)
      * \param namePrefix the prefix name of the flow
      * \param machinesNumber number of machine to create
      */
-    Flow(const size_t &indice, const std::string &type, const std::string &namePrefix, const std::string &source, const std::string &destination, const std::string &expectedDelay, const std::string &expectedReliability);
+    Flow(SymbolTable &symbols, const size_t &indice, const std::string &type, const std::string &namePrefix, const std::string &source, const std::string &destination, const std::string &expectedDelay, const std::string &expectedReliability);
 
     /**
      * \brief Destructor.
@@ -115,17 +131,23 @@ class Flow
 
     /**
      * \brief Generate flow C++ code.
-     * This function return a vector which contain the declaration and instanciation of the flow
-     * \return flow code
+     * This function writes the declaration and instanciation of the flow
+     * \param sink sink of the code
+     */
+    void GenerateFlowCpp(CodeSink &sink);
+
+    /**
+     * \brief Generate the flow as a row of the table of the flows.
+     * \param table table of the flows
      */
-    std::vector<std::string> GenerateFlowCpp();
+    void GenerateTableRowCpp(CodeTable &table);
 
     /**
      * \brief Generate Flowmonitor install C++ code.
-     * This function returns a vector which contains the declaration of Flowmonitor on a node
-     * \return Flowmonitor declaration code
+     * This function writes the declaration of Flowmonitor on a node
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateFlowmonitor();
+    void GenerateFlowmonitor(CodeSink &sink);
 
     /**
      * \brief Set flow name.
@@ -146,7 +168,7 @@ class Flow
      * \brief Get flow name.
      * \return flow name
      */
-    std::string GetFlowName();
+    const std::string &GetFlowName() const;
 
     /**
      * \brief Get flow name.
@@ -165,7 +187,7 @@ class Flow
      * \brief Get indice.
      * \return indice
      */
-    std::string GetIndice();
+    const std::string &GetIndice() const;
 
     /**
      * \brief Set indice.
@@ -177,7 +199,7 @@ class Flow
      * \brief Get flow type.
      * \return type the flow type
      */
-    std::string GetFlowType();
+    const std::string &GetFlowType() const;
 };
 
 #endif /* FLOW_H */
@@ -25,68 +25,31 @@
  * \date 2009
  */
 
+#include <algorithm>
 #include <cstdlib> 
 #include <iostream>
-#include <fstream>
 #include <stdexcept>
 
 #include "generator.h"
+#include "code-table.h"
 #include "node.h"
-#include "hub.h"
-#include "point-to-point.h"
-#include "bridge.h"
-#include "ap.h"
-#include "ping.h"
-#include "udp-echo.h"
-#include "udp.h"
-#include "udp-cosem.h"
-#include "data-concentrator.h"
-#include "meter-data-management.h"
-#include "demand-response.h"
-#include "tcp-large-transfer.h"
-#include "tap.h"
-#include "emu.h"
 #include "utils.h"
 
 using utils::split;
 
-Generator::Generator(const std::string &simulationName)
+Generator::Generator(const std::string &simulationName) : m_nodeStore(m_symbols)
 {
   this->m_simulationName = simulationName;
+  this->m_emitTables = false;
 
-  /* Node. */
-  this->m_indiceNodePc = 0;
-  this->m_indiceNodeRouter = 0;
-  this->m_indiceNodeAp = 0;
-  this->m_indiceNodeStation = 0;
-  this->m_indiceNodeBridge = 0;
-  this->m_indiceNodeTap = 0;
-  this->m_indiceNodeEmu = 0;
-
-  /* Link */
-  this->m_indiceNetworkHardwareAp = 0;
-  this->m_indiceNetworkHardwareEmu = 0;
-  this->m_indiceNetworkHardwarePointToPoint = 0;
-  this->m_indiceNetworkHardwareTap = 0;
-  this->m_indiceNetworkHardwareHub = 0;
-  this->m_indiceNetworkHardwareBridge = 0;
-
-  /* Application */
-  this->m_indiceApplicationPing = 0; 
-  this->m_indiceApplicationTcpLargeTransfer = 0;
-  this->m_indiceApplicationUdpEcho = 0;
-  this->m_indiceApplicationUdp = 0;
-  this->m_indiceApplicationUdpCosem = 0;
-  this->m_indiceApplicationDataConcentrator = 0;
-  this->m_indiceApplicationMeterDataManagement = 0;
-  this->m_indiceApplicationDemandResponse = 0;
-
-  // Flow
-  this->m_indiceFlowWireless = 0;
-  this->m_indiceFlowMultiHop = 0;
-  this->m_indiceFlowWired = 0;
-
+  /* elements created by type. */
+  this->m_typeCounters.assign(TypeRegistry::GetNCounters(), 0);
 
+  /* Removed elements */
+  this->m_nRemovedNodes = 0;
+  this->m_nRemovedApplications = 0;
+  this->m_nRemovedNetworkHardwares = 0;
+  this->m_nRemovedFlows = 0;
 }
 
 Generator::~Generator()
@@ -94,24 +57,24 @@ Generator::~Generator()
   /* Node */
   for(size_t i = 0; i < this->m_listNode.size(); i++)
   {
-    delete this->m_listNode.at(i);
+    this->m_arena.Destroy(this->m_listNode.at(i));
   }
 
   /* Link */
   for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
   {
-    delete this->m_listNetworkHardware.at(i);
+    this->m_arena.Destroy(this->m_listNetworkHardware.at(i));
   }
 
   /* Application */
   for(size_t i = 0; i < this->m_listApplication.size(); i++)
   {
-    delete this->m_listApplication.at(i);
+    this->m_arena.Destroy(this->m_listApplication.at(i));
   }
   /* Flow */
   for(size_t i = 0; i < this->m_listFlow.size(); i++)
   {
-    delete this->m_listFlow.at(i);
+    this->m_arena.Destroy(this->m_listFlow.at(i));
   }
 }
 
@@ -136,142 +99,140 @@ void Generator::AddConfig(const std::string &config)
 //
 void Generator::AddNode(const std::string &type, const std::string &nodeName) 
 {
-  size_t number = 1;
-  Node *equi = NULL;
+  this->AddNode(type, nodeName, 1);
+}
 
-  // call to the right type constructor. 
-  if(type == "Pc" || type == "Pc-group")
-  {
-    equi = new Node(this->m_indiceNodePc, type, nodeName, number);
-    this->m_indiceNodePc += 1;
-  } 
-  else if(type == "Router")
-  {
-    equi = new Node(this->m_indiceNodeRouter, type, nodeName, number);
-    this->m_indiceNodeRouter += 1;
-  } 
-  else if(type == "AccessPoint")
-  {
-    equi = new Node(this->m_indiceNodeAp, type, nodeName, number);
-    this->m_indiceNodeAp += 1;
-  } 
-  else if(type == "Station")
-  {
-    equi = new Node(this->m_indiceNodeStation, type, nodeName, number);
-    this->m_indiceNodeStation += 1;
-  } 
-  else if(type == "Bridge")
-  {
-    equi = new Node(this->m_indiceNodeBridge, type, nodeName, number);
-    this->m_indiceNodeBridge += 1;
-  } 
-  else if(type == "Tap")
-  {
-    equi = new Node(this->m_indiceNodeTap, type, nodeName, number);
-    this->m_indiceNodeTap += 1;
-  } 
-  else if(type == "Emu")
+void Generator::AddNode(const std::string &type, const std::string &nodeName, const size_t number) 
+{
+  if(this->FindNode(nodeName))
   {
-    equi = new Node(this->m_indiceNodeEmu, type, nodeName, number);
-    this->m_indiceNodeEmu += 1;
+    throw std::logic_error("Add Node failed! (" + nodeName + ") already exists.");
   }
 
-  if(equi)
-  {
-    this->m_listNode.push_back(equi);
-  }
-  else
+  const TypeInfo *info = TypeRegistry::Find(NODE_KIND, type);
+  if(!info)
   {
     throw std::logic_error("Add Node failed! (" + type + ") unknow.");
   }
+
+  this->InsertNode(*info, type, nodeName, number);
 }
 
-void Generator::AddNode(const std::string &type, const std::string &nodeName, const size_t number) 
+void Generator::AddNodes(const std::string &type, const std::vector<std::string> &nodeNames)
 {
-  Node *equi = NULL;
-
-  // call to the right type constructor. 
-  if(type == "Pc" || type == "Pc-group")
+  const TypeInfo *info = TypeRegistry::Find(NODE_KIND, type);
+  if(!info)
   {
-    equi = new Node(this->m_indiceNodePc, type, nodeName, number);
-    this->m_indiceNodePc += 1;
-  } 
-  else if(type == "Router")
-  {
-    equi = new Node(this->m_indiceNodeRouter, type, nodeName, number);
-    this->m_indiceNodeRouter += 1;
-  } 
-  else if(type == "AccessPoint")
-  {
-    equi = new Node(this->m_indiceNodeAp, type, nodeName, number);
-    this->m_indiceNodeAp += 1;
-  } 
-  else if(type == "Station")
-  {
-    equi = new Node(this->m_indiceNodeStation, type, nodeName, number);
-    this->m_indiceNodeStation += 1;
-  } 
-  else if(type == "Bridge")
-  {
-    equi = new Node(this->m_indiceNodeBridge, type, nodeName, number);
-    this->m_indiceNodeBridge += 1;
-  } 
-  else if(type == "Tap")
-  {
-    equi = new Node(this->m_indiceNodeTap, type, nodeName, number);
-    this->m_indiceNodeTap += 1;
+    throw std::logic_error("Add Node failed! (" + type + ") unknow.");
   }
-  else if(type == "Emu")
+
+  this->ReserveNodes(nodeNames.size());
+  for(size_t i = 0; i < nodeNames.size(); i++)
   {
-    equi = new Node(this->m_indiceNodeEmu, type, nodeName, number);
-    this->m_indiceNodeEmu += 1;
+    this->InsertNode(*info, type, nodeNames[i], 1);
   }
+}
 
-  if(equi)
+void Generator::AddNodes(const std::string &type, const std::string &prefix, const size_t first, const size_t count)
+{
+  const TypeInfo *info = TypeRegistry::Find(NODE_KIND, type);
+  if(!info)
   {
-    this->m_listNode.push_back(equi);
+    throw std::logic_error("Add Node failed! (" + type + ") unknow.");
   }
-  else
+
+  this->ReserveNodes(count);
+  std::string nodeName = prefix + utils::integerToString(first);
+  for(size_t i = 0; i < count; i++)
   {
-    throw std::logic_error("Add Node failed! (" + type + ") unknow.");
+    if(i > 0)
+    {
+      /* increment the decimal number ending the name in place. */
+      size_t end = nodeName.size();
+      while(end > prefix.size() && nodeName[end - 1] == '9')
+      {
+        nodeName[--end] = '0';
+      }
+      if(end == prefix.size())
+      {
+        nodeName.insert(prefix.size(), 1, '1');
+      }
+      else
+      {
+        nodeName[end - 1]++;
+      }
+    }
+    this->InsertNode(*info, type, nodeName, 1);
   }
 }
 
+void Generator::ReserveNodes(const size_t nNodes)
+{
+  this->m_listNode.reserve(this->m_listNode.size() + nNodes);
+  this->m_nodeStore.Reserve(this->m_nodeStore.GetSize() + nNodes);
+  this->m_nodeIndex.Reserve(this->m_nodeIndex.GetSize() + nNodes);
+  /* a node interns its name and the name of its ip interface. */
+  this->m_symbols.Reserve(this->m_symbols.GetSize() + 2 * nNodes);
+}
 
-void Generator::RemoveNode(const std::string &name)
+void Generator::InsertNode(const TypeInfo &info, const std::string &type, const std::string &nodeName, const size_t number)
 {
-  size_t startNumber = this->m_listNode.size();
-  for(size_t i = 0; i < this->m_listNode.size(); i++)
+  if(!this->m_nodeIndex.Insert(nodeName, this->m_listNode.size()))
   {
-    if(this->m_listNode.at(i)->GetNodeName() == name)
-    {
-      delete this->m_listNode[i];
-      this->m_listNode.erase(this->m_listNode.begin() + i);
-      break;
-    }
+    throw std::logic_error("Add Node failed! (" + nodeName + ") already exists.");
   }
-  size_t endNumber = this->m_listNode.size();
-  if(startNumber == endNumber)
+
+  Node *equi = new (this->m_arena) Node(this->m_nodeStore, this->NextIndice(info), type, nodeName, number);
+  this->m_listNode.push_back(equi);
+}
+
+size_t Generator::NextIndice(const TypeInfo &type)
+{
+  return this->m_typeCounters[type.counter]++;
+}
+
+void Generator::RemoveNode(const std::string &name)
+{
+  size_t i = 0;
+  if(!this->m_nodeIndex.Find(name, i))
   {
     throw std::logic_error("Node remove failed! (" + name + ") not found.");
   }
+
+  /* the slot stays empty until the next Compact(). */
+  this->m_nodeIndex.Erase(name);
+  this->m_arena.Destroy(this->m_listNode[i]);
+  this->m_listNode[i] = 0;
+  this->m_nRemovedNodes += 1;
 }
 
 void Generator::RemoveNode(const size_t index)
 {
-  if(this->m_listNode.size() < index)
+  this->Compact();
+  if(index >= this->m_listNode.size())
   {
     throw std::out_of_range("Node remove failed ! (index not exists).");
     return;
   }
   
-  delete this->m_listNode[index];
-  this->m_listNode.erase(this->m_listNode.begin() + index);
+  this->RemoveNode(this->m_listNode[index]->GetNodeName());
+}
+
+Node* Generator::FindNode(const std::string &name)
+{
+  size_t i = 0;
+  if(!this->m_nodeIndex.Find(name, i))
+  {
+    return 0;
+  }
+
+  return this->m_listNode[i];
 }
 
 Node* Generator::GetNode(const size_t index)
 {
-  if(this->m_listNode.size() < index)
+  this->Compact();
+  if(index >= this->m_listNode.size())
   {
     throw std::out_of_range("Index does not exist.");
     return 0;
@@ -282,7 +243,7 @@ Node* Generator::GetNode(const size_t index)
 
 size_t Generator::GetNNodes() const
 {
-  return this->m_listNode.size();
+  return this->m_listNode.size() - this->m_nRemovedNodes;
 }
 
 
@@ -291,107 +252,129 @@ size_t Generator::GetNNodes() const
 //
 void Generator::AddApplication(const std::string &type, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) 
 {
-  if(type == "UdpEcho")
-  {
-    UdpEcho *app = new UdpEcho(type, this->m_indiceApplicationUdpEcho, senderNode, receiverNode, startTime, endTime, port);
-    this->m_indiceApplicationUdpEcho += 1;
-    this->m_listApplication.push_back(app);
-  }
+  ApplicationSpec spec;
+  spec.type = type;
+  spec.startTime = startTime;
+  spec.endTime = endTime;
+  spec.hasPort = true;
+  spec.port = port;
+  this->CreateApplication(spec, senderNode, receiverNode, PORT_PARAMETER);
+}
 
-  else if(type == "Udp")
-  {
-    Udp *app = new Udp(type, this->m_indiceApplicationUdp, senderNode, receiverNode, startTime, endTime, port);
-    this->m_indiceApplicationUdp += 1;
-    this->m_listApplication.push_back(app);
-  }
+void Generator::AddApplication(const std::string &type, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) 
+{
+  ApplicationSpec spec;
+  spec.type = type;
+  spec.startTime = startTime;
+  spec.endTime = endTime;
+  this->CreateApplication(spec, senderNode, receiverNode, 0);
+}
 
-  else if(type == "UdpCosem")
-  {
-    UdpCosem *app = new UdpCosem(type, this->m_indiceApplicationUdpCosem, senderNode, receiverNode, startTime, endTime, port);
-    this->m_indiceApplicationUdpCosem += 1;
-    this->m_listApplication.push_back(app);
-  }
+void Generator::AddApplication(const std::string &type, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime) 
+{
+  ApplicationSpec spec;
+  spec.type = type;
+  spec.startTime = startTime;
+  spec.endTime = endTime;
+  spec.hasInterval = true;
+  spec.interval = interval;
+  spec.hasReadingTime = true;
+  spec.readingTime = readingTime;
+  this->CreateApplication(spec, senderNode, receiverNode, INTERVAL_PARAMETER | READING_TIME_PARAMETER);
+}
 
-  else if(type == "TcpLargeTransfer")
+/**
+ * \brief Check an application description gives the parameters its type requires.
+ * \param info application type
+ * \param spec application description
+ */
+static void RequireParameters(const TypeInfo &info, const ApplicationSpec &spec)
+{
+  const bool given[] = { false, false, spec.hasPort, spec.hasInterval, spec.hasReadingTime, spec.hasPacketSize, spec.hasPacketIntervalTime, spec.hasMaxPacketCount };
+  for(size_t i = 0; i < sizeof(given) / sizeof(given[0]); i++)
   {
-    TcpLargeTransfer *app = new TcpLargeTransfer(type, this->m_indiceApplicationTcpLargeTransfer, senderNode, receiverNode, startTime, endTime, port);
-    this->m_indiceApplicationTcpLargeTransfer += 1;
-    this->m_listApplication.push_back(app);
+    if((info.required & (1 << i)) && !given[i])
+    {
+      throw std::logic_error("Application add failed! (" + spec.name + ") " + spec.type + " requires <" + TypeRegistry::GetParameterName(static_cast<TypeParameter>(1 << i)) + ">.");
+    }
   }
+}
 
-  else
+void Generator::AddApplication(const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode)
+{
+  const TypeInfo *info = TypeRegistry::Find(APPLICATION_KIND, spec.type);
+  if(!info)
   {
     throw std::logic_error("Application add failed.");
   }
 
+  RequireParameters(*info, spec);
+  this->InsertApplication(info->createApplication(this->m_arena, this->m_symbols, spec.type, this->NextIndice(*info), spec, senderNode, receiverNode));
 }
 
-void Generator::AddApplication(const std::string &type, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) 
+void Generator::AddApplications(const std::vector<ApplicationSpec> &specs)
 {
-  if(type == "Ping")
-  {
-    Ping *app = new Ping(type, this->m_indiceApplicationPing, senderNode, receiverNode, startTime, endTime);
-    this->m_indiceApplicationPing += 1;
-    this->m_listApplication.push_back(app);
-  }
+  this->m_listApplication.reserve(this->m_listApplication.size() + specs.size());
+  this->m_applicationIndex.Reserve(this->m_applicationIndex.GetSize() + specs.size());
 
-  else if(type == "DataConcentrator")
+  const TypeInfo *info = 0;
+  for(size_t i = 0; i < specs.size(); i++)
   {
-    DataConcentrator *app = new DataConcentrator(type, this->m_indiceApplicationDataConcentrator, senderNode, receiverNode, startTime, endTime);
-    this->m_indiceApplicationDataConcentrator += 1;
-    this->m_listApplication.push_back(app);
-  }
+    const ApplicationSpec &spec = specs[i];
+    if(!info || spec.type != info->name)
+    {
+      info = TypeRegistry::Find(APPLICATION_KIND, spec.type);
+      if(!info)
+      {
+        throw std::logic_error("Application add failed.");
+      }
+    }
 
-  else if(type == "DemandResponse")
-  {
-    DemandResponse *app = new DemandResponse(type, this->m_indiceApplicationDemandResponse, senderNode, receiverNode, startTime, endTime);
-    this->m_indiceApplicationDemandResponse += 1;
-    this->m_listApplication.push_back(app);
+    RequireParameters(*info, spec);
+    this->InsertApplication(info->createApplication(this->m_arena, this->m_symbols, spec.type, this->NextIndice(*info), spec, spec.sender, spec.receiver));
   }
+}
 
-  else
+void Generator::CreateApplication(const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode, const uint32_t parameters)
+{
+  const TypeInfo *info = TypeRegistry::Find(APPLICATION_KIND, spec.type);
+  if(!info || info->parameters != parameters)
   {
     throw std::logic_error("Application add failed.");
-  } 
+  }
+
+  this->InsertApplication(info->createApplication(this->m_arena, this->m_symbols, spec.type, this->NextIndice(*info), spec, senderNode, receiverNode));
 }
 
-void Generator::AddApplication(const std::string &type, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime) 
+void Generator::InsertApplication(Application *app)
 {
-  if(type == "MeterDataManagement")
+  if(!this->m_applicationIndex.Insert(app->GetAppName(), this->m_listApplication.size()))
   {
-    MeterDataManagement *app = new MeterDataManagement(type, this->m_indiceApplicationMeterDataManagement, senderNode, receiverNode, startTime, endTime, interval, readingTime);
-    this->m_indiceApplicationMeterDataManagement += 1;
-    this->m_listApplication.push_back(app);
+    std::string name = app->GetAppName();
+    this->m_arena.Destroy(app);
+    throw std::logic_error("Application add failed! (" + name + ") already exists.");
   }
-
-  else
-  {
-    throw std::logic_error("Application add failed.");
-  } 
+  this->m_listApplication.push_back(app);
 }
 
 void Generator::RemoveApplication(const std::string &name)
 {
-  size_t startNumber = this->m_listApplication.size();
-  for(size_t i = 0; i < this->m_listApplication.size(); i++)
-  {
-    if(this->m_listApplication.at(i)->GetAppName() == name)
-    {
-      delete this->m_listApplication[i];
-      this->m_listApplication.erase(this->m_listApplication.begin() + i);
-      break;
-    }
-  }
-  size_t endNumber = this->m_listApplication.size();
-  if(startNumber == endNumber)
+  size_t i = 0;
+  if(!this->m_applicationIndex.Find(name, i))
   {
     throw std::logic_error("Application remove failed! (" + name + ") not found.");
   }
+
+  this->m_applicationIndex.Erase(name);
+  this->m_arena.Destroy(this->m_listApplication[i]);
+  this->m_listApplication[i] = 0;
+  this->m_nRemovedApplications += 1;
 }
 
 Application* Generator::GetApplication(const size_t index)
 {
-  if(this->m_listApplication.size() < index)
+  this->Compact();
+  if(index >= this->m_listApplication.size())
   {
     throw std::out_of_range("Index does not exist");
     return 0;
@@ -402,7 +385,7 @@ Application* Generator::GetApplication(const size_t index)
 
 size_t Generator::GetNApplications() const
 {
-  return this->m_listApplication.size();
+  return this->m_listApplication.size() - this->m_nRemovedApplications;
 }
 
 //
@@ -410,99 +393,77 @@ size_t Generator::GetNApplications() const
 //
 void Generator::AddNetworkHardware(const std::string &type) 
 {
-  // call to the right type constructor. 
-  if(type == "Hub")
-  {
-    Hub *link = new Hub(type, this->m_indiceNetworkHardwareHub);
-    this->m_indiceNetworkHardwareHub += 1;
-    this->m_listNetworkHardware.push_back(link);
-  } 
-  else if(type == "PointToPoint")
-  {
-    PointToPoint *link = new PointToPoint(type, this->m_indiceNetworkHardwarePointToPoint);
-    this->m_indiceNetworkHardwarePointToPoint += 1;
-    this->m_listNetworkHardware.push_back(link);
-  } 
-  else
-  {
-    throw std::logic_error("Add Link failed. ( " + type + ") not found.");
-  }
+  NetworkHardwareParameters parameters;
+  this->CreateNetworkHardware(type, parameters, 0);
 }
 
 void Generator::AddNetworkHardware(const std::string &type, const std::string &linkNode) 
 {
-  if(type == "Bridge")
-  {
-    Bridge *link = new Bridge(type, this->m_indiceNetworkHardwareBridge, linkNode);
-    this->m_indiceNetworkHardwareBridge += 1;
-    this->m_listNetworkHardware.push_back(link);
-  } 
-  else if(type == "Ap")
-  {
-    Ap *link = new Ap(type, this->m_indiceNetworkHardwareAp, linkNode);
-    this->m_indiceNetworkHardwareAp += 1;
-    this->m_listNetworkHardware.push_back(link);
-  } 
-  else
-  {
-    throw std::logic_error("Add Link failed. (" + type + ") not found.");
-  }
+  NetworkHardwareParameters parameters;
+  parameters.linkNode = linkNode;
+  this->CreateNetworkHardware(type, parameters, LINK_NODE_PARAMETER);
 }
 
 void Generator::AddNetworkHardware(const std::string &type, const std::string &linkNode, const std::string &ifaceName)
 { 
-  if(type == "Emu")
-  {
-    Emu *link = new Emu(type, this->m_indiceNetworkHardwareEmu, linkNode, ifaceName);
-    this->m_indiceNetworkHardwareEmu += 1;
-    this->m_listNetworkHardware.push_back(link);
-  } 
-  else if(type == "Tap")
-  {
-    Tap *link = new Tap(type, this->m_indiceNetworkHardwareTap, linkNode, ifaceName);
-    this->m_indiceNetworkHardwareTap += 1;
-    this->m_listNetworkHardware.push_back(link);
-  } 
-  else
+  NetworkHardwareParameters parameters;
+  parameters.linkNode = linkNode;
+  parameters.ifaceName = ifaceName;
+  this->CreateNetworkHardware(type, parameters, LINK_NODE_PARAMETER | IFACE_NAME_PARAMETER);
+}
+
+void Generator::CreateNetworkHardware(const std::string &type, const NetworkHardwareParameters &parameters, const uint32_t given)
+{
+  const TypeInfo *info = TypeRegistry::Find(NETWORK_HARDWARE_KIND, type);
+  if(!info || info->parameters != given)
   {
     throw std::logic_error("Add Link failed. (" + type + ") not found.");
   }
+
+  this->InsertNetworkHardware(info->createNetworkHardware(this->m_arena, this->m_symbols, type, this->NextIndice(*info), parameters));
 }
 
-void Generator::RemoveNetworkHardware(const std::string &name)
+void Generator::InsertNetworkHardware(NetworkHardware *link)
 {
-  size_t startNumber = this->m_listNetworkHardware.size();
-  for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
+  if(!this->m_networkHardwareIndex.Insert(link->GetNetworkHardwareName(), this->m_listNetworkHardware.size()))
   {
-    if(this->m_listNetworkHardware.at(i)->GetNetworkHardwareName() == name)
-    {
-      delete this->m_listNetworkHardware[i];
-      this->m_listNetworkHardware.erase(this->m_listNetworkHardware.begin() + i);
-      break;
-    }
+    std::string name = link->GetNetworkHardwareName();
+    this->m_arena.Destroy(link);
+    throw std::logic_error("Add Link failed! (" + name + ") already exists.");
   }
-  size_t endNumber = this->m_listNetworkHardware.size();
-  if(startNumber == endNumber)
+  this->m_listNetworkHardware.push_back(link);
+}
+
+void Generator::RemoveNetworkHardware(const std::string &name)
+{
+  size_t i = 0;
+  if(!this->m_networkHardwareIndex.Find(name, i))
   {
     throw std::logic_error("Link remove failed! (" + name + ") not found.");
   }
+
+  this->m_networkHardwareIndex.Erase(name);
+  this->m_arena.Destroy(this->m_listNetworkHardware[i]);
+  this->m_listNetworkHardware[i] = 0;
+  this->m_nRemovedNetworkHardwares += 1;
 }
 
 void Generator::RemoveNetworkHardware(const size_t index)
 {
-  if(this->m_listNetworkHardware.size() < index)
+  this->Compact();
+  if(index >= this->m_listNetworkHardware.size())
   {
     throw std::out_of_range("Link remove failed! (index not exists).");
     return;
   }
 
-  delete this->m_listNetworkHardware[index];
-  this->m_listNetworkHardware.erase(this->m_listNetworkHardware.begin() + index);
+  this->RemoveNetworkHardware(this->m_listNetworkHardware[index]->GetNetworkHardwareName());
 }
 
 NetworkHardware* Generator::GetNetworkHardware(const size_t index)
 {
-  if(this->m_listNetworkHardware.size() < index)
+  this->Compact();
+  if(index >= this->m_listNetworkHardware.size())
   {
     throw std::out_of_range("Index does not exist.");
     return 0;
@@ -513,7 +474,7 @@ NetworkHardware* Generator::GetNetworkHardware(const size_t index)
 
 size_t Generator::GetNNetworkHardwares() const
 {
-  return this->m_listNetworkHardware.size();
+  return this->m_listNetworkHardware.size() - this->m_nRemovedNetworkHardwares;
 }
 
 //
@@ -521,53 +482,110 @@ size_t Generator::GetNNetworkHardwares() const
 //
 void Generator::AddFlow(const std::string &type, const std::string &flowName, const std::string &source, const std::string &destination, const std::string &expectedDelay, const std::string &expectedReliability) 
 {
-/// size_t number = 1;
-  Flow *equi = NULL;
-
-  // call to the right type constructor. 
-  if(type == "WifiFlow")
+  size_t i = 0;
+  if(this->m_flowIndex.Find(flowName, i))
   {
-    equi = new Flow(this->m_indiceFlowWired, type, flowName, source, destination, expectedDelay, expectedReliability);
-    this->m_indiceFlowWired += 1;
-  } 
-  else if(type == "MultiHopFlow")
+    throw std::logic_error("Add Flow failed! (" + flowName + ") already exists.");
+  }
+
+  const TypeInfo *info = TypeRegistry::Find(FLOW_KIND, type);
+  if(!info)
   {
-    equi = new Flow(this->m_indiceFlowMultiHop, type, flowName, source, destination, expectedDelay, expectedReliability);
-    this->m_indiceFlowMultiHop += 1;
-  } 
-  else if(type == "WiredFlow")
+    throw std::logic_error("Add Flow failed! (" + type + ") unknow.");
+  }
+
+  Flow *equi = new (this->m_arena) Flow(this->m_symbols, this->NextIndice(*info), type, flowName, source, destination, expectedDelay, expectedReliability);
+  this->m_listFlow.push_back(equi);
+  this->m_flowIndex.Insert(flowName, this->m_listFlow.size() - 1);
+}
+
+void Generator::RemoveFlow(const std::string &name)
+{
+  size_t i = 0;
+  if(!this->m_flowIndex.Find(name, i))
   {
-    equi = new Flow(this->m_indiceFlowWired, type, flowName, source, destination, expectedDelay, expectedReliability);
-    this->m_indiceFlowWired += 1;
-  } 
+    throw std::logic_error("Flow remove failed! (" + name + ") not found.");
+  }
+
+  this->m_flowIndex.Erase(name);
+  this->m_arena.Destroy(this->m_listFlow[i]);
+  this->m_listFlow[i] = 0;
+  this->m_nRemovedFlows += 1;
+}
 
-  if(equi)
+/**
+ * \brief Drop the empty slots of a list and update the positions of the names.
+ * \param list element list
+ * \param index position of the elements, by name
+ * \param nRemoved number of empty slots, reset
+ * \param getName element name accessor
+ */
+template <class T>
+static void CompactList(std::vector<T*> &list, NameIndex &index, size_t &nRemoved, const std::string &(T::*getName)() const)
+{
+  if(nRemoved == 0)
   {
-    this->m_listFlow.push_back(equi);
+    return;
   }
-  else
+
+  size_t n = 0;
+  for(size_t i = 0; i < list.size(); i++)
   {
-    throw std::logic_error("Add Flow failed! (" + type + ") unknow.");
+    if(list[i] == 0)
+    {
+      continue;
+    }
+    if(n != i)
+    {
+      list[n] = list[i];
+      index.Set((list[n]->*getName)(), n);
+    }
+    n++;
   }
+  list.resize(n);
+  nRemoved = 0;
 }
 
-void Generator::RemoveFlow(const std::string &name)
+const AdjacencyIndex &Generator::GetAdjacencyIndex()
 {
-  size_t startNumber = this->m_listFlow.size();
-  for(size_t i = 0; i < this->m_listFlow.size(); i++)
+  this->Compact();
+
+  this->m_adjacency.Clear();
+  for(size_t i = 0; i < this->m_listNetworkHardware.size(); i++)
   {
-    if(this->m_listFlow.at(i)->GetFlowName() == name)
+    this->m_adjacency.AddNetworkHardware();
+    const std::vector<Symbol> &nodes = this->m_listNetworkHardware.at(i)->GetInstalledNodes();
+    for(size_t j = 0; j < nodes.size(); j++)
     {
-      delete this->m_listFlow[i];
-      this->m_listFlow.erase(this->m_listFlow.begin() + i);
-      break;
+      const std::string &name = this->m_symbols.GetName(nodes.at(j));
+      this->m_adjacency.AddMember(name, this->GetInstalledMachinesNumber(name));
     }
   }
-  size_t endNumber = this->m_listFlow.size();
-  if(startNumber == endNumber)
+
+  return this->m_adjacency;
+}
+
+const Arena &Generator::GetArena() const
+{
+  return this->m_arena;
+}
+
+void Generator::Compact()
+{
+  if(this->m_nRemovedNodes != 0)
   {
-    throw std::logic_error("Flow remove failed! (" + name + ") not found.");
+    /* move the rows of the nodes left down, so that a row is the node position. */
+    CompactList<Node>(this->m_listNode, this->m_nodeIndex, this->m_nRemovedNodes, &Node::GetNodeName);
+    for(size_t i = 0; i < this->m_listNode.size(); i++)
+    {
+      this->m_nodeStore.Move(this->m_listNode[i]->GetRow(), i);
+      this->m_listNode[i]->SetRow(i);
+    }
+    this->m_nodeStore.Resize(this->m_listNode.size());
   }
+  CompactList<Application>(this->m_listApplication, this->m_applicationIndex, this->m_nRemovedApplications, &Application::GetAppName);
+  CompactList<NetworkHardware>(this->m_listNetworkHardware, this->m_networkHardwareIndex, this->m_nRemovedNetworkHardwares, &NetworkHardware::GetNetworkHardwareName);
+  CompactList<Flow>(this->m_listFlow, this->m_flowIndex, this->m_nRemovedFlows, &Flow::GetFlowName);
 }
 
 
@@ -576,283 +594,263 @@ void Generator::RemoveFlow(const std::string &name)
 // This part is looking about the code to write.
 //
 
+/**
+ * \brief Includes of every generated program.
+ */
+static const char CPP_INCLUDES[] =
+  "#include \"ns3/core-module.h\"\n"
+  "#include \"ns3/global-route-manager.h\"\n"
+  "#include \"ns3/internet-module.h\"\n"
+  "\n"
+  "#include \"ns3/flow-monitor-helper.h\"\n"
+  "#include \"ns3/ipv4-global-routing-helper.h\"\n"
+  "#include \"ns3/ipv4-flow-classifier.h\"\n"
+  "\n"
+  "#include <map>\n"
+  "\n";
+
+/**
+ * \brief Last include and namespaces of every generated program.
+ */
+static const char CPP_NAMESPACES[] =
+  "#include <sqlite3.h>\n"
+  "using namespace ns3;\n"
+  "using namespace std;\n"
+  "\n";
+
+/**
+ * \brief Helpers of the generated program and start of its main function.
+ */
+static const char CPP_HELPERS[] =
+  "\n"
+  "template <typename T>\n"
+  "string NumberToString ( T Number )\n"
+  "{\n"
+  "	stringstream ss;\n"
+  "	ss << Number;\n"
+  "	return ss.str();\n"
+  "}\n"
+  "\n"
+  "sqlite3 *database;\n"
+  "sqlite3_stmt *statement;\n"
+  "vector<vector<string> >  query(const char *query)\n"
+  "{\n"
+  "    vector<vector<string> > results;\n"
+  "\n"
+  "    if(sqlite3_prepare_v2(database, query, -1, &statement, 0) == SQLITE_OK)\n"
+  "    {\n"
+  "        int cols = sqlite3_column_count(statement);\n"
+  "        int result = 0;\n"
+  "        while(true)\n"
+  "        {\n"
+  "            result = sqlite3_step(statement);\n"
+  "\n"
+  "            if(result == SQLITE_ROW)\n"
+  "            {\n"
+  "                vector<string> values;\n"
+  "                for(int col = 0; col < cols; col++)\n"
+  "                {\n"
+  "                    values.push_back((char*)sqlite3_column_text(statement, col));\n"
+  "                }\n"
+  "                results.push_back(values);\n"
+  "            }\n"
+  "            else\n"
+  "            {\n"
+  "                break;  \n"
+  "            }\n"
+  "        }\n"
+  "\n"
+  "        sqlite3_finalize(statement);\n"
+  "    }\n"
+  "\n"
+  "    string error = sqlite3_errmsg(database);\n"
+  "    if(error != \"not an error\") std::cout << query << \" \" << error << std::endl;\n"
+  "\n"
+  "    return results; \n"
+  "}\n"
+  "int main(int argc, char *argv[])\n"
+  "{\n";
+
+/**
+ * \brief Setup of the simulation, from the command line parse to the configuration.
+ */
+static const char CPP_SETUP[] =
+  "  cmd.Parse (argc, argv);\n"
+  "\n"
+  "  std::string modelName = \"mymodelname\";\n"
+  //added logging statements
+  "\n"
+  /// Added for cosem simulation only
+  "/*\n"
+  "LogComponentEnable (\"CosemApplicationLayerClient\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"CosemApplicationLayerServer\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"CosemApplicationsProcessClient\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"CosemApplicationsProcessServer\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"UdpCosemWrapperLayerClient\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"UdpCosemWrapperLayerServer\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"DataConcentratorApplication\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"DemandResponseApplication\", LOG_LEVEL_INFO);\n"
+  "LogComponentEnable (\"MeterDataManagementApplication\", LOG_LEVEL_INFO);\n"
+  "*/\n"
+  "\n"
+  "  Time::SetResolution (Time::NS);\n"
+  /***
+  "  LogComponentEnable (\"UdpEchoClientApplication\", LOG_LEVEL_INFO);\n"
+  "  LogComponentEnable (\"UdpEchoServerApplication\", LOG_LEVEL_INFO);\n"
+  ***/
+  "  ///LogComponentEnableAll (LOG_LEVEL_INFO);\n"
+  "\n"
+  "\n"
+  "  /* Configuration. */\n";
+
+void Generator::SetEmitTables(const bool &tables)
+{
+  this->m_emitTables = tables;
+}
+
 void Generator::GenerateCodeCpp(std::string fileName) 
 {
   if(fileName != ""){
-    this->m_cppFile.open(fileName.c_str());
+    FileCodeSink sink(fileName);
+    this->GenerateCodeCpp(sink, fileName);
+    sink.Close();
+  }
+  else
+  {
+    CountingCodeSink sink;
+    this->GenerateCodeCpp(sink, fileName);
   }
+}
+
+void Generator::GenerateCodeCpp(CodeSink &sink, const std::string &fileName)
+{
+  this->GetAdjacencyIndex();
 
-  this->WriteCpp("//////////////////////////////////////////////////////////////////////////////////////");
-  this->WriteCpp("//");
-  this->WriteCpp("// This source file was automatically generated using <" + this->m_simulationName + "> XML file.");
-  this->WriteCpp("//");
-  this->WriteCpp("//////////////////////////////////////////////////////////////////////////////////////");
+  sink.WriteLine("//////////////////////////////////////////////////////////////////////////////////////");
+  sink.WriteLine("//");
+  sink.WriteLine(CodeLine(sink) << "// This source file was automatically generated using <" << this->m_simulationName << "> XML file.");
+  sink.WriteLine("//");
+  sink.WriteLine("//////////////////////////////////////////////////////////////////////////////////////");
 
-this->WriteCpp("");
+sink.WriteLine("");
 
   //
   // Generate headers 
   //
-  this->WriteCpp("#include \"ns3/core-module.h\"");
-  this->WriteCpp("#include \"ns3/global-route-manager.h\"");
-  this->WriteCpp("#include \"ns3/internet-module.h\"");
-  this->WriteCpp("");
-  this->WriteCpp("#include \"ns3/flow-monitor-helper.h\"");
-  this->WriteCpp("#include \"ns3/ipv4-global-routing-helper.h\"");
-  this->WriteCpp("#include \"ns3/ipv4-flow-classifier.h\"");
-  this->WriteCpp("");
-  this->WriteCpp("#include <map>");
-
-  this->WriteCpp("");
+  sink.Write(CPP_INCLUDES, sizeof(CPP_INCLUDES) - 1);
 
   std::vector<std::string> allHeaders = GenerateHeader();
   for(size_t i = 0; i <  allHeaders.size(); i++)
   {
-    this->WriteCpp("" + allHeaders.at(i));
+    sink.WriteLine(allHeaders.at(i));
   }
 
-  this->WriteCpp("#include <sqlite3.h>");
-
-  this->WriteCpp("using namespace ns3;");
-  this->WriteCpp("using namespace std;");
-  this->WriteCpp("");
+  sink.Write(CPP_NAMESPACES, sizeof(CPP_NAMESPACES) - 1);
 
 //added logging statements
   std::string prefixName(fileName, 0, fileName.find('.'));
-  this->WriteCpp("NS_LOG_COMPONENT_DEFINE (\"" + prefixName + "\");");
-
-  this->WriteCpp("");
-
-  this->WriteCpp("template <typename T>");
-  this->WriteCpp("string NumberToString ( T Number )");
-  this->WriteCpp("{");
-  this->WriteCpp("	stringstream ss;");
-  this->WriteCpp("	ss << Number;");
-  this->WriteCpp("	return ss.str();");
-  this->WriteCpp("}");
-  this->WriteCpp("");
-
-  this->WriteCpp("sqlite3 *database;");
-  this->WriteCpp("sqlite3_stmt *statement;");
-  this->WriteCpp("vector<vector<string> >  query(const char *query)");
-  this->WriteCpp("{");
-  this->WriteCpp("    vector<vector<string> > results;");
-  this->WriteCpp("");
-  this->WriteCpp("    if(sqlite3_prepare_v2(database, query, -1, &statement, 0) == SQLITE_OK)");
-  this->WriteCpp("    {");
-  this->WriteCpp("        int cols = sqlite3_column_count(statement);");
-  this->WriteCpp("        int result = 0;");
-  this->WriteCpp("        while(true)");
-  this->WriteCpp("        {");
-  this->WriteCpp("            result = sqlite3_step(statement);");
-  this->WriteCpp("");
-  this->WriteCpp("            if(result == SQLITE_ROW)");
-  this->WriteCpp("            {");
-  this->WriteCpp("                vector<string> values;");
-  this->WriteCpp("                for(int col = 0; col < cols; col++)");
-  this->WriteCpp("                {");
-  this->WriteCpp("                    values.push_back((char*)sqlite3_column_text(statement, col));");
-  this->WriteCpp("                }");
-  this->WriteCpp("                results.push_back(values);");
-  this->WriteCpp("            }");
-  this->WriteCpp("            else");
-  this->WriteCpp("            {");
-  this->WriteCpp("                break;  ");
-  this->WriteCpp("            }");
-  this->WriteCpp("        }");
-  this->WriteCpp("");
-  this->WriteCpp("        sqlite3_finalize(statement);");
-  this->WriteCpp("    }");
-  this->WriteCpp("");
-  this->WriteCpp("    string error = sqlite3_errmsg(database);");
-  this->WriteCpp("    if(error != \"not an error\") std::cout << query << \" \" << error << std::endl;");
-  this->WriteCpp("");
-  this->WriteCpp("    return results; ");
-  this->WriteCpp("}");
-
-  this->WriteCpp("int main(int argc, char *argv[])");
-  this->WriteCpp("{");
+  sink.WriteLine(CodeLine(sink) << "NS_LOG_COMPONENT_DEFINE (\"" << prefixName << "\");");
+
+  sink.Write(CPP_HELPERS, sizeof(CPP_HELPERS) - 1);
+
+  IndentedCodeSink code(sink, "  ");
 
   //
   // Tap/Emu variables
   //
-  std::vector<std::string> allVars = GenerateVarsCpp();
-  for(size_t i = 0; i <  allVars.size(); i++)
-  {
-    this->WriteCpp("  " + allVars.at(i));
-    this->WriteCpp("");
-  }
+  IndentedCodeSink vars(sink, "  ", "\n");
+  this->GenerateVarsCpp(vars);
 
   //
   // Generate Command Line 
   //
-  this->WriteCpp("  CommandLine cmd;");
-
-  std::vector<std::string> allCmdLine = GenerateCmdLineCpp();
-  for(size_t i = 0; i <  allCmdLine.size(); i++)
-  {
-    this->WriteCpp("  " + allCmdLine.at(i));
-  } 
+  sink.WriteLine("  CommandLine cmd;");
 
-  this->WriteCpp("  cmd.Parse (argc, argv);");
-  this->WriteCpp("");
+  this->GenerateCmdLineCpp(code);
 
-  this->WriteCpp("  std::string modelName = \"mymodelname\";");
-
-//added logging statements
-  this->WriteCpp("");
-/// Added for cosem simulation only
-  this->WriteCpp("/*");
-     this->WriteCpp("LogComponentEnable (\"CosemApplicationLayerClient\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"CosemApplicationLayerServer\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"CosemApplicationsProcessClient\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"CosemApplicationsProcessServer\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"UdpCosemWrapperLayerClient\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"UdpCosemWrapperLayerServer\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"DataConcentratorApplication\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"DemandResponseApplication\", LOG_LEVEL_INFO);");
-     this->WriteCpp("LogComponentEnable (\"MeterDataManagementApplication\", LOG_LEVEL_INFO);");
-  this->WriteCpp("*/");
-  this->WriteCpp("");
-
-  this->WriteCpp("  Time::SetResolution (Time::NS);");
-/***
-  this->WriteCpp("  LogComponentEnable (\"UdpEchoClientApplication\", LOG_LEVEL_INFO);");
-  this->WriteCpp("  LogComponentEnable (\"UdpEchoServerApplication\", LOG_LEVEL_INFO);");
-***/
-  this->WriteCpp("  ///LogComponentEnableAll (LOG_LEVEL_INFO);");
-  this->WriteCpp("");
+  sink.Write(CPP_SETUP, sizeof(CPP_SETUP) - 1);
 
   //
   // Generate Optional configuration
   // 
-  this->WriteCpp("");
-  this->WriteCpp("  /* Configuration. */");
-  std::vector<std::string> conf = GenerateConfigCpp();
-  for(size_t i = 0; i <  conf.size(); i++)
-  {
-    this->WriteCpp("  " + conf.at(i));
-  }
+  this->GenerateConfigCpp(code);
 
   //
   // Generate Nodes. 
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Build nodes. */");
-  std::vector<std::string> nodeBuild = GenerateNodeCpp();
-  for(size_t i = 0; i <  nodeBuild.size(); i++)
-  {
-    this->WriteCpp("  " + nodeBuild.at(i));
-  }
+  sink.WriteLine("");
+  sink.WriteLine("  /* Build nodes. */");
+  this->GenerateNodeCpp(code);
 
   //
   // Generate Link.
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Build link. */");
-  std::vector<std::string> linkBuild = GenerateNetworkHardwareCpp(); 
-  for(size_t i = 0; i <  linkBuild.size(); i++)
-  {
-    this->WriteCpp("  " + linkBuild.at(i));
-  }
+  sink.WriteLine("");
+  sink.WriteLine("  /* Build link. */");
+  this->GenerateNetworkHardwareCpp(code);
 
   //
   // Generate link net device container.
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Build link net device container. */");
+  sink.WriteLine("");
+  sink.WriteLine("  /* Build link net device container. */");
 
-  std::vector<std::string> linkNdcBuild = GenerateNetDeviceCpp(); 
-  for(size_t i = 0; i <  linkNdcBuild.size(); i++)
-  {
-    this->WriteCpp("  " + linkNdcBuild.at(i));
-  }
+  this->GenerateNetDeviceCpp(code);
 
   //
   // Generate Ip Stack. 
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Install the IP stack. */");
-  std::vector<std::string> allStacks = GenerateIpStackCpp();
-  for(size_t i = 0; i <  allStacks.size(); i++)
-  {
-    this->WriteCpp("  " + allStacks.at(i));
-  }
+  sink.WriteLine("");
+  sink.WriteLine("  /* Install the IP stack. */");
+  this->GenerateIpStackCpp(code);
 
   //
   // Generate IP assignation.
   // 
-  this->WriteCpp("");
-  this->WriteCpp("  /* IP assign. */");
-  this->WriteCpp("  map<string, string> ipMap;");
-  std::vector<std::string> allAssign = GenerateIpAssignCpp();
-  for(size_t i = 0; i <  allAssign.size(); i++)
-  {
-    this->WriteCpp("  " + allAssign.at(i));
-  } 
+  sink.WriteLine("");
+  sink.WriteLine("  /* IP assign. */");
+  sink.WriteLine("  map<string, string> ipMap;");
+  this->GenerateIpAssignCpp(code);
 
   //
   // Generate TapBridge if tap is used.
   //
-  std::vector<std::string> allTapBridge = GenerateTapBridgeCpp();
-  if(allTapBridge.size() > 0)
-  {
-    this->WriteCpp("");
-    this->WriteCpp("  /* Tap Bridge. */");
-  }
-  for(size_t i = 0; i <  allTapBridge.size(); i++)
-  {
-    this->WriteCpp("  " + allTapBridge.at(i));
-  } 
+  IndentedCodeSink tapBridge(sink, "  ");
+  tapBridge.SetPreamble("\n  /* Tap Bridge. */\n");
+  this->GenerateTapBridgeCpp(tapBridge);
 
   //
   // Generate Route.
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Generate Route. */");
-  std::vector<std::string> allRoutes = GenerateRouteCpp();
-  for(size_t i = 0; i <  allRoutes.size(); i++)
-  {
-    this->WriteCpp("  " + allRoutes.at(i));
-  } 
+  sink.WriteLine("");
+  sink.WriteLine("  /* Generate Route. */");
+  this->GenerateRouteCpp(code);
 
   //
   // Generate Application.
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Generate Application. */");
-  std::vector<std::string> allApps = GenerateApplicationCpp();
-  for(size_t i = 0; i <  allApps.size(); i++)
-  {
-    this->WriteCpp("  " + allApps.at(i));
-  } 
+  sink.WriteLine("");
+  sink.WriteLine("  /* Generate Application. */");
+  this->GenerateApplicationCpp(code);
 
   //
   // Others
   //
-  this->WriteCpp("");
-  this->WriteCpp("  /* Simulation. */");
-  this->WriteCpp("");
+  sink.WriteLine("");
+  sink.WriteLine("  /* Simulation. */");
+  sink.WriteLine("");
 
-  this->WriteCpp("  /* Pcap output. */");
-  std::vector<std::string> allTrace = GenerateTraceCpp();
-  for(size_t i = 0; i <  allTrace.size(); i++)
-  {
-    this->WriteCpp("  " + allTrace.at(i));
-  } 
+  sink.WriteLine("  /* Pcap output. */");
+  this->GenerateTraceCpp(code);
 
-  this->WriteCpp("");
-  this->WriteCpp("  /* Flow Monitor */");
+  sink.WriteLine("");
+  sink.WriteLine("  /* Flow Monitor */");
 
-  this->WriteCpp("  FlowMonitorHelper flowmonHelper;");
-///  this->WriteCpp("  Ptr<FlowMonitor> monitor = flowmonHelper.InstallAll();");
-  this->WriteCpp("  Ptr<FlowMonitor> monitor;");
+  sink.WriteLine("  FlowMonitorHelper flowmonHelper;");
+///  sink.WriteLine("  Ptr<FlowMonitor> monitor = flowmonHelper.InstallAll();");
+  sink.WriteLine("  Ptr<FlowMonitor> monitor;");
 
-  std::vector<std::string> allFlowmon = GenerateFlowmonitor();
-  for(size_t i = 0; i <  allFlowmon.size(); i++)
-  {
-    this->WriteCpp("  " + allFlowmon.at(i));
-  } 
+  this->GenerateFlowmonitor(code);
 
   /* Set stop time. */
   size_t stopTime = 0;/* default stop time. */
@@ -865,135 +863,126 @@ this->WriteCpp("");
   }
   stopTime += 50;
 
-  this->WriteCpp("");
+  sink.WriteLine("");
 
-  this->WriteCpp("  /* Stop the simulation after x seconds. */");
-  this->WriteCpp("  uint32_t stopTime = "+ utils::integerToString(stopTime) +";"); 
-  this->WriteCpp("  Simulator::Stop (Seconds (stopTime));");
+  sink.WriteLine("  /* Stop the simulation after x seconds. */");
+  sink.WriteLine(CodeLine(sink) << "  uint32_t stopTime = " << stopTime << ";"); 
+  sink.WriteLine("  Simulator::Stop (Seconds (stopTime));");
 
-  this->WriteCpp("");
-  this->WriteCpp("  /* Start and clean simulation. */");
-  this->WriteCpp("  Simulator::Run ();");
-  this->WriteCpp("  flowmonHelper.SerializeToXmlFile (\"" + prefixName + ".flowmonitor\", true, true);");
+  sink.WriteLine("");
+  sink.WriteLine("  /* Start and clean simulation. */");
+  sink.WriteLine("  Simulator::Run ();");
+  sink.WriteLine(CodeLine(sink) << "  flowmonHelper.SerializeToXmlFile (\"" << prefixName << ".flowmonitor\", true, true);");
 
 /// Flowmonitor and database
-  std::vector<std::string> allMetrics = GenerateMetrics();
-  for(size_t i = 0; i <  allMetrics.size(); i++)
-  {
-    this->WriteCpp("  " + allMetrics.at(i));
-  } 
+  this->GenerateMetrics(sink);
 
-  this->WriteCpp("");
-  this->WriteCpp("  Simulator::Destroy ();");
+  sink.WriteLine("");
+  sink.WriteLine("  Simulator::Destroy ();");
 
-  this->WriteCpp("}"); 
-  
-  if(fileName != ""){
-    this->m_cppFile.close();
+  sink.WriteLine("}"); 
+}
+
+/**
+ * \brief Append the headers not already in a list.
+ * \param headers headers without duplicate
+ * \param trans headers of an element
+ */
+static void AppendHeaders(std::vector<std::string> &headers, const std::vector<std::string> &trans)
+{
+  for(size_t i = 0; i <  trans.size(); i++)
+  {
+    /* add the header if no duplicate have been detected. */
+    if(std::find(headers.begin(), headers.end(), trans.at(i)) == headers.end())
+    {
+      headers.push_back(trans.at(i));
+    }
   }
 }
 
+/**
+ * \brief Check if an element type is met for the first time.
+ * \param types types already met
+ * \param type type of an element
+ * \return true if the type was not met, it is then added to the list
+ */
+static bool FirstOfType(std::vector<std::string> &types, const std::string &type)
+{
+  if(std::find(types.begin(), types.end(), type) != types.end())
+  {
+    return false;
+  }
+
+  types.push_back(type);
+  return true;
+}
+
 std::vector<std::string> Generator::GenerateHeader() 
 {
-  std::vector<std::string> allHeaders;
+  /* the duplicates are dropped as the headers are read, the list holds one entry per header. */
+  std::vector<std::string> headersWithoutDuplicateElem;
+  /* the headers only depend on the element type, they are read once per type. */
+  std::vector<std::string> types;
   // get all headers.
   /* from m_listNode. */
   for(size_t i = 0; i <  this->m_listNode.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNode.at(i))->GenerateHeader();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(FirstOfType(types, this->m_listNode.at(i)->GetNodeType()))
     {
-      allHeaders.push_back(trans.at(j));
+      AppendHeaders(headersWithoutDuplicateElem, this->m_listNode.at(i)->GenerateHeader());
     }
   }
   /* from m_listLink */
+  types.clear();
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateHeader();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(FirstOfType(types, this->m_listNetworkHardware.at(i)->GetLinkType()))
     {
-      allHeaders.push_back(trans.at(j));
+      AppendHeaders(headersWithoutDuplicateElem, this->m_listNetworkHardware.at(i)->GenerateHeader());
     }
   }
   /* from m_listApplication */
+  types.clear();
   for(size_t i = 0; i <  this->m_listApplication.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listApplication.at(i))->GenerateHeader();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(FirstOfType(types, this->m_listApplication.at(i)->GetApplicationType()))
     {
-      allHeaders.push_back(trans.at(j));
-    }
-  }
-
-  /* check for duplicate */
-  std::vector<std::string> headersWithoutDuplicateElem;
-  bool isDuplicate = false;
-  /* iterate all headers string */
-  for(size_t i = 0; i <  allHeaders.size(); i++)
-  {
-    isDuplicate = false;
-    /* iterate the vector whith no duplicate */
-    for(size_t j = 0; j <  headersWithoutDuplicateElem.size(); j++)
-    {
-      /* check if the string into the allHeaders vector is also in the vector without duplicate */
-      if( allHeaders.at(i) == headersWithoutDuplicateElem.at(j))
-      {
-        /* it's an duplicated elem. */
-        isDuplicate = true;
-        break;
-      }	
-    }
-    /* add the string from allHeaders if no duplicate have been detected. */
-    if(!isDuplicate)
-    {
-      headersWithoutDuplicateElem.push_back(allHeaders.at(i));
+      AppendHeaders(headersWithoutDuplicateElem, this->m_listApplication.at(i)->GenerateHeader());
     }
   }
   return headersWithoutDuplicateElem;
 }
 
-std::vector<std::string> Generator::GenerateVarsCpp()
+void Generator::GenerateVarsCpp(CodeSink &sink)
 {
-  std::vector<std::string> allVars;
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateVarsCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allVars.push_back(trans.at(j));
-    }
+    this->m_listNetworkHardware.at(i)->GenerateVarsCpp(sink);
   }
 
   /* add nsc var if used. */
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  for(size_t i = 0; i < this->m_nodeStore.GetSize(); i++)
   {
-    if( (this->m_listNode.at(i))->GetNsc() != "")
+    if(this->m_nodeStore.HasNsc(i))
     {
-      allVars.push_back("std::string nscStack = \"" + (this->m_listNode.at(i))->GetNsc() + "\";");
+      sink.WriteLine(CodeLine(sink) << "std::string nscStack = \"" << this->m_symbols.GetName(this->m_nodeStore.GetNsc(i)) << "\";");
     }
   }
-  return allVars;
 }
 
-std::vector<std::string> Generator::GenerateCmdLineCpp() 
+void Generator::GenerateCmdLineCpp(CodeSink &sink)
 {
-  std::vector<std::string> allCmdLine;
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateCmdLineCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allCmdLine.push_back(trans.at(j));
-    }
+    this->m_listNetworkHardware.at(i)->GenerateCmdLineCpp(sink);
   }
-  return allCmdLine;
 }
 
-std::vector<std::string> Generator::GenerateConfigCpp() 
+void Generator::GenerateConfigCpp(CodeSink &sink)
 {
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  for(size_t i = 0; i < this->m_nodeStore.GetSize(); i++)
   {
-    if( ((this->m_listNode.at(i))->GetNodeName()).find("tap_") == 0)
+    if(this->m_symbols.GetName(this->m_nodeStore.GetName(i)).compare(0, 4, "tap_") == 0)
     {
       this->AddConfig("GlobalValue::Bind (\"SimulatorImplementationType\", StringValue (\"ns3::RealtimeSimulatorImpl\"));");
       this->AddConfig("GlobalValue::Bind (\"ChecksumEnabled\", BooleanValue (true));");
@@ -1009,594 +998,848 @@ std::vector<std::string> Generator::GenerateConfigCpp()
     }
   } 
 
-  std::vector<std::string> allConf;
   for(size_t i = 0; i <  this->m_listConfiguration.size(); i++)
   {
-    allConf.push_back(this->m_listConfiguration.at(i));
+    sink.WriteLine(this->m_listConfiguration.at(i));
   }
-
-  return allConf;
 }
 
-std::vector<std::string> Generator::GenerateNodeCpp() 
+void Generator::GenerateNodeCpp(CodeSink &sink)
 {
-  std::vector<std::string> allNodes;
   /* get all the node code. */
   for(size_t i = 0; i <  this->m_listNode.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNode.at(i))->GenerateNodeCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allNodes.push_back(trans.at(j));
-    }
+    this->m_listNode.at(i)->GenerateNodeCpp(sink);
+  }
+}
+
+/**
+ * \brief Write the body of a link table loop, by helper type of the row.
+ * \param sink sink of the code
+ * \param csma number of csma links in the table
+ * \param p2p number of point-to-point links in the table
+ * \param csmaText lines for a csma link, ended by '\\n'
+ * \param p2pText lines for a point-to-point link, ended by '\\n'
+ */
+static void WriteLinkCases(CodeSink &sink, const size_t csma, const size_t p2p, const char *csmaText, const char *p2pText)
+{
+  /* a helper array is only declared if the table has links of its type. */
+  if(csma > 0 && p2p > 0)
+  {
+    IndentedCodeSink cases(sink, "  ");
+    sink.WriteLine("  if (row.csma)");
+    sink.WriteLine("    {");
+    CodeTable::WriteText(cases, csmaText);
+    sink.WriteLine("    }");
+    sink.WriteLine("  else");
+    sink.WriteLine("    {");
+    CodeTable::WriteText(cases, p2pText);
+    sink.WriteLine("    }");
+  }
+  else
+  {
+    CodeTable::WriteText(sink, csma > 0 ? csmaText : p2pText);
+  }
+}
+
+/**
+ * \brief Write the head of a loop over a run of consecutive rows of the link table.
+ * \param sink sink of the code
+ * \param begin first row of the run
+ * \param end row after the last row of the run
+ * \param links number of rows of the link table
+ */
+static void WriteLinkLoop(CodeSink &sink, const size_t begin, const size_t end, const size_t links)
+{
+  if(begin == 0 && end == links)
+  {
+    sink.WriteLine("for (uint32_t i = 0; i < linkCount; ++i)");
+  }
+  else
+  {
+    sink.WriteLine(CodeLine(sink) << "for (uint32_t i = " << begin << "; i < " << end << "; ++i)");
   }
-  return allNodes;
 }
 
-std::vector<std::string> Generator::GenerateNetworkHardwareCpp() 
+/**
+ * \brief Write the device install loop of a run of consecutive rows of the link table.
+ * \param sink sink of the code
+ * \param begin first row of the run
+ * \param end row after the last row of the run
+ * \param links number of rows of the link table
+ * \param csma number of csma links in the run
+ * \param p2p number of point-to-point links in the run
+ */
+static void WriteLinkInstall(CodeSink &sink, const size_t begin, const size_t end, const size_t links, const size_t csma, const size_t p2p)
+{
+  WriteLinkLoop(sink, begin, end, links);
+  sink.WriteLine("  {");
+  sink.WriteLine("  const LinkRow &row = links[i];");
+  WriteLinkCases(sink, csma, p2p, "  linkDevices[i] = linkCsma[row.helper].Install (linkNodes[i]);\n",
+                 "  linkDevices[i] = linkP2p[row.helper].Install (linkNodes[i]);\n");
+  sink.WriteLine("  }");
+}
+
+void Generator::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> allLink;
+  /* the helpers of the link table are set by its loop, they create no ns-3 object before the net devices. */
+  bool linkTable = this->m_emitTables && this->GenerateLinkTableCpp(sink) > 0;
+  std::string helperName;
+
   /* get all the link build code. */
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateNetworkHardwareCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(linkTable && this->m_listNetworkHardware.at(i)->GetTableHelper(helperName) != NetworkHardware::TABLE_HELPER_NONE)
     {
-      allLink.push_back(trans.at(j));
+      continue;
     }
+    this->m_listNetworkHardware.at(i)->GenerateNetworkHardwareCpp(sink);
   }
-  return allLink;
 }
-std::vector<std::string> Generator::GenerateNetDeviceCpp() 
+void Generator::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> allNdc;
-  /* get all the link build code. */
+  size_t links = 0;
+  std::string helperName;
+
+  /* the members of the links of the link table are rows of the member table. */
+  if(this->m_emitTables)
+  {
+    CodeTable table(sink);
+    for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+    {
+      NetworkHardware::TableHelper helper = this->m_listNetworkHardware.at(i)->GetTableHelper(helperName);
+      if(helper == NetworkHardware::TABLE_HELPER_NONE)
+      {
+        continue;
+      }
+      this->m_listNetworkHardware.at(i)->GenerateMemberRowsCpp(table, links);
+      links++;
+    }
+    table.End();
+  }
+
+  /* the devices are created in the order of the links, a run of links of the link table by one loop. */
+  size_t begin = 0;
+  size_t k = 0;
+  size_t csma = 0;
+  size_t p2p = 0;
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateNetDeviceCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    NetworkHardware::TableHelper helper = links > 0 ? this->m_listNetworkHardware.at(i)->GetTableHelper(helperName) : NetworkHardware::TABLE_HELPER_NONE;
+    if(helper != NetworkHardware::TABLE_HELPER_NONE)
     {
-      allNdc.push_back(trans.at(j));
+      k++;
+      if(helper == NetworkHardware::TABLE_HELPER_CSMA)
+      {
+        csma++;
+      }
+      else
+      {
+        p2p++;
+      }
+      continue;
     }
+
+    if(k > begin)
+    {
+      WriteLinkInstall(sink, begin, k, links, csma, p2p);
+      begin = k;
+      csma = 0;
+      p2p = 0;
+    }
+    this->m_listNetworkHardware.at(i)->GenerateNetDeviceCpp(sink);
+  }
+  if(k > begin)
+  {
+    WriteLinkInstall(sink, begin, k, links, csma, p2p);
   }
-  return allNdc;
 }
 
-std::vector<std::string> Generator::GenerateIpStackCpp() 
+void Generator::GenerateIpStackCpp(CodeSink &sink)
 {
-  std::vector<std::string> allStack;
-
   /* construct node without bridge Node. */
-  allStack.push_back("InternetStackHelper internetStackH;");
+  sink.WriteLine("InternetStackHelper internetStackH;");
 
-  std::string nodeName = "";
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  for(size_t i = 0; i < this->m_nodeStore.GetSize(); i++)
   {
-    nodeName = (this->m_listNode.at(i))->GetNodeName();
     // if it is not a bridge you can add it. /
-    if(nodeName.find("bridge_") != 0)
+    if(this->m_symbols.GetName(this->m_nodeStore.GetName(i)).compare(0, 7, "bridge_") != 0)
     {
-      std::vector<std::string> trans = (this->m_listNode.at(i)->GenerateIpStackCpp());
-      for(size_t j = 0; j <  trans.size(); j++)
-      {
-        allStack.push_back(trans.at(j));
-      }
+      this->m_listNode.at(i)->GenerateIpStackCpp(sink);
     }
   }
+}
 
-  return allStack;
+/**
+ * \brief Append an IPv4 address in dotted notation to a line.
+ * \param line line of code
+ * \param address address
+ * \return the line
+ */
+static CodeLine &AppendAddress(CodeLine &line, const uint32_t address)
+{
+  return line << (address >> 24) << '.' << ((address >> 16) & 0xff) << '.' << ((address >> 8) & 0xff) << '.' << (address & 0xff);
 }
 
-std::vector<std::string> Generator::GenerateIpAssignCpp() 
+void Generator::ComputeAddressBlocks(std::vector<uint32_t> &bases, std::vector<uint32_t> &masks)
 {
-  std::vector<std::string> ipAssign;
-  ipAssign.push_back("std::ostringstream addrOss;");
-  ipAssign.push_back("Ipv4AddressHelper ipv4;");
+  bases.resize(this->m_listNetworkHardware.size());
+  masks.resize(this->m_listNetworkHardware.size());
 
-  size_t ipRange = 0;
+  /* each link takes a /24 of 10.0.0.0/8, or a larger block if it has more devices. */
+  uint32_t address = 10U << 24;
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    ipAssign.push_back("ipv4.SetBase (\"10.0." + utils::integerToString(ipRange) + ".0\", \"255.255.255.0\");");
-    ipAssign.push_back("Ipv4InterfaceContainer iface_" + this->m_listNetworkHardware.at(i)->GetNdcName() + " = ipv4.Assign (" + this->m_listNetworkHardware.at(i)->GetNdcName() + ");");
+    uint32_t blockSize = 256;
+    while(blockSize < this->m_adjacency.GetMachinesNumber(i) + 2)
+    {
+      blockSize *= 2;
+    }
+    address = (address + blockSize - 1) & ~(blockSize - 1);
+    if(blockSize > (1U << 24) || address + blockSize > (11U << 24))
+    {
+      throw std::logic_error("IP assign failed! (" + this->m_listNetworkHardware.at(i)->GetNetworkHardwareName() + ") no room left in 10.0.0.0/8.");
+    }
 
-    if (this->m_listNetworkHardware.at(i)->GetNdcName().find("ndc_ap_") == 0)
+    bases[i] = address;
+    masks[i] = ~(blockSize - 1);
+    address += blockSize;
+  }
+}
+
+/**
+ * \brief Row structure of the link table.
+ */
+static const char LINK_ROW[] =
+  "struct LinkRow\n"
+  "{\n"
+  "  bool csma;\n"
+  "  uint32_t helper;\n"
+  "  uint64_t dataRate;\n"
+  "  uint64_t delay;\n"
+  "  const char *base;\n"
+  "  const char *mask;\n"
+  "};\n";
+
+/**
+ * \brief Append an unsigned 64 bits literal to a row.
+ * \param line line of code
+ * \param value value
+ * \return the line
+ */
+static CodeLine &AppendUint64(CodeLine &line, const uint64_t value)
+{
+  line << value;
+  if(value > 0xffffffffULL)
+  {
+    line << "ULL";
+  }
+  return line;
+}
+
+size_t Generator::GenerateLinkTableCpp(CodeSink &sink)
+{
+  std::vector<uint32_t> bases;
+  std::vector<uint32_t> masks;
+  std::string helperName;
+  size_t links = 0;
+  size_t csma = 0;
+  size_t p2p = 0;
+
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    NetworkHardware::TableHelper helper = link->GetTableHelper(helperName);
+    if(helper == NetworkHardware::TABLE_HELPER_NONE)
+    {
+      continue;
+    }
+
+    if(links == 0)
     {
-        ipAssign.push_back("iface_" + this->m_listNetworkHardware.at(i)->GetNdcName() + ".GetAddress(0).Print (addrOss);");
-        ipAssign.push_back("ipMap [addrOss.str()] = Names::FindName (ap_" + this->m_listNetworkHardware.at(i)->GetIndice() + ".Get (0));");
-        ipAssign.push_back("addrOss.str(\"\");");
-        ipAssign.push_back("addrOss.clear();");
-        ipAssign.push_back("///ipv4.Assign (ndc_sta_" + this->m_listNetworkHardware.at(i)->GetIndice() + ");");
-        ipAssign.push_back("Ipv4InterfaceContainer iface_ndc_sta_" + this->m_listNetworkHardware.at(i)->GetIndice() + ";");
-
-        ipAssign.push_back("for (uint32_t i = 0; i < " + this->m_listNetworkHardware.at(i)->GetAllNodeContainer() + ".GetN (); ++i)");
-        ipAssign.push_back("  {");
-        ipAssign.push_back("  iface_ndc_sta_" + this->m_listNetworkHardware.at(i)->GetIndice() + ".Add (ipv4.Assign (ndc_sta_" + this->m_listNetworkHardware.at(i)->GetIndice() + ".Get (i)));");
-        ipAssign.push_back("  iface_ndc_sta_" + this->m_listNetworkHardware.at(i)->GetIndice() + ".GetAddress(i).Print (addrOss);");
-        ipAssign.push_back("  ipMap [addrOss.str()] = Names::FindName (" + this->m_listNetworkHardware.at(i)->GetAllNodeContainer() + ".Get (i));");
-        ipAssign.push_back("  addrOss.str(\"\");");
-        ipAssign.push_back("  addrOss.clear();");
-        ipAssign.push_back("  }");
+      this->ComputeAddressBlocks(bases, masks);
+      sink.WriteLine("");
+      CodeTable::WriteText(sink, LINK_ROW);
+      sink.WriteLine("static const LinkRow links[] =");
+      sink.WriteLine("{");
+    }
+
+    CodeLine row(sink);
+    if(helper == NetworkHardware::TABLE_HELPER_CSMA)
+    {
+      row << "  { true, " << csma++ << ", ";
     }
     else
     {
-        ipAssign.push_back("for (uint32_t i = 0; i < " + this->m_listNetworkHardware.at(i)->GetAllNodeContainer() + ".GetN (); ++i)");
-        ipAssign.push_back("  {");
-        ipAssign.push_back("  iface_" + this->m_listNetworkHardware.at(i)->GetNdcName() + ".GetAddress(i).Print (addrOss);");
-        ipAssign.push_back("  ipMap [addrOss.str()] = Names::FindName (" + this->m_listNetworkHardware.at(i)->GetAllNodeContainer() + ".Get (i));");
-        ipAssign.push_back("  addrOss.str(\"\");");
-        ipAssign.push_back("  addrOss.clear();");
-        ipAssign.push_back("  }");
+      row << "  { false, " << p2p++ << ", ";
     }
+    AppendUint64(row, link->GetDataRate()) << ", ";
+    AppendUint64(row, link->GetNetworkHardwareDelay()) << ", \"";
+    AppendAddress(row, bases[i]) << "\", \"";
+    AppendAddress(row, masks[i]) << "\" },";
+    sink.WriteLine(row);
+    links++;
+  }
 
-std::cerr << "ndc name = " << this->m_listNetworkHardware.at(i)->GetNdcName() << std::endl;
-std::cerr << "Node container name = " << this->m_listNetworkHardware.at(i)->GetAllNodeContainer() << std::endl;
+  if(links == 0)
+  {
+    return 0;
+  }
 
-    ipRange += 1;
-  } 
+  sink.WriteLine("};");
+  sink.WriteLine("const uint32_t linkCount = sizeof (links) / sizeof (links[0]);");
+  if(csma > 0)
+  {
+    sink.WriteLine(CodeLine(sink) << "CsmaHelper linkCsma[" << csma << "];");
+  }
+  if(p2p > 0)
+  {
+    sink.WriteLine(CodeLine(sink) << "PointToPointHelper linkP2p[" << p2p << "];");
+  }
+  sink.WriteLine("NodeContainer linkNodes[linkCount];");
+  sink.WriteLine("NetDeviceContainer linkDevices[linkCount];");
+  sink.WriteLine("Ipv4InterfaceContainer linkIfaces[linkCount];");
 
+  /* the other phases, the applications and the traces use the names of the link objects. */
+  size_t k = 0;
+  csma = 0;
+  p2p = 0;
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    NetworkHardware *link = this->m_listNetworkHardware.at(i);
+    NetworkHardware::TableHelper helper = link->GetTableHelper(helperName);
+    if(helper == NetworkHardware::TABLE_HELPER_NONE)
+    {
+      continue;
+    }
 
-  return ipAssign;
+    if(helper == NetworkHardware::TABLE_HELPER_CSMA)
+    {
+      sink.WriteLine(CodeLine(sink) << "CsmaHelper &" << helperName << " = linkCsma[" << csma++ << "];");
+    }
+    else
+    {
+      sink.WriteLine(CodeLine(sink) << "PointToPointHelper &" << helperName << " = linkP2p[" << p2p++ << "];");
+    }
+    sink.WriteLine(CodeLine(sink) << "NodeContainer &" << link->GetAllNodeContainer() << " = linkNodes[" << k << "];");
+    sink.WriteLine(CodeLine(sink) << "NetDeviceContainer &" << link->GetNdcName() << " = linkDevices[" << k << "];");
+    sink.WriteLine(CodeLine(sink) << "Ipv4InterfaceContainer &iface_" << link->GetNdcName() << " = linkIfaces[" << k << "];");
+    k++;
+  }
+
+  sink.WriteLine("for (uint32_t i = 0; i < linkCount; ++i)");
+  sink.WriteLine("  {");
+  sink.WriteLine("  const LinkRow &row = links[i];");
+  WriteLinkCases(sink, csma, p2p,
+                 "  linkCsma[row.helper].SetChannelAttribute (\"DataRate\", DataRateValue (row.dataRate));\n"
+                 "  linkCsma[row.helper].SetChannelAttribute (\"Delay\", TimeValue (NanoSeconds (row.delay)));\n",
+                 "  linkP2p[row.helper].SetDeviceAttribute (\"DataRate\", DataRateValue (row.dataRate));\n"
+                 "  linkP2p[row.helper].SetChannelAttribute (\"Delay\", TimeValue (NanoSeconds (row.delay)));\n");
+  sink.WriteLine("  }");
+
+  return links;
 }
 
-std::vector<std::string> Generator::GenerateRouteCpp() 
+/**
+ * \brief Body of the IP assign loop of the link table.
+ */
+static const char LINK_IP_ASSIGN[] =
+  "  {\n"
+  "  ipv4.SetBase (links[i].base, links[i].mask);\n"
+  "  linkIfaces[i] = ipv4.Assign (linkDevices[i]);\n"
+  "  for (uint32_t j = 0; j < linkNodes[i].GetN (); ++j)\n"
+  "    {\n"
+  "    linkIfaces[i].GetAddress(j).Print (addrOss);\n"
+  "    ipMap [addrOss.str()] = Names::FindName (linkNodes[i].Get (j));\n"
+  "    addrOss.str(\"\");\n"
+  "    addrOss.clear();\n"
+  "    }\n"
+  "  }\n";
+
+void Generator::GenerateIpAssignCpp(CodeSink &sink)
 {
-  std::vector<std::string> allRoutes;
- 
-  allRoutes.push_back("Ipv4GlobalRoutingHelper::PopulateRoutingTables ();");
+  sink.WriteLine("std::ostringstream addrOss;");
+  sink.WriteLine("Ipv4AddressHelper ipv4;");
+
+  std::vector<uint32_t> bases;
+  std::vector<uint32_t> masks;
+  this->ComputeAddressBlocks(bases, masks);
+
+  /* the addresses are assigned in the order of the links, a run of links of the link table by one loop. */
+  std::string helperName;
+  size_t links = 0;
+  for(size_t i = 0; this->m_emitTables && i < this->m_listNetworkHardware.size(); i++)
+  {
+    if(this->m_listNetworkHardware.at(i)->GetTableHelper(helperName) != NetworkHardware::TABLE_HELPER_NONE)
+    {
+      links++;
+    }
+  }
 
-  return allRoutes;
+  size_t begin = 0;
+  size_t k = 0;
+  for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
+  {
+    if(links > 0 && this->m_listNetworkHardware.at(i)->GetTableHelper(helperName) != NetworkHardware::TABLE_HELPER_NONE)
+    {
+      k++;
+      continue;
+    }
+    if(k > begin)
+    {
+      WriteLinkLoop(sink, begin, k, links);
+      CodeTable::WriteText(sink, LINK_IP_ASSIGN);
+      begin = k;
+    }
+
+    CodeLine base(sink);
+    base << "ipv4.SetBase (\"";
+    AppendAddress(base, bases[i]) << "\", \"";
+    AppendAddress(base, masks[i]) << "\");";
+    sink.WriteLine(base);
+    sink.WriteLine(CodeLine(sink) << "Ipv4InterfaceContainer iface_" << this->m_listNetworkHardware.at(i)->GetNdcName() << " = ipv4.Assign (" << this->m_listNetworkHardware.at(i)->GetNdcName() << ");");
+
+    if (this->m_listNetworkHardware.at(i)->GetNdcName().find("ndc_ap_") == 0)
+    {
+        sink.WriteLine(CodeLine(sink) << "iface_" << this->m_listNetworkHardware.at(i)->GetNdcName() << ".GetAddress(0).Print (addrOss);");
+        sink.WriteLine(CodeLine(sink) << "ipMap [addrOss.str()] = Names::FindName (ap_" << this->m_listNetworkHardware.at(i)->GetIndice() << ".Get (0));");
+        sink.WriteLine("addrOss.str(\"\");");
+        sink.WriteLine("addrOss.clear();");
+        sink.WriteLine(CodeLine(sink) << "///ipv4.Assign (ndc_sta_" << this->m_listNetworkHardware.at(i)->GetIndice() << ");");
+        sink.WriteLine(CodeLine(sink) << "Ipv4InterfaceContainer iface_ndc_sta_" << this->m_listNetworkHardware.at(i)->GetIndice() << ";");
+
+        sink.WriteLine(CodeLine(sink) << "for (uint32_t i = 0; i < " << this->m_listNetworkHardware.at(i)->GetAllNodeContainer() << ".GetN (); ++i)");
+        sink.WriteLine("  {");
+        sink.WriteLine(CodeLine(sink) << "  iface_ndc_sta_" << this->m_listNetworkHardware.at(i)->GetIndice() << ".Add (ipv4.Assign (ndc_sta_" << this->m_listNetworkHardware.at(i)->GetIndice() << ".Get (i)));");
+        sink.WriteLine(CodeLine(sink) << "  iface_ndc_sta_" << this->m_listNetworkHardware.at(i)->GetIndice() << ".GetAddress(i).Print (addrOss);");
+        sink.WriteLine(CodeLine(sink) << "  ipMap [addrOss.str()] = Names::FindName (" << this->m_listNetworkHardware.at(i)->GetAllNodeContainer() << ".Get (i));");
+        sink.WriteLine("  addrOss.str(\"\");");
+        sink.WriteLine("  addrOss.clear();");
+        sink.WriteLine("  }");
+    }
+    else
+    {
+        sink.WriteLine(CodeLine(sink) << "for (uint32_t i = 0; i < " << this->m_listNetworkHardware.at(i)->GetAllNodeContainer() << ".GetN (); ++i)");
+        sink.WriteLine("  {");
+        sink.WriteLine(CodeLine(sink) << "  iface_" << this->m_listNetworkHardware.at(i)->GetNdcName() << ".GetAddress(i).Print (addrOss);");
+        sink.WriteLine(CodeLine(sink) << "  ipMap [addrOss.str()] = Names::FindName (" << this->m_listNetworkHardware.at(i)->GetAllNodeContainer() << ".Get (i));");
+        sink.WriteLine("  addrOss.str(\"\");");
+        sink.WriteLine("  addrOss.clear();");
+        sink.WriteLine("  }");
+    }
+  } 
+  if(k > begin)
+  {
+    WriteLinkLoop(sink, begin, k, links);
+    CodeTable::WriteText(sink, LINK_IP_ASSIGN);
+  }
+}
+
+void Generator::GenerateRouteCpp(CodeSink &sink)
+{
+  sink.WriteLine("Ipv4GlobalRoutingHelper::PopulateRoutingTables ();");
+}
+
+size_t Generator::GetInstalledMachinesNumber(const std::string &nodeName)
+{
+  /* a single member of a node container */
+  if(nodeName.find("NodeContainer(") == 0)
+  {
+    return 1;
+  }
+
+  Node *node = this->FindNode(nodeName);
+  if(node)
+  {
+    return node->GetMachinesNumber();
+  }
+
+  return 0;
 }
 
-std::vector<std::string> Generator::GenerateApplicationCpp() 
+void Generator::GenerateApplicationCpp(CodeSink &sink)
 {
+  CodeTable table(sink);
   size_t nodeNumber = 0;
   std::string ndcName = "";
-  size_t linkNumber = 0;
-  std::vector<std::string> allApps;
   /* get all the ip assign code. */
   for(size_t i = 0; i <  this->m_listApplication.size(); i++)
   {
     /* get NetDeviceContainer and number from the receiver. */
-    std::string receiverName = this->m_listApplication.at(i)->GetReceiverNode();
+    const std::string &receiverName = this->m_listApplication.at(i)->GetReceiverNode();
     nodeNumber = 0;
     ndcName = "";
-    linkNumber = 0;
 
-    /* if the receiver is in NodeContainer */
+    /* first link the receiver is installed on. */
+    size_t link = 0;
+    size_t member = 0;
+    bool found = this->m_adjacency.FindAttachment(receiverName, link, member);
+    if(found)
+    {
+      nodeNumber = this->m_adjacency.GetMemberOffset(link, member);
+    }
+
+    /* if the receiver is in NodeContainer, its whole container may be installed first. */
     if(receiverName.find("NodeContainer(") == 0)
     {
-      std::string oldReceiverName = receiverName;
-      
       std::vector<std::string> tab_name;
       split(tab_name, receiverName, '(');
       
-      std::string str_get = tab_name.at(1);
+      const std::string &str_get = tab_name.at(1);
       std::vector<std::string> tab_name2;
       split(tab_name2, str_get, '.');
       
-      receiverName = tab_name2.at(0);
-      for(size_t x = 0;  x < this->m_listNetworkHardware.size(); x++)
-      {
-        nodeNumber = 0;
-        for(size_t y = 0; y < this->m_listNetworkHardware.at(x)->GetInstalledNodes().size(); y++)
-        {
-          if(this->m_listNetworkHardware.at(x)->GetInstalledNodes().at(y) == receiverName || this->m_listNetworkHardware.at(x)->GetInstalledNodes().at(y) == oldReceiverName)
-          {
-            ndcName = (this->m_listNetworkHardware.at(x))->GetNdcName();
-            linkNumber = x;
-            break;
-          }
-          if(ndcName != "")
-          {
-            break;
-          }
-        }
-      }
-      std::vector<std::string> linksNode = this->m_listNetworkHardware.at(linkNumber)->GetInstalledNodes();
-      for(size_t j = 0; j < linksNode.size(); j++)
+      std::string containerName = tab_name2.at(0);
+
+      /* index of the machine in its container: NodeContainer(x.Get(i)) */
+      size_t memberNumber = tab_name.size() > 2 ? utils::stringToInteger(tab_name.at(2)) : 0;
+
+      size_t containerLink = 0;
+      size_t containerMember = 0;
+      if(this->m_adjacency.FindAttachment(containerName, containerLink, containerMember)
+         && (!found || containerLink < link || (containerLink == link && containerMember < member)))
       {
-        if(linksNode.at(j) == oldReceiverName)
-        {
-          nodeNumber = j;
-          break;
-        }
+        link = containerLink;
+        nodeNumber = this->m_adjacency.GetMemberOffset(containerLink, containerMember) + memberNumber;
+        found = true;
       }
     }
-    else
+
+    if(found)
     {
-      for(size_t j = 0; j <  this->m_listNetworkHardware.size(); j++)
-      {
-        nodeNumber = 0;
-        linkNumber = 0;
-        std::vector<std::string> nodes = (this->m_listNetworkHardware.at(j))->GetInstalledNodes();
-        for(size_t k = 0; k <  nodes.size(); k++)
-        {
-          if( nodes.at(k) == receiverName)
-          {
-            ndcName = (this->m_listNetworkHardware.at(j))->GetNdcName();
-            break;
-          }
-          else
-          {
-            for(size_t l = 0; l <  this->m_listNode.size(); l++)
-            {
-              if(this->m_listNode.at(l)->GetNodeName() == nodes.at(k))
-              {
-                nodeNumber += this->m_listNode.at(l)->GetMachinesNumber();
-                break;
-              }
-            }
-          }
-        }
-        if(ndcName != "")
-        {
-          break;
-        }
-      }
+      ndcName = this->m_listNetworkHardware.at(link)->GetNdcName();
     }
-    /* get the application code with param. */
-    std::vector<std::string> trans = (this->m_listApplication.at(i)->GenerateApplicationCpp(ndcName, nodeNumber));
-    for(size_t j = 0; j <  trans.size(); j++)
+
+    /* get the application code with param, the consecutive rows of a type make one table. */
+    if(this->m_emitTables && this->m_listApplication.at(i)->GenerateTableRowCpp(table, ndcName, nodeNumber))
     {
-      allApps.push_back(trans.at(j));
+      continue;
     }
+    table.End();
+    this->m_listApplication.at(i)->GenerateApplicationCpp(sink, ndcName, nodeNumber);
   }
-
-  return allApps;
+  table.End();
 }
 
-std::vector<std::string> Generator::GenerateTapBridgeCpp()
+void Generator::GenerateTapBridgeCpp(CodeSink &sink)
 {
-  std::vector<std::string> allTapBridge;
-
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateTapBridgeCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allTapBridge.push_back(trans.at(j));
-    }
+    this->m_listNetworkHardware.at(i)->GenerateTapBridgeCpp(sink);
   }
-
-  return allTapBridge;
 }
 
-std::vector<std::string> Generator::GenerateTraceCpp()
+void Generator::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> allTrace;
-
   for(size_t i = 0; i <  this->m_listNetworkHardware.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listNetworkHardware.at(i))->GenerateTraceCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
-    {
-      allTrace.push_back(trans.at(j));
-    }
+    this->m_listNetworkHardware.at(i)->GenerateTraceCpp(sink);
   }
-
-  return allTrace;
 }
 
-std::vector<std::string> Generator::GenerateFlowmonitor() 
+void Generator::GenerateFlowmonitor(CodeSink &sink)
 {
-  std::vector<std::string> allFlowmon;
-
-  std::string nodeName = "";
-  for(size_t i = 0; i <  this->m_listNode.size(); i++)
+  for(size_t i = 0; i < this->m_nodeStore.GetSize(); i++)
   {
-    nodeName = (this->m_listNode.at(i))->GetNodeName();
-      std::vector<std::string> trans = (this->m_listNode.at(i)->GenerateFlowmonitor());
-      for(size_t j = 0; j <  trans.size(); j++)
-      {
-        allFlowmon.push_back(trans.at(j));
-      }
+    if(this->m_nodeStore.GetFlowmonitor(i))
+    {
+      this->m_listNode.at(i)->GenerateFlowmonitor(sink);
+    }
   }
-
-  return allFlowmon;
 }
 
-std::vector<std::string> Generator::GenerateFlowCpp() 
+void Generator::GenerateFlowCpp(CodeSink &sink)
 {
-  std::vector<std::string> allFlows;
   /* get all the flow code. */
+  CodeTable table(sink);
   for(size_t i = 0; i <  this->m_listFlow.size(); i++)
   {
-    std::vector<std::string> trans = (this->m_listFlow.at(i))->GenerateFlowCpp();
-    for(size_t j = 0; j <  trans.size(); j++)
+    if(this->m_emitTables)
     {
-      allFlows.push_back(trans.at(j));
+      this->m_listFlow.at(i)->GenerateTableRowCpp(table);
+    }
+    else
+    {
+      this->m_listFlow.at(i)->GenerateFlowCpp(sink);
     }
   }
-  return allFlows;
+  table.End();
 }
 
-std::vector<std::string> Generator::GenerateMetrics() 
+/**
+ * \brief Metrics of the generated program, before the expected flow values.
+ */
+static const char CPP_METRICS[] =
+  "    monitor->CheckForLostPackets ();\n"
+  "  \n"
+  "  	// open the database file\n"
+  "  	if(sqlite3_open(\"pgcpmtDatabaseTest.sqlite\", &database) == SQLITE_OK)\n"
+  "          std::cout << \"database opened\" << std::endl;\n"
+  "      else\n"
+  "          std::cout << \"open database failed\" << std::endl;\n"
+  "      string mynone = NumberToString(0);\n"
+  "  	// create node name and ip address table with data\n"
+  "  	query(\"CREATE TABLE if not exists nodeNameIpAdrs (ModelName VARCHAR (20), NodeName VARCHAR (20), IpAdrs VARCHAR (20));\");\n"
+  "  	// create flow header table with data\n"
+  "  	query(\"CREATE TABLE if not exists flowHeader (ModelName VARCHAR (20), FlowId STRING, sourceNodeName VARCHAR (20), DestNodeName VARCHAR (20), Protocol VARCHAR (20), SourcePort STRING, DestPort STRING);\");\n"
+  "  	// create the flow data table\n"
+  "  	query(\"CREATE TABLE if not exists flowData (ModelName VARCHAR (20), FlowId STRING, TxBitrate STRING, RxBitrate STRING, MeanDelay STRING, PacketLossRatio STRING);\");\n"
+  "  	// create the packet data table\n"
+  "  	query(\"CREATE TABLE if not exists packetData (ModelName VARCHAR (20), FlowId STRING, FirstTxPacket STRING, FirstRxPacket STRING, LastTxPacket STRING, LastRxPacket STRING, DelaySum STRING, JitterSum STRING, LastDelay STRING, TxBytes STRING, RxBytes STRING, TxPackets STRING, RxPackets STRING, LostPackets STRING, TimesForwarded STRING, Throughput STRING);\");\n"
+  "  	query(\"CREATE TABLE if not exists performanceData (ModelName VARCHAR (20), FlowId STRING, Status VARCHAR (20), FromNode VARCHAR (20), ToNode VARCHAR (20), ExpectedReliability STRING, ExpectedDelay STRING, ActualReliability STRING, ActualDelay STRING, TxPackets STRING, RxPackets STRING, Throughput STRING, Cost STRING);\");\n"
+  "  \n"
+  "  	// database info\n"
+  "  	double txBitrate = 0;\n"
+  "  	double rxBitrate = 0;\n"
+  "  	double meanDelay = 0;\n"
+  "  	uint32_t packetLossRatio = 0;\n"
+  "  \n"
+  "  	double firstTxPacket = 0;\n"
+  "  	double firstRxPacket = 0;\n"
+  "  	double lastTxPacket = 0;\n"
+  "  	double lastRxPacket = 0;\n"
+  "  	double delaySum = 0;\n"
+  "  	double jitterSum = 0;\n"
+  "  	double lastDelay = 0;\n"
+  "  	uint32_t txBytes = 0;\n"
+  "  	uint32_t rxBytes = 0;\n"
+  "  	uint32_t txPackets = 0;\n"
+  "  	uint32_t rxPackets = 0;\n"
+  "  	uint32_t lostPackets = 0;\n"
+  "  	uint32_t timeForwarded = 0;\n"
+  "  	double throughput = 0;\n"
+  "  \n"
+  "    Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (flowmonHelper.GetClassifier ());\n"
+  "    std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats ();\n"
+  "    uint32_t txPacketsum = 0;\n"
+  "    uint32_t rxPacketsum = 0;\n"
+  "    uint32_t DropPacketsum = 0;\n"
+  "    uint32_t LostPacketsum = 0;\n"
+  "    double Delaysum = 0;\n"
+  "    std::string protocolName;\n"
+  "    const char *DroppedNames[] = { \"No Route\", \"TTL Expire\", \"Bad Checksum\", \"Queue\", \"Interface Down\", \"Route error\", \"Fragment timeout\", \"Unknown\" };\n"
+  "    cout << \" \" << endl;\n"
+  "    cout << \" \" << endl;\n"
+  "    cout << \"IP Address		Node Name\" << endl;\n"
+  "    cout << \"----------		---------\" << endl;\n"
+  "    for (map<string, string>::iterator it = ipMap.begin(); it!=ipMap.end(); ++it)\n"
+  "  {\n"
+  "      cout << it->first << \"		\" << it->second << endl;\n"
+  "  	string myNodeName = it->second;\n"
+  "  	string myIpAdrs = it->first;\n"
+  "  	string flowDataQuery (\"INSERT INTO nodeNameIpAdrs VALUES(\"\"'\" + modelName + \"'\" + \", \" + \"'\" + myNodeName + \"'\" + \",\" + \"'\" + myIpAdrs + \"'\" + \");\"  );\n"
+  "  	query( flowDataQuery.c_str() );\n"
+  "  }\n"
+  "  \n"
+  "    for (std::map<FlowId, FlowMonitor::FlowStats>::const_iterator i = stats.begin (); i != stats.end (); ++i)\n"
+  "    {\n"
+  "      Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow (i->first);\n"
+  "      txPacketsum += i->second.txPackets;\n"
+  "      rxPacketsum += i->second.rxPackets;\n"
+  "      LostPacketsum += i->second.lostPackets;\n"
+  "      DropPacketsum += i->second.packetsDropped.size();\n"
+  "      Delaysum += i->second.delaySum.GetSeconds();\n"
+  "  /*    cout << \">\" << endl;\n"
+  "      cout << \">\" << endl;\n"
+  "      cout << \">\" << endl;\n"
+  "  */\n"
+  "      if (t.protocol == 17)\n"
+  "              protocolName = \"UDP\";\n"
+  "      else if (t.protocol == 6)\n"
+  "                protocolName = \"TCP\";\n"
+  "              else protocolName = \"UNK\";\n"
+  "              \n"
+  "      cout << \"Flow ID: \" << i->first << endl;\n"
+  "      cout << \"======\" << endl;\n"
+  "  \n"
+  "      std::ostringstream srcAddrOss;\n"
+  "      std::ostringstream dstAddrOss;\n"
+  "      t.sourceAddress.Print (srcAddrOss);\n"
+  "      t.destinationAddress.Print (dstAddrOss);\n"
+  "  \n"
+  "      cout << protocolName << \" \" << ipMap[srcAddrOss.str()] << \"/\" << srcAddrOss.str() << \"/\" << t.sourcePort << \" ----> \" << ipMap[dstAddrOss.str()] << \"/\" << dstAddrOss.str() << \"/\" << t.destinationPort << endl;\n"
+  "      cout << \" \" << endl;\n"
+  "  \n"
+  "      if ((i->second.timeLastTxPacket - i->second.timeFirstTxPacket) == 0)\n"
+  "        cout << \"Tx bitrate: 0 kbps\" << endl;\n"
+  "      else\n"
+  "        cout << \"Tx bitrate:\" << (8.0 * i->second.txBytes * 1e-3 * 1e9) / (i->second.timeLastTxPacket - i->second.timeFirstTxPacket) << \" kbps\" << endl;\n"
+  "  \n"
+  "      if ((i->second.timeLastRxPacket - i->second.timeFirstRxPacket) == 0)\n"
+  "        cout << \"Rx bitrate: 0 kbps\" << endl;\n"
+  "      else\n"
+  "        cout << \"Rx bitrate:\" << (8.0 * i->second.rxBytes * 1e-3 * 1e9) / (i->second.timeLastRxPacket - i->second.timeFirstRxPacket) << \" kbps\" << endl;\n"
+  "  \n"
+  "      if (i->second.rxPackets == 0)\n"
+  "        cout << \"Mean delay: 0 ms\" << endl;\n"
+  "      else cout << \"Mean delay:\" << (1000 * i->second.delaySum.GetSeconds()) / (i->second.rxPackets) << \" ms\" << endl;\n"
+  "  \n"
+  "      if ((i->second.rxPackets + i->second.lostPackets) == 0)\n"
+  "        cout << \"Packet Loss ratio: 0%\" << endl;\n"
+  "      else cout << \"Packet Loss ratio: \" << ((i->second.lostPackets * 1.0) / (i->second.rxPackets + i->second.lostPackets) * 1.0) * 100 << \"%\" << endl;\n"
+  "  \n"
+  "      cout << \" \" << endl;\n"
+  "      cout << \"First Tx Packet: \" << i->second.timeFirstTxPacket.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"First Rx Packet: \" << i->second.timeFirstRxPacket.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"Last Tx Packet: \" << i->second.timeLastTxPacket.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"Last Rx Packet: \" << i->second.timeLastRxPacket.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"Delay Sum: \" << i->second.delaySum.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"Jitter Sum: \" << i->second.jitterSum.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"Last Delay: \" << i->second.lastDelay.GetSeconds() << \" secs.\" << endl;\n"
+  "      cout << \"Tx Bytes: \" << i->second.txBytes << endl;\n"
+  "      cout << \"Rx Bytes: \" << i->second.rxBytes << endl;\n"
+  "      cout << \"Tx Packets: \" << i->second.txPackets << endl;\n"
+  "      cout << \"Rx Packets: \" << i->second.rxPackets << endl;\n"
+  "      cout << \"Lost Packets: \" << i->second.lostPackets << endl;\n"
+  "      cout << \"Times Forwarded: \" << i->second.timesForwarded << endl;\n"
+  "  \n"
+  "      if ((i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) == 0)\n"
+  "        cout << \"Throughput: 0 Kbps\" << endl;\n"
+  "      else cout << \"Throughput: \" << i->second.rxBytes * 8.0 / (i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) / 1024  << \" Kbps\" << endl;\n"
+  "  \n"
+  "      cout << \" \" << endl;\n"
+  "  \n"
+  "      if (!i->second.packetsDropped.empty())\n"
+  "        {\n"
+  "        cout << \"Packets Dropped:\" << endl;\n"
+  "        cout << \" \" << endl;\n"
+  "        }\n"
+  "  \n"
+  "      for (uint32_t reasonCode = 0; reasonCode < i->second.packetsDropped.size (); reasonCode++)\n"
+  "      {\n"
+  "        cout << DroppedNames[reasonCode] << \":\" << i->second.packetsDropped[reasonCode] << endl;\n"
+  "      }\n"
+  "  \n"
+  "      // insert flow header data into database\n"
+  "  	string myFlowIdNumber = NumberToString(i->first);\n"
+  "  	string mySourceIp = srcAddrOss.str();\n"
+  "  	string mySourceName = ipMap[srcAddrOss.str()];\n"
+  "  	string myDestName = ipMap[dstAddrOss.str()];\n"
+  "  	string myDestIp = dstAddrOss.str();\n"
+  "  	string myProtocol = NumberToString(Delaysum / txPacketsum);\n"
+  "  	string mySourcePort = NumberToString(t.sourcePort);\n"
+  "  	string myDestPort = NumberToString(t.destinationPort);\n"
+  "  	string flowHeaderQuery (\"INSERT INTO flowHeader VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + \"'\" + mySourceName + \"'\" + \",\" + \"'\" + myDestName + \"'\" + \",\" + \"'\" + protocolName + \"'\"  + \",\" + mySourcePort + \",\" + myDestPort + \");\"  );\n"
+  "  	query( flowHeaderQuery.c_str() );\n"
+  "  \n"
+  "  	// insert flow data into database\n"
+  "  	string mytxBitrate = NumberToString(txBitrate);\n"
+  "  	string myrxBitrate = NumberToString(rxBitrate);\n"
+  "  	string mymeanDelay = NumberToString(meanDelay);\n"
+  "  	string mypacketLossRatio = NumberToString(packetLossRatio);\n"
+  "  	string flowDataQuery (\"INSERT INTO flowData VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + mytxBitrate + \",\" + myrxBitrate + \",\" + mymeanDelay + \",\" + mypacketLossRatio + \");\"  );\n"
+  "  	query( flowDataQuery.c_str() );\n"
+  "  \n"
+  "      // packet data into database\n"
+  "  	firstTxPacket = i->second.timeFirstTxPacket.GetSeconds();\n"
+  "  	firstRxPacket = i->second.timeFirstRxPacket.GetSeconds();	\n"
+  "  	lastTxPacket = i->second.timeLastTxPacket.GetSeconds();\n"
+  "  	lastRxPacket = i->second.timeLastRxPacket.GetSeconds();	\n"
+  "  	delaySum = i->second.delaySum.GetSeconds();\n"
+  "  	jitterSum = i->second.jitterSum.GetSeconds();	\n"
+  "  	lastDelay = i->second.lastDelay.GetSeconds();	\n"
+  "  	txBytes = i->second.txBytes;\n"
+  "  	rxBytes = i->second.rxBytes;\n"
+  "  	txPackets = i->second.txPackets;\n"
+  "  	rxPackets = i->second.rxPackets;\n"
+  "  	timeForwarded = i->second.timesForwarded;\n"
+  "  	throughput = i->second.rxBytes * 8.0 / (i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) / 1024;	\n"
+  "  \n"
+  "  	string myfirstTxPacket = NumberToString(firstTxPacket);\n"
+  "  	string myfirstRxPacket = NumberToString(firstRxPacket);\n"
+  "  	string mylastTxPacket = NumberToString(lastTxPacket);\n"
+  "  	string mylastRxPacket = NumberToString(lastRxPacket);\n"
+  "  	string mydelaySum = NumberToString(delaySum);\n"
+  "  	string myjitterSum = NumberToString(jitterSum);\n"
+  "  	string mylastDelay = NumberToString(lastDelay);\n"
+  "  	string mytxBytes = NumberToString(txBytes);\n"
+  "  	string myrxBytes = NumberToString(rxBytes);\n"
+  "  	string mytxPackets = NumberToString(txPackets);\n"
+  "  	string myrxPackets = NumberToString(rxPackets);\n"
+  "  	string mylostPackets = NumberToString(lostPackets);\n"
+  "  	string mytimeForwarded = NumberToString(timeForwarded);\n"
+  "  	string mythroughput = NumberToString(throughput);\n"
+  "  	string packetDataQuery (\"INSERT INTO packetData VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + myfirstTxPacket + \",\" + myfirstRxPacket + \",\" + mylastTxPacket + \",\" + mylastRxPacket + \",\" + mydelaySum + \",\" + myjitterSum + \",\" + mylastDelay + \",\" + mytxBytes + \",\" + myrxBytes + \",\" + mytxPackets + \",\" + myrxPackets + \",\" + mylostPackets + \",\" + mytimeForwarded + \",\" + mythroughput + \");\"  );\n"
+  "  	query( packetDataQuery.c_str() );\n"
+  "  \n"
+  "  	// calculate performance data and complete performance data table\n"
+  "  	// throughtput = mythroughput\n"
+  "  	// average flow delay = myDelaySum/myrxPackets\n"
+  "  	// reliability = mytxPackets/myrxPackets\n"
+  "    	std::string myStatus = \"Ok\";\n"
+  "  	double actualReliability;\n"
+  "  	double actualDelay;\n"
+  "          if (rxPackets == 0)\n"
+  "            {\n"
+  "            actualReliability = 0;\n"
+  "            actualDelay = 0;\n"
+  "            }\n"
+  "          else\n"
+  "            {\n"
+  "            actualReliability = txPackets/rxPackets;\n"
+  "            actualDelay = delaySum/rxPackets;\n"
+  "            }\n"
+  "  	string myactualReliability = NumberToString(actualReliability);\n"
+  "  	string myactualDelay = NumberToString(actualDelay);\n"
+  "  \n"
+  "  	string myExpectedReliability = NumberToString(0.98);\n"
+  "  	string myExpectedDelay = NumberToString(15);\n"
+  "  	string myCost = NumberToString(0);\n"
+  "  	string perfDataQuery (\"INSERT INTO performanceData VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + \"'\" + myStatus + \"'\" + \",\" + \"'\" + mySourceName + \"'\" + \",\" + \"'\" + myDestName + \"'\" + \",\" + \"'\" + myExpectedReliability + \"'\" + \",\" + \"'\" + myExpectedDelay + \"'\" + \",\" + myactualReliability + \",\" + myactualDelay + \",\" + mytxPackets + \",\" + myrxPackets + \",\" + mythroughput + \",\" + \"'\" + myCost + \"'\" + \");\"  );\n"
+  "  	query( perfDataQuery.c_str() );\n"
+  "  \n"
+  "  \n"
+  "    }\n"
+  "   \n";
+
+/**
+ * \brief Summary of the generated program, after the expected flow values.
+ */
+static const char CPP_SUMMARY[] =
+  "   \n"
+  "    cout << \" \" << endl;\n"
+  "    cout << \" \" << endl;\n"
+  "    cout << \"================================================\" << endl;\n"
+  "    cout << \"=================Summary========================\" << endl;\n"
+  "    cout << \"================================================\" << endl;\n"
+  "    cout << \"All Tx Packets: \" << txPacketsum << endl;\n"
+  "    cout << \"All Rx Packets: \" << rxPacketsum << endl;\n"
+  "    cout << \"All Delay: \" << Delaysum / txPacketsum << endl;\n"
+  "    cout << \"All Lost Packets: \" << LostPacketsum << endl;\n"
+  "    cout << \"All Drop Packets: \" << DropPacketsum << endl;\n"
+  "  \n"
+  "    if (txPacketsum != 0)\n"
+  "    {\n"
+  "      cout << \"Packets Delivery Ratio: \" << ((rxPacketsum * 100) / txPacketsum) << \"%\" << endl;\n"
+  "      cout << \"Packets Lost Ratio: \" << ((LostPacketsum * 100) / txPacketsum) << \"%\" << endl;\n"
+  "    }\n"
+  "  \n"
+  "    	double newLostPacketsum = LostPacketsum/txPacketsum;\n"
+  "      // Summary information for all packet flows\n"
+  "  	string mytx = NumberToString(txPacketsum);\n"
+  "  	string myrx = NumberToString(rxPacketsum);\n"
+  "  	string myDelay = NumberToString(Delaysum / txPacketsum);\n"
+  "  	string myLost = NumberToString(LostPacketsum);\n"
+  "  	string myDrop = NumberToString(DropPacketsum);\n"
+  "  	string myDelRatio = NumberToString((rxPacketsum) / txPacketsum);\n"
+  "   	string myLostRatio = NumberToString(newLostPacketsum);\n"
+  "  \n"
+  "  	query(\"CREATE TABLE if not exists summary (ModelName VARCHAR (20), TxPackets STRING, RxPackets STRING, Delay STRING, LostPackets STRING, DroppedPackets STRING, PacketDeliveryRatio STRING, PacketLostRatio STRING);\");\n"
+  "  	string mysqlquery (\"INSERT INTO summary VALUES(\"\"'\" + modelName + \"'\" + \", \" + mytx + \", \" + myrx + \", \" + myDelay + \", \" + myLost + \", \" + myDrop + \", \" + myDelRatio + \", \" + myLostRatio + \");\"  );\n"
+  "  	query( mysqlquery.c_str() );\n"
+  "  \n"
+  "  	// close the database\n"
+  "  	sqlite3_close(database);\n";
+
+void Generator::GenerateMetrics(CodeSink &sink)
 {
-  std::vector<std::string> allMetrics;
  
 ///  allRoutes.push_back("Ipv4GlobalRoutingHelper::PopulateRoutingTables ();");
 
-  allMetrics.push_back("  monitor->CheckForLostPackets ();");
-  allMetrics.push_back("");
-
-  allMetrics.push_back("	// open the database file");
-  allMetrics.push_back("	if(sqlite3_open(\"pgcpmtDatabaseTest.sqlite\", &database) == SQLITE_OK)");
-  allMetrics.push_back("        std::cout << \"database opened\" << std::endl;");
-  allMetrics.push_back("    else");
-  allMetrics.push_back("        std::cout << \"open database failed\" << std::endl;");
-  allMetrics.push_back("    string mynone = NumberToString(0);");
-  allMetrics.push_back("	// create node name and ip address table with data");
-  allMetrics.push_back("	query(\"CREATE TABLE if not exists nodeNameIpAdrs (ModelName VARCHAR (20), NodeName VARCHAR (20), IpAdrs VARCHAR (20));\");");
-  allMetrics.push_back("	// create flow header table with data");
-  allMetrics.push_back("	query(\"CREATE TABLE if not exists flowHeader (ModelName VARCHAR (20), FlowId STRING, sourceNodeName VARCHAR (20), DestNodeName VARCHAR (20), Protocol VARCHAR (20), SourcePort STRING, DestPort STRING);\");");
-  allMetrics.push_back("	// create the flow data table");
-  allMetrics.push_back("	query(\"CREATE TABLE if not exists flowData (ModelName VARCHAR (20), FlowId STRING, TxBitrate STRING, RxBitrate STRING, MeanDelay STRING, PacketLossRatio STRING);\");");
-  allMetrics.push_back("	// create the packet data table");
-  allMetrics.push_back("	query(\"CREATE TABLE if not exists packetData (ModelName VARCHAR (20), FlowId STRING, FirstTxPacket STRING, FirstRxPacket STRING, LastTxPacket STRING, LastRxPacket STRING, DelaySum STRING, JitterSum STRING, LastDelay STRING, TxBytes STRING, RxBytes STRING, TxPackets STRING, RxPackets STRING, LostPackets STRING, TimesForwarded STRING, Throughput STRING);\");");
-  allMetrics.push_back("	query(\"CREATE TABLE if not exists performanceData (ModelName VARCHAR (20), FlowId STRING, Status VARCHAR (20), FromNode VARCHAR (20), ToNode VARCHAR (20), ExpectedReliability STRING, ExpectedDelay STRING, ActualReliability STRING, ActualDelay STRING, TxPackets STRING, RxPackets STRING, Throughput STRING, Cost STRING);\");");
-  allMetrics.push_back("");
-  allMetrics.push_back("	// database info");
-  allMetrics.push_back("	double txBitrate = 0;");
-  allMetrics.push_back("	double rxBitrate = 0;");
-  allMetrics.push_back("	double meanDelay = 0;");
-  allMetrics.push_back("	uint32_t packetLossRatio = 0;");
-  allMetrics.push_back("");
-  allMetrics.push_back("	double firstTxPacket = 0;");
-  allMetrics.push_back("	double firstRxPacket = 0;");
-  allMetrics.push_back("	double lastTxPacket = 0;");
-  allMetrics.push_back("	double lastRxPacket = 0;");
-  allMetrics.push_back("	double delaySum = 0;");
-  allMetrics.push_back("	double jitterSum = 0;");
-  allMetrics.push_back("	double lastDelay = 0;");
-  allMetrics.push_back("	uint32_t txBytes = 0;");
-  allMetrics.push_back("	uint32_t rxBytes = 0;");
-  allMetrics.push_back("	uint32_t txPackets = 0;");
-  allMetrics.push_back("	uint32_t rxPackets = 0;");
-  allMetrics.push_back("	uint32_t lostPackets = 0;");
-  allMetrics.push_back("	uint32_t timeForwarded = 0;");
-  allMetrics.push_back("	double throughput = 0;");
-  allMetrics.push_back("");
-
-  allMetrics.push_back("  Ptr<Ipv4FlowClassifier> classifier = DynamicCast<Ipv4FlowClassifier> (flowmonHelper.GetClassifier ());");
-  allMetrics.push_back("  std::map<FlowId, FlowMonitor::FlowStats> stats = monitor->GetFlowStats ();");
-  allMetrics.push_back("  uint32_t txPacketsum = 0;");
-  allMetrics.push_back("  uint32_t rxPacketsum = 0;");
-  allMetrics.push_back("  uint32_t DropPacketsum = 0;");
-  allMetrics.push_back("  uint32_t LostPacketsum = 0;");
-  allMetrics.push_back("  double Delaysum = 0;");
-  allMetrics.push_back("  std::string protocolName;");
-  allMetrics.push_back("  const char *DroppedNames[] = { \"No Route\", \"TTL Expire\", \"Bad Checksum\", \"Queue\", \"Interface Down\", \"Route error\", \"Fragment timeout\", \"Unknown\" };");
-
-  allMetrics.push_back("  cout << \" \" << endl;");
-  allMetrics.push_back("  cout << \" \" << endl;");
-  allMetrics.push_back("  cout << \"IP Address		Node Name\" << endl;");
-  allMetrics.push_back("  cout << \"----------		---------\" << endl;");
-  allMetrics.push_back("  for (map<string, string>::iterator it = ipMap.begin(); it!=ipMap.end(); ++it)");
-  allMetrics.push_back("{");
-  allMetrics.push_back("    cout << it->first << \"		\" << it->second << endl;");
-  allMetrics.push_back("	string myNodeName = it->second;");
-  allMetrics.push_back("	string myIpAdrs = it->first;");
-  allMetrics.push_back("	string flowDataQuery (\"INSERT INTO nodeNameIpAdrs VALUES(\"\"'\" + modelName + \"'\" + \", \" + \"'\" + myNodeName + \"'\" + \",\" + \"'\" + myIpAdrs + \"'\" + \");\"  );");
-  allMetrics.push_back("	query( flowDataQuery.c_str() );");
-  allMetrics.push_back("}");
-
-  allMetrics.push_back("");
-  allMetrics.push_back("  for (std::map<FlowId, FlowMonitor::FlowStats>::const_iterator i = stats.begin (); i != stats.end (); ++i)");
-  allMetrics.push_back("  {");
-  allMetrics.push_back("    Ipv4FlowClassifier::FiveTuple t = classifier->FindFlow (i->first);");
-  allMetrics.push_back("    txPacketsum += i->second.txPackets;");
-  allMetrics.push_back("    rxPacketsum += i->second.rxPackets;");
-  allMetrics.push_back("    LostPacketsum += i->second.lostPackets;");
-  allMetrics.push_back("    DropPacketsum += i->second.packetsDropped.size();");
-  allMetrics.push_back("    Delaysum += i->second.delaySum.GetSeconds();");
-  allMetrics.push_back("/*    cout << \">\" << endl;");
-  allMetrics.push_back("    cout << \">\" << endl;");
-  allMetrics.push_back("    cout << \">\" << endl;");
-  allMetrics.push_back("*/");
-  allMetrics.push_back("    if (t.protocol == 17)");
-  allMetrics.push_back("            protocolName = \"UDP\";");
-  allMetrics.push_back("    else if (t.protocol == 6)");
-  allMetrics.push_back("              protocolName = \"TCP\";");
-  allMetrics.push_back("            else protocolName = \"UNK\";");
-  allMetrics.push_back("            ");
-  allMetrics.push_back("    cout << \"Flow ID: \" << i->first << endl;");
-  allMetrics.push_back("    cout << \"======\" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    std::ostringstream srcAddrOss;");
-  allMetrics.push_back("    std::ostringstream dstAddrOss;");
-  allMetrics.push_back("    t.sourceAddress.Print (srcAddrOss);");
-  allMetrics.push_back("    t.destinationAddress.Print (dstAddrOss);");
-  allMetrics.push_back("");
-  allMetrics.push_back("    cout << protocolName << \" \" << ipMap[srcAddrOss.str()] << \"/\" << srcAddrOss.str() << \"/\" << t.sourcePort << \" ----> \" << ipMap[dstAddrOss.str()] << \"/\" << dstAddrOss.str() << \"/\" << t.destinationPort << endl;");
-  allMetrics.push_back("    cout << \" \" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    if ((i->second.timeLastTxPacket - i->second.timeFirstTxPacket) == 0)");
-  allMetrics.push_back("      cout << \"Tx bitrate: 0 kbps\" << endl;");
-  allMetrics.push_back("    else");
-  allMetrics.push_back("      cout << \"Tx bitrate:\" << (8.0 * i->second.txBytes * 1e-3 * 1e9) / (i->second.timeLastTxPacket - i->second.timeFirstTxPacket) << \" kbps\" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    if ((i->second.timeLastRxPacket - i->second.timeFirstRxPacket) == 0)");
-  allMetrics.push_back("      cout << \"Rx bitrate: 0 kbps\" << endl;");
-  allMetrics.push_back("    else");
-  allMetrics.push_back("      cout << \"Rx bitrate:\" << (8.0 * i->second.rxBytes * 1e-3 * 1e9) / (i->second.timeLastRxPacket - i->second.timeFirstRxPacket) << \" kbps\" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    if (i->second.rxPackets == 0)");
-  allMetrics.push_back("      cout << \"Mean delay: 0 ms\" << endl;");
-  allMetrics.push_back("    else cout << \"Mean delay:\" << (1000 * i->second.delaySum.GetSeconds()) / (i->second.rxPackets) << \" ms\" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    if ((i->second.rxPackets + i->second.lostPackets) == 0)");
-  allMetrics.push_back("      cout << \"Packet Loss ratio: 0%\" << endl;");
-  allMetrics.push_back("    else cout << \"Packet Loss ratio: \" << ((i->second.lostPackets * 1.0) / (i->second.rxPackets + i->second.lostPackets) * 1.0) * 100 << \"%\" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    cout << \" \" << endl;");
-  allMetrics.push_back("    cout << \"First Tx Packet: \" << i->second.timeFirstTxPacket.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"First Rx Packet: \" << i->second.timeFirstRxPacket.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"Last Tx Packet: \" << i->second.timeLastTxPacket.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"Last Rx Packet: \" << i->second.timeLastRxPacket.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"Delay Sum: \" << i->second.delaySum.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"Jitter Sum: \" << i->second.jitterSum.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"Last Delay: \" << i->second.lastDelay.GetSeconds() << \" secs.\" << endl;");
-  allMetrics.push_back("    cout << \"Tx Bytes: \" << i->second.txBytes << endl;");
-  allMetrics.push_back("    cout << \"Rx Bytes: \" << i->second.rxBytes << endl;");
-  allMetrics.push_back("    cout << \"Tx Packets: \" << i->second.txPackets << endl;");
-  allMetrics.push_back("    cout << \"Rx Packets: \" << i->second.rxPackets << endl;");
-  allMetrics.push_back("    cout << \"Lost Packets: \" << i->second.lostPackets << endl;");
-  allMetrics.push_back("    cout << \"Times Forwarded: \" << i->second.timesForwarded << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    if ((i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) == 0)");
-  allMetrics.push_back("      cout << \"Throughput: 0 Kbps\" << endl;");
-  allMetrics.push_back("    else cout << \"Throughput: \" << i->second.rxBytes * 8.0 / (i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) / 1024  << \" Kbps\" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    cout << \" \" << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("    if (!i->second.packetsDropped.empty())");
-  allMetrics.push_back("      {");
-  allMetrics.push_back("      cout << \"Packets Dropped:\" << endl;");
-  allMetrics.push_back("      cout << \" \" << endl;");
-  allMetrics.push_back("      }");
-  allMetrics.push_back("");
-  allMetrics.push_back("    for (uint32_t reasonCode = 0; reasonCode < i->second.packetsDropped.size (); reasonCode++)");
-  allMetrics.push_back("    {");
-  allMetrics.push_back("      cout << DroppedNames[reasonCode] << \":\" << i->second.packetsDropped[reasonCode] << endl;");
-  allMetrics.push_back("    }");
-
-  allMetrics.push_back("");
-  allMetrics.push_back("    // insert flow header data into database");
-  allMetrics.push_back("	string myFlowIdNumber = NumberToString(i->first);");
-  allMetrics.push_back("	string mySourceIp = srcAddrOss.str();");
-  allMetrics.push_back("	string mySourceName = ipMap[srcAddrOss.str()];");
-  allMetrics.push_back("	string myDestName = ipMap[dstAddrOss.str()];");
-  allMetrics.push_back("	string myDestIp = dstAddrOss.str();");
-  allMetrics.push_back("	string myProtocol = NumberToString(Delaysum / txPacketsum);");
-  allMetrics.push_back("	string mySourcePort = NumberToString(t.sourcePort);");
-  allMetrics.push_back("	string myDestPort = NumberToString(t.destinationPort);");
-  allMetrics.push_back("	string flowHeaderQuery (\"INSERT INTO flowHeader VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + \"'\" + mySourceName + \"'\" + \",\" + \"'\" + myDestName + \"'\" + \",\" + \"'\" + protocolName + \"'\"  + \",\" + mySourcePort + \",\" + myDestPort + \");\"  );");
-  allMetrics.push_back("	query( flowHeaderQuery.c_str() );");
-  allMetrics.push_back("");
-  allMetrics.push_back("	// insert flow data into database");
-  allMetrics.push_back("	string mytxBitrate = NumberToString(txBitrate);");
-  allMetrics.push_back("	string myrxBitrate = NumberToString(rxBitrate);");
-  allMetrics.push_back("	string mymeanDelay = NumberToString(meanDelay);");
-  allMetrics.push_back("	string mypacketLossRatio = NumberToString(packetLossRatio);");
-  allMetrics.push_back("	string flowDataQuery (\"INSERT INTO flowData VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + mytxBitrate + \",\" + myrxBitrate + \",\" + mymeanDelay + \",\" + mypacketLossRatio + \");\"  );");
-  allMetrics.push_back("	query( flowDataQuery.c_str() );");
-  allMetrics.push_back("");
-  allMetrics.push_back("    // packet data into database");
-  allMetrics.push_back("	firstTxPacket = i->second.timeFirstTxPacket.GetSeconds();");
-  allMetrics.push_back("	firstRxPacket = i->second.timeFirstRxPacket.GetSeconds();	");
-  allMetrics.push_back("	lastTxPacket = i->second.timeLastTxPacket.GetSeconds();");
-  allMetrics.push_back("	lastRxPacket = i->second.timeLastRxPacket.GetSeconds();	");
-  allMetrics.push_back("	delaySum = i->second.delaySum.GetSeconds();");
-  allMetrics.push_back("	jitterSum = i->second.jitterSum.GetSeconds();	");
-  allMetrics.push_back("	lastDelay = i->second.lastDelay.GetSeconds();	");
-  allMetrics.push_back("	txBytes = i->second.txBytes;");
-  allMetrics.push_back("	rxBytes = i->second.rxBytes;");
-  allMetrics.push_back("	txPackets = i->second.txPackets;");
-  allMetrics.push_back("	rxPackets = i->second.rxPackets;");
-  allMetrics.push_back("	timeForwarded = i->second.timesForwarded;");
-  allMetrics.push_back("	throughput = i->second.rxBytes * 8.0 / (i->second.timeLastRxPacket.GetSeconds() - i->second.timeFirstTxPacket.GetSeconds()) / 1024;	");
-  allMetrics.push_back("");
-  allMetrics.push_back("	string myfirstTxPacket = NumberToString(firstTxPacket);");
-  allMetrics.push_back("	string myfirstRxPacket = NumberToString(firstRxPacket);");
-  allMetrics.push_back("	string mylastTxPacket = NumberToString(lastTxPacket);");
-  allMetrics.push_back("	string mylastRxPacket = NumberToString(lastRxPacket);");
-  allMetrics.push_back("	string mydelaySum = NumberToString(delaySum);");
-  allMetrics.push_back("	string myjitterSum = NumberToString(jitterSum);");
-  allMetrics.push_back("	string mylastDelay = NumberToString(lastDelay);");
-  allMetrics.push_back("	string mytxBytes = NumberToString(txBytes);");
-  allMetrics.push_back("	string myrxBytes = NumberToString(rxBytes);");
-  allMetrics.push_back("	string mytxPackets = NumberToString(txPackets);");
-  allMetrics.push_back("	string myrxPackets = NumberToString(rxPackets);");
-  allMetrics.push_back("	string mylostPackets = NumberToString(lostPackets);");
-  allMetrics.push_back("	string mytimeForwarded = NumberToString(timeForwarded);");
-  allMetrics.push_back("	string mythroughput = NumberToString(throughput);");
-  allMetrics.push_back("	string packetDataQuery (\"INSERT INTO packetData VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + myfirstTxPacket + \",\" + myfirstRxPacket + \",\" + mylastTxPacket + \",\" + mylastRxPacket + \",\" + mydelaySum + \",\" + myjitterSum + \",\" + mylastDelay + \",\" + mytxBytes + \",\" + myrxBytes + \",\" + mytxPackets + \",\" + myrxPackets + \",\" + mylostPackets + \",\" + mytimeForwarded + \",\" + mythroughput + \");\"  );");
-  allMetrics.push_back("	query( packetDataQuery.c_str() );");
-  allMetrics.push_back("");
-  allMetrics.push_back("	// calculate performance data and complete performance data table");
-  allMetrics.push_back("	// throughtput = mythroughput");
-  allMetrics.push_back("	// average flow delay = myDelaySum/myrxPackets");
-  allMetrics.push_back("	// reliability = mytxPackets/myrxPackets");
-  allMetrics.push_back("  	std::string myStatus = \"Ok\";");
-  allMetrics.push_back("	double actualReliability;");
-  allMetrics.push_back("	double actualDelay;");
-  allMetrics.push_back("        if (rxPackets == 0)");
-  allMetrics.push_back("          {");
-  allMetrics.push_back("          actualReliability = 0;");
-  allMetrics.push_back("          actualDelay = 0;");
-  allMetrics.push_back("          }");
-  allMetrics.push_back("        else");
-  allMetrics.push_back("          {");
-  allMetrics.push_back("          actualReliability = txPackets/rxPackets;");
-  allMetrics.push_back("          actualDelay = delaySum/rxPackets;");
-  allMetrics.push_back("          }");
-  allMetrics.push_back("	string myactualReliability = NumberToString(actualReliability);");
-  allMetrics.push_back("	string myactualDelay = NumberToString(actualDelay);");
-  allMetrics.push_back("");
-  allMetrics.push_back("	string myExpectedReliability = NumberToString(0.98);");
-  allMetrics.push_back("	string myExpectedDelay = NumberToString(15);");
-  allMetrics.push_back("	string myCost = NumberToString(0);");
-  allMetrics.push_back("	string perfDataQuery (\"INSERT INTO performanceData VALUES(\"\"'\" + modelName + \"'\" + \", \" + myFlowIdNumber + \",\" + \"'\" + myStatus + \"'\" + \",\" + \"'\" + mySourceName + \"'\" + \",\" + \"'\" + myDestName + \"'\" + \",\" + \"'\" + myExpectedReliability + \"'\" + \",\" + \"'\" + myExpectedDelay + \"'\" + \",\" + myactualReliability + \",\" + myactualDelay + \",\" + mytxPackets + \",\" + myrxPackets + \",\" + mythroughput + \",\" + \"'\" + myCost + \"'\" + \");\"  );");
-  allMetrics.push_back("	query( perfDataQuery.c_str() );");
-  allMetrics.push_back("");
-  allMetrics.push_back("");
-
-  allMetrics.push_back("  }");
-  allMetrics.push_back(" ");
-
-  std::vector<std::string> flowBuild = GenerateFlowCpp();
-  for(size_t i = 0; i <  flowBuild.size(); i++)
-  {
-    allMetrics.push_back("  " + flowBuild.at(i));
-  }
-
-  allMetrics.push_back(" ");
-  allMetrics.push_back("  cout << \" \" << endl;");
-  allMetrics.push_back("  cout << \" \" << endl;");
-  allMetrics.push_back("  cout << \"================================================\" << endl;");
-  allMetrics.push_back("  cout << \"=================Summary========================\" << endl;");
-  allMetrics.push_back("  cout << \"================================================\" << endl;");
-  allMetrics.push_back("  cout << \"All Tx Packets: \" << txPacketsum << endl;");
-  allMetrics.push_back("  cout << \"All Rx Packets: \" << rxPacketsum << endl;");
-  allMetrics.push_back("  cout << \"All Delay: \" << Delaysum / txPacketsum << endl;");
-  allMetrics.push_back("  cout << \"All Lost Packets: \" << LostPacketsum << endl;");
-  allMetrics.push_back("  cout << \"All Drop Packets: \" << DropPacketsum << endl;");
-  allMetrics.push_back("");
-  allMetrics.push_back("  if (txPacketsum != 0)");
-  allMetrics.push_back("  {");
-  allMetrics.push_back("    cout << \"Packets Delivery Ratio: \" << ((rxPacketsum * 100) / txPacketsum) << \"%\" << endl;");
-  allMetrics.push_back("    cout << \"Packets Lost Ratio: \" << ((LostPacketsum * 100) / txPacketsum) << \"%\" << endl;");
-  allMetrics.push_back("  }");
-  allMetrics.push_back("");
-  allMetrics.push_back("  	double newLostPacketsum = LostPacketsum/txPacketsum;");
-  allMetrics.push_back("    // Summary information for all packet flows");
-  allMetrics.push_back("	string mytx = NumberToString(txPacketsum);");
-  allMetrics.push_back("	string myrx = NumberToString(rxPacketsum);");
-  allMetrics.push_back("	string myDelay = NumberToString(Delaysum / txPacketsum);");
-  allMetrics.push_back("	string myLost = NumberToString(LostPacketsum);");
-  allMetrics.push_back("	string myDrop = NumberToString(DropPacketsum);");
-  allMetrics.push_back("	string myDelRatio = NumberToString((rxPacketsum) / txPacketsum);");
-  allMetrics.push_back(" 	string myLostRatio = NumberToString(newLostPacketsum);");
-  allMetrics.push_back("");
-  allMetrics.push_back("	query(\"CREATE TABLE if not exists summary (ModelName VARCHAR (20), TxPackets STRING, RxPackets STRING, Delay STRING, LostPackets STRING, DroppedPackets STRING, PacketDeliveryRatio STRING, PacketLostRatio STRING);\");");
-  allMetrics.push_back("	string mysqlquery (\"INSERT INTO summary VALUES(\"\"'\" + modelName + \"'\" + \", \" + mytx + \", \" + myrx + \", \" + myDelay + \", \" + myLost + \", \" + myDrop + \", \" + myDelRatio + \", \" + myLostRatio + \");\"  );");
-  allMetrics.push_back("	query( mysqlquery.c_str() );");
-  allMetrics.push_back("");
-  allMetrics.push_back("	// close the database");
-  allMetrics.push_back("	sqlite3_close(database);");
-
-  return allMetrics;
-}
+  sink.Write(CPP_METRICS, sizeof(CPP_METRICS) - 1);
 
-//
-// Cpp generation operation part.
-//
+  IndentedCodeSink flows(sink, "    ");
+  this->GenerateFlowCpp(flows);
 
-void Generator::WriteCpp(const std::string &line) 
-{
-//std::cout << line << std::endl;
-  if(this->m_cppFile.is_open())
-  {
-    this->m_cppFile << line + '\n';
-  }
+  sink.Write(CPP_SUMMARY, sizeof(CPP_SUMMARY) - 1);
 }
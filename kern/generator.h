@@ -32,9 +32,15 @@
 #include "network-hardware.h"
 #include "application.h"
 #include "flow.h"
+#include "name-index.h"
+#include "adjacency-index.h"
+#include "symbol-table.h"
+#include "node-store.h"
+#include "arena.h"
+#include "code-sink.h"
+#include "type-registry.h"
 
 #include <iostream>
-#include <fstream>
 #include <string>
 #include <vector>
 
@@ -98,8 +104,33 @@ class Generator
      */
     void AddNode(const std::string &type, const std::string &nodeName, const size_t number);
 
+    /**
+     * \brief Add many nodes of a type.
+     *
+     * The type is looked up once and the node list, the node index and the
+     * symbol table are sized for the whole batch. A name already used stops
+     * the batch: the nodes before it are added, as with one AddNode call per name.
+     *
+     * \param type node type
+     * \param nodeNames node names
+     */
+    void AddNodes(const std::string &type, const std::vector<std::string> &nodeNames);
+
+    /**
+     * \brief Add nodes named prefix + number, for count numbers from first.
+     * \param type node type
+     * \param prefix node name prefix
+     * \param first number of the first node
+     * \param count number of nodes
+     */
+    void AddNodes(const std::string &type, const std::string &prefix, const size_t first, const size_t count);
+
     /**
      * \brief Remove an node element.
+     *
+     * The node is found by its name in the node index and its slot of the node
+     * list is left empty, the list is compacted on the next access by index.
+     *
      * \param name node name to remove
      */
     void RemoveNode(const std::string &name);
@@ -110,6 +141,13 @@ class Generator
      */
     void RemoveNode(const size_t index);
 
+    /**
+     * \brief Get a node by name.
+     * \param name node name
+     * \return node pointer, 0 if there is no node of that name
+     */
+    Node* FindNode(const std::string &name);
+
     /**
      * \brief Get node at specified index.
      * \param index index
@@ -166,6 +204,30 @@ class Generator
      */
     void AddApplication(const std::string &type, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime);
 
+    /**
+     * \brief Add an application from its description.
+     *
+     * The type and its parameters are checked against the type registry:
+     * a parameter required by the type and missing from the description is
+     * an error, naming the missing element.
+     *
+     * \param spec application description
+     * \param senderNode sender node
+     * \param receiverNode receiver node
+     */
+    void AddApplication(const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode);
+
+    /**
+     * \brief Add many applications from their descriptions.
+     *
+     * The sender and receiver are the ones of the descriptions. The list and
+     * the index are sized for the whole batch and the type is only looked up
+     * again when it changes from one description to the next.
+     *
+     * \param specs application descriptions
+     */
+    void AddApplications(const std::vector<ApplicationSpec> &specs);
+
     /**
      * \brief Remove an application element.
      * \param name application name to remove
@@ -255,14 +317,63 @@ class Generator
      */
     void RemoveFlow(const std::string &name);
 
+    /**
+     * \brief Index the nodes installed on the links.
+     *
+     * The index is rebuilt from the current model at each call, link
+     * indexes are the ones of GetNetworkHardware().
+     *
+     * \return node to link and link to node index
+     */
+    const AdjacencyIndex &GetAdjacencyIndex();
+
+    /**
+     * \brief Get the memory of the model objects.
+     * \return arena holding the nodes, links, applications and flows
+     */
+    const Arena &GetArena() const;
+
+    /**
+     * \brief Enable/disable the generation of the links, the applications and the flows as tables.
+     *
+     * The applications of the types with a table (UdpEcho, Udp) and the
+     * flows are then generated as rows of constant tables walked by a
+     * builder loop (see CodeTable), the others as code.
+     *
+     * The links of the types with a table (Hub, PointToPoint) are rows of
+     * one link table, with their helper, data rate, delay and address
+     * block, and their members are rows of a member table. The net device
+     * and IP assign phases walk the link table in the order of the links,
+     * one loop per run of consecutive table links, so the devices are
+     * created in the same order as without tables.
+     *
+     * The nodes outside of populations, the other links and the other
+     * applications stay one block of code each.
+     *
+     * \param tables tables state
+     */
+    void SetEmitTables(const bool &tables);
+
     /**
      * \brief Generate ns-3 C++ code.
      * 
      * This procedure is the main procedure to generate the code from the simulation.
      * It also go to use all the procedure on the bottom like generate all headers, ...
+     * Nothing is written if the file name is empty.
+     * \param fileName C++ output file name
      */
     void GenerateCodeCpp(std::string fileName = "");
 
+    /**
+     * \brief Generate ns-3 C++ code into a sink.
+     *
+     * Each line is written into the sink as soon as it is built, the code is
+     * never held in memory.
+     * \param sink sink of the code
+     * \param fileName C++ output file name, it names the log component and the flowmonitor output
+     */
+    void GenerateCodeCpp(CodeSink &sink, const std::string &fileName);
+
     /**
      * \brief Generate ns-3 python code.
      * 
@@ -278,44 +389,34 @@ class Generator
     std::string m_simulationName;
 
     /**
-     * \brief Configuration list.
-     */
-    std::vector<std::string> m_listConfiguration;
-
-    /**
-     * \brief Number attribute of term node created.
+     * \brief Generate the links, the applications and the flows as tables.
      */
-    size_t m_indiceNodePc;
+    bool m_emitTables;
 
     /**
-     * \brief Number attribute of router node created.
-     */
-    size_t m_indiceNodeRouter;
-
-    /**
-     * \brief Number attribute of ap node created.
+     * \brief Configuration list.
      */
-    size_t m_indiceNodeAp;
+    std::vector<std::string> m_listConfiguration;
 
     /**
-     * \brief Number attribute of station node created.
+     * \brief Memory of the nodes, links, applications and flows.
      */
-    size_t m_indiceNodeStation;
+    Arena m_arena;
 
     /**
-     * \brief Number attribute of bridge node created.
+     * \brief Names of the nodes, links, applications and flows, and the identifiers derived from them.
      */
-    size_t m_indiceNodeBridge;
+    SymbolTable m_symbols;
 
     /**
-     * \brief Number attribute of tap node created.
+     * \brief Columns of the node fields, the nodes of m_listNode are views over its rows.
      */
-    size_t m_indiceNodeTap;
+    NodeStore m_nodeStore;
 
     /**
-     * \brief Number attribute of emu node created.
+     * \brief Number of elements created, by TypeInfo::counter.
      */
-    size_t m_indiceNodeEmu;
+    std::vector<size_t> m_typeCounters;
 
     /**
      * \brief List of node created instance.
@@ -325,110 +426,109 @@ class Generator
     std::vector<Node*> m_listNode;
 
     /**
-     * \brief List of application created instance.
-     * 
-     * This attribute is the list of the created instance of application.
+     * \brief Position of the nodes in m_listNode, by name.
      */
-    std::vector<Application*> m_listApplication;
+    NameIndex m_nodeIndex;
 
     /**
-     * \brief List of link created instace.
-     * 
-     * This attribute is the list of the created instance of link.
+     * \brief Number of removed nodes still holding an empty slot of m_listNode.
      */
-    std::vector<NetworkHardware*> m_listNetworkHardware;
+    size_t m_nRemovedNodes;
 
     /**
-     * \brief List of flow created instance.
+     * \brief List of application created instance.
      * 
-     * This attribute is the list of the created instance of flow.
-     */
-    std::vector<Flow*> m_listFlow;
-
-    /**
-     * \brief Number attribute of ping application created.
-     */
-    size_t m_indiceApplicationPing; 
-
-    /**
-     * \brief Number attribute of tcp large transfert application created.
-     */
-    size_t m_indiceApplicationTcpLargeTransfer;
-
-    /**
-     * \brief Number attribute of udp echo application created.
+     * This attribute is the list of the created instance of application.
      */
-    size_t m_indiceApplicationUdpEcho;
+    std::vector<Application*> m_listApplication;
 
     /**
-     * \brief Number attribute of udp application created.
+     * \brief Position of the applications in m_listApplication, by name.
      */
-    size_t m_indiceApplicationUdp;
+    NameIndex m_applicationIndex;
 
     /**
-     * \brief Number attribute of udp cosem application created.
+     * \brief Number of removed applications still holding an empty slot of m_listApplication.
      */
-    size_t m_indiceApplicationUdpCosem;
+    size_t m_nRemovedApplications;
 
     /**
-     * \brief Number attribute of data concentrator application created.
+     * \brief List of link created instace.
+     * 
+     * This attribute is the list of the created instance of link.
      */
-    size_t m_indiceApplicationDataConcentrator;
+    std::vector<NetworkHardware*> m_listNetworkHardware;
 
     /**
-     * \brief Number attribute of meter data management application created.
+     * \brief Position of the links in m_listNetworkHardware, by name.
      */
-    size_t m_indiceApplicationMeterDataManagement;
+    NameIndex m_networkHardwareIndex;
 
     /**
-     * \brief Number attribute of demand response application created.
+     * \brief Number of removed links still holding an empty slot of m_listNetworkHardware.
      */
-    size_t m_indiceApplicationDemandResponse;
+    size_t m_nRemovedNetworkHardwares;
 
     /**
-     * \brief Number attribute of ap link created.
+     * \brief List of flow created instance.
+     * 
+     * This attribute is the list of the created instance of flow.
      */
-    size_t m_indiceNetworkHardwareAp;
+    std::vector<Flow*> m_listFlow;
 
     /**
-     * \brief Number attribute of emu link created.
+     * \brief Position of the flows in m_listFlow, by name.
      */
-    size_t m_indiceNetworkHardwareEmu;
+    NameIndex m_flowIndex;
 
     /**
-     * \brief Number attribute of point-to-point link created.
+     * \brief Number of removed flows still holding an empty slot of m_listFlow.
      */
-    size_t m_indiceNetworkHardwarePointToPoint;
+    size_t m_nRemovedFlows;
 
     /**
-     * \brief Number attribute of tap link created.
+     * \brief Nodes installed on the links, built before generating the code.
      */
-    size_t m_indiceNetworkHardwareTap;
+    AdjacencyIndex m_adjacency;
 
     /**
-     * \brief Number attribute of hub link created.
+     * \brief Get the indice of a new element and count it.
+     * \param type type of the element
+     * \return indice
      */
-    size_t m_indiceNetworkHardwareHub;
+    size_t NextIndice(const TypeInfo &type);
 
     /**
-     * \brief Number attribute of bridge link created.
+     * \brief Size the node list, the node index and the symbol table for more nodes.
+     * \param nNodes number of nodes to be added
      */
-    size_t m_indiceNetworkHardwareBridge; 
+    void ReserveNodes(const size_t nNodes);
 
     /**
-     * \brief Number attribute of Wireless flow created.
+     * \brief Index and create a node of a known type.
+     * \param info node type
+     * \param type node type name
+     * \param nodeName node name
+     * \param number number of machines
      */
-    size_t m_indiceFlowWireless; 
+    void InsertNode(const TypeInfo &info, const std::string &type, const std::string &nodeName, const size_t number);
 
     /**
-     * \brief Number attribute of MultiHop flow created.
+     * \brief Create an application given by one of the positional AddApplication.
+     * \param spec application description
+     * \param senderNode sender node
+     * \param receiverNode receiver node
+     * \param parameters parameters given, they must be the ones of the type
      */
-    size_t m_indiceFlowMultiHop; 
+    void CreateApplication(const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode, const uint32_t parameters);
 
     /**
-     * \brief Number attribute of Wired flow created.
+     * \brief Create a link given by one of the AddNetworkHardware.
+     * \param type link type
+     * \param parameters link parameters
+     * \param given parameters given, they must be the ones of the type
      */
-    size_t m_indiceFlowWired; 
+    void CreateNetworkHardware(const std::string &type, const NetworkHardwareParameters &parameters, const uint32_t given);
 
     //
     // C++ code generation operation part
@@ -446,109 +546,142 @@ class Generator
     /**
      * \brief Generate vars C++ code.
      * 
-     * This function return a string wich contain all C++ vars.
-     * \return vars code
+     * This function writes all C++ vars.
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateVarsCpp();
+    void GenerateVarsCpp(CodeSink &sink);
 
     /**
      * \brief Generate command line C++ code.
-     * \return commend line code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateCmdLineCpp();
+    void GenerateCmdLineCpp(CodeSink &sink);
 
     /**
      * \brief Generate config C++ code.
-     * \return config code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateConfigCpp();
+    void GenerateConfigCpp(CodeSink &sink);
 
     /**
      * \brief Generate node declaration C++ code.
-     * \return declaration code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateNodeCpp();
+    void GenerateNodeCpp(CodeSink &sink);
 
     /**
      * \brief Generate link C++ code.
-     * \return link code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateNetworkHardwareCpp();
+    void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate net device C++ code.
-     * \return net device code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateNetDeviceCpp();
+    void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Generate ip stack declaration.
-     * \return IP stack code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateIpStackCpp();
+    void GenerateIpStackCpp(CodeSink &sink);
 
     /**
      * \brief Generate ip assign C++ code.
-     * \return IP assign code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateIpAssignCpp();
+    void GenerateIpAssignCpp(CodeSink &sink);
+
+    /**
+     * \brief Compute the address block of each link in 10.0.0.0/8.
+     * \param bases set to the first address of the block of each link
+     * \param masks set to the network mask of each link
+     * \throw std::logic_error if the blocks do not fit in 10.0.0.0/8
+     */
+    void ComputeAddressBlocks(std::vector<uint32_t> &bases, std::vector<uint32_t> &masks);
+
+    /**
+     * \brief Generate the link table, its containers and the loop configuring its helpers.
+     * \param sink sink of the code
+     * \return number of links in the table
+     */
+    size_t GenerateLinkTableCpp(CodeSink &sink);
 
     /**
      * \brief Generate tap bridge C++ code.
-     * \return tab bridge code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateTapBridgeCpp();
+    void GenerateTapBridgeCpp(CodeSink &sink);
 
     /**
      * \brief Generate route C++ code.
-     * \return route code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateRouteCpp();
+    void GenerateRouteCpp(CodeSink &sink);
 
     /**
-     * \brief Generate application C++ code.
-     * \return application code
+     * \brief Get the number of machines a name installed on a network hardware stands for.
+     * \param nodeName installed node name
+     * \return number of machines
      */
-    std::vector<std::string> GenerateApplicationCpp();
+    size_t GetInstalledMachinesNumber(const std::string &nodeName);
+
+    //
+    // Element lists operation part.
+    //
 
     /**
-     * \brief Generate trace C++ code.
-     * \return trace code
+     * \brief Append an application to the list and index its name.
+     * \param app application, deleted if its name is already used
      */
-    std::vector<std::string> GenerateTraceCpp();
+    void InsertApplication(Application *app);
 
     /**
-     * \brief Generate Flowmonitor declaration.
-     * \return Flowmonitor declaration code
+     * \brief Append a link to the list and index its name.
+     * \param link link, deleted if its name is already used
      */
-    std::vector<std::string> GenerateFlowmonitor();
+    void InsertNetworkHardware(NetworkHardware *link);
 
     /**
-     * \brief Generate Metrics C++ code.
-     * \return Metrics code
+     * \brief Drop the empty slots of the removed elements from the lists.
+     *
+     * The positions held by the name indexes are updated, this is done once
+     * after any number of removals, before the lists are used by index.
      */
-    std::vector<std::string> GenerateMetrics();
+    void Compact();
 
     /**
-     * \brief Generate flow C++ code.
-     * \return Flow code
+     * \brief Generate application C++ code.
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateFlowCpp();
+    void GenerateApplicationCpp(CodeSink &sink);
 
-    //
-    // C++ generation operation part.
-    //
+    /**
+     * \brief Generate trace C++ code.
+     * \param sink sink of the code
+     */
+    void GenerateTraceCpp(CodeSink &sink);
+
+    /**
+     * \brief Generate Flowmonitor declaration.
+     * \param sink sink of the code
+     */
+    void GenerateFlowmonitor(CodeSink &sink);
 
     /**
-     * \brief Name of the C++ output file name.
-     */  
-    std::ofstream m_cppFile;
+     * \brief Generate Metrics C++ code.
+     *
+     * The code is written indented for the body of main.
+     * \param sink sink of the code
+     */
+    void GenerateMetrics(CodeSink &sink);
 
     /**
-     * \brief Write C++ code into the attribute file name.
-     * \param line the new line to add to the attribute file name
+     * \brief Generate flow C++ code.
+     * \param sink sink of the code
      */
-    void WriteCpp(const std::string &line);
+    void GenerateFlowCpp(CodeSink &sink);
 
 };
 
@@ -27,11 +27,14 @@
 
 #include "hub.h"
 
-Hub::Hub(const std::string &type, const size_t &indice) : NetworkHardware(type, indice)
+#include "utils.h"
+
+Hub::Hub(SymbolTable &symbols, const std::string &type, const size_t &indice) : NetworkHardware(symbols, type, indice)
 {
   this->SetNetworkHardwareName(std::string("hub_" + this->GetIndice()));
   this->SetNdcName(std::string("ndc_" + this->GetNetworkHardwareName()));
   this->SetAllNodeContainer(std::string("all_" + this->GetNetworkHardwareName()));
+  this->m_csmaName = this->InternName("csma_");
 }
 
 Hub::~Hub()
@@ -47,46 +50,37 @@ std::vector<std::string> Hub::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Hub::GenerateNetworkHardwareCpp()
+void Hub::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> generatedLink;
-
-  generatedLink.push_back("");
-  generatedLink.push_back("CsmaHelper csma_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\",  TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
-
-  return generatedLink;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "CsmaHelper " << this->GetSymbolName(this->m_csmaName) << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".SetChannelAttribute (\"DataRate\", DataRateValue (" << this->GetDataRate() << "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".SetChannelAttribute (\"Delay\",  TimeValue (" << CodeTime(this->GetNetworkHardwareDelay()) << "));");
 }
 
-std::vector<std::string> Hub::GenerateNetDeviceCpp()
+void Hub::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
+  this->GroupAsNodeContainerCpp(sink);
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetNdcName() << " = " << this->GetSymbolName(this->m_csmaName) << ".Install (" << this->GetAllNodeContainer() << ");");
 }
 
-std::vector<std::string> Hub::GenerateTraceCpp()
+void Hub::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> trace;
-
   if(this->GetTrace())
   {
     if(this->GetPromisc())
     {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", true);");
+      sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".EnablePcapAll (\"" << this->GetSymbolName(this->m_csmaName) << "\", true);");
     }
     else
     {
-      trace.push_back("csma_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"csma_" + this->GetNetworkHardwareName() + "\", false);");
+      sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".EnablePcapAll (\"" << this->GetSymbolName(this->m_csmaName) << "\", false);");
     }
   }
+}
 
-  return trace;
+NetworkHardware::TableHelper Hub::GetTableHelper(std::string &helperName) const
+{
+  helperName = this->GetSymbolName(this->m_csmaName);
+  return TABLE_HELPER_CSMA;
 }
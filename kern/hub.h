@@ -49,13 +49,20 @@
  */
 class Hub : public NetworkHardware
 {
+  private:
+    /**
+     * \brief Csma helper name.
+     */
+    Symbol m_csmaName;
+
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice hub number
      * \param type link type
      */
-    Hub(const std::string &type, const size_t &indice);
+    Hub(SymbolTable &symbols, const std::string &type, const size_t &indice);
 
     /**
      * \brief Destructor.
@@ -71,21 +78,28 @@ class Hub : public NetworkHardware
 
     /**
      * \brief Generate link C++ code.
-     * \return link code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate net device container C++ code.
-     * \return net device container code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Generate trace line C++ code.
-     * \return trace line code
+     * \param sink sink of the code
+     */
+    virtual void GenerateTraceCpp(CodeSink &sink);
+
+    /**
+     * \brief Get the helper building the link from a row of the link table.
+     * \param helperName set to the name of the helper of the link
+     * \return TABLE_HELPER_CSMA
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
+    virtual TableHelper GetTableHelper(std::string &helperName) const;
     
 };
 
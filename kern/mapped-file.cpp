@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file mapped-file.cpp
+ * \brief Read-only memory mapped file.
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "mapped-file.h"
+
+MappedFile::MappedFile()
+{
+  this->m_data = 0;
+  this->m_size = 0;
+}
+
+MappedFile::~MappedFile()
+{
+  this->Close();
+}
+
+void MappedFile::Open(const std::string &fileName)
+{
+  this->Close();
+
+  int fd = open(fileName.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    throw std::runtime_error(fileName + ": " + strerror(errno));
+  }
+
+  struct stat st;
+  if(fstat(fd, &st) != 0)
+  {
+    int err = errno;
+    close(fd);
+    throw std::runtime_error(fileName + ": " + strerror(err));
+  }
+
+  /* an empty file cannot be mapped, it is just an empty buffer. */
+  if(st.st_size > 0)
+  {
+    void *data = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if(data == MAP_FAILED)
+    {
+      int err = errno;
+      close(fd);
+      throw std::runtime_error(fileName + ": " + strerror(err));
+    }
+    madvise(data, st.st_size, MADV_SEQUENTIAL);
+    this->m_data = data;
+    this->m_size = st.st_size;
+  }
+
+  /* the mapping stays valid once the descriptor is closed. */
+  close(fd);
+}
+
+void MappedFile::Close()
+{
+  if(this->m_data)
+  {
+    munmap(this->m_data, this->m_size);
+  }
+  this->m_data = 0;
+  this->m_size = 0;
+}
+
+const char *MappedFile::GetData() const
+{
+  return static_cast<const char*>(this->m_data);
+}
+
+size_t MappedFile::GetSize() const
+{
+  return this->m_size;
+}
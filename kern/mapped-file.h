@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file mapped-file.h
+ * \brief Read-only memory mapped file.
+ */
+
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <string>
+
+/**
+ * \ingroup generator
+ * \brief Read-only memory mapped file.
+ *
+ *  The whole file is mapped at once and the kernel is told it will be read
+ *  sequentially. The mapping is released by Close() or by the destructor.
+ */
+class MappedFile
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    MappedFile();
+
+    /**
+     * \brief Destructor.
+     */
+    ~MappedFile();
+
+    /**
+     * \brief Map a file, closing the previous mapping.
+     * \param fileName file name
+     * \throw std::runtime_error if the file cannot be opened or mapped
+     */
+    void Open(const std::string &fileName);
+
+    /**
+     * \brief Release the mapping.
+     */
+    void Close();
+
+    /**
+     * \brief Get the file content.
+     * \return first byte of the file (NULL if the file is empty)
+     */
+    const char *GetData() const;
+
+    /**
+     * \brief Get the file size.
+     * \return size in bytes
+     */
+    size_t GetSize() const;
+
+  private:
+    /**
+     * \brief Copy constructor (not implemented).
+     */
+    MappedFile(const MappedFile &);
+
+    /**
+     * \brief Assignment (not implemented).
+     */
+    MappedFile &operator=(const MappedFile &);
+
+    /**
+     * \brief Mapped bytes.
+     */
+    void *m_data;
+
+    /**
+     * \brief Mapping size.
+     */
+    size_t m_size;
+};
+
+#endif /* MAPPED_FILE_H */
@@ -30,7 +30,7 @@
 
 #include "utils.h"
 
-MeterDataManagement::MeterDataManagement(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+MeterDataManagement::MeterDataManagement(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->m_interval = interval;
   this->m_readingTime = readingTime;
@@ -70,28 +70,14 @@ std::vector<std::string> MeterDataManagement::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> MeterDataManagement::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void MeterDataManagement::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
   (void)netDeviceContainer;
   (void)numberIntoNetDevice;
 
-std::cerr << this->GetIndice() << std::endl;
-std::cerr << this->GetAppName() << std::endl;
-std::cerr << this->GetSenderNode() << std::endl;
-std::cerr << this->GetReceiverNode() << std::endl;
-std::cerr << this->GetStartTime() << std::endl;
-std::cerr << this->GetEndTime() << std::endl;
-std::cerr << this->GetEndTimeNumber() << std::endl;
-std::cerr << this->GetApplicationType() << std::endl;
-std::cerr << this->GetInterval() << std::endl;
-std::cerr << this->GetReadingTime() << std::endl << std::endl;
-
-  apps.push_back("");
-  apps.push_back("MeterDataManagementApplicationHelper mdm_" + this->GetAppName() + " (dcApps_dataConcentrator_" + this->GetIndice() + ", iface_ndc_p2p_" + this->GetIndice() + ".GetAddress (1), Seconds (" + this->GetInterval() + ".0), " + this->GetReadingTime() + ".0);");
-  apps.push_back("ApplicationContainer mdmApps_" + this->GetAppName() + " = mdm_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ");");
-  apps.push_back("mdmApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("mdmApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  return apps;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "MeterDataManagementApplicationHelper mdm_" << this->GetAppName() << " (dcApps_dataConcentrator_" << this->GetIndice() << ", iface_ndc_p2p_" << this->GetIndice() << ".GetAddress (1), Seconds (" << this->GetInterval() << ".0), " << this->GetReadingTime() << ".0);");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer mdmApps_" << this->GetAppName() << " = mdm_" << this->GetAppName() << ".Install (" << this->GetReceiverNode() << ");");
+  sink.WriteLine(CodeLine(sink) << "mdmApps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "mdmApps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 }
@@ -63,6 +63,7 @@ class MeterDataManagement : public Application
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param type application type
      * \param indice indice in the generator vector
      * \param senderNode sender node
@@ -70,7 +71,7 @@ class MeterDataManagement : public Application
      * \param startTime application start time
      * \param endTime application end time
      */
-    MeterDataManagement(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime);
+    MeterDataManagement(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &interval, const size_t &readingTime);
 
     /**
      * \brief Destructor.
@@ -85,11 +86,11 @@ class MeterDataManagement : public Application
 
     /**
      * \brief Generate the application C++ code.
+     * \param sink sink of the code
      * \param netDeviceContainer net device container name which are contain the sender node
      * \param numberIntoNetDevice place of the machine into the net device container
-     * \return application code
      */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice);
+    virtual void GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice);
     
     /**
      * \brief Get interval.
@@ -0,0 +1,179 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/**
+ * \file name-index.cpp
+ * \brief Hash index from element names to handles.
+ */
+
+#include "name-index.h"
+#include "utils.h"
+
+NameIndex::Slot::Slot()
+{
+  this->used = false;
+  this->hash = 0;
+  this->handle = 0;
+}
+
+NameIndex::NameIndex()
+{
+  this->m_size = 0;
+}
+
+NameIndex::~NameIndex()
+{
+}
+
+size_t NameIndex::Probe(const std::string &name, const uint64_t hash) const
+{
+  size_t mask = this->m_slots.size() - 1;
+  size_t i = static_cast<size_t>(hash) & mask;
+  while(this->m_slots[i].used && (this->m_slots[i].hash != hash || this->m_slots[i].name != name))
+  {
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+void NameIndex::Grow(const size_t nSlots)
+{
+  std::vector<Slot> slots(nSlots);
+  slots.swap(this->m_slots);
+
+  for(size_t i = 0; i < slots.size(); i++)
+  {
+    if(slots[i].used)
+    {
+      Slot &slot = this->m_slots[this->Probe(slots[i].name, slots[i].hash)];
+      slot.used = true;
+      slot.hash = slots[i].hash;
+      slot.name.swap(slots[i].name);
+      slot.handle = slots[i].handle;
+    }
+  }
+}
+
+bool NameIndex::Insert(const std::string &name, const size_t handle)
+{
+  if(2 * (this->m_size + 1) > this->m_slots.size())
+  {
+    this->Grow(this->m_slots.empty() ? 16 : this->m_slots.size() * 2);
+  }
+
+  uint64_t hash = utils::hashBytes(name.data(), name.size());
+  Slot &slot = this->m_slots[this->Probe(name, hash)];
+  if(slot.used)
+  {
+    return false;
+  }
+
+  slot.used = true;
+  slot.hash = hash;
+  slot.name = name;
+  slot.handle = handle;
+  this->m_size++;
+  return true;
+}
+
+void NameIndex::Set(const std::string &name, const size_t handle)
+{
+  if(!this->Insert(name, handle))
+  {
+    this->m_slots[this->Probe(name, utils::hashBytes(name.data(), name.size()))].handle = handle;
+  }
+}
+
+bool NameIndex::Find(const std::string &name, size_t &handle) const
+{
+  if(this->m_size == 0)
+  {
+    return false;
+  }
+
+  const Slot &slot = this->m_slots[this->Probe(name, utils::hashBytes(name.data(), name.size()))];
+  if(!slot.used)
+  {
+    return false;
+  }
+
+  handle = slot.handle;
+  return true;
+}
+
+bool NameIndex::Erase(const std::string &name)
+{
+  if(this->m_size == 0)
+  {
+    return false;
+  }
+
+  size_t mask = this->m_slots.size() - 1;
+  size_t hole = this->Probe(name, utils::hashBytes(name.data(), name.size()));
+  if(!this->m_slots[hole].used)
+  {
+    return false;
+  }
+
+  /* move back the following slots which cannot be reached anymore. */
+  size_t i = hole;
+  for(;;)
+  {
+    i = (i + 1) & mask;
+    Slot &slot = this->m_slots[i];
+    if(!slot.used)
+    {
+      break;
+    }
+
+    size_t home = static_cast<size_t>(slot.hash) & mask;
+    if(((i - home) & mask) >= ((i - hole) & mask))
+    {
+      Slot &free = this->m_slots[hole];
+      free.hash = slot.hash;
+      free.name.swap(slot.name);
+      free.handle = slot.handle;
+      hole = i;
+    }
+  }
+
+  this->m_slots[hole].used = false;
+  this->m_slots[hole].name.clear();
+  this->m_size--;
+  return true;
+}
+
+size_t NameIndex::GetSize() const
+{
+  return this->m_size;
+}
+
+void NameIndex::Reserve(const size_t nNames)
+{
+  size_t nSlots = this->m_slots.empty() ? 16 : this->m_slots.size();
+  while(2 * nNames > nSlots)
+  {
+    nSlots *= 2;
+  }
+  if(nSlots > this->m_slots.size())
+  {
+    this->Grow(nSlots);
+  }
+}
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/**
+ * \file name-index.h
+ * \brief Hash index from element names to handles.
+ */
+
+#ifndef NAME_INDEX_H
+#define NAME_INDEX_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Hash index from element names to handles.
+ *
+ *  Open addressing with linear probing: the slots hold the name, its hash
+ *  and the handle (a position in the list of the elements). Erasing shifts
+ *  the following slots of the probe sequence back, so lookups never go
+ *  through deleted slots. The table doubles when it is half full.
+ */
+class NameIndex
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    NameIndex();
+
+    /**
+     * \brief Destructor.
+     */
+    ~NameIndex();
+
+    /**
+     * \brief Index a new name.
+     * \param name element name
+     * \param handle element handle
+     * \return false if the name is already indexed (the index is unchanged)
+     */
+    bool Insert(const std::string &name, const size_t handle);
+
+    /**
+     * \brief Index a name, replacing the handle of an indexed one.
+     * \param name element name
+     * \param handle element handle
+     */
+    void Set(const std::string &name, const size_t handle);
+
+    /**
+     * \brief Look a name up.
+     * \param name element name
+     * \param handle element handle
+     * \return false if the name is not indexed
+     */
+    bool Find(const std::string &name, size_t &handle) const;
+
+    /**
+     * \brief Remove a name.
+     * \param name element name
+     * \return false if the name is not indexed
+     */
+    bool Erase(const std::string &name);
+
+    /**
+     * \brief Get the number of names.
+     * \return number of names indexed
+     */
+    size_t GetSize() const;
+
+    /**
+     * \brief Size the table for a number of names.
+     *
+     * Inserting up to this number of names does not rehash the table.
+     *
+     * \param nNames number of names
+     */
+    void Reserve(const size_t nNames);
+
+  private:
+    /**
+     * \brief Slot of the table.
+     */
+    struct Slot
+    {
+      Slot();
+
+      /**
+       * \brief The slot holds a name.
+       */
+      bool used;
+
+      /**
+       * \brief Hash of the name.
+       */
+      uint64_t hash;
+
+      /**
+       * \brief Name.
+       */
+      std::string name;
+
+      /**
+       * \brief Handle.
+       */
+      size_t handle;
+    };
+
+    /**
+     * \brief Find the slot of a name, or the free slot ending its probe sequence.
+     * \param name element name
+     * \param hash hash of the name
+     * \return slot index
+     */
+    size_t Probe(const std::string &name, const uint64_t hash) const;
+
+    /**
+     * \brief Rehash the names in a larger table.
+     * \param nSlots new table size, a power of 2
+     */
+    void Grow(const size_t nSlots);
+
+    /**
+     * \brief Slots, the size is 0 or a power of 2.
+     */
+    std::vector<Slot> m_slots;
+
+    /**
+     * \brief Number of used slots.
+     */
+    size_t m_size;
+};
+
+#endif /* NAME_INDEX_H */
@@ -26,149 +26,358 @@
  */
 
 #include "network-hardware.h"
+#include "code-table.h"
 #include "generator.h"
 #include <stdexcept>
 
 #include "utils.h"
 
-NetworkHardware::NetworkHardware(const std::string &type, const size_t &indice)
+NetworkHardware::NetworkHardware(SymbolTable &symbols, const std::string &type, const size_t &indice)
 {
-  this->m_type = type;
+  this->m_symbols = &symbols;
+  this->m_type = symbols.Intern(type);
   this->m_indice = indice;
-  this->m_dataRate = std::string("5000000"); /* 5 Mbps */
-  this->m_networkHardwareDelay = std::string("2000"); /* 2 ms */
+  this->m_indiceName = utils::integerToString(indice);
+  this->m_dataRate = 5000000; /* 5 Mbps */
+  this->m_networkHardwareDelay = 2000 * utils::NANOSECONDS_PER_MILLISECOND; /* 2000 ms */
+  this->m_networkHardwareName = symbols.Intern("");
+  this->m_ndcName = this->m_networkHardwareName;
+  this->m_allNodeContainer = this->m_networkHardwareName;
 
   this->m_enableTrace = false;
   this->m_tracePromisc = false;
+  this->m_nodesSorted = true;
 }
 
 NetworkHardware::~NetworkHardware()
 {
 }
 
-std::string NetworkHardware::GetIndice()
+const std::string &NetworkHardware::GetIndice() const
 {
-  return utils::integerToString(this->m_indice);
+  return this->m_indiceName;
 }
 
 void NetworkHardware::SetIndice(const size_t &indice)
 {
   this->m_indice = indice;
+  this->m_indiceName = utils::integerToString(indice);
 }
 
-std::string NetworkHardware::GetNetworkHardwareName()
+const std::string &NetworkHardware::GetNetworkHardwareName() const
 {
-  return this->m_networkHardwareName;
+  return this->m_symbols->GetName(this->m_networkHardwareName);
 }
 
-std::string NetworkHardware::GetDataRate()
+uint64_t NetworkHardware::GetDataRate() const
 {
   return this->m_dataRate;
 }
 
-std::string NetworkHardware::GetNetworkHardwareDelay()
+uint64_t NetworkHardware::GetNetworkHardwareDelay() const
 {
   return this->m_networkHardwareDelay;
 }
 
-std::string NetworkHardware::GetNdcName()
+const std::string &NetworkHardware::GetNdcName() const
 {
-  return this->m_ndcName;
+  return this->m_symbols->GetName(this->m_ndcName);
 }
 
-std::vector<std::string> NetworkHardware::GetInstalledNodes()
+const std::vector<Symbol> &NetworkHardware::GetInstalledNodes()
 {
+  this->SortInstalledNodes();
   return this->m_nodes;
 }
 
-std::string NetworkHardware::GetInstalledNode(const size_t &i)
+const std::string &NetworkHardware::GetInstalledNode(const size_t &i)
 {
-  return this->m_nodes.at(i);
+  this->SortInstalledNodes();
+  return this->m_symbols->GetName(this->m_nodes.at(i));
+}
+
+Symbol NetworkHardware::InternName(const std::string &prefix)
+{
+  return this->m_symbols->Intern(prefix, this->m_networkHardwareName);
+}
+
+const std::string &NetworkHardware::GetSymbolName(const Symbol symbol) const
+{
+  return this->m_symbols->GetName(symbol);
 }
 
 void NetworkHardware::removeInstalledNode(const size_t &nb)
 {
-  try
+  if(nb < this->m_routers.size())
   {
-    this->m_nodes.erase(this->m_nodes.begin() + nb);
+    this->m_routers.erase(this->m_routers.begin() + nb);
   }
-  catch(const std::out_of_range &e)
+  else if(nb - this->m_routers.size() < this->m_otherNodes.size())
   {
-    throw std::out_of_range(e);
-    return;
+    this->m_otherNodes.erase(this->m_otherNodes.begin() + (nb - this->m_routers.size()));
+  }
+  else
+  {
+    throw std::out_of_range("Remove installed node failed! (index not exists).");
   }
+  this->m_nodesSorted = false;
 }
 
 void NetworkHardware::SetNetworkHardwareName(const std::string &linkName)
 {
-  this->m_networkHardwareName = linkName;
+  this->m_networkHardwareName = this->m_symbols->Intern(linkName);
 }
 
 void NetworkHardware::SetDataRate(const std::string &dataRate)
 {
-  this->m_dataRate = dataRate;
+  if(!utils::parseDataRate(dataRate, this->m_dataRate))
+  {
+    throw std::logic_error("Invalid data rate <" + dataRate + "> for " + this->GetNetworkHardwareName() + ".");
+  }
+}
+
+void NetworkHardware::SetDataRate(const uint64_t bitsPerSecond)
+{
+  this->m_dataRate = bitsPerSecond;
 }
 
 void NetworkHardware::SetNetworkHardwareDelay(const std::string &linkDelay)
 {
-  this->m_networkHardwareDelay = linkDelay;
+  if(!utils::parseTime(linkDelay, utils::NANOSECONDS_PER_MILLISECOND, this->m_networkHardwareDelay))
+  {
+    throw std::logic_error("Invalid link delay <" + linkDelay + "> for " + this->GetNetworkHardwareName() + ".");
+  }
+}
+
+void NetworkHardware::SetNetworkHardwareDelay(const uint64_t nanoseconds)
+{
+  this->m_networkHardwareDelay = nanoseconds;
 }
 
 void NetworkHardware::SetNdcName(const std::string &ndcName)
 {
-  this->m_ndcName = ndcName;
+  this->m_ndcName = this->m_symbols->Intern(ndcName);
 }
 
 void NetworkHardware::Install(const std::string &node)
 {
-  this->m_nodes.push_back(node);
-  std::vector<std::string> trans;
-  std::vector<std::string> transWhitoutRouter;
-  for(size_t i = 0; i <  this->m_nodes.size(); i++)
+  if(node.compare(0, 7, "router_") == 0)
+  {
+    this->m_routers.push_back(this->m_symbols->Intern(node));
+  }
+  else
+  {
+    this->m_otherNodes.push_back(this->m_symbols->Intern(node));
+  }
+  this->m_nodesSorted = false;
+}
+
+void NetworkHardware::InstallRange(const std::vector<std::string> &nodes)
+{
+  this->m_otherNodes.reserve(this->m_otherNodes.size() + nodes.size());
+  for(size_t i = 0; i < nodes.size(); i++)
   {
-    if((this->m_nodes.at(i)).find("router_") == 0)
+    const std::string &node = nodes[i];
+    if(node.compare(0, 7, "router_") == 0)
     {
-      trans.push_back(this->m_nodes.at(i));
+      this->m_routers.push_back(this->m_symbols->Intern(node));
     }
     else
     {
-      transWhitoutRouter.push_back(this->m_nodes.at(i));
+      this->m_otherNodes.push_back(this->m_symbols->Intern(node));
     }
   }
-  for(size_t i = 0; i <  transWhitoutRouter.size(); i++)
+  this->m_nodesSorted = nodes.empty() && this->m_nodesSorted;
+}
+
+void NetworkHardware::SortInstalledNodes()
+{
+  if(this->m_nodesSorted)
   {
-    trans.push_back(transWhitoutRouter.at(i));
+    return;
   }
-  this->m_nodes = trans;
+
+  this->m_nodes.clear();
+  this->m_nodes.reserve(this->m_routers.size() + this->m_otherNodes.size());
+  this->m_nodes.insert(this->m_nodes.end(), this->m_routers.begin(), this->m_routers.end());
+  this->m_nodes.insert(this->m_nodes.end(), this->m_otherNodes.begin(), this->m_otherNodes.end());
+  this->m_nodesSorted = true;
 }
 
-std::string NetworkHardware::GetAllNodeContainer()
+const std::string &NetworkHardware::GetAllNodeContainer() const
 {
-  return this->m_allNodeContainer;
+  return this->m_symbols->GetName(this->m_allNodeContainer);
 }
 
 void NetworkHardware::SetAllNodeContainer(const std::string &allNodeContainer)
 {
-  this->m_allNodeContainer = allNodeContainer;
+  this->m_allNodeContainer = this->m_symbols->Intern(allNodeContainer);
 }
 
-std::vector<std::string> NetworkHardware::GroupAsNodeContainerCpp()
+/**
+ * \brief Start of a population member expression.
+ */
+static const std::string MEMBER_OPEN = "NodeContainer(";
+
+/**
+ * \brief Parse a population member expression, as returned by Node::GetNodeName(number).
+ * \param node node name, "NodeContainer(station_0_99.Get(4))" for a member
+ * \param containerSize size of the population container name
+ * \param number member number
+ * \return true if node is a population member
+ */
+static bool ParseMember(const std::string &node, size_t &containerSize, size_t &number)
 {
-  std::vector<std::string> res;
+  size_t get = node.rfind(".Get(");
+  if(node.compare(0, MEMBER_OPEN.size(), MEMBER_OPEN) != 0 || get == std::string::npos || get <= MEMBER_OPEN.size()
+     || node.size() < get + 8 || node.compare(node.size() - 2, 2, "))") != 0)
+  {
+    return false;
+  }
 
-  res.push_back("NodeContainer " + this->m_allNodeContainer + ";");
+  number = 0;
+  for(size_t i = get + 5; i < node.size() - 2; i++)
+  {
+    if(node[i] < '0' || node[i] > '9')
+    {
+      return false;
+    }
+    number = number * 10 + (node[i] - '0');
+  }
+  containerSize = get - MEMBER_OPEN.size();
+  return true;
+}
 
-  for(size_t i = 0; i <  this->m_nodes.size(); i++)
-     {
-      if((this->m_nodes.at(i).find("ap_") == 0) && (this->m_allNodeContainer.find("all_ap_") == 0))
-      ;
-      else
+size_t NetworkHardware::FindMemberRun(const size_t i, size_t &containerSize, size_t &first)
+{
+  const std::string &node = this->m_symbols->GetName(this->m_nodes.at(i));
+  size_t end = i + 1;
+  containerSize = 0;
+  first = 0;
+  if(ParseMember(node, containerSize, first))
+  {
+    size_t nextSize = 0;
+    size_t next = 0;
+    while(end < this->m_nodes.size())
+    {
+      const std::string &nextNode = this->m_symbols->GetName(this->m_nodes.at(end));
+      if(!ParseMember(nextNode, nextSize, next) || nextSize != containerSize || next != first + (end - i)
+         || nextNode.compare(MEMBER_OPEN.size(), containerSize, node, MEMBER_OPEN.size(), containerSize) != 0)
       {
-      res.push_back(this->m_allNodeContainer + ".Add (" + this->m_nodes.at(i) + ");");
+        break;
       }
-     }
+      end++;
+    }
+  }
+
+  return end;
+}
+
+size_t NetworkHardware::GroupAsNodeContainerCpp(CodeSink &sink)
+{
+  size_t members = 0;
+  const std::string &allNodeContainer = this->GetAllNodeContainer();
+  sink.WriteLine(CodeLine(sink) << "NodeContainer " << allNodeContainer << ";");
+
+  this->SortInstalledNodes();
+  size_t i = 0;
+  while(i < this->m_nodes.size())
+  {
+    const std::string &node = this->m_symbols->GetName(this->m_nodes.at(i));
+    if((node.find("ap_") == 0) && (allNodeContainer.find("all_ap_") == 0))
+    {
+      i++;
+      continue;
+    }
+
+    /* the consecutive members of a population are added by a loop. */
+    size_t containerSize = 0;
+    size_t first = 0;
+    size_t end = this->FindMemberRun(i, containerSize, first);
 
-  return res;
+    if(end - i > 1)
+    {
+      sink.WriteLine(CodeLine(sink) << "for (uint32_t i = " << first << "; i < " << first + (end - i) << "; ++i)");
+      sink.WriteLine("  {");
+      sink.WriteLine(CodeLine(sink) << "  " << allNodeContainer << ".Add (" << node.substr(MEMBER_OPEN.size(), containerSize) << ".Get (i));");
+      sink.WriteLine("  }");
+    }
+    else
+    {
+      sink.WriteLine(CodeLine(sink) << allNodeContainer << ".Add (" << node << ");");
+    }
+    members += end - i;
+    i = end;
+  }
+
+  return members;
+}
+
+/**
+ * \brief Members of the links of the link table.
+ *
+ * A row adds "count" members of a population from "first", or the whole
+ * node container when count is 0.
+ */
+static const CodeTableType LINK_MEMBER_TABLE =
+{
+  "LinkMemberRow",
+  "struct LinkMemberRow\n"
+  "{\n"
+  "  uint32_t link;\n"
+  "  uint32_t nodes;\n"
+  "  uint32_t first;\n"
+  "  uint32_t count;\n"
+  "};\n",
+  "for (size_t i = 0; i < sizeof (table) / sizeof (table[0]); ++i)\n"
+  "  {\n"
+  "  const LinkMemberRow &row = table[i];\n"
+  "  if (row.count == 0)\n"
+  "    {\n"
+  "    linkNodes[row.link].Add (*nodes[row.nodes]);\n"
+  "    }\n"
+  "  for (uint32_t j = row.first; j < row.first + row.count; ++j)\n"
+  "    {\n"
+  "    linkNodes[row.link].Add (nodes[row.nodes]->Get (j));\n"
+  "    }\n"
+  "  }\n"
+};
+
+size_t NetworkHardware::GenerateMemberRowsCpp(CodeTable &table, const size_t link)
+{
+  size_t members = 0;
+  const std::string &allNodeContainer = this->GetAllNodeContainer();
+
+  this->SortInstalledNodes();
+  size_t i = 0;
+  while(i < this->m_nodes.size())
+  {
+    const std::string &node = this->m_symbols->GetName(this->m_nodes.at(i));
+    if((node.find("ap_") == 0) && (allNodeContainer.find("all_ap_") == 0))
+    {
+      i++;
+      continue;
+    }
+
+    size_t containerSize = 0;
+    size_t first = 0;
+    size_t end = this->FindMemberRun(i, containerSize, first);
+
+    table.Begin(LINK_MEMBER_TABLE);
+    CodeSink &sink = table.GetSink();
+    if(containerSize > 0)
+    {
+      sink.WriteLine(CodeLine(sink) << "  { " << link << ", " << table.AddNodeContainer(node.substr(MEMBER_OPEN.size(), containerSize)) << ", " << first << ", " << end - i << " },");
+    }
+    else
+    {
+      sink.WriteLine(CodeLine(sink) << "  { " << link << ", " << table.AddNodeContainer(node) << ", 0, 0 },");
+    }
+    members += end - i;
+    i = end;
+  }
+
+  return members;
 }
 
 void NetworkHardware::SetTrace(const bool &state)
@@ -191,32 +400,34 @@ bool NetworkHardware::GetPromisc()
   return this->m_tracePromisc;
 }
 
-std::vector<std::string> NetworkHardware::GenerateTapBridgeCpp()
+void NetworkHardware::GenerateTapBridgeCpp(CodeSink &sink)
+{
+  (void)sink;
+}
+
+void NetworkHardware::GenerateVarsCpp(CodeSink &sink)
 {
-  std::vector<std::string> res;
-  return res;
+  (void)sink;
 }
 
-std::vector<std::string> NetworkHardware::GenerateVarsCpp()
+void NetworkHardware::GenerateCmdLineCpp(CodeSink &sink)
 {
-  std::vector<std::string> res;
-  return res;
+  (void)sink;
 }
 
-std::vector<std::string> NetworkHardware::GenerateCmdLineCpp()
+void NetworkHardware::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> res;
-  return res;
+  (void)sink;
 }
 
-std::vector<std::string> NetworkHardware::GenerateTraceCpp()
+NetworkHardware::TableHelper NetworkHardware::GetTableHelper(std::string &helperName) const
 {
-  std::vector<std::string> res;
-  return res;
+  (void)helperName;
+  return TABLE_HELPER_NONE;
 }
 
 /* XXX to move elsewhere */
-std::string NetworkHardware::GetLinkType()
+const std::string &NetworkHardware::GetLinkType() const
 {
-  return this->m_type;
+  return this->m_symbols->GetName(this->m_type);
 }
@@ -28,10 +28,16 @@
 #ifndef NETWORKHARDWARE_H
 #define NETWORKHARDWARE_H
 
+#include <stdint.h>
 #include <iostream>
 #include <string>
 #include <vector>
 
+#include "code-sink.h"
+#include "symbol-table.h"
+
+class CodeTable;
+
 /**
  * \ingroup generator
  * \brief This is the link class.
@@ -56,15 +62,15 @@
  *    ~LinkImpl();
  *
  *    virtual std::vector<std::string> GenerateHeader();
- *    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
- *    virtual std::vector<std::string> GenerateNetdeviceCpp();
+ *    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
+ *    virtual void GenerateNetDeviceCpp(CodeSink &sink);
  *    virtual std::vector<std::string> GenerateNetworkHardwarePython();
  *    virtual std::vector<std::string> GenerateNetdevicePython();
  *    # and if you need
- *    virtual std::vector<std::string> GenerateTraceCpp();
- *    virtual std::vector<std::string> GenerateTapBridgeCpp();
- *    virtual std::vector<std::string> GenerateVarsCpp();
- *    virtual std::vector<std::string> GenerateCmdLineCpp();
+ *    virtual void GenerateTraceCpp(CodeSink &sink);
+ *    virtual void GenerateTapBridgeCpp(CodeSink &sink);
+ *    virtual void GenerateVarsCpp(CodeSink &sink);
+ *    virtual void GenerateCmdLineCpp(CodeSink &sink);
  *    virtual std::vector<std::string> GenerateTracePython();
  *    virtual std::vector<std::string> GenerateTapBridgePython();
  *    virtual std::vector<std::string> GenerateVarsPython();
@@ -74,40 +80,50 @@
 class NetworkHardware
 {
   private:
+    /**
+     * \brief Table holding the names.
+     */
+    SymbolTable *m_symbols;
+
     /**
      * \brief Type of the link.
      */
-    std::string m_type;
+    Symbol m_type;
 
     /**
      * \brief Number of the link.
      */
     size_t m_indice;
 
+    /**
+     * \brief Indice as a string, as returned by GetIndice.
+     */
+    std::string m_indiceName;
+
     /**
      * \brief Link name.
      */
-    std::string m_networkHardwareName;
+    Symbol m_networkHardwareName;
 
     /**
-     * \brief Data rate.
+     * \brief Data rate in bit/s.
      */
-    std::string m_dataRate;
+    uint64_t m_dataRate;
 
     /**
-     * \brief Link delay.
+     * \brief Link delay in nanoseconds.
      */
-    std::string m_networkHardwareDelay;
+    uint64_t m_networkHardwareDelay;
 
     /**
      * \brief Node device container name.
      */
-    std::string m_ndcName;
+    Symbol m_ndcName;
 
     /**
      * \brief Name of the node container group.
      */
-    std::string m_allNodeContainer;
+    Symbol m_allNodeContainer;
 
     /**
      * \brief Enable/disable trafic.
@@ -120,17 +136,60 @@ class NetworkHardware
     bool m_tracePromisc;
 
     /**
-     * \brief Node name which are connected to the link.
+     * \brief Node name which are connected to the link, routers first.
+     *
+     * It is rebuilt from m_routers and m_otherNodes when it is read after
+     * an install.
+     */
+    std::vector<Symbol> m_nodes;
+
+    /**
+     * \brief Routers connected to the link, in install order.
+     */
+    std::vector<Symbol> m_routers;
+
+    /**
+     * \brief Other nodes connected to the link, in install order.
      */
-    std::vector<std::string> m_nodes;
+    std::vector<Symbol> m_otherNodes;
+
+    /**
+     * \brief m_nodes holds the current routers and other nodes.
+     */
+    bool m_nodesSorted;
+
+    /**
+     * \brief Rebuild m_nodes if nodes were installed or removed.
+     */
+    void SortInstalledNodes();
+
+    /**
+     * \brief Find the run of consecutive population members starting at an installed node.
+     * \param i index of the installed node in m_nodes
+     * \param containerSize set to the size of the population container name, 0 if the node is not a member
+     * \param first set to the index of the node in its population
+     * \return index of the node following the run
+     */
+    size_t FindMemberRun(const size_t i, size_t &containerSize, size_t &first);
 
   public:
+    /**
+     * \brief Helpers of the links built from a row of the link table.
+     */
+    enum TableHelper
+    {
+      TABLE_HELPER_NONE,
+      TABLE_HELPER_CSMA,
+      TABLE_HELPER_P2P
+    };
+
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice number of the link
      * \param type link type
      */
-    NetworkHardware(const std::string &type, const size_t &indice);
+    NetworkHardware(SymbolTable &symbols, const std::string &type, const size_t &indice);
 
     /**
      * \brief Destructor.
@@ -145,47 +204,59 @@ class NetworkHardware
 
     /**
      * \brief Generate link C++ code.
-     * \return link code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp() = 0;
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink) = 0;
 
     /**
      * \brief Generate net device container C++ code.
      *
      * The net device container contain all nodes installed by the link.
-     * \return net device container code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp() = 0;
+    virtual void GenerateNetDeviceCpp(CodeSink &sink) = 0;
 
     /**
      * \brief Generate tap bridge C++ code.
-     * \return tap bridge code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateTapBridgeCpp();
+    virtual void GenerateTapBridgeCpp(CodeSink &sink);
 
     /**
      * \brief Generate vars C++ code.
-     * \return vars code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateVarsCpp();
+    virtual void GenerateVarsCpp(CodeSink &sink);
 
     /**
      * \brief Generate cmd line C++ code.
-     * \return cmd line code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateCmdLineCpp();
+    virtual void GenerateCmdLineCpp(CodeSink &sink);
 
     /**
      * \brief Generate trace line C++ code.
-     * \return trace line code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
+    virtual void GenerateTraceCpp(CodeSink &sink);
+
+    /**
+     * \brief Get the helper building the link from a row of the link table.
+     *
+     * In tables mode, the links which only need a helper, a data rate and a
+     * delay are rows of one link table, walked by the link, net device and
+     * IP assign phases instead of their own code.
+     *
+     * \param helperName set to the name of the helper of the link
+     * \return TABLE_HELPER_NONE if the link generates its own code
+     */
+    virtual TableHelper GetTableHelper(std::string &helperName) const;
 
     /**
      * \brief Get link number.
      * \return link number
      */
-    std::string GetIndice();
+    const std::string &GetIndice() const;
 
     /**
      * \brief Set link number.
@@ -197,37 +268,51 @@ class NetworkHardware
      * \brief Get link name.
      * \return link name
      */
-    std::string GetNetworkHardwareName();
+    const std::string &GetNetworkHardwareName() const;
 
     /**
      * \brief Get link data rate.
-     * \return link data rate
+     * \return link data rate in bit/s
      */
-    std::string GetDataRate();
+    uint64_t GetDataRate() const;
 
     /**
-     * \brief Get link delay (in ms).
-     * \return link delay
+     * \brief Get link delay.
+     * \return link delay in nanoseconds
      */
-    std::string GetNetworkHardwareDelay();
+    uint64_t GetNetworkHardwareDelay() const;
 
     /**
      * \brief Get net device container name.
      * \return net device container name
      */
-    std::string GetNdcName();
+    const std::string &GetNdcName() const;
 
     /**
      * \brief Get attached nodes list.
-     * \return node list
+     * \return symbols of the node names
      */
-    std::vector<std::string> GetInstalledNodes();
+    const std::vector<Symbol> &GetInstalledNodes();
 
     /**
      * \brief Get n node.
      * \param i index from Get node
      */
-    std::string GetInstalledNode(const size_t &i);
+    const std::string &GetInstalledNode(const size_t &i);
+
+    /**
+     * \brief Intern an identifier of the generated code derived from the link name.
+     * \param prefix prefix of the identifier, "csma_" for instance
+     * \return symbol of prefix + link name
+     */
+    Symbol InternName(const std::string &prefix);
+
+    /**
+     * \brief Get the name of a symbol.
+     * \param symbol symbol returned by InternName
+     * \return name
+     */
+    const std::string &GetSymbolName(const Symbol symbol) const;
 
     /**
      * \brief Remove installed selected node.
@@ -242,17 +327,31 @@ class NetworkHardware
     void SetNetworkHardwareName(const std::string &linkName);
 
     /**
-     * \brief Set data rate in bps.
-     * \param dataRate new data rate
+     * \brief Set data rate.
+     * \param dataRate new data rate, in bps without unit ("5000000", "5Mbps")
+     * \throw std::logic_error if the text is not a data rate
      */
     void SetDataRate(const std::string &dataRate);
 
     /**
-     * \brief Set link delay in millisecond.
-     * \param linkDelay new link delay
+     * \brief Set data rate.
+     * \param bitsPerSecond new data rate in bit/s
+     */
+    void SetDataRate(const uint64_t bitsPerSecond);
+
+    /**
+     * \brief Set link delay.
+     * \param linkDelay new link delay, in millisecond without unit ("2", "2ms")
+     * \throw std::logic_error if the text is not a duration
      */
     void SetNetworkHardwareDelay(const std::string &linkDelay);
 
+    /**
+     * \brief Set link delay.
+     * \param nanoseconds new link delay in nanoseconds
+     */
+    void SetNetworkHardwareDelay(const uint64_t nanoseconds);
+
     /**
      * \brief Set net device container name.
      * \param ndcName new net device container name
@@ -261,21 +360,41 @@ class NetworkHardware
 
     /**
      * \brief Install node on link.
+     *
+     * The routers come first in the installed nodes, each group in install
+     * order. The order is only computed when the nodes are read, so
+     * installing is constant time.
+     *
      * \param node new node to add
      */
     void Install(const std::string &node);
 
+    /**
+     * \brief Install many nodes on link.
+     * \param nodes new nodes to add, in install order
+     */
+    void InstallRange(const std::vector<std::string> &nodes);
+
     /**
      * \brief Group all link installed nodes.
-     * \return all nodes
+     * \param sink sink of the code
+     * \return number of nodes added to the node container
+     */
+    size_t GroupAsNodeContainerCpp(CodeSink &sink);
+
+    /**
+     * \brief Generate the rows of the link installed nodes in the link member table.
+     * \param table member table
+     * \param link index of the link in the link table
+     * \return number of nodes added to the node container
      */
-    std::vector<std::string> GroupAsNodeContainerCpp();
+    size_t GenerateMemberRowsCpp(CodeTable &table, const size_t link);
 
     /**
      * \brief Get all node container name.
      * \return node container name
      */
-    std::string GetAllNodeContainer();
+    const std::string &GetAllNodeContainer() const;
     
     /**
      * \brief Set name of all node container.
@@ -311,7 +430,7 @@ class NetworkHardware
      * \brief Get the link type
      * \return link type
      */
-    std::string GetLinkType();
+    const std::string &GetLinkType() const;
 };
 
 #endif /* NETWORKHARDWARE_H */
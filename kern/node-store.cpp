@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file node-store.cpp
+ * \brief Columns of the node fields read by the whole population passes.
+ */
+
+#include "node-store.h"
+
+NodeStore::NodeStore(SymbolTable &symbols)
+{
+  this->m_symbols = &symbols;
+  this->m_noNsc = symbols.Intern("");
+}
+
+NodeStore::~NodeStore()
+{
+}
+
+size_t NodeStore::Add(const std::string &type, const std::string &nodeName, const size_t machinesNumber)
+{
+  this->m_types.push_back(this->m_symbols->Intern(type));
+  this->m_names.push_back(this->m_symbols->Intern(nodeName));
+  this->m_machinesNumbers.push_back(machinesNumber);
+  this->m_nscs.push_back(this->m_noNsc);
+  this->m_flowmonitors.push_back(false);
+
+  return this->m_names.size() - 1;
+}
+
+void NodeStore::Reserve(const size_t nRows)
+{
+  this->m_types.reserve(nRows);
+  this->m_names.reserve(nRows);
+  this->m_machinesNumbers.reserve(nRows);
+  this->m_nscs.reserve(nRows);
+  this->m_flowmonitors.reserve(nRows);
+}
+
+void NodeStore::Move(const size_t from, const size_t to)
+{
+  this->m_types[to] = this->m_types[from];
+  this->m_names[to] = this->m_names[from];
+  this->m_machinesNumbers[to] = this->m_machinesNumbers[from];
+  this->m_nscs[to] = this->m_nscs[from];
+  this->m_flowmonitors[to] = this->m_flowmonitors[from];
+}
+
+void NodeStore::Resize(const size_t nRows)
+{
+  this->m_types.resize(nRows);
+  this->m_names.resize(nRows);
+  this->m_machinesNumbers.resize(nRows);
+  this->m_nscs.resize(nRows);
+  this->m_flowmonitors.resize(nRows);
+}
+
+size_t NodeStore::GetSize() const
+{
+  return this->m_names.size();
+}
+
+SymbolTable &NodeStore::GetSymbols() const
+{
+  return *this->m_symbols;
+}
+
+Symbol NodeStore::GetType(const size_t row) const
+{
+  return this->m_types[row];
+}
+
+Symbol NodeStore::GetName(const size_t row) const
+{
+  return this->m_names[row];
+}
+
+void NodeStore::SetName(const size_t row, const Symbol name)
+{
+  this->m_names[row] = name;
+}
+
+size_t NodeStore::GetMachinesNumber(const size_t row) const
+{
+  return this->m_machinesNumbers[row];
+}
+
+void NodeStore::SetMachinesNumber(const size_t row, const size_t machinesNumber)
+{
+  this->m_machinesNumbers[row] = machinesNumber;
+}
+
+Symbol NodeStore::GetNsc(const size_t row) const
+{
+  return this->m_nscs[row];
+}
+
+void NodeStore::SetNsc(const size_t row, const Symbol nsc)
+{
+  this->m_nscs[row] = nsc;
+}
+
+bool NodeStore::HasNsc(const size_t row) const
+{
+  return this->m_nscs[row] != this->m_noNsc;
+}
+
+bool NodeStore::GetFlowmonitor(const size_t row) const
+{
+  return this->m_flowmonitors[row];
+}
+
+void NodeStore::SetFlowmonitor(const size_t row, const bool state)
+{
+  this->m_flowmonitors[row] = state;
+}
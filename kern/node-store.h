@@ -0,0 +1,207 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file node-store.h
+ * \brief Columns of the node fields read by the whole population passes.
+ */
+
+#ifndef NODE_STORE_H
+#define NODE_STORE_H
+
+#include <string>
+#include <vector>
+
+#include "symbol-table.h"
+
+/**
+ * \ingroup generator
+ * \brief Columns of the node fields read by the whole population passes.
+ *
+ *  The type, name, machine number, NSC library and flowmonitor state of
+ *  every node are held by one array each, a node has a row of the arrays
+ *  and its Node object is a view over the row. The passes which test one
+ *  field of every node scan its column instead of reaching each Node
+ *  through a pointer.
+ *
+ *  The rows are added in node order. Removing a node leaves its row until
+ *  the generator compacts its node list and moves the rows down with Move,
+ *  afterwards the row of a node is its position in the list.
+ */
+class NodeStore
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param symbols table holding the names
+     */
+    NodeStore(SymbolTable &symbols);
+
+    /**
+     * \brief Destructor.
+     */
+    ~NodeStore();
+
+    /**
+     * \brief Add a row.
+     * \param type node type
+     * \param nodeName node name
+     * \param machinesNumber number of machines
+     * \return row
+     */
+    size_t Add(const std::string &type, const std::string &nodeName, const size_t machinesNumber);
+
+    /**
+     * \brief Reserve the columns for more rows.
+     * \param nRows number of rows
+     */
+    void Reserve(const size_t nRows);
+
+    /**
+     * \brief Copy a row over another one.
+     * \param from source row
+     * \param to destination row
+     */
+    void Move(const size_t from, const size_t to);
+
+    /**
+     * \brief Drop the rows from a row on.
+     * \param nRows number of rows kept
+     */
+    void Resize(const size_t nRows);
+
+    /**
+     * \brief Get the number of rows.
+     * \return number of rows
+     */
+    size_t GetSize() const;
+
+    /**
+     * \brief Get the table holding the names.
+     * \return symbol table
+     */
+    SymbolTable &GetSymbols() const;
+
+    /**
+     * \brief Get the type of a row.
+     * \param row row
+     * \return symbol of the type
+     */
+    Symbol GetType(const size_t row) const;
+
+    /**
+     * \brief Get the node name of a row.
+     * \param row row
+     * \return symbol of the name
+     */
+    Symbol GetName(const size_t row) const;
+
+    /**
+     * \brief Set the node name of a row.
+     * \param row row
+     * \param name symbol of the name
+     */
+    void SetName(const size_t row, const Symbol name);
+
+    /**
+     * \brief Get the number of machines of a row.
+     * \param row row
+     * \return number of machines
+     */
+    size_t GetMachinesNumber(const size_t row) const;
+
+    /**
+     * \brief Set the number of machines of a row.
+     * \param row row
+     * \param machinesNumber number of machines
+     */
+    void SetMachinesNumber(const size_t row, const size_t machinesNumber);
+
+    /**
+     * \brief Get the NSC library of a row.
+     * \param row row
+     * \return symbol of the library, the one of "" if NSC is not used
+     */
+    Symbol GetNsc(const size_t row) const;
+
+    /**
+     * \brief Set the NSC library of a row.
+     * \param row row
+     * \param nsc symbol of the library
+     */
+    void SetNsc(const size_t row, const Symbol nsc);
+
+    /**
+     * \brief Tell if a row uses NSC.
+     * \param row row
+     * \return true if the NSC library is not empty
+     */
+    bool HasNsc(const size_t row) const;
+
+    /**
+     * \brief Get the flowmonitor state of a row.
+     * \param row row
+     * \return true if a flowmonitor is installed
+     */
+    bool GetFlowmonitor(const size_t row) const;
+
+    /**
+     * \brief Set the flowmonitor state of a row.
+     * \param row row
+     * \param state flowmonitor state
+     */
+    void SetFlowmonitor(const size_t row, const bool state);
+
+  private:
+    /**
+     * \brief Table holding the names.
+     */
+    SymbolTable *m_symbols;
+
+    /**
+     * \brief Symbol of the empty NSC library.
+     */
+    Symbol m_noNsc;
+
+    /**
+     * \brief Node types.
+     */
+    std::vector<Symbol> m_types;
+
+    /**
+     * \brief Node names.
+     */
+    std::vector<Symbol> m_names;
+
+    /**
+     * \brief Numbers of machines.
+     */
+    std::vector<size_t> m_machinesNumbers;
+
+    /**
+     * \brief NSC libraries.
+     */
+    std::vector<Symbol> m_nscs;
+
+    /**
+     * \brief Flowmonitor states, one bit per row.
+     */
+    std::vector<bool> m_flowmonitors;
+};
+
+#endif /* NODE_STORE_H */
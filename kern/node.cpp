@@ -30,15 +30,14 @@
 
 #include "utils.h"
 
-Node::Node(const size_t &indice, const std::string &type, const std::string &nodeName, const size_t &machinesNumber)
+Node::Node(NodeStore &store, const size_t &indice, const std::string &type, const std::string &nodeName, const size_t &machinesNumber)
 {
+  this->m_store = &store;
+  this->m_row = store.Add(type, nodeName, machinesNumber);
   this->m_indice = indice;
-  this->m_type = type;
-  this->m_nodeName = nodeName;
-  this->m_ipInterfaceName = std::string("iface_" + this->m_nodeName);
-  this->m_nsc = std::string("");	
-  this->m_machinesNumber = machinesNumber;
-  this->m_enableFlowmonitor = false;
+  this->m_indiceName = utils::integerToString(indice);
+  this->m_ipInterfaceName = store.GetSymbols().Intern("iface_", store.GetName(this->m_row));
+  this->m_firstMember = 0;
 }
 
 Node::~Node()
@@ -47,57 +46,58 @@ Node::~Node()
 
 void Node::SetNodeName(const std::string &nodeName)
 {
-  this->m_nodeName = nodeName;
+  this->m_store->SetName(this->m_row, this->m_store->GetSymbols().Intern(nodeName));
 }
 
 void Node::SetIpInterfaceName(const std::string &ipInterfaceName)
 {
-  this->m_ipInterfaceName = ipInterfaceName;
+  this->m_ipInterfaceName = this->m_store->GetSymbols().Intern(ipInterfaceName);
 }
 
-std::string Node::GetNodeName()
+const std::string &Node::GetNodeName() const
 {
-  return this->m_nodeName;
+  return this->m_store->GetSymbols().GetName(this->m_store->GetName(this->m_row));
 }
 
 std::string Node::GetNodeName(const size_t &number)
 {
-  return std::string("NodeContainer(" + this->m_nodeName + ".Get(" + utils::integerToString(number) + "))");
+  return std::string("NodeContainer(" + this->GetNodeName() + ".Get(" + utils::integerToString(number) + "))");
 }
 
-std::string Node::GetIpInterfaceName()
+const std::string &Node::GetIpInterfaceName() const
 {
-  return this->m_ipInterfaceName;
+  return this->m_store->GetSymbols().GetName(this->m_ipInterfaceName);
 }
 
-std::string Node::GetIndice()
+const std::string &Node::GetIndice() const
 {
-  return utils::integerToString(this->m_indice);
+  return this->m_indiceName;
 }
 
 void Node::SetIndice(const size_t &indice)
 {
   this->m_indice = indice;
+  this->m_indiceName = utils::integerToString(indice);
 }
 
-std::string Node::GetNsc()
+const std::string &Node::GetNsc() const
 {
-  return this->m_nsc;
+  return this->m_store->GetSymbols().GetName(this->m_store->GetNsc(this->m_row));
 }
 
 void Node::SetNsc(const std::string &nsc)
 {
-  this->m_nsc = nsc;
+  this->m_store->SetNsc(this->m_row, this->m_store->GetSymbols().Intern(nsc));
 }
 
 size_t Node::GetMachinesNumber()
 {
-  return this->m_machinesNumber;
+  return this->m_store->GetMachinesNumber(this->m_row);
 }
 
 void Node::SetMachinesNumber(const size_t machinesNumber)
 {
-  this->m_machinesNumber = machinesNumber;
+  this->m_store->SetMachinesNumber(this->m_row, machinesNumber);
 }
 
 std::vector<std::string> Node::GenerateHeader()
@@ -108,54 +108,130 @@ std::vector<std::string> Node::GenerateHeader()
   return headers; 
 }
 
-std::vector<std::string> Node::GenerateNodeCpp()
+void Node::GenerateNodeCpp(CodeSink &sink)
 {
-  std::vector<std::string> nodes;
-
-  nodes.push_back("");
-  nodes.push_back("NodeContainer " + this->m_nodeName + ";");
-  nodes.push_back(this->m_nodeName + ".Create (" + utils::integerToString(this->m_machinesNumber) + ");");
-  nodes.push_back("Names::Add (\"" + this->m_nodeName + "\", " + this->m_nodeName + ".Get (0));");
-
-  return nodes; 
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "NodeContainer " << this->GetNodeName() << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetNodeName() << ".Create (" << this->GetMachinesNumber() << ");");
+  if(this->IsPopulation())
+  {
+    sink.WriteLine(CodeLine(sink) << "for (uint32_t i = 0; i < " << this->GetNodeName() << ".GetN (); ++i)");
+    sink.WriteLine("  {");
+    CodeLine name(sink);
+    name << "  Names::Add (\"" << this->m_memberPrefix << "\" + NumberToString (i + " << this->m_firstMember << ")";
+    if(!this->m_memberSuffix.empty())
+    {
+      name << " + \"" << this->m_memberSuffix << "\"";
+    }
+    name << ", " << this->GetNodeName() << ".Get (i));";
+    sink.WriteLine(name);
+    sink.WriteLine("  }");
+  }
+  else
+  {
+    sink.WriteLine(CodeLine(sink) << "Names::Add (\"" << this->GetNodeName() << "\", " << this->GetNodeName() << ".Get (0));");
+  }
 }
 
-std::vector<std::string> Node::GenerateIpStackCpp()
+void Node::GenerateIpStackCpp(CodeSink &sink)
 {
-  std::vector<std::string> stack;
-  
-  if(this->m_nsc != "")
+  if(this->m_store->HasNsc(this->m_row))
   {
-    stack.push_back("internetStackH.SetTcp (\"ns3::NscTcpL4Protocol\",\"Library\",StringValue(nscStack));");
+    sink.WriteLine("internetStackH.SetTcp (\"ns3::NscTcpL4Protocol\",\"Library\",StringValue(nscStack));");
   }
-  stack.push_back("internetStackH.Install (" + this->m_nodeName + ");");
-
-  return stack; 
+  sink.WriteLine(CodeLine(sink) << "internetStackH.Install (" << this->GetNodeName() << ");");
 }
 
-std::vector<std::string> Node::GenerateFlowmonitor()
+void Node::GenerateFlowmonitor(CodeSink &sink)
 {
-  std::vector<std::string> flowmon;
-
   if(this->GetFlowmonitor())
   {
-    flowmon.push_back("monitor = flowmonHelper.Install(" + this->m_nodeName + ");");
+    sink.WriteLine(CodeLine(sink) << "monitor = flowmonHelper.Install(" << this->GetNodeName() << ");");
   }
-
-  return flowmon; 
 }
 
 void Node::SetFlowmonitor(const bool &state)
 {
-  this->m_enableFlowmonitor = state;
+  this->m_store->SetFlowmonitor(this->m_row, state);
 }
 
 bool Node::GetFlowmonitor()
 {
-  return this->m_enableFlowmonitor;
+  return this->m_store->GetFlowmonitor(this->m_row);
+}
+
+size_t Node::GetRow() const
+{
+  return this->m_row;
+}
+
+void Node::SetRow(const size_t row)
+{
+  this->m_row = row;
 }
 
-std::string Node::GetNodeType()
+const std::string &Node::GetNodeType() const
 {
-  return this->m_type;
+  return this->m_store->GetSymbols().GetName(this->m_store->GetType(this->m_row));
+}
+
+void Node::SetMemberNames(const std::string &prefix, const size_t &firstMember, const std::string &suffix)
+{
+  this->m_memberPrefix = prefix;
+  this->m_firstMember = firstMember;
+  this->m_memberSuffix = suffix;
+}
+
+bool Node::IsPopulation()
+{
+  return this->m_memberPrefix != "";
+}
+
+const std::string &Node::GetMemberPrefix() const
+{
+  return this->m_memberPrefix;
+}
+
+const std::string &Node::GetMemberSuffix() const
+{
+  return this->m_memberSuffix;
+}
+
+size_t Node::GetFirstMember()
+{
+  return this->m_firstMember;
+}
+
+bool Node::FindMember(const std::string &name, size_t &number)
+{
+  size_t prefixSize = this->m_memberPrefix.size();
+  size_t suffixSize = this->m_memberSuffix.size();
+  if(!this->IsPopulation() || name.size() <= prefixSize + suffixSize || name.compare(0, prefixSize, this->m_memberPrefix) != 0
+     || name.compare(name.size() - suffixSize, suffixSize, this->m_memberSuffix) != 0)
+  {
+    return false;
+  }
+
+  size_t end = name.size() - suffixSize;
+  size_t index = 0;
+  for(size_t i = prefixSize; i < end; i++)
+  {
+    if(name[i] < '0' || name[i] > '9')
+    {
+      return false;
+    }
+    index = index * 10 + (name[i] - '0');
+  }
+  /* "station_07" is not "station_7". */
+  if(name[prefixSize] == '0' && end > prefixSize + 1)
+  {
+    return false;
+  }
+
+  if(index < this->m_firstMember || index - this->m_firstMember >= this->GetMachinesNumber())
+  {
+    return false;
+  }
+  number = index - this->m_firstMember;
+  return true;
 }
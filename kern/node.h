@@ -32,6 +32,9 @@
 #include <string>
 #include <vector>
 
+#include "code-sink.h"
+#include "node-store.h"
+
 /**
  * \ingroup generator
  * \brief Node base class.
@@ -53,49 +56,55 @@ class Node
 {
   private:
     /**
-     * \brief Node number.
+     * \brief Store holding the row of the node.
      */
-    size_t m_indice;
+    NodeStore *m_store;
 
     /**
-     * \brief Node name.
+     * \brief Row of the node in the store.
      */
-    std::string m_nodeName;
+    size_t m_row;
 
     /**
-     * \brief Ip interface name. 
+     * \brief Node number.
      */
-    std::string m_ipInterfaceName;
+    size_t m_indice;
 
     /**
-     * \brief Nsc use.
+     * \brief Indice as a string, as returned by GetIndice.
      */
-    std::string m_nsc;
+    std::string m_indiceName;
 
     /**
-     * \brief Number of machines.
+     * \brief Ip interface name. 
      */
-    size_t m_machinesNumber;
+    Symbol m_ipInterfaceName;
 
     /**
-     * \brief Node type.
+     * \brief Member name prefix of a population, empty for other nodes.
      */
-    std::string m_type;
+    std::string m_memberPrefix;
 
     /**
-     * \brief Enable/disable Flowmonitor.
+     * \brief Member name suffix of a population, after the index.
      */
-    bool m_enableFlowmonitor;
+    std::string m_memberSuffix;
+
+    /**
+     * \brief Index of the first member of a population.
+     */
+    size_t m_firstMember;
 
   public:
     /**
      * \brief Constructor.
+     * \param store store holding the row of the node, which the constructor adds
      * \param indice number of the node
      * \param type type of the node (pc, router, ...)
      * \param namePrefix the prefix name of the node
      * \param machinesNumber number of machine to create
      */
-    Node(const size_t &indice, const std::string &type, const std::string &namePrefix, const size_t &machinesNumber);
+    Node(NodeStore &store, const size_t &indice, const std::string &type, const std::string &namePrefix, const size_t &machinesNumber);
 
     /**
      * \brief Destructor.
@@ -111,24 +120,24 @@ class Node
 
     /**
      * \brief Generate node C++ code.
-     * This function return a vector which contain the declaration and instanciation of the node
-     * \return node code
+     * This function writes the declaration and instanciation of the node
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateNodeCpp();
+    void GenerateNodeCpp(CodeSink &sink);
 
     /**
      * \brief Generate IP stack C++ code.
-     * This function return a vector which contain the c++ code from the Ipv4 stack declaration and instanciation
-     * \return IP stack code.
+     * This function writes the c++ code from the Ipv4 stack declaration and instanciation
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateIpStackCpp();
+    void GenerateIpStackCpp(CodeSink &sink);
 
     /**
      * \brief Generate Flowmonitor install C++ code.
-     * This function returns a vector which contains the declaration of Flowmonitor on a node
-     * \return Flowmonitor declaration code
+     * This function writes the declaration of Flowmonitor on a node
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateFlowmonitor();
+    void GenerateFlowmonitor(CodeSink &sink);
 
     /**
      * \brief Set node name.
@@ -149,7 +158,7 @@ class Node
      * \brief Get node name.
      * \return node name
      */
-    std::string GetNodeName();
+    const std::string &GetNodeName() const;
 
     /**
      * \brief Get node name.
@@ -162,13 +171,13 @@ class Node
      * \brief Get ip interface name.
      * \return IP interface name
      */
-    std::string GetIpInterfaceName();
+    const std::string &GetIpInterfaceName() const;
 
     /**
      * \brief Get indice.
      * \return indice
      */
-    std::string GetIndice();
+    const std::string &GetIndice() const;
 
     /**
      * \brief Set indice.
@@ -180,7 +189,7 @@ class Node
      * \brief Get NSC (Network Simulation Cradle) code.
      * \return nsc code
      */
-    std::string GetNsc();
+    const std::string &GetNsc() const;
 
     /**
      * \brief Set NSC (Network Simulation Cradle) code.
@@ -212,11 +221,70 @@ class Node
      */
     bool GetFlowmonitor();
 
+    /**
+     * \brief Get the row of the node in its store.
+     * \return row
+     */
+    size_t GetRow() const;
+
+    /**
+     * \brief Set the row of the node, when the store moves it.
+     * \param row new row
+     */
+    void SetRow(const size_t row);
+
     /**
      * \brief Get node type.
      * \return type the node type
      */
-    std::string GetNodeType();
+    const std::string &GetNodeType() const;
+
+    /**
+     * \brief Make the node a population.
+     *
+     * The machines of a population are named prefix + index + suffix, with
+     * the index going from firstMember to firstMember + machinesNumber - 1,
+     * as written in the range syntax "prefix[first..last]". The suffix is
+     * empty for a range, the grouped nodes "station_0_c1", "station_1_c1"
+     * have the suffix "_c1".
+     *
+     * \param prefix member name prefix
+     * \param firstMember index of the first member
+     * \param suffix member name suffix
+     */
+    void SetMemberNames(const std::string &prefix, const size_t &firstMember, const std::string &suffix = "");
+
+    /**
+     * \brief Get if the node is a population.
+     * \return true if the machines have their own names
+     */
+    bool IsPopulation();
+
+    /**
+     * \brief Get the member name prefix of a population.
+     * \return member name prefix
+     */
+    const std::string &GetMemberPrefix() const;
+
+    /**
+     * \brief Get the member name suffix of a population.
+     * \return member name suffix
+     */
+    const std::string &GetMemberSuffix() const;
+
+    /**
+     * \brief Get the index of the first member of a population.
+     * \return first member index
+     */
+    size_t GetFirstMember();
+
+    /**
+     * \brief Find a member of the population.
+     * \param name member name
+     * \param number position of the member in the node container
+     * \return true if name is a member of the population
+     */
+    bool FindMember(const std::string &name, size_t &number);
 };
 
 #endif /* NODE_H */
@@ -30,7 +30,7 @@
 
 #include "utils.h"
 
-Ping::Ping(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+Ping::Ping(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->SetAppName(std::string("ping_" + this->GetIndice()));
 }
@@ -49,28 +49,24 @@ std::vector<std::string> Ping::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Ping::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void Ping::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
+  sink.WriteLine(CodeLine(sink) << "InetSocketAddress dst_" << this->GetAppName() << " = InetSocketAddress (iface_" << netDeviceContainer << ".GetAddress(" << numberIntoNetDevice << "));");
+  sink.WriteLine(CodeLine(sink) << "OnOffHelper onoff_" << this->GetAppName() << " = OnOffHelper (\"ns3::Ipv4RawSocketFactory\", dst_" << this->GetAppName() << ");");
+  sink.WriteLine(CodeLine(sink) << "onoff_" << this->GetAppName() << ".SetAttribute (\"OnTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"));");
+  sink.WriteLine(CodeLine(sink) << "onoff_" << this->GetAppName() << ".SetAttribute (\"OffTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"));");
 
-  apps.push_back("InetSocketAddress dst_" + this->GetAppName() + " = InetSocketAddress (iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "));");
-  apps.push_back("OnOffHelper onoff_" + this->GetAppName() + " = OnOffHelper (\"ns3::Ipv4RawSocketFactory\", dst_" + this->GetAppName() + ");");
-  apps.push_back("onoff_" + this->GetAppName() + ".SetAttribute (\"OnTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"));");
-  apps.push_back("onoff_" + this->GetAppName() + ".SetAttribute (\"OffTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"));");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer apps_" << this->GetAppName() << " = onoff_" << this->GetAppName() << ".Install(" << this->GetSenderNode() << ".Get(0));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".1));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".1));");
 
-  apps.push_back("ApplicationContainer apps_" + this->GetAppName() + " = onoff_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".1));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".1));");
+  sink.WriteLine(CodeLine(sink) << "PacketSinkHelper sink_" << this->GetAppName() << " = PacketSinkHelper (\"ns3::Ipv4RawSocketFactory\", dst_" << this->GetAppName() << ");");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << " = sink_" << this->GetAppName() << ".Install (" << this->GetReceiverNode() << ".Get(0));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".2));");
 
-  apps.push_back("PacketSinkHelper sink_" + this->GetAppName() + " = PacketSinkHelper (\"ns3::Ipv4RawSocketFactory\", dst_" + this->GetAppName() + ");");
-  apps.push_back("apps_" + this->GetAppName() + " = sink_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".2));");
-
-  apps.push_back("V4PingHelper ping_" + this->GetAppName() + " = V4PingHelper(iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "));");
-  apps.push_back("apps_" + this->GetAppName() + " = ping_" + this->GetAppName() + ".Install(" + this->GetSenderNode() + ".Get(0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".2));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  return apps;
+  sink.WriteLine(CodeLine(sink) << "V4PingHelper ping_" << this->GetAppName() << " = V4PingHelper(iface_" << netDeviceContainer << ".GetAddress(" << numberIntoNetDevice << "));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << " = ping_" << this->GetAppName() << ".Install(" << this->GetSenderNode() << ".Get(0));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".2));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 }
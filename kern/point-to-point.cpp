@@ -27,11 +27,14 @@
 
 #include "point-to-point.h"
 
-PointToPoint::PointToPoint(const std::string &type, const size_t &indice) : NetworkHardware(type, indice)
+#include "utils.h"
+
+PointToPoint::PointToPoint(SymbolTable &symbols, const std::string &type, const size_t &indice) : NetworkHardware(symbols, type, indice)
 {
   this->SetNetworkHardwareName(std::string("p2p_" + this->GetIndice()));
   this->SetNdcName(std::string("ndc_" + this->GetNetworkHardwareName()));
   this->SetAllNodeContainer(std::string("all_" + this->GetNetworkHardwareName()));
+  this->m_p2pName = this->InternName("p2p_");
 }
 
 PointToPoint::~PointToPoint()
@@ -47,39 +50,30 @@ std::vector<std::string> PointToPoint::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> PointToPoint::GenerateNetworkHardwareCpp()
+void PointToPoint::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> generatedLink;
-
-  generatedLink.push_back("");
-  generatedLink.push_back("PointToPointHelper p2p_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + ".SetDeviceAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("p2p_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\", TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
-
-  return generatedLink;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "PointToPointHelper " << this->GetSymbolName(this->m_p2pName) << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_p2pName) << ".SetDeviceAttribute (\"DataRate\", DataRateValue (" << this->GetDataRate() << "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_p2pName) << ".SetChannelAttribute (\"Delay\", TimeValue (" << CodeTime(this->GetNetworkHardwareDelay()) << "));");
 }
 
-std::vector<std::string> PointToPoint::GenerateNetDeviceCpp()
+void PointToPoint::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = p2p_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
+  this->GroupAsNodeContainerCpp(sink);
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetNdcName() << " = " << this->GetSymbolName(this->m_p2pName) << ".Install (" << this->GetAllNodeContainer() << ");");
 }
 
-std::vector<std::string> PointToPoint::GenerateTraceCpp()
+void PointToPoint::GenerateTraceCpp(CodeSink &sink)
 {
-  std::vector<std::string> trace;
-
   if(this->GetTrace())
   {
-    trace.push_back("p2p_" + this->GetNetworkHardwareName() + ".EnablePcapAll (\"" + this->GetNetworkHardwareName() + "\");");
+    sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_p2pName) << ".EnablePcapAll (\"" << this->GetNetworkHardwareName() << "\");");
   }
+}
 
-  return trace;
+NetworkHardware::TableHelper PointToPoint::GetTableHelper(std::string &helperName) const
+{
+  helperName = this->GetSymbolName(this->m_p2pName);
+  return TABLE_HELPER_P2P;
 }
@@ -49,13 +49,20 @@
  */
 class PointToPoint : public NetworkHardware
 {
+  private:
+    /**
+     * \brief Point-to-point helper name.
+     */
+    Symbol m_p2pName;
+
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice point-to-point number into the link generator vector
      * \param type link type
      */
-    PointToPoint(const std::string &type, const size_t &indice);
+    PointToPoint(SymbolTable &symbols, const std::string &type, const size_t &indice);
 
     /**
      * \brief Destructor.
@@ -71,21 +78,28 @@ class PointToPoint : public NetworkHardware
 
     /**
      * \brief Generate link C++ code.
-     * \return link code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate net device container C++ code.
-     * \return net device container code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Generate trace line C++ code.
-     * \return trace line code
+     * \param sink sink of the code
+     */
+    virtual void GenerateTraceCpp(CodeSink &sink);
+
+    /**
+     * \brief Get the helper building the link from a row of the link table.
+     * \param helperName set to the name of the helper of the link
+     * \return TABLE_HELPER_P2P
      */
-    virtual std::vector<std::string> GenerateTraceCpp();
+    virtual TableHelper GetTableHelper(std::string &helperName) const;
     
 };
 
@@ -0,0 +1,190 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file population-index.cpp
+ * \brief Index of the member names of node populations.
+ */
+
+#include "population-index.h"
+
+/**
+ * \brief Get the key of a prefix and a suffix, '\\0' is not part of a name.
+ * \param prefix member name prefix
+ * \param suffix member name suffix
+ * \return key
+ */
+static std::string IntervalsKey(const std::string &prefix, const std::string &suffix)
+{
+  std::string key;
+  key.reserve(prefix.size() + 1 + suffix.size());
+  key.append(prefix);
+  key.push_back('\0');
+  key.append(suffix);
+  return key;
+}
+
+/**
+ * \brief Find the next run of digits of a name written as a member index.
+ *
+ * The index of a member is written in decimal without leading zero, a run
+ * which is not is skipped.
+ *
+ * \param name name
+ * \param begin position to search from, set to the start of the run
+ * \param end set to the end of the run
+ * \param number value of the run
+ * \return false if there is no more run
+ */
+static bool NextMemberIndex(const std::string &name, size_t &begin, size_t &end, size_t &number)
+{
+  while(begin < name.size())
+  {
+    while(begin < name.size() && (name[begin] < '0' || name[begin] > '9'))
+    {
+      begin++;
+    }
+    end = begin;
+    number = 0;
+    bool valid = true;
+    while(end < name.size() && name[end] >= '0' && name[end] <= '9')
+    {
+      if(number > (static_cast<size_t>(-1) - (name[end] - '0')) / 10)
+      {
+        valid = false;
+      }
+      number = number * 10 + (name[end] - '0');
+      end++;
+    }
+    if(end > begin && valid && (name[begin] != '0' || end == begin + 1))
+    {
+      return true;
+    }
+    begin = end;
+  }
+
+  return false;
+}
+
+PopulationIndex::PopulationIndex()
+{
+  this->m_size = 0;
+}
+
+PopulationIndex::~PopulationIndex()
+{
+}
+
+const PopulationIndex::Intervals *PopulationIndex::FindIntervals(const std::string &prefix, const std::string &suffix) const
+{
+  size_t k = 0;
+  if(!this->m_keys.Find(IntervalsKey(prefix, suffix), k))
+  {
+    return 0;
+  }
+
+  return &this->m_intervals[k];
+}
+
+bool PopulationIndex::Insert(const std::string &prefix, const std::string &suffix, const size_t first, const size_t last, const size_t handle)
+{
+  size_t overlap = 0;
+  if(this->FindOverlap(prefix, suffix, first, last, overlap))
+  {
+    return false;
+  }
+
+  size_t k = this->m_intervals.size();
+  if(!this->m_keys.Insert(IntervalsKey(prefix, suffix), k))
+  {
+    this->m_keys.Find(IntervalsKey(prefix, suffix), k);
+  }
+  else
+  {
+    this->m_intervals.push_back(Intervals());
+  }
+
+  Interval &interval = this->m_intervals[k][first];
+  interval.last = last;
+  interval.handle = handle;
+  this->m_size++;
+  return true;
+}
+
+void PopulationIndex::InsertName(const std::string &name, const size_t handle)
+{
+  size_t begin = 0;
+  size_t end = 0;
+  size_t number = 0;
+  while(NextMemberIndex(name, begin, end, number))
+  {
+    this->Insert(name.substr(0, begin), name.substr(end), number, number, handle);
+    begin = end;
+  }
+}
+
+bool PopulationIndex::Find(const std::string &name, size_t &handle) const
+{
+  if(this->m_size == 0)
+  {
+    return false;
+  }
+
+  size_t begin = 0;
+  size_t end = 0;
+  size_t number = 0;
+  while(NextMemberIndex(name, begin, end, number))
+  {
+    if(this->FindOverlap(name.substr(0, begin), name.substr(end), number, number, handle))
+    {
+      return true;
+    }
+    begin = end;
+  }
+
+  return false;
+}
+
+bool PopulationIndex::FindOverlap(const std::string &prefix, const std::string &suffix, const size_t first, const size_t last, size_t &handle) const
+{
+  const Intervals *intervals = this->FindIntervals(prefix, suffix);
+  if(!intervals)
+  {
+    return false;
+  }
+
+  /* the intervals are disjoint: only the last one starting before "last" may reach "first". */
+  Intervals::const_iterator it = intervals->upper_bound(last);
+  if(it == intervals->begin())
+  {
+    return false;
+  }
+  --it;
+  if(it->second.last < first)
+  {
+    return false;
+  }
+
+  handle = it->second.handle;
+  return true;
+}
+
+size_t PopulationIndex::GetSize() const
+{
+  return this->m_size;
+}
@@ -0,0 +1,150 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file population-index.h
+ * \brief Index of the member names of node populations.
+ */
+
+#ifndef POPULATION_INDEX_H
+#define POPULATION_INDEX_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "name-index.h"
+
+/**
+ * \ingroup generator
+ * \brief Index of the member names of node populations.
+ *
+ *  A population of members named prefix + index + suffix, for the indexes
+ *  first to last, is one interval whatever its size. The intervals of a
+ *  prefix and a suffix are kept in a map ordered by their first index, so
+ *  finding the population of a member name is parsing a run of digits of
+ *  the name and looking the number up among the intervals of the prefix
+ *  and suffix around it.
+ *
+ *  A single name can be indexed too, as a member of one index of every
+ *  prefix and suffix it could be split in: a population is then checked
+ *  against the names of its members without spelling them out.
+ */
+class PopulationIndex
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    PopulationIndex();
+
+    /**
+     * \brief Destructor.
+     */
+    ~PopulationIndex();
+
+    /**
+     * \brief Index a population.
+     * \param prefix member name prefix
+     * \param suffix member name suffix
+     * \param first first member index
+     * \param last last member index
+     * \param handle population handle
+     * \return false if the population overlaps an indexed one (the index is unchanged)
+     */
+    bool Insert(const std::string &prefix, const std::string &suffix, const size_t first, const size_t last, const size_t handle);
+
+    /**
+     * \brief Index a single name, at each run of digits it holds.
+     * \param name name
+     * \param handle name handle
+     */
+    void InsertName(const std::string &name, const size_t handle);
+
+    /**
+     * \brief Find the population a name is a member of.
+     * \param name member name
+     * \param handle population handle
+     * \return false if the name is not a member of an indexed population
+     */
+    bool Find(const std::string &name, size_t &handle) const;
+
+    /**
+     * \brief Find a population, or a single name, overlapping the members of a population.
+     * \param prefix member name prefix
+     * \param suffix member name suffix
+     * \param first first member index
+     * \param last last member index
+     * \param handle handle of the overlapping population or name
+     * \return false if no indexed member has the name of one of these members
+     */
+    bool FindOverlap(const std::string &prefix, const std::string &suffix, const size_t first, const size_t last, size_t &handle) const;
+
+    /**
+     * \brief Get the number of indexed populations and names.
+     * \return number of intervals
+     */
+    size_t GetSize() const;
+
+  private:
+    /**
+     * \brief Members of a population, from its first index (the key of the map).
+     */
+    struct Interval
+    {
+      /**
+       * \brief Last member index.
+       */
+      size_t last;
+
+      /**
+       * \brief Population handle.
+       */
+      size_t handle;
+    };
+
+    /**
+     * \brief Intervals of a prefix and a suffix by first index.
+     */
+    typedef std::map<size_t, Interval> Intervals;
+
+    /**
+     * \brief Get the intervals of a prefix and a suffix.
+     * \param prefix member name prefix
+     * \param suffix member name suffix
+     * \return intervals, null if there is none
+     */
+    const Intervals *FindIntervals(const std::string &prefix, const std::string &suffix) const;
+
+    /**
+     * \brief Index of the prefix and suffix pairs, to their position in m_intervals.
+     */
+    NameIndex m_keys;
+
+    /**
+     * \brief Intervals of each prefix and suffix pair.
+     */
+    std::vector<Intervals> m_intervals;
+
+    /**
+     * \brief Number of intervals.
+     */
+    size_t m_size;
+};
+
+#endif /* POPULATION_INDEX_H */
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file symbol-table.cpp
+ * \brief Interned identifiers of the generated code.
+ */
+
+#include "symbol-table.h"
+#include "utils.h"
+
+/**
+ * \brief Free slot.
+ */
+static const Symbol NO_SYMBOL = 0xffffffff;
+
+SymbolTable::SymbolTable()
+{
+}
+
+SymbolTable::~SymbolTable()
+{
+}
+
+size_t SymbolTable::Probe(const std::string &name, const uint64_t hash) const
+{
+  size_t mask = this->m_slots.size() - 1;
+  size_t i = static_cast<size_t>(hash) & mask;
+  while(this->m_slots[i] != NO_SYMBOL && (this->m_hashes[this->m_slots[i]] != hash || this->m_names[this->m_slots[i]] != name))
+  {
+    i = (i + 1) & mask;
+  }
+
+  return i;
+}
+
+void SymbolTable::Grow(const size_t nSlots)
+{
+  std::vector<Symbol> slots(nSlots, NO_SYMBOL);
+  slots.swap(this->m_slots);
+
+  size_t mask = this->m_slots.size() - 1;
+  for(Symbol symbol = 0; symbol < this->m_names.size(); symbol++)
+  {
+    size_t i = static_cast<size_t>(this->m_hashes[symbol]) & mask;
+    while(this->m_slots[i] != NO_SYMBOL)
+    {
+      i = (i + 1) & mask;
+    }
+    this->m_slots[i] = symbol;
+  }
+}
+
+Symbol SymbolTable::Intern(const std::string &name)
+{
+  if(2 * (this->m_names.size() + 1) > this->m_slots.size())
+  {
+    this->Grow(this->m_slots.empty() ? 64 : this->m_slots.size() * 2);
+  }
+
+  uint64_t hash = utils::hashBytes(name.data(), name.size());
+  Symbol &slot = this->m_slots[this->Probe(name, hash)];
+  if(slot == NO_SYMBOL)
+  {
+    slot = static_cast<Symbol>(this->m_names.size());
+    this->m_names.push_back(name);
+    this->m_hashes.push_back(hash);
+  }
+
+  return slot;
+}
+
+Symbol SymbolTable::Intern(const std::string &prefix, const Symbol symbol)
+{
+  this->m_buffer.assign(prefix);
+  this->m_buffer.append(this->m_names[symbol]);
+
+  return this->Intern(this->m_buffer);
+}
+
+const std::string &SymbolTable::GetName(const Symbol symbol) const
+{
+  return this->m_names[symbol];
+}
+
+size_t SymbolTable::GetSize() const
+{
+  return this->m_names.size();
+}
+
+void SymbolTable::Reserve(const size_t nNames)
+{
+  size_t nSlots = this->m_slots.empty() ? 64 : this->m_slots.size();
+  while(2 * nNames > nSlots)
+  {
+    nSlots *= 2;
+  }
+  if(nSlots > this->m_slots.size())
+  {
+    this->Grow(nSlots);
+  }
+  this->m_hashes.reserve(nNames);
+}
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file symbol-table.h
+ * \brief Interned identifiers of the generated code.
+ */
+
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Id of an interned identifier.
+ */
+typedef uint32_t Symbol;
+
+/**
+ * \ingroup generator
+ * \brief Interned identifiers of the generated code.
+ *
+ *  Every node, container and helper name of a topology is held once by the
+ *  table, the model classes keep its symbol. The names never move, the
+ *  references returned by GetName stay valid as long as the table. The
+ *  lookup is an open addressing table of symbols, probed with the hash of
+ *  the name, which doubles when it is half full.
+ */
+class SymbolTable
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    SymbolTable();
+
+    /**
+     * \brief Destructor.
+     */
+    ~SymbolTable();
+
+    /**
+     * \brief Intern a name.
+     * \param name name
+     * \return symbol of the name, the same for equal names
+     */
+    Symbol Intern(const std::string &name);
+
+    /**
+     * \brief Intern a name made of a prefix and another symbol.
+     *
+     * Used for the identifiers derived from an element name, "ndc_" + "ap_0".
+     * \param prefix prefix
+     * \param symbol symbol following the prefix
+     * \return symbol of prefix + name of symbol
+     */
+    Symbol Intern(const std::string &prefix, const Symbol symbol);
+
+    /**
+     * \brief Get the name of a symbol.
+     * \param symbol symbol
+     * \return name
+     */
+    const std::string &GetName(const Symbol symbol) const;
+
+    /**
+     * \brief Get the number of symbols.
+     * \return number of names interned
+     */
+    size_t GetSize() const;
+
+    /**
+     * \brief Size the table for a number of symbols.
+     * \param nNames number of names, interned or not
+     */
+    void Reserve(const size_t nNames);
+
+  private:
+    /**
+     * \brief Find the slot of a name, or the free slot ending its probe sequence.
+     * \param name name
+     * \param hash hash of the name
+     * \return slot index
+     */
+    size_t Probe(const std::string &name, const uint64_t hash) const;
+
+    /**
+     * \brief Rehash the symbols in more slots.
+     * \param nSlots new number of slots, a power of 2
+     */
+    void Grow(const size_t nSlots);
+
+    /**
+     * \brief Names, by symbol.
+     */
+    std::deque<std::string> m_names;
+
+    /**
+     * \brief Hash of the names, by symbol.
+     */
+    std::vector<uint64_t> m_hashes;
+
+    /**
+     * \brief Slots holding a symbol or NO_SYMBOL, the size is 0 or a power of 2.
+     */
+    std::vector<Symbol> m_slots;
+
+    /**
+     * \brief Buffer of the derived names being interned.
+     */
+    std::string m_buffer;
+};
+
+#endif /* SYMBOL_TABLE_H */
@@ -27,7 +27,9 @@
 
 #include "tap.h"
 
-Tap::Tap(const std::string &type, const size_t &indice, const std::string &tapNode, const std::string &ifaceName) : NetworkHardware(type, indice)
+#include "utils.h"
+
+Tap::Tap(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &tapNode, const std::string &ifaceName) : NetworkHardware(symbols, type, indice)
 {
   this->Install(tapNode);
   this->m_tapNode = tapNode;
@@ -35,35 +37,28 @@ Tap::Tap(const std::string &type, const size_t &indice, const std::string &tapNo
   this->SetNetworkHardwareName(std::string("tap_" + this->GetIndice()));
   this->SetNdcName(std::string("ndc_" + this->GetNetworkHardwareName()));
   this->SetAllNodeContainer(std::string("all_" + this->GetNetworkHardwareName()));
+  this->m_csmaName = this->InternName("csma_");
+  this->m_tapBridgeName = this->InternName("tapBridge_");
+  this->m_modeName = this->InternName("mode_");
+  this->m_tapDeviceName = this->InternName("tapName_");
 }
 
 Tap::~Tap()
 {
 }
 
-std::vector<std::string> Tap::GenerateNetDeviceCpp()
+void Tap::GenerateNetDeviceCpp(CodeSink &sink)
 {
-  std::vector<std::string> ndc;
-  std::vector<std::string> allNodes = this->GroupAsNodeContainerCpp();
-  for(size_t i = 0; i <  allNodes.size(); i++)
-  {
-    ndc.push_back(allNodes.at(i));
-  }
-  ndc.push_back("NetDeviceContainer " + this->GetNdcName() + " = csma_" + this->GetNetworkHardwareName() + ".Install (" + this->GetAllNodeContainer() + ");");
-
-  return ndc;
+  this->GroupAsNodeContainerCpp(sink);
+  sink.WriteLine(CodeLine(sink) << "NetDeviceContainer " << this->GetNdcName() << " = " << this->GetSymbolName(this->m_csmaName) << ".Install (" << this->GetAllNodeContainer() << ");");
 }
 
-std::vector<std::string> Tap::GenerateTapBridgeCpp()
+void Tap::GenerateTapBridgeCpp(CodeSink &sink)
 {
-  std::vector<std::string> tapBridge;
-
-  tapBridge.push_back("TapBridgeHelper tapBridge_" + this->GetNetworkHardwareName() + " (iface_" + this->GetNdcName() + ".GetAddress(1));");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".SetAttribute (\"Mode\", StringValue (mode_" + this->GetNetworkHardwareName() + "));");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".SetAttribute (\"DeviceName\", StringValue (tapName_" + this->GetNetworkHardwareName() + "));");
-  tapBridge.push_back("tapBridge_" + this->GetNetworkHardwareName() + ".Install (" + this->m_tapNode + ".Get(0), " + this->GetNdcName() + ".Get(0));");
-
-  return tapBridge;
+  sink.WriteLine(CodeLine(sink) << "TapBridgeHelper " << this->GetSymbolName(this->m_tapBridgeName) << " (iface_" << this->GetNdcName() << ".GetAddress(1));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_tapBridgeName) << ".SetAttribute (\"Mode\", StringValue (" << this->GetSymbolName(this->m_modeName) << "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_tapBridgeName) << ".SetAttribute (\"DeviceName\", StringValue (" << this->GetSymbolName(this->m_tapDeviceName) << "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_tapBridgeName) << ".Install (" << this->m_tapNode << ".Get(0), " << this->GetNdcName() << ".Get(0));");
 }
 
 std::string Tap::GetTapName()
@@ -86,12 +81,10 @@ void Tap::SetIfaceName(const std::string &ifaceName)
   this->m_ifaceName = ifaceName;
 }
 
-std::vector<std::string> Tap::GenerateVarsCpp()
+void Tap::GenerateVarsCpp(CodeSink &sink)
 {
-  std::vector<std::string> vars;
-  vars.push_back("std::string mode_" + this->GetNetworkHardwareName() + " = \"ConfigureLocal\";");
-  vars.push_back("std::string tapName_" + this->GetNetworkHardwareName() + " = \"" + this->m_ifaceName + "\";");
-  return vars;
+  sink.WriteLine(CodeLine(sink) << "std::string " << this->GetSymbolName(this->m_modeName) << " = \"ConfigureLocal\";");
+  sink.WriteLine(CodeLine(sink) << "std::string " << this->GetSymbolName(this->m_tapDeviceName) << " = \"" << this->m_ifaceName << "\";");
 }
 
 std::vector<std::string> Tap::GenerateHeader()
@@ -104,22 +97,16 @@ std::vector<std::string> Tap::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> Tap::GenerateNetworkHardwareCpp()
+void Tap::GenerateNetworkHardwareCpp(CodeSink &sink)
 {
-  std::vector<std::string> generatedLink;
-
-  generatedLink.push_back("");
-  generatedLink.push_back("CsmaHelper csma_" + this->GetNetworkHardwareName() + ";");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"DataRate\", DataRateValue (" + this->GetDataRate() + "));");
-  generatedLink.push_back("csma_" + this->GetNetworkHardwareName() + ".SetChannelAttribute (\"Delay\", TimeValue (MilliSeconds (" + this->GetNetworkHardwareDelay() + ")));");
-
-  return generatedLink;
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "CsmaHelper " << this->GetSymbolName(this->m_csmaName) << ";");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".SetChannelAttribute (\"DataRate\", DataRateValue (" << this->GetDataRate() << "));");
+  sink.WriteLine(CodeLine(sink) << this->GetSymbolName(this->m_csmaName) << ".SetChannelAttribute (\"Delay\", TimeValue (" << CodeTime(this->GetNetworkHardwareDelay()) << "));");
 }
 
-std::vector<std::string> Tap::GenerateCmdLineCpp()
+void Tap::GenerateCmdLineCpp(CodeSink &sink)
 {
-  std::vector<std::string> cmdLine;
-  cmdLine.push_back("cmd.AddValue (\"mode_" + this->GetNetworkHardwareName() + "\", \"Mode Setting of TapBridge\", mode_" + this->GetNetworkHardwareName() + ");");
-  cmdLine.push_back("cmd.AddValue (\"tapName_" + this->GetNetworkHardwareName() + "\", \"Name of the OS tap device\", tapName_" + this->GetNetworkHardwareName() + ");");
-  return cmdLine;
+  sink.WriteLine(CodeLine(sink) << "cmd.AddValue (\"" << this->GetSymbolName(this->m_modeName) << "\", \"Mode Setting of TapBridge\", " << this->GetSymbolName(this->m_modeName) << ");");
+  sink.WriteLine(CodeLine(sink) << "cmd.AddValue (\"" << this->GetSymbolName(this->m_tapDeviceName) << "\", \"Name of the OS tap device\", " << this->GetSymbolName(this->m_tapDeviceName) << ");");
 }
@@ -72,15 +72,36 @@ class Tap : public NetworkHardware
      */
     std::string m_ifaceName;
 
+    /**
+     * \brief Csma helper name.
+     */
+    Symbol m_csmaName;
+
+    /**
+     * \brief Tap bridge helper name.
+     */
+    Symbol m_tapBridgeName;
+
+    /**
+     * \brief Mode variable.
+     */
+    Symbol m_modeName;
+
+    /**
+     * \brief Device name variable.
+     */
+    Symbol m_tapDeviceName;
+
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param indice tap number
      * \param tapNode external linux host
      * \param ifaceName iface name
      * \param type link type
      */
-    Tap(const std::string &type, const size_t &indice, const std::string &tapNode, const std::string &ifaceName);
+    Tap(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &tapNode, const std::string &ifaceName);
 
     /**
      * \brief Destructor.
@@ -119,33 +140,33 @@ class Tap : public NetworkHardware
 
     /**
      * \brief Generate link C++ code.
-     * \return link code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetworkHardwareCpp();
+    virtual void GenerateNetworkHardwareCpp(CodeSink &sink);
 
     /**
      * \brief Generate net device container C++ code.
-     * \return net device container code
+     * \param sink sink of the code
      */
-    virtual std::vector<std::string> GenerateNetDeviceCpp();
+    virtual void GenerateNetDeviceCpp(CodeSink &sink);
 
     /**
      * \brief Function re-writted from link main class.
-     * \return tap bridge code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateTapBridgeCpp();
+    void GenerateTapBridgeCpp(CodeSink &sink);
 
     /**
      * \brief Function re-writted from link main class.
-     * \return vars code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateVarsCpp();
+    void GenerateVarsCpp(CodeSink &sink);
 
     /**
      * \brief Function re-wrotted from link main class.
-     * \return cmd line code
+     * \param sink sink of the code
      */
-    std::vector<std::string> GenerateCmdLineCpp();
+    void GenerateCmdLineCpp(CodeSink &sink);
     
 };
 
@@ -30,7 +30,7 @@
 
 #include "utils.h"
 
-TcpLargeTransfer::TcpLargeTransfer(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+TcpLargeTransfer::TcpLargeTransfer(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->m_port = port;
   this->SetAppName(std::string("tcp_" + this->GetIndice()));
@@ -57,28 +57,24 @@ void TcpLargeTransfer::SetPort(const size_t &port)
   this->m_port = port;
 }
 
-std::vector<std::string> TcpLargeTransfer::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void TcpLargeTransfer::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
+  sink.WriteLine(CodeLine(sink) << "uint16_t port_" << this->GetAppName() << " = " << this->m_port << ";");
+  sink.WriteLine(CodeLine(sink) << "Address sinkLocalAddress_" << this->GetAppName() << " (InetSocketAddress (Ipv4Address::GetAny (), port_" << this->GetAppName() << "));");
+  sink.WriteLine(CodeLine(sink) << "PacketSinkHelper sinkHelper_" << this->GetAppName() << " (\"ns3::TcpSocketFactory\", sinkLocalAddress_" << this->GetAppName() << ");");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer sinkApp_" << this->GetAppName() << " = sinkHelper_" << this->GetAppName() << ".Install (" << this->GetReceiverNode() << ");");
+  sink.WriteLine(CodeLine(sink) << "sinkApp_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "sinkApp_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 
-  apps.push_back("uint16_t port_" + this->GetAppName() + " = " + utils::integerToString(this->m_port) + ";");
-  apps.push_back("Address sinkLocalAddress_" + this->GetAppName() + " (InetSocketAddress (Ipv4Address::GetAny (), port_" + this->GetAppName() + "));");
-  apps.push_back("PacketSinkHelper sinkHelper_" + this->GetAppName() + " (\"ns3::TcpSocketFactory\", sinkLocalAddress_" + this->GetAppName() + ");");
-  apps.push_back("ApplicationContainer sinkApp_" + this->GetAppName() + " = sinkHelper_" + this->GetAppName() + ".Install (" + this->GetReceiverNode() + ");");
-  apps.push_back("sinkApp_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("sinkApp_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
+  sink.WriteLine(CodeLine(sink) << "OnOffHelper clientHelper_" << this->GetAppName() << " (\"ns3::TcpSocketFactory\", Address ());");
+  sink.WriteLine(CodeLine(sink) << "clientHelper_" << this->GetAppName() << ".SetAttribute (\"OnTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"));");
+  sink.WriteLine(CodeLine(sink) << "clientHelper_" << this->GetAppName() << ".SetAttribute (\"OffTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"));");
 
-  apps.push_back("OnOffHelper clientHelper_" + this->GetAppName() + " (\"ns3::TcpSocketFactory\", Address ());");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute (\"OnTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=1]\"));");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute (\"OffTime\", StringValue (\"ns3::ConstantRandomVariable[Constant=0]\"));");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer clientApps_" << this->GetAppName() << ";");
+  sink.WriteLine(CodeLine(sink) << "AddressValue remoteAddress_" << this->GetAppName() << " (InetSocketAddress (iface_" << netDeviceContainer << ".GetAddress (" << numberIntoNetDevice << "), port_" << this->GetAppName() << "));");
+  sink.WriteLine(CodeLine(sink) << "clientHelper_" << this->GetAppName() << ".SetAttribute (\"Remote\", remoteAddress_" << this->GetAppName() << ");");
+  sink.WriteLine(CodeLine(sink) << "clientApps_" << this->GetAppName() << ".Add (clientHelper_" << this->GetAppName() << ".Install (" << this->GetSenderNode() << "));");
 
-  apps.push_back("ApplicationContainer clientApps_" + this->GetAppName() + ";");
-  apps.push_back("AddressValue remoteAddress_" + this->GetAppName() + " (InetSocketAddress (iface_" + netDeviceContainer + ".GetAddress (" + utils::integerToString(numberIntoNetDevice) + "), port_" + this->GetAppName() + "));");
-  apps.push_back("clientHelper_" + this->GetAppName() + ".SetAttribute (\"Remote\", remoteAddress_" + this->GetAppName() + ");");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Add (clientHelper_" + this->GetAppName() + ".Install (" + this->GetSenderNode() + "));");
-
-  apps.push_back("clientApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  return apps;
+  sink.WriteLine(CodeLine(sink) << "clientApps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "clientApps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 }
@@ -57,6 +57,7 @@ class TcpLargeTransfer : public Application
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param type application type
      * \param indice number of the application on the generator applicaiton vector
      * \param senderNode sender node
@@ -65,7 +66,7 @@ class TcpLargeTransfer : public Application
      * \param endTime application end time
      * \param port port which are sended the traffic
      */
-    TcpLargeTransfer(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port);
+    TcpLargeTransfer(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port);
 
     /**
      * \brief Destructor.
@@ -80,11 +81,11 @@ class TcpLargeTransfer : public Application
 
     /**
      * \brief Generate application C++ code.
+     * \param sink sink of the code
      * \param netDeviceContainer net device container
      * \param numberIntoNetDevice number of the sender node into the net device container
-     * \return the ns3 application code
      */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice);
+    virtual void GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice);
 
     /**
      * \brief Get port.
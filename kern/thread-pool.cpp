@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file thread-pool.cpp
+ * \brief Run independent tasks on several threads.
+ */
+
+#include <unistd.h>
+
+#include <stdexcept>
+
+#include "thread-pool.h"
+
+ThreadTask::~ThreadTask()
+{
+}
+
+/**
+ * \brief Argument of a pool thread.
+ */
+struct ThreadPoolWorker
+{
+  ThreadPool *pool; /**< pool */
+  size_t index;     /**< index of the thread queue */
+};
+
+ThreadPool::ThreadPool(const size_t nThreads)
+{
+  this->m_nThreads = nThreads;
+  if(this->m_nThreads == 0)
+  {
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    this->m_nThreads = n > 0 ? n : 1;
+  }
+  this->m_tasks = 0;
+  this->m_queues = new Queue[this->m_nThreads];
+  for(size_t i = 0; i < this->m_nThreads; i++)
+  {
+    pthread_mutex_init(&this->m_queues[i].mutex, 0);
+    this->m_queues[i].begin = 0;
+    this->m_queues[i].end = 0;
+  }
+}
+
+ThreadPool::~ThreadPool()
+{
+  for(size_t i = 0; i < this->m_nThreads; i++)
+  {
+    pthread_mutex_destroy(&this->m_queues[i].mutex);
+  }
+  delete[] this->m_queues;
+}
+
+size_t ThreadPool::GetNThreads() const
+{
+  return this->m_nThreads;
+}
+
+void *ThreadPool::Work(void *worker)
+{
+  ThreadPoolWorker *w = static_cast<ThreadPoolWorker*>(worker);
+  w->pool->RunTasks(w->index);
+  return 0;
+}
+
+bool ThreadPool::NextTask(const size_t self, size_t &task)
+{
+  Queue &own = this->m_queues[self];
+
+  pthread_mutex_lock(&own.mutex);
+  bool found = own.begin < own.end;
+  if(found)
+  {
+    task = own.begin++;
+  }
+  pthread_mutex_unlock(&own.mutex);
+  if(found)
+  {
+    return true;
+  }
+
+  /* steal the second half of the first queue not empty. */
+  for(size_t k = 1; k < this->m_nThreads; k++)
+  {
+    Queue &victim = this->m_queues[(self + k) % this->m_nThreads];
+    size_t begin = 0;
+    size_t end = 0;
+
+    pthread_mutex_lock(&victim.mutex);
+    if(victim.begin < victim.end)
+    {
+      end = victim.end;
+      begin = end - (victim.end - victim.begin + 1) / 2;
+      victim.end = begin;
+    }
+    pthread_mutex_unlock(&victim.mutex);
+
+    if(begin < end)
+    {
+      pthread_mutex_lock(&own.mutex);
+      own.begin = begin + 1;
+      own.end = end;
+      pthread_mutex_unlock(&own.mutex);
+      task = begin;
+      return true;
+    }
+  }
+
+  /* no task is ever added, every queue is empty: the work is done. */
+  return false;
+}
+
+void ThreadPool::RunTasks(const size_t self)
+{
+  size_t i = 0;
+  while(this->NextTask(self, i))
+  {
+    /* each task has its own error slot, no lock needed. */
+    try
+    {
+      this->m_tasks->at(i)->Run();
+    }
+    catch(const std::exception &e)
+    {
+      this->m_errors.at(i) = e.what();
+    }
+    catch(...)
+    {
+      this->m_errors.at(i) = "unknown error";
+    }
+  }
+}
+
+void ThreadPool::Run(const std::vector<ThreadTask*> &tasks)
+{
+  this->m_tasks = &tasks;
+  this->m_errors.assign(tasks.size(), std::string());
+
+  /* each thread starts with a contiguous share of the tasks. */
+  size_t nThreads = this->m_nThreads < tasks.size() ? this->m_nThreads : tasks.size();
+  for(size_t i = 0; i < this->m_nThreads; i++)
+  {
+    this->m_queues[i].begin = i < nThreads ? tasks.size() * i / nThreads : 0;
+    this->m_queues[i].end = i < nThreads ? tasks.size() * (i + 1) / nThreads : 0;
+  }
+
+  /* the caller is the first worker, the tasks of a thread which cannot be
+   * started are stolen by the others. */
+  std::vector<ThreadPoolWorker> workers(nThreads);
+  std::vector<pthread_t> threads;
+  for(size_t i = 1; i < nThreads; i++)
+  {
+    pthread_t thread;
+    workers.at(i).pool = this;
+    workers.at(i).index = i;
+    if(pthread_create(&thread, 0, &ThreadPool::Work, &workers.at(i)) == 0)
+    {
+      threads.push_back(thread);
+    }
+  }
+  if(nThreads > 0)
+  {
+    this->RunTasks(0);
+  }
+  for(size_t i = 0; i < threads.size(); i++)
+  {
+    pthread_join(threads.at(i), 0);
+  }
+  this->m_tasks = 0;
+
+  for(size_t i = 0; i < this->m_errors.size(); i++)
+  {
+    if(!this->m_errors.at(i).empty())
+    {
+      throw std::runtime_error(this->m_errors.at(i));
+    }
+  }
+}
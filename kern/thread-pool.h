@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file thread-pool.h
+ * \brief Run independent tasks on several threads.
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Work item of a ThreadPool.
+ */
+class ThreadTask
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~ThreadTask();
+
+    /**
+     * \brief Do the work, called from one of the pool threads.
+     */
+    virtual void Run() = 0;
+};
+
+/**
+ * \ingroup generator
+ * \brief Run independent tasks on several threads.
+ *
+ *  Each thread starts with its own contiguous share of the tasks; a thread
+ *  which runs out of work steals the second half of the remaining tasks of
+ *  another one, so long tasks do not hold back the others and the threads
+ *  rarely contend for the same queue. An exception thrown by a task is kept
+ *  and thrown again by Run() once all the tasks are done.
+ */
+class ThreadPool
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param nThreads number of threads, 0 for one per processor
+     */
+    ThreadPool(const size_t nThreads);
+
+    /**
+     * \brief Destructor.
+     */
+    ~ThreadPool();
+
+    /**
+     * \brief Get the number of threads.
+     * \return number of threads
+     */
+    size_t GetNThreads() const;
+
+    /**
+     * \brief Run tasks and wait for their completion.
+     *
+     * The caller runs tasks too, with a single thread it runs them all.
+     *
+     * \param tasks tasks to run
+     * \throw std::runtime_error with the message of the first task (in the
+     * tasks order) which failed
+     */
+    void Run(const std::vector<ThreadTask*> &tasks);
+
+  private:
+    /**
+     * \brief Copy constructor (not implemented).
+     */
+    ThreadPool(const ThreadPool &);
+
+    /**
+     * \brief Assignment (not implemented).
+     */
+    ThreadPool &operator=(const ThreadPool &);
+
+    /**
+     * \brief Tasks of a thread, [begin, end) in the tasks vector.
+     */
+    struct Queue
+    {
+      pthread_mutex_t mutex; /**< protect begin and end */
+      size_t begin;          /**< next task to run */
+      size_t end;            /**< end of the tasks */
+    };
+
+    /**
+     * \brief Thread entry point.
+     * \param worker a ThreadPoolWorker
+     * \return NULL
+     */
+    static void *Work(void *worker);
+
+    /**
+     * \brief Get the next task of a thread, stealing it if needed.
+     * \param self thread index
+     * \param task index of the task to run
+     * \return false when no task is left
+     */
+    bool NextTask(const size_t self, size_t &task);
+
+    /**
+     * \brief Run tasks until none is left.
+     * \param self thread index
+     */
+    void RunTasks(const size_t self);
+
+    /**
+     * \brief Number of threads.
+     */
+    size_t m_nThreads;
+
+    /**
+     * \brief Task queue of each thread.
+     */
+    Queue *m_queues;
+
+    /**
+     * \brief Tasks being run.
+     */
+    const std::vector<ThreadTask*> *m_tasks;
+
+    /**
+     * \brief Error message of each task, empty if it succeeded.
+     */
+    std::vector<std::string> m_errors;
+};
+
+#endif /* THREAD_POOL_H */
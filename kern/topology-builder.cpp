@@ -0,0 +1,614 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-builder.cpp
+ * \brief Populate a Generator from topology element descriptions.
+ */
+
+#include <iostream>
+#include <stdexcept>
+
+#include "topology-builder.h"
+#include "generator.h"
+#include "network-hardware.h"
+#include "node.h"
+#include "utils.h"
+
+TopologyBuilder::TopologyBuilder(Generator *gen)
+{
+  this->m_gen = gen;
+  this->m_verbose = false;
+  this->m_warned = false;
+  this->m_grouping = false;
+  this->m_runSize = 0;
+  this->m_runFirst = 0;
+}
+
+TopologyBuilder::~TopologyBuilder()
+{
+}
+
+void TopologyBuilder::SetVerbose(const bool &verbose)
+{
+  this->m_verbose = verbose;
+}
+
+void TopologyBuilder::SetNodeGrouping(const bool &grouping)
+{
+  this->FlushRun();
+  this->m_grouping = grouping;
+}
+
+void TopologyBuilder::Finish()
+{
+  this->FlushRun();
+}
+
+void TopologyBuilder::KeepNode(const std::string &name)
+{
+  this->m_kept.insert(name);
+}
+
+bool TopologyBuilder::ParseBoolean(const std::string &text, const char *element)
+{
+  bool value = false;
+  if(!utils::parseBoolean(text, value) && !this->m_warned)
+  {
+    std::cerr << "Warning: <" << element << ">" << text << "</" << element << "> is read as false, only true is true." << std::endl;
+    this->m_warned = true;
+  }
+
+  return value;
+}
+
+/**
+ * \brief Replace the characters which can not be part of a C++ identifier.
+ * \param text text
+ * \return text with '_' in place of these characters
+ */
+static std::string IdentifierPart(const std::string &text)
+{
+  std::string name = text;
+  for(size_t i = 0; i < name.size(); i++)
+  {
+    char c = name[i];
+    if(!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'))
+    {
+      name[i] = '_';
+    }
+  }
+
+  return name;
+}
+
+/**
+ * \brief Get the node container name of a population.
+ * \param prefix member name prefix
+ * \param first first member index
+ * \param last last member index
+ * \param suffix member name suffix
+ * \return a C++ identifier
+ */
+static std::string PopulationName(const std::string &prefix, const size_t first, const size_t last, const std::string &suffix = "")
+{
+  std::string name = IdentifierPart(prefix);
+  if(name.empty() || (name[0] >= '0' && name[0] <= '9'))
+  {
+    name = "nodes_" + name;
+  }
+
+  return name + utils::integerToString(first) + "_" + utils::integerToString(last) + IdentifierPart(suffix);
+}
+
+/**
+ * \brief Parse the member index between a prefix and a suffix of a node name.
+ *
+ * The index is written in decimal without leading zero, as the members of
+ * a population are named.
+ *
+ * \param name node name
+ * \param prefixSize size of the prefix
+ * \param suffixSize size of the suffix
+ * \param number member index
+ * \return true if the name holds an index there
+ */
+static bool ParseMemberIndex(const std::string &name, const size_t prefixSize, const size_t suffixSize, size_t &number)
+{
+  if(name.size() <= prefixSize + suffixSize)
+  {
+    return false;
+  }
+
+  size_t end = name.size() - suffixSize;
+  if(end - prefixSize > 18 || (name[prefixSize] == '0' && end > prefixSize + 1))
+  {
+    return false;
+  }
+
+  number = 0;
+  for(size_t i = prefixSize; i < end; i++)
+  {
+    if(name[i] < '0' || name[i] > '9')
+    {
+      return false;
+    }
+    number = number * 10 + (name[i] - '0');
+  }
+
+  return true;
+}
+
+/**
+ * \brief Split two node names in member names of a population.
+ *
+ * "station_4_c1" and "station_5_c1" are the members 4 and 5 of the prefix
+ * "station_" and the suffix "_c1".
+ *
+ * \param name first node name
+ * \param next second node name
+ * \param prefix member name prefix
+ * \param suffix member name suffix
+ * \param first member index of name
+ * \return true if next is the member following name
+ */
+static bool SplitMemberNames(const std::string &name, const std::string &next, std::string &prefix, std::string &suffix, size_t &first)
+{
+  size_t prefixSize = 0;
+  while(prefixSize < name.size() && prefixSize < next.size() && name[prefixSize] == next[prefixSize])
+  {
+    prefixSize++;
+  }
+  while(prefixSize > 0 && name[prefixSize - 1] >= '0' && name[prefixSize - 1] <= '9')
+  {
+    prefixSize--;
+  }
+
+  size_t suffixSize = 0;
+  while(prefixSize + suffixSize < name.size() && prefixSize + suffixSize < next.size()
+        && name[name.size() - 1 - suffixSize] == next[next.size() - 1 - suffixSize])
+  {
+    suffixSize++;
+  }
+  while(suffixSize > 0 && name[name.size() - suffixSize] >= '0' && name[name.size() - suffixSize] <= '9')
+  {
+    suffixSize--;
+  }
+
+  size_t second = 0;
+  if(prefixSize == 0 || !ParseMemberIndex(name, prefixSize, suffixSize, first)
+     || !ParseMemberIndex(next, prefixSize, suffixSize, second) || second != first + 1)
+  {
+    return false;
+  }
+
+  prefix = name.substr(0, prefixSize);
+  suffix = name.substr(name.size() - suffixSize);
+  return true;
+}
+
+/**
+ * \brief Check if a node may be grouped in a population.
+ * \param spec node description
+ * \return true for a single Pc or Station
+ */
+static bool IsGroupable(const NodeSpec &spec)
+{
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  return (spec.type == "Pc" || spec.type == "Station") && !utils::parseRange(spec.name, prefix, first, last);
+}
+
+void TopologyBuilder::AddNode(const NodeSpec &spec)
+{
+  bool kept = !this->m_kept.empty() && this->m_kept.find(spec.name) != this->m_kept.end();
+  if(this->m_runSize > 0 && !kept && this->ExtendsRun(spec))
+  {
+    this->m_runSize++;
+    return;
+  }
+
+  this->FlushRun();
+  if(this->m_grouping && !kept && IsGroupable(spec))
+  {
+    this->m_run = spec;
+    this->m_runSize = 1;
+    return;
+  }
+
+  this->AddNodeNow(spec);
+}
+
+bool TopologyBuilder::ExtendsRun(const NodeSpec &spec)
+{
+  if(spec.type != this->m_run.type || spec.enableFlowmonitor != this->m_run.enableFlowmonitor || !IsGroupable(spec))
+  {
+    return false;
+  }
+
+  if(this->m_runSize == 1)
+  {
+    return SplitMemberNames(this->m_run.name, spec.name, this->m_runPrefix, this->m_runSuffix, this->m_runFirst);
+  }
+
+  size_t number = 0;
+  return spec.name.compare(0, this->m_runPrefix.size(), this->m_runPrefix) == 0
+    && spec.name.size() >= this->m_runSuffix.size()
+    && spec.name.compare(spec.name.size() - this->m_runSuffix.size(), this->m_runSuffix.size(), this->m_runSuffix) == 0
+    && ParseMemberIndex(spec.name, this->m_runPrefix.size(), this->m_runSuffix.size(), number)
+    && number == this->m_runFirst + this->m_runSize;
+}
+
+void TopologyBuilder::FlushRun()
+{
+  size_t number = this->m_runSize;
+  if(number == 0)
+  {
+    return;
+  }
+  this->m_runSize = 0;
+
+  if(number == 1)
+  {
+    this->AddNodeNow(this->m_run);
+    return;
+  }
+
+  size_t last = this->m_runFirst + number - 1;
+  std::string name = PopulationName(this->m_runPrefix, this->m_runFirst, last, this->m_runSuffix);
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->AddNode(" << this->m_run.type << ", " << name << ", " << number << ")" << std::endl;
+  }
+  size_t i = this->m_gen->GetNNodes();
+  this->IndexPopulation(i, this->m_runPrefix, this->m_runFirst, last, this->m_runSuffix);
+  this->m_gen->AddNode(this->m_run.type, name, number);
+  this->m_names.InsertName(name, i);
+  Node *node = this->m_gen->GetNode(i);
+  node->SetMemberNames(this->m_runPrefix, this->m_runFirst, this->m_runSuffix);
+
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->GetNode(" << i << ")->SetFlowmonitor(" << this->m_run.enableFlowmonitor << ")" << std::endl;
+  }
+  this->SetNodeFields(node, this->m_run);
+}
+
+void TopologyBuilder::IndexPopulation(const size_t node, const std::string &prefix, const size_t first, const size_t last, const std::string &suffix)
+{
+  /* the other nodes are only indexed by member name once they may collide with a population. */
+  if(this->m_populations.GetSize() == 0)
+  {
+    for(size_t i = 0; i < this->m_gen->GetNNodes(); i++)
+    {
+      this->m_names.InsertName(this->m_gen->GetNode(i)->GetNodeName(), i);
+    }
+  }
+
+  size_t other = 0;
+  if(this->m_names.FindOverlap(prefix, suffix, first, last, other))
+  {
+    throw std::logic_error("Add Node failed! (" + this->m_gen->GetNode(other)->GetNodeName() + ") already exists.");
+  }
+  if(!this->m_populations.Insert(prefix, suffix, first, last, node))
+  {
+    this->m_populations.FindOverlap(prefix, suffix, first, last, other);
+    throw std::logic_error("Add Node failed! (" + prefix + "[" + utils::integerToString(first) + ".." + utils::integerToString(last) + "]" + suffix
+                           + ") overlaps " + this->m_gen->GetNode(other)->GetNodeName() + ".");
+  }
+}
+
+void TopologyBuilder::AddNodeNow(const NodeSpec &spec)
+{
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  if(utils::parseRange(spec.name, prefix, first, last))
+  {
+    std::string name = PopulationName(prefix, first, last);
+    size_t number = last - first + 1;
+    if(this->m_verbose)
+    {
+      std::cerr << "gen->AddNode(" << spec.type << ", " << name << ", " << number << ")" << std::endl;
+    }
+    size_t i = this->m_gen->GetNNodes();
+    this->IndexPopulation(i, prefix, first, last);
+    this->m_gen->AddNode(spec.type, name, number);
+    this->m_names.InsertName(name, i);
+    this->m_gen->GetNode(i)->SetMemberNames(prefix, first);
+  }
+  else
+  {
+    if(this->m_verbose)
+    {
+      std::cerr << "gen->AddNode(" << spec.type << ", " << spec.name << ")" << std::endl;
+    }
+    size_t population = 0;
+    if(this->m_populations.Find(spec.name, population))
+    {
+      throw std::logic_error("Add Node failed! (" + spec.name + ") already exists.");
+    }
+    this->m_gen->AddNode(spec.type, spec.name);
+    if(this->m_populations.GetSize() > 0)
+    {
+      this->m_names.InsertName(spec.name, this->m_gen->GetNNodes() - 1);
+    }
+  }
+
+  size_t i = this->m_gen->GetNNodes() - 1;
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->GetNode(" << i << ")->SetFlowmonitor(" << spec.enableFlowmonitor << ")" << std::endl;
+  }
+  this->SetNodeFields(this->m_gen->GetNode(i), spec);
+}
+
+void TopologyBuilder::SetNodeFields(Node *node, const NodeSpec &spec)
+{
+  node->SetFlowmonitor(ParseBoolean(spec.enableFlowmonitor, "enableFlowmonitor"));
+}
+
+void TopologyBuilder::AddNetworkHardware(const NetworkHardwareSpec &spec)
+{
+  this->FlushRun();
+
+  if(spec.type == "Ap" || spec.type == "Bridge")
+  {
+    if(spec.type == "Ap" && spec.name.compare(0, 2, "hw") != 0)
+    {
+      throw std::logic_error("Error-> Improper AP hardware name <" + spec.name + ">");
+    }
+
+    /* the hardware name is "hw" followed by the name of its node. */
+    std::string linkNode = spec.name.length() > 2 ? spec.name.substr(2) : std::string("");
+    if(this->m_verbose)
+    {
+      std::cerr << "gen->AddNetworkHardware(" << spec.type << ", " << linkNode << ")" << std::endl;
+    }
+    this->m_gen->AddNetworkHardware(spec.type, linkNode);
+  }
+  else
+  {
+    if(this->m_verbose)
+    {
+      std::cerr << "gen->AddNetworkHardware(" << spec.type << ")" << std::endl;
+    }
+    this->m_gen->AddNetworkHardware(spec.type);
+  }
+
+  size_t i = this->m_gen->GetNNetworkHardwares() - 1;
+  NetworkHardware *hw = this->m_gen->GetNetworkHardware(i);
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->GetNetworkHardware(" << i << ")->SetDataRate(" << spec.dataRate << ")" << std::endl;
+    std::cerr << "gen->GetNetworkHardware(" << i << ")->SetNetworkHardwareDelay(" << spec.linkDelay << ")" << std::endl;
+    std::cerr << "gen->GetNetworkHardware(" << i << ")->SetTrace(" << spec.enableTrace << ")" << std::endl;
+  }
+  this->SetNetworkHardwareFields(hw, spec);
+}
+
+void TopologyBuilder::SetNetworkHardwareFields(NetworkHardware *hw, const NetworkHardwareSpec &spec)
+{
+  /* an absent data rate or delay keeps the default one. */
+  if(!spec.dataRate.empty())
+  {
+    hw->SetDataRate(spec.dataRate);
+  }
+  if(!spec.linkDelay.empty())
+  {
+    hw->SetNetworkHardwareDelay(spec.linkDelay);
+  }
+  hw->SetTrace(ParseBoolean(spec.enableTrace, "enableTrace"));
+}
+
+std::string TopologyBuilder::ResolveNodeName(const std::string &name)
+{
+  size_t number = 0;
+  size_t member = 0;
+  if(this->m_populations.Find(name, member))
+  {
+    Node *node = this->m_gen->GetNode(member);
+    if(node->FindMember(name, number))
+    {
+      return node->GetNodeName(number);
+    }
+  }
+
+  return name;
+}
+
+void TopologyBuilder::InstallNode(const std::string &nodeName)
+{
+  this->FlushRun();
+
+  if(this->m_gen->GetNNetworkHardwares() == 0)
+  {
+    throw std::logic_error("Install failed! (" + nodeName + ") no network hardware.");
+  }
+
+  this->Connect(this->m_gen->GetNNetworkHardwares() - 1, nodeName);
+}
+
+Node* TopologyBuilder::FindNode(const std::string &name)
+{
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  size_t member = 0;
+  if(!utils::parseRange(name, prefix, first, last))
+  {
+    return this->m_gen->FindNode(name);
+  }
+
+  if(this->m_populations.FindOverlap(prefix, "", first, last, member))
+  {
+    Node *node = this->m_gen->GetNode(member);
+    if(node->GetMemberPrefix() == prefix && node->GetMemberSuffix().empty() && node->GetFirstMember() == first
+       && node->GetMachinesNumber() == last - first + 1)
+    {
+      return node;
+    }
+  }
+
+  return 0;
+}
+
+void TopologyBuilder::Connect(const size_t link, const std::string &nodeName)
+{
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  if(!utils::parseRange(nodeName, prefix, first, last))
+  {
+    this->InstallOne(link, this->ResolveNodeName(nodeName));
+    return;
+  }
+
+  /* a whole population is installed at once. */
+  Node *node = this->FindNode(nodeName);
+  if(node != 0)
+  {
+    this->InstallOne(link, node->GetNodeName());
+    return;
+  }
+
+  std::vector<std::string> nodes;
+  nodes.reserve(last - first + 1);
+  for(size_t index = first; index <= last; index++)
+  {
+    nodes.push_back(this->ResolveNodeName(prefix + utils::integerToString(index)));
+  }
+
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->GetNetworkHardware(" << link << ")->InstallRange(" << nodeName << ")" << std::endl;
+  }
+  this->m_gen->GetNetworkHardware(link)->InstallRange(nodes);
+}
+
+void TopologyBuilder::InstallOne(const size_t link, const std::string &nodeName)
+{
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->GetNetworkHardware(" << link << ")->Install(" << nodeName << ")" << std::endl;
+  }
+  this->m_gen->GetNetworkHardware(link)->Install(nodeName);
+}
+
+size_t TopologyBuilder::Disconnect(const size_t link, const std::string &nodeName)
+{
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  std::string installed;
+  std::string members;
+  if(utils::parseRange(nodeName, prefix, first, last))
+  {
+    Node *node = this->FindNode(nodeName);
+    if(node == 0)
+    {
+      size_t removed = 0;
+      for(size_t index = first; index <= last; index++)
+      {
+        removed += this->Disconnect(link, prefix + utils::integerToString(index));
+      }
+      return removed;
+    }
+
+    /* a population is installed whole or member by member. */
+    installed = node->GetNodeName();
+    members = "NodeContainer(" + installed + ".Get(";
+  }
+  else
+  {
+    installed = this->ResolveNodeName(nodeName);
+  }
+
+  /* a member is only disconnected alone if it was connected alone. */
+  std::string population;
+  std::string range;
+  size_t member = 0;
+  if(installed != nodeName && this->m_populations.Find(nodeName, member))
+  {
+    Node *node = this->m_gen->GetNode(member);
+    population = node->GetNodeName();
+    range = node->GetMemberPrefix() + "[" + utils::integerToString(node->GetFirstMember()) + ".."
+            + utils::integerToString(node->GetFirstMember() + node->GetMachinesNumber() - 1) + "]" + node->GetMemberSuffix();
+  }
+
+  NetworkHardware *hw = this->m_gen->GetNetworkHardware(link);
+  size_t removed = 0;
+  for(size_t i = hw->GetInstalledNodes().size(); i > 0; i--)
+  {
+    const std::string &name = hw->GetInstalledNode(i - 1);
+    if(name == installed || (!members.empty() && name.compare(0, members.size(), members) == 0))
+    {
+      if(this->m_verbose)
+      {
+        std::cerr << "gen->GetNetworkHardware(" << link << ")->removeInstalledNode(" << i - 1 << ")" << std::endl;
+      }
+      hw->removeInstalledNode(i - 1);
+      removed++;
+    }
+    else if(name == population)
+    {
+      throw std::logic_error("Disconnect failed! (" + nodeName + ") is connected with its population " + range + ", only the whole population can be disconnected.");
+    }
+  }
+
+  return removed;
+}
+
+void TopologyBuilder::AddApplication(const ApplicationSpec &spec)
+{
+  this->FlushRun();
+
+  std::string sender = this->ResolveNodeName(spec.sender);
+  std::string receiver = this->ResolveNodeName(spec.receiver);
+
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->AddApplication(" << spec.type << ", " << sender << ", " << receiver << ", " << spec.startTime << ", " << spec.endTime;
+    if(spec.hasPort)
+    {
+      std::cerr << ", port=" << spec.port;
+    }
+    if(spec.hasInterval)
+    {
+      std::cerr << ", interval=" << spec.interval;
+    }
+    if(spec.hasReadingTime)
+    {
+      std::cerr << ", readingTime=" << spec.readingTime;
+    }
+    std::cerr << ")" << std::endl;
+  }
+  this->m_gen->AddApplication(spec, sender, receiver);
+}
+
+void TopologyBuilder::AddFlow(const FlowSpec &spec)
+{
+  this->FlushRun();
+
+  if(this->m_verbose)
+  {
+    std::cerr << "gen->AddFlow(" << spec.type << ", " << spec.name << ", " << spec.source << ", " << spec.destination << ", " << spec.expectedDelaySeconds << ", " << spec.expectedReliabilityPercent << ")" << std::endl;
+  }
+  this->m_gen->AddFlow(spec.type, spec.name, spec.source, spec.destination, spec.expectedDelaySeconds, spec.expectedReliabilityPercent);
+}
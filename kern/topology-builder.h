@@ -0,0 +1,294 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-builder.h
+ * \brief Populate a Generator from topology element descriptions.
+ */
+
+#ifndef TOPOLOGY_BUILDER_H
+#define TOPOLOGY_BUILDER_H
+
+#include "topology-sink.h"
+#include "population-index.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+class Generator;
+class NetworkHardware;
+class Node;
+
+/**
+ * \ingroup generator
+ * \brief Populate a Generator from topology element descriptions.
+ *
+ *  The builder holds the rules which turn the elements of a topology
+ *  input (see TopologySchema.xsd) into Generator calls, so that every
+ *  reader (object model, streaming parser, ...) builds the same model.
+ *
+ *  A node named with a range, "station_[0..49999]", is a population: it is
+ *  added as one Node of 50000 machines named station_0 to station_49999.
+ *  Connecting the same range to a network hardware installs the whole
+ *  population; applications and other ranges may refer to single members.
+ *
+ *  With the node grouping, the runs of nodes of the same type named by
+ *  consecutive numbers, "station_0_c1", "station_1_c1", ..., are added as
+ *  populations too, as if the input used a range. A node is then only
+ *  added once the next element shows the end of its run, Finish adds the
+ *  last one.
+ */
+class TopologyBuilder : public TopologySink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param gen generator to populate
+     */
+    TopologyBuilder(Generator *gen);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~TopologyBuilder();
+
+    /**
+     * \brief Enable/disable the trace of the Generator calls on std::cerr.
+     * \param verbose trace state
+     */
+    void SetVerbose(const bool &verbose);
+
+    /**
+     * \brief Enable/disable the grouping of the runs of nodes in populations.
+     *
+     * Only the end nodes (Pc, Station) are grouped: the routers come first
+     * on the links and the other nodes are named by their network hardware.
+     *
+     * \param grouping grouping state
+     */
+    void SetNodeGrouping(const bool &grouping);
+
+    /**
+     * \brief Add the nodes still held by the grouping.
+     *
+     * It must be called after the last element when the grouping is enabled.
+     */
+    void Finish();
+
+    /**
+     * \brief Keep a node out of the grouped populations.
+     *
+     * The node is added as a Node of its own even if it continues a run, so
+     * that a patch can change it once the model is built.
+     *
+     * \param name node name
+     */
+    void KeepNode(const std::string &name);
+
+    /**
+     * \brief Get the Generator node of a node element.
+     *
+     * The positions of the populations are the ones of the Generator before
+     * any node is removed: the nodes are looked up before the model changes.
+     *
+     * \param name node name from the input, a range for a population
+     * \return the node, 0 if there is no node element of that name
+     */
+    Node* FindNode(const std::string &name);
+
+    /**
+     * \brief Connect a node to a network hardware.
+     * \param link index of the network hardware in the Generator
+     * \param nodeName node name from the input, a range for a population or several nodes
+     */
+    void Connect(const size_t link, const std::string &nodeName);
+
+    /**
+     * \brief Disconnect a node from a network hardware.
+     * \param link index of the network hardware in the Generator
+     * \param nodeName node name from the input, a range for a population or several nodes
+     * \return number of installs removed
+     */
+    size_t Disconnect(const size_t link, const std::string &nodeName);
+
+    /**
+     * \brief Set the fields of a node other than its type and name.
+     * \param node node
+     * \param spec node description
+     */
+    void SetNodeFields(Node *node, const NodeSpec &spec);
+
+    /**
+     * \brief Set the fields of a network hardware other than its type and name.
+     * \param hw network hardware
+     * \param spec network hardware description
+     */
+    void SetNetworkHardwareFields(NetworkHardware *hw, const NetworkHardwareSpec &spec);
+
+    /**
+     * \brief Add a node.
+     * \param spec node description
+     */
+    virtual void AddNode(const NodeSpec &spec);
+
+    /**
+     * \brief Add a network hardware.
+     *
+     * The hardware becomes the target of the following InstallNode calls.
+     *
+     * \param spec network hardware description
+     */
+    virtual void AddNetworkHardware(const NetworkHardwareSpec &spec);
+
+    /**
+     * \brief Connect a node to the last added network hardware.
+     * \param nodeName node name
+     */
+    virtual void InstallNode(const std::string &nodeName);
+
+    /**
+     * \brief Add an application.
+     * \param spec application description
+     */
+    virtual void AddApplication(const ApplicationSpec &spec);
+
+    /**
+     * \brief Add a flow.
+     * \param spec flow description
+     */
+    virtual void AddFlow(const FlowSpec &spec);
+
+  private:
+    /**
+     * \brief Get the name to give to the Generator for a node name.
+     * \param name node name from the input
+     * \return the node container expression if name is a population member, name otherwise
+     */
+    std::string ResolveNodeName(const std::string &name);
+
+    /**
+     * \brief Connect one node to a network hardware.
+     * \param link index of the network hardware in the Generator
+     * \param nodeName name given to the Generator
+     */
+    void InstallOne(const size_t link, const std::string &nodeName);
+
+    /**
+     * \brief Add a node to the Generator.
+     * \param spec node description
+     */
+    void AddNodeNow(const NodeSpec &spec);
+
+    /**
+     * \brief Index a population, before it is added to the Generator.
+     * \param node index the population node will have
+     * \param prefix member name prefix
+     * \param first first member index
+     * \param last last member index
+     * \param suffix member name suffix
+     * \throw std::logic_error if a member name is already used
+     */
+    void IndexPopulation(const size_t node, const std::string &prefix, const size_t first, const size_t last, const std::string &suffix = "");
+
+    /**
+     * \brief Check if a node continues the run of grouped nodes.
+     * \param spec node description
+     * \return true if the node is the next member of the run
+     */
+    bool ExtendsRun(const NodeSpec &spec);
+
+    /**
+     * \brief Add the run of grouped nodes to the Generator, as a population if it has several nodes.
+     */
+    void FlushRun();
+
+    /**
+     * \brief Parse a flag element, absent is false.
+     *
+     * Any text other than "true" is false, as it always was; the first
+     * one other than "false" is reported on the error output.
+     *
+     * \param text element text
+     * \param element element name, for the warning
+     * \return boolean
+     */
+    bool ParseBoolean(const std::string &text, const char *element);
+
+    /**
+     * \brief Group the runs of nodes in populations.
+     */
+    bool m_grouping;
+
+    /**
+     * \brief First node of the run, the description of all of them.
+     */
+    NodeSpec m_run;
+
+    /**
+     * \brief Number of nodes in the run, 0 without run.
+     */
+    size_t m_runSize;
+
+    /**
+     * \brief Member name prefix of the run, known from its second node.
+     */
+    std::string m_runPrefix;
+
+    /**
+     * \brief Member name suffix of the run, known from its second node.
+     */
+    std::string m_runSuffix;
+
+    /**
+     * \brief Index of the first member of the run.
+     */
+    size_t m_runFirst;
+
+    /**
+     * \brief Populations, ranges and grouped runs, to their node index.
+     */
+    PopulationIndex m_populations;
+
+    /**
+     * \brief Names of the other nodes, to their node index, once there is a population.
+     */
+    PopulationIndex m_names;
+
+    /**
+     * \brief Nodes kept out of the grouped populations.
+     */
+    std::set<std::string> m_kept;
+
+    /**
+     * \brief Generator to populate.
+     */
+    Generator *m_gen;
+
+    /**
+     * \brief Trace the Generator calls.
+     */
+    bool m_verbose;
+
+    /**
+     * \brief A flag other than true or false was reported.
+     */
+    bool m_warned;
+};
+
+#endif /* TOPOLOGY_BUILDER_H */
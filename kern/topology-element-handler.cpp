@@ -0,0 +1,338 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-element-handler.cpp
+ * \brief Turn the element events of a Gen document into sink calls.
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "topology-element-handler.h"
+#include "topology-sink.h"
+
+/**
+ * \brief Compare an element name slice with a literal.
+ * \param name name slice
+ * \param length slice length
+ * \param literal NUL terminated name
+ * \return true if the names are equal
+ */
+static bool Is(const char *name, const size_t length, const char *literal)
+{
+  return strncmp(name, literal, length) == 0 && literal[length] == '\0';
+}
+
+/**
+ * \brief Convert the text of a numeric element.
+ *
+ * Leading and trailing white spaces are allowed as in xs:unsignedInt.
+ *
+ * \param text text slice
+ * \param length slice length
+ * \return the value
+ */
+static size_t ToSize(const char *text, const size_t length)
+{
+  const char *end = text + length;
+  while(text != end && (*text == ' ' || *text == '\t' || *text == '\n' || *text == '\r'))
+  {
+    text++;
+  }
+  while(end != text && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r'))
+  {
+    end--;
+  }
+  if(text != end && *text == '+')
+  {
+    text++;
+  }
+  if(text == end)
+  {
+    throw std::runtime_error("Cannot convert string to uint64_t");
+  }
+
+  size_t ret = 0;
+  for(; text != end; text++)
+  {
+    if(*text < '0' || *text > '9')
+    {
+      throw std::runtime_error("Cannot convert string to uint64_t");
+    }
+    ret = ret * 10 + (*text - '0');
+  }
+  return ret;
+}
+
+/* the descriptions are cleared member by member to keep the string buffers. */
+
+static void Clear(NodeSpec &spec)
+{
+  spec.type.clear();
+  spec.name.clear();
+  spec.enableFlowmonitor.clear();
+}
+
+static void Clear(NetworkHardwareSpec &spec)
+{
+  spec.type.clear();
+  spec.name.clear();
+  spec.dataRate.clear();
+  spec.linkDelay.clear();
+  spec.enableTrace.clear();
+}
+
+static void Clear(ApplicationSpec &spec)
+{
+  spec.type.clear();
+  spec.name.clear();
+  spec.sender.clear();
+  spec.receiver.clear();
+  spec.startTime = 0;
+  spec.endTime = 0;
+  spec.hasPort = false;
+  spec.port = 0;
+  spec.hasInterval = false;
+  spec.interval = 0;
+  spec.hasReadingTime = false;
+  spec.readingTime = 0;
+  spec.hasPacketSize = false;
+  spec.packetSize = 0;
+  spec.hasMaxPacketCount = false;
+  spec.maxPacketCount = 0;
+  spec.hasPacketIntervalTime = false;
+  spec.packetIntervalTime.clear();
+}
+
+static void Clear(FlowSpec &spec)
+{
+  spec.type.clear();
+  spec.name.clear();
+  spec.source.clear();
+  spec.destination.clear();
+  spec.expectedDelaySeconds.clear();
+  spec.expectedReliabilityPercent.clear();
+}
+
+TopologyElementHandler::TopologyElementHandler(TopologySink &sink) : m_sink(sink)
+{
+  this->m_section = NONE;
+  this->m_inConnectedNodes = false;
+}
+
+TopologyElementHandler::~TopologyElementHandler()
+{
+}
+
+void TopologyElementHandler::StartElement(const char *name, const size_t length)
+{
+  if(Is(name, length, "Nodes"))
+  {
+    this->m_section = NODES;
+  }
+  else if(Is(name, length, "NetworkHardwares"))
+  {
+    this->m_section = NETWORK_HARDWARES;
+  }
+  else if(Is(name, length, "Applications"))
+  {
+    this->m_section = APPLICATIONS;
+  }
+  else if(Is(name, length, "Flows"))
+  {
+    this->m_section = FLOWS;
+  }
+  else if(Is(name, length, "node"))
+  {
+    Clear(this->m_node);
+  }
+  else if(Is(name, length, "networkHardware"))
+  {
+    Clear(this->m_networkHardware);
+  }
+  else if(Is(name, length, "connectedNodes"))
+  {
+    /* connectedNodes is the last child of networkHardware, the description is complete. */
+    this->m_sink.AddNetworkHardware(this->m_networkHardware);
+    this->m_inConnectedNodes = true;
+  }
+  else if(Is(name, length, "application"))
+  {
+    Clear(this->m_application);
+  }
+  else if(Is(name, length, "flow"))
+  {
+    Clear(this->m_flow);
+  }
+}
+
+void TopologyElementHandler::EndElement(const char *name, const size_t length, const char *text, const size_t textLength)
+{
+  switch(this->m_section)
+  {
+  case NODES:
+    if(Is(name, length, "node"))
+    {
+      this->m_sink.AddNode(this->m_node);
+    }
+    else if(Is(name, length, "type"))
+    {
+      this->m_node.type.assign(text, textLength);
+    }
+    else if(Is(name, length, "name"))
+    {
+      this->m_node.name.assign(text, textLength);
+    }
+    else if(Is(name, length, "enableFlowmonitor"))
+    {
+      this->m_node.enableFlowmonitor.assign(text, textLength);
+    }
+    break;
+
+  case NETWORK_HARDWARES:
+    if(this->m_inConnectedNodes)
+    {
+      if(Is(name, length, "name"))
+      {
+        this->m_nodeName.assign(text, textLength);
+        this->m_sink.InstallNode(this->m_nodeName);
+      }
+      else if(Is(name, length, "connectedNodes"))
+      {
+        this->m_inConnectedNodes = false;
+      }
+    }
+    else if(Is(name, length, "type"))
+    {
+      this->m_networkHardware.type.assign(text, textLength);
+    }
+    else if(Is(name, length, "name"))
+    {
+      this->m_networkHardware.name.assign(text, textLength);
+    }
+    else if(Is(name, length, "dataRate"))
+    {
+      this->m_networkHardware.dataRate.assign(text, textLength);
+    }
+    else if(Is(name, length, "linkDelay"))
+    {
+      this->m_networkHardware.linkDelay.assign(text, textLength);
+    }
+    else if(Is(name, length, "enableTrace"))
+    {
+      this->m_networkHardware.enableTrace.assign(text, textLength);
+    }
+    break;
+
+  case APPLICATIONS:
+    if(Is(name, length, "application"))
+    {
+      this->m_sink.AddApplication(this->m_application);
+    }
+    else if(Is(name, length, "type"))
+    {
+      this->m_application.type.assign(text, textLength);
+    }
+    else if(Is(name, length, "name"))
+    {
+      this->m_application.name.assign(text, textLength);
+    }
+    else if(Is(name, length, "sender"))
+    {
+      this->m_application.sender.assign(text, textLength);
+    }
+    else if(Is(name, length, "receiver"))
+    {
+      this->m_application.receiver.assign(text, textLength);
+    }
+    else if(Is(name, length, "startTime"))
+    {
+      this->m_application.startTime = ToSize(text, textLength);
+    }
+    else if(Is(name, length, "endTime"))
+    {
+      this->m_application.endTime = ToSize(text, textLength);
+    }
+    else if(Is(name, length, "port"))
+    {
+      this->m_application.port = ToSize(text, textLength);
+      this->m_application.hasPort = true;
+    }
+    else if(Is(name, length, "interval"))
+    {
+      this->m_application.interval = ToSize(text, textLength);
+      this->m_application.hasInterval = true;
+    }
+    else if(Is(name, length, "readingTime"))
+    {
+      this->m_application.readingTime = ToSize(text, textLength);
+      this->m_application.hasReadingTime = true;
+    }
+    else if(Is(name, length, "packetSize"))
+    {
+      this->m_application.packetSize = ToSize(text, textLength);
+      this->m_application.hasPacketSize = true;
+    }
+    else if(Is(name, length, "maxPacketCount"))
+    {
+      this->m_application.maxPacketCount = ToSize(text, textLength);
+      this->m_application.hasMaxPacketCount = true;
+    }
+    else if(Is(name, length, "packetIntervalTime"))
+    {
+      this->m_application.packetIntervalTime.assign(text, textLength);
+      this->m_application.hasPacketIntervalTime = true;
+    }
+    break;
+
+  case FLOWS:
+    if(Is(name, length, "flow"))
+    {
+      this->m_sink.AddFlow(this->m_flow);
+    }
+    else if(Is(name, length, "type"))
+    {
+      this->m_flow.type.assign(text, textLength);
+    }
+    else if(Is(name, length, "name"))
+    {
+      this->m_flow.name.assign(text, textLength);
+    }
+    else if(Is(name, length, "source"))
+    {
+      this->m_flow.source.assign(text, textLength);
+    }
+    else if(Is(name, length, "destination"))
+    {
+      this->m_flow.destination.assign(text, textLength);
+    }
+    else if(Is(name, length, "expectedDelaySeconds"))
+    {
+      this->m_flow.expectedDelaySeconds.assign(text, textLength);
+    }
+    else if(Is(name, length, "expectedReliabilityPercent"))
+    {
+      this->m_flow.expectedReliabilityPercent.assign(text, textLength);
+    }
+    break;
+
+  case NONE:
+    break;
+  }
+}
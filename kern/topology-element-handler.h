@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-element-handler.h
+ * \brief Turn the element events of a Gen document into sink calls.
+ */
+
+#ifndef TOPOLOGY_ELEMENT_HANDLER_H
+#define TOPOLOGY_ELEMENT_HANDLER_H
+
+#include "topology-spec.h"
+
+#include <string>
+
+class TopologySink;
+
+/**
+ * \ingroup generator
+ * \brief Turn the element events of a Gen document into sink calls.
+ *
+ *  Readers report the start of every element and the end of every element
+ *  with the text it contains; names and texts are passed as slices of the
+ *  reader buffer and are only copied into the element descriptions.
+ *
+ *  Each element is handed to the sink as soon as it is complete. Network
+ *  hardwares are added when their <connectedNodes> element starts (it is the
+ *  last child of <networkHardware>) and every connected node name is
+ *  installed as it is read.
+ */
+class TopologyElementHandler
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param sink sink fed with the topology elements
+     */
+    TopologyElementHandler(TopologySink &sink);
+
+    /**
+     * \brief Destructor.
+     */
+    ~TopologyElementHandler();
+
+    /**
+     * \brief An element starts.
+     * \param name element local name
+     * \param length name length
+     */
+    void StartElement(const char *name, const size_t length);
+
+    /**
+     * \brief An element ends.
+     * \param name element local name
+     * \param length name length
+     * \param text element text (empty for elements with children)
+     * \param textLength text length
+     */
+    void EndElement(const char *name, const size_t length, const char *text, const size_t textLength);
+
+  private:
+    /**
+     * \brief Top level section being read.
+     */
+    enum Section
+    {
+      NONE,
+      NODES,
+      NETWORK_HARDWARES,
+      APPLICATIONS,
+      FLOWS
+    };
+
+    /**
+     * \brief Sink fed with the elements.
+     */
+    TopologySink &m_sink;
+
+    /**
+     * \brief Current section.
+     */
+    Section m_section;
+
+    /**
+     * \brief Reading the connected nodes of a network hardware.
+     */
+    bool m_inConnectedNodes;
+
+    /**
+     * \brief Node being read.
+     */
+    NodeSpec m_node;
+
+    /**
+     * \brief Network hardware being read.
+     */
+    NetworkHardwareSpec m_networkHardware;
+
+    /**
+     * \brief Application being read.
+     */
+    ApplicationSpec m_application;
+
+    /**
+     * \brief Flow being read.
+     */
+    FlowSpec m_flow;
+
+    /**
+     * \brief Connected node name (reused buffer).
+     */
+    std::string m_nodeName;
+};
+
+#endif /* TOPOLOGY_ELEMENT_HANDLER_H */
@@ -0,0 +1,277 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-fragment.cpp
+ * \brief Topology read from one file of a modular topology.
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+#include "topology-fragment.h"
+#include "population-index.h"
+#include "utils.h"
+
+TopologyFragment::TopologyFragment(const std::string &fileName)
+{
+  this->m_fileName = fileName;
+}
+
+TopologyFragment::~TopologyFragment()
+{
+}
+
+const std::string &TopologyFragment::GetFileName() const
+{
+  return this->m_fileName;
+}
+
+void TopologyFragment::AddNode(const NodeSpec &spec)
+{
+  this->m_nodes.push_back(spec);
+}
+
+void TopologyFragment::AddNetworkHardware(const NetworkHardwareSpec &spec)
+{
+  this->m_networkHardwares.push_back(spec);
+  this->m_connectedNodes.push_back(std::vector<std::string>());
+}
+
+void TopologyFragment::InstallNode(const std::string &nodeName)
+{
+  if(this->m_connectedNodes.empty())
+  {
+    throw std::logic_error("Install failed! (" + nodeName + ") no network hardware.");
+  }
+  this->m_connectedNodes.back().push_back(nodeName);
+}
+
+void TopologyFragment::AddApplication(const ApplicationSpec &spec)
+{
+  this->m_applications.push_back(spec);
+}
+
+void TopologyFragment::AddFlow(const FlowSpec &spec)
+{
+  this->m_flows.push_back(spec);
+}
+
+void TopologyFragment::ReplayNodes(TopologySink &sink) const
+{
+  for(size_t i = 0; i < this->m_nodes.size(); i++)
+  {
+    sink.AddNode(this->m_nodes.at(i));
+  }
+}
+
+void TopologyFragment::ReplayNetworkHardwares(TopologySink &sink) const
+{
+  for(size_t i = 0; i < this->m_networkHardwares.size(); i++)
+  {
+    sink.AddNetworkHardware(this->m_networkHardwares.at(i));
+    const std::vector<std::string> &nodes = this->m_connectedNodes.at(i);
+    for(size_t j = 0; j < nodes.size(); j++)
+    {
+      sink.InstallNode(nodes.at(j));
+    }
+  }
+}
+
+void TopologyFragment::ReplayApplications(TopologySink &sink) const
+{
+  for(size_t i = 0; i < this->m_applications.size(); i++)
+  {
+    sink.AddApplication(this->m_applications.at(i));
+  }
+}
+
+void TopologyFragment::ReplayFlows(TopologySink &sink) const
+{
+  for(size_t i = 0; i < this->m_flows.size(); i++)
+  {
+    sink.AddFlow(this->m_flows.at(i));
+  }
+}
+
+const std::vector<NodeSpec> &TopologyFragment::GetNodes() const
+{
+  return this->m_nodes;
+}
+
+const std::vector<NetworkHardwareSpec> &TopologyFragment::GetNetworkHardwares() const
+{
+  return this->m_networkHardwares;
+}
+
+const std::vector<std::vector<std::string> > &TopologyFragment::GetConnectedNodes() const
+{
+  return this->m_connectedNodes;
+}
+
+const std::vector<ApplicationSpec> &TopologyFragment::GetApplications() const
+{
+  return this->m_applications;
+}
+
+const std::vector<FlowSpec> &TopologyFragment::GetFlows() const
+{
+  return this->m_flows;
+}
+
+std::vector<std::string> ReadTopologyManifest(const std::string &fileName)
+{
+  std::ifstream file(fileName.c_str());
+  if(!file)
+  {
+    throw std::runtime_error("Cannot open manifest " + fileName);
+  }
+
+  std::string dir;
+  std::string::size_type slash = fileName.rfind('/');
+  if(slash != std::string::npos)
+  {
+    dir = fileName.substr(0, slash + 1);
+  }
+
+  std::vector<std::string> fragments;
+  std::string line;
+  while(std::getline(file, line))
+  {
+    std::string::size_type begin = line.find_first_not_of(" \t\r");
+    if(begin == std::string::npos || line[begin] == '#')
+    {
+      continue;
+    }
+    std::string::size_type end = line.find_last_not_of(" \t\r");
+    std::string name = line.substr(begin, end - begin + 1);
+    fragments.push_back(name[0] == '/' ? name : dir + name);
+  }
+
+  if(fragments.empty())
+  {
+    throw std::runtime_error("Manifest " + fileName + " lists no topology file");
+  }
+
+  return fragments;
+}
+
+/**
+ * \brief Record a name, failing if it is already used.
+ * \param names names already used and the file declaring them
+ * \param kind element kind, for the error message
+ * \param name name to record
+ * \param fileName file declaring the name
+ */
+static void CheckName(std::map<std::string, const std::string*> &names, const char *kind, const std::string &name, const std::string &fileName)
+{
+  std::pair<std::map<std::string, const std::string*>::iterator, bool> ret = names.insert(std::make_pair(name, &fileName));
+  if(!ret.second)
+  {
+    throw std::logic_error("Name collision: " + std::string(kind) + " " + name + " declared in " + *ret.first->second + " and " + fileName);
+  }
+}
+
+void MergeTopologyFragments(const std::vector<TopologyFragment*> &fragments, TopologySink &sink)
+{
+  std::map<std::string, const std::string*> nodes;
+  std::map<std::string, const std::string*> networkHardwares;
+  std::map<std::string, const std::string*> applications;
+  std::map<std::string, const std::string*> flows;
+
+  /* the ranges are intervals of member indexes, whatever their size, to their fragment. */
+  PopulationIndex ranges;
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    const TopologyFragment &fragment = *fragments.at(i);
+    for(size_t j = 0; j < fragment.GetNodes().size(); j++)
+    {
+      const std::string &name = fragment.GetNodes().at(j).name;
+      std::string prefix;
+      size_t first = 0;
+      size_t last = 0;
+      size_t other = 0;
+      if(utils::parseRange(name, prefix, first, last) && !ranges.Insert(prefix, "", first, last, i))
+      {
+        ranges.FindOverlap(prefix, "", first, last, other);
+        throw std::logic_error("Name collision: node range " + name + " declared in " + fragments.at(other)->GetFileName() + " and " + fragment.GetFileName());
+      }
+    }
+  }
+
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    const TopologyFragment &fragment = *fragments.at(i);
+    for(size_t j = 0; j < fragment.GetNodes().size(); j++)
+    {
+      const std::string &name = fragment.GetNodes().at(j).name;
+      std::string prefix;
+      size_t first = 0;
+      size_t last = 0;
+      if(utils::parseRange(name, prefix, first, last))
+      {
+        continue;
+      }
+      CheckName(nodes, "node", name, fragment.GetFileName());
+
+      /* a node collides with the member of a range of the same name. */
+      size_t other = 0;
+      if(ranges.Find(name, other))
+      {
+        throw std::logic_error("Name collision: node " + name + " declared in " + fragments.at(std::min(i, other))->GetFileName()
+                               + " and " + fragments.at(std::max(i, other))->GetFileName());
+      }
+    }
+  }
+
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    const TopologyFragment &fragment = *fragments.at(i);
+    for(size_t j = 0; j < fragment.GetNetworkHardwares().size(); j++)
+    {
+      CheckName(networkHardwares, "network hardware", fragment.GetNetworkHardwares().at(j).name, fragment.GetFileName());
+    }
+    for(size_t j = 0; j < fragment.GetApplications().size(); j++)
+    {
+      CheckName(applications, "application", fragment.GetApplications().at(j).name, fragment.GetFileName());
+    }
+    for(size_t j = 0; j < fragment.GetFlows().size(); j++)
+    {
+      CheckName(flows, "flow", fragment.GetFlows().at(j).name, fragment.GetFileName());
+    }
+  }
+
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    fragments.at(i)->ReplayNodes(sink);
+  }
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    fragments.at(i)->ReplayNetworkHardwares(sink);
+  }
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    fragments.at(i)->ReplayApplications(sink);
+  }
+  for(size_t i = 0; i < fragments.size(); i++)
+  {
+    fragments.at(i)->ReplayFlows(sink);
+  }
+}
@@ -0,0 +1,180 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-fragment.h
+ * \brief Topology read from one file of a modular topology.
+ */
+
+#ifndef TOPOLOGY_FRAGMENT_H
+#define TOPOLOGY_FRAGMENT_H
+
+#include "topology-sink.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * \ingroup generator
+ * \brief Topology read from one file of a modular topology.
+ *
+ *  A fragment keeps the elements it receives so that the fragments can be
+ *  read concurrently and merged afterwards, see MergeTopologyFragments().
+ */
+class TopologyFragment : public TopologySink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param fileName file the fragment is read from
+     */
+    TopologyFragment(const std::string &fileName);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~TopologyFragment();
+
+    /**
+     * \brief Get the file the fragment is read from.
+     * \return file name
+     */
+    const std::string &GetFileName() const;
+
+    virtual void AddNode(const NodeSpec &spec);
+    virtual void AddNetworkHardware(const NetworkHardwareSpec &spec);
+    virtual void InstallNode(const std::string &nodeName);
+    virtual void AddApplication(const ApplicationSpec &spec);
+    virtual void AddFlow(const FlowSpec &spec);
+
+    /**
+     * \brief Pass the nodes to a sink.
+     * \param sink sink to feed
+     */
+    void ReplayNodes(TopologySink &sink) const;
+
+    /**
+     * \brief Pass the network hardwares and their connected nodes to a sink.
+     * \param sink sink to feed
+     */
+    void ReplayNetworkHardwares(TopologySink &sink) const;
+
+    /**
+     * \brief Pass the applications to a sink.
+     * \param sink sink to feed
+     */
+    void ReplayApplications(TopologySink &sink) const;
+
+    /**
+     * \brief Pass the flows to a sink.
+     * \param sink sink to feed
+     */
+    void ReplayFlows(TopologySink &sink) const;
+
+    /**
+     * \brief Get the nodes.
+     * \return nodes in document order
+     */
+    const std::vector<NodeSpec> &GetNodes() const;
+
+    /**
+     * \brief Get the network hardwares.
+     * \return network hardwares in document order
+     */
+    const std::vector<NetworkHardwareSpec> &GetNetworkHardwares() const;
+
+    /**
+     * \brief Get the connected nodes of the network hardwares.
+     * \return connected nodes of each network hardware, in document order
+     */
+    const std::vector<std::vector<std::string> > &GetConnectedNodes() const;
+
+    /**
+     * \brief Get the applications.
+     * \return applications in document order
+     */
+    const std::vector<ApplicationSpec> &GetApplications() const;
+
+    /**
+     * \brief Get the flows.
+     * \return flows in document order
+     */
+    const std::vector<FlowSpec> &GetFlows() const;
+
+  private:
+    /**
+     * \brief File the fragment is read from.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Nodes.
+     */
+    std::vector<NodeSpec> m_nodes;
+
+    /**
+     * \brief Network hardwares.
+     */
+    std::vector<NetworkHardwareSpec> m_networkHardwares;
+
+    /**
+     * \brief Connected nodes of each network hardware.
+     */
+    std::vector<std::vector<std::string> > m_connectedNodes;
+
+    /**
+     * \brief Applications.
+     */
+    std::vector<ApplicationSpec> m_applications;
+
+    /**
+     * \brief Flows.
+     */
+    std::vector<FlowSpec> m_flows;
+};
+
+/**
+ * \ingroup generator
+ * \brief Read the fragment list of a modular topology.
+ *
+ * The manifest lists one topology file per line, empty lines and lines
+ * starting with '#' are ignored. Relative names are relative to the
+ * directory of the manifest.
+ *
+ * \param fileName manifest file name
+ * \return fragment file names, in manifest order
+ * \throw std::runtime_error if the manifest cannot be read or is empty
+ */
+std::vector<std::string> ReadTopologyManifest(const std::string &fileName);
+
+/**
+ * \ingroup generator
+ * \brief Merge fragments into a sink.
+ *
+ * The nodes of all the fragments are passed first, then the network
+ * hardwares, the applications and the flows, each in fragment order, so
+ * a fragment may refer to the nodes of another one and the result does
+ * not depend on the order the fragments were read in.
+ *
+ * \param fragments fragments, in manifest order
+ * \param sink sink to feed
+ * \throw std::logic_error if two fragments declare the same name
+ */
+void MergeTopologyFragments(const std::vector<TopologyFragment*> &fragments, TopologySink &sink);
+
+#endif /* TOPOLOGY_FRAGMENT_H */
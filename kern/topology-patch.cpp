@@ -0,0 +1,976 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+/**
+ * \file topology-patch.cpp
+ * \brief Changes applied to a built topology model.
+ */
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "topology-patch.h"
+#include "topology-builder.h"
+#include "generator.h"
+#include "network-hardware.h"
+#include "node.h"
+#include "utils.h"
+
+/**
+ * \brief Kind names, as written in the patch file.
+ */
+static const char *g_kindNames[] = { "node", "networkHardware", "application", "flow" };
+
+/**
+ * \brief Set a field of a node.
+ * \param spec node description
+ * \param field field name
+ * \param value field value
+ * \return false if the node has no such field
+ */
+static bool SetField(NodeSpec &spec, const std::string &field, const std::string &value)
+{
+  if(field == "type")
+  {
+    spec.type = value;
+  }
+  else if(field == "enableFlowmonitor")
+  {
+    spec.enableFlowmonitor = value;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * \brief Set a field of a network hardware.
+ * \param spec network hardware description
+ * \param field field name
+ * \param value field value
+ * \return false if the network hardware has no such field
+ */
+static bool SetField(NetworkHardwareSpec &spec, const std::string &field, const std::string &value)
+{
+  if(field == "type")
+  {
+    spec.type = value;
+  }
+  else if(field == "dataRate")
+  {
+    spec.dataRate = value;
+  }
+  else if(field == "linkDelay")
+  {
+    spec.linkDelay = value;
+  }
+  else if(field == "enableTrace")
+  {
+    spec.enableTrace = value;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * \brief Set a field of an application.
+ * \param spec application description
+ * \param field field name
+ * \param value field value
+ * \return false if the application has no such field
+ * \throw std::runtime_error if a numeric field value is not a number
+ */
+static bool SetField(ApplicationSpec &spec, const std::string &field, const std::string &value)
+{
+  if(field == "type")
+  {
+    spec.type = value;
+  }
+  else if(field == "sender")
+  {
+    spec.sender = value;
+  }
+  else if(field == "receiver")
+  {
+    spec.receiver = value;
+  }
+  else if(field == "startTime")
+  {
+    spec.startTime = utils::stringToInteger(value);
+  }
+  else if(field == "endTime")
+  {
+    spec.endTime = utils::stringToInteger(value);
+  }
+  else if(field == "port")
+  {
+    spec.hasPort = true;
+    spec.port = utils::stringToInteger(value);
+  }
+  else if(field == "interval")
+  {
+    spec.hasInterval = true;
+    spec.interval = utils::stringToInteger(value);
+  }
+  else if(field == "readingTime")
+  {
+    spec.hasReadingTime = true;
+    spec.readingTime = utils::stringToInteger(value);
+  }
+  else if(field == "packetSize")
+  {
+    spec.hasPacketSize = true;
+    spec.packetSize = utils::stringToInteger(value);
+  }
+  else if(field == "maxPacketCount")
+  {
+    spec.hasMaxPacketCount = true;
+    spec.maxPacketCount = utils::stringToInteger(value);
+  }
+  else if(field == "packetIntervalTime")
+  {
+    spec.hasPacketIntervalTime = true;
+    spec.packetIntervalTime = value;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * \brief Set a field of a flow.
+ * \param spec flow description
+ * \param field field name
+ * \param value field value
+ * \return false if the flow has no such field
+ */
+static bool SetField(FlowSpec &spec, const std::string &field, const std::string &value)
+{
+  if(field == "type")
+  {
+    spec.type = value;
+  }
+  else if(field == "source")
+  {
+    spec.source = value;
+  }
+  else if(field == "destination")
+  {
+    spec.destination = value;
+  }
+  else if(field == "expectedDelaySeconds")
+  {
+    spec.expectedDelaySeconds = value;
+  }
+  else if(field == "expectedReliabilityPercent")
+  {
+    spec.expectedReliabilityPercent = value;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
+/**
+ * \brief Set the fields of an element.
+ * \param spec element description
+ * \param fields fields and values, in patch order
+ */
+template <class Spec>
+static void SetFields(Spec &spec, const std::vector<std::pair<std::string, std::string> > &fields)
+{
+  for(size_t i = 0; i < fields.size(); i++)
+  {
+    SetField(spec, fields.at(i).first, fields.at(i).second);
+  }
+}
+
+/**
+ * \brief Check a field can be set, on a blank element.
+ * \param field field name
+ * \param value field value
+ * \return false if the element has no such field
+ */
+template <class Spec>
+static bool CheckField(const std::string &field, const std::string &value)
+{
+  Spec spec;
+  return SetField(spec, field, value);
+}
+
+TopologyPatch::Change::Change()
+{
+  this->remove = false;
+}
+
+TopologyPatch::TopologyPatch(TopologyBuilder &builder, Generator &gen) : m_builder(builder), m_gen(gen), m_added(""), m_read("")
+{
+  this->m_nNetworkHardwares = 0;
+  this->m_nApplications = 0;
+  this->m_nLines = 0;
+}
+
+TopologyPatch::~TopologyPatch()
+{
+}
+
+void TopologyPatch::Read(const std::string &fileName)
+{
+  std::ifstream file(fileName.c_str());
+  if(!file)
+  {
+    throw std::runtime_error("Cannot open patch " + fileName);
+  }
+
+  std::string dir;
+  std::string::size_type slash = fileName.rfind('/');
+  if(slash != std::string::npos)
+  {
+    dir = fileName.substr(0, slash + 1);
+  }
+
+  std::string line;
+  for(size_t lineNumber = 1; std::getline(file, line); lineNumber++)
+  {
+    std::istringstream in(line);
+    std::string command;
+    if(!(in >> command) || command[0] == '#')
+    {
+      continue;
+    }
+
+    std::ostringstream error;
+    error << fileName << ":" << lineNumber << " error: ";
+
+    if(command == "add")
+    {
+      std::string name;
+      if(!(in >> name))
+      {
+        throw std::runtime_error(error.str() + "add requires a topology file");
+      }
+      this->m_addedFiles.push_back(name[0] == '/' ? name : dir + name);
+      continue;
+    }
+
+    int kind = NETWORK_HARDWARE;
+    if(command == "remove" || command == "set")
+    {
+      std::string kindName;
+      in >> kindName;
+      for(kind = 0; kind < N_KINDS && kindName != g_kindNames[kind]; kind++)
+      {
+      }
+      if(kind == N_KINDS)
+      {
+        throw std::runtime_error(error.str() + "unknown element kind <" + kindName + ">");
+      }
+    }
+    else if(command != "connect" && command != "disconnect")
+    {
+      throw std::runtime_error(error.str() + "unknown change <" + command + ">");
+    }
+
+    std::string name;
+    if(!(in >> name))
+    {
+      throw std::runtime_error(error.str() + command + " requires an element name");
+    }
+    Change &change = this->m_changes[kind][name];
+
+    if(kind == NODE)
+    {
+      this->m_builder.KeepNode(name);
+    }
+
+    if(command == "remove")
+    {
+      change.remove = true;
+      if(kind == NODE)
+      {
+        this->m_removedNodes.insert(name);
+      }
+    }
+    else if(command == "set")
+    {
+      std::string field;
+      std::string value;
+      in >> field;
+      std::getline(in >> std::ws, value);
+      std::string::size_type end = value.find_last_not_of(" \t\r");
+      value.erase(end == std::string::npos ? 0 : end + 1);
+
+      bool known = false;
+      try
+      {
+        switch(kind)
+        {
+          case NODE:
+            known = CheckField<NodeSpec>(field, value);
+            break;
+          case NETWORK_HARDWARE:
+            known = CheckField<NetworkHardwareSpec>(field, value);
+            break;
+          case APPLICATION:
+            known = CheckField<ApplicationSpec>(field, value);
+            break;
+          default:
+            known = CheckField<FlowSpec>(field, value);
+            break;
+        }
+      }
+      catch(const std::runtime_error &)
+      {
+        throw std::runtime_error(error.str() + field + " <" + value + "> is not a number");
+      }
+      if(!known)
+      {
+        throw std::runtime_error(error.str() + "unknown " + g_kindNames[kind] + " field <" + field + ">");
+      }
+      change.fields.push_back(std::make_pair(field, value));
+    }
+    else
+    {
+      std::string nodeName;
+      if(!(in >> nodeName))
+      {
+        throw std::runtime_error(error.str() + command + " requires a node name");
+      }
+      (command == "connect" ? change.connect : change.disconnect).push_back(nodeName);
+      this->m_builder.KeepNode(nodeName);
+    }
+    this->m_nLines++;
+  }
+}
+
+const std::vector<std::string> &TopologyPatch::GetAddedFiles() const
+{
+  return this->m_addedFiles;
+}
+
+/**
+ * \brief Record the name of an added element, failing if it is already added.
+ * \param index added elements by name
+ * \param kind element kind, for the error message
+ * \param name element name
+ * \param position index of the element in the added elements
+ * \param fileName file declaring the element
+ */
+static void AddName(std::map<std::string, size_t> &index, const char *kind, const std::string &name, const size_t position, const std::string &fileName)
+{
+  if(!index.insert(std::make_pair(name, position)).second)
+  {
+    throw std::logic_error("Name collision: " + std::string(kind) + " " + name + " added twice, again by " + fileName);
+  }
+}
+
+void TopologyPatch::Add(const TopologyFragment &fragment)
+{
+  for(size_t i = 0; i < fragment.GetNodes().size(); i++)
+  {
+    AddName(this->m_addedIndex[NODE], g_kindNames[NODE], fragment.GetNodes().at(i).name, this->m_added.GetNodes().size(), fragment.GetFileName());
+    this->m_added.AddNode(fragment.GetNodes().at(i));
+    this->m_builder.KeepNode(fragment.GetNodes().at(i).name);
+  }
+  for(size_t i = 0; i < fragment.GetNetworkHardwares().size(); i++)
+  {
+    AddName(this->m_addedIndex[NETWORK_HARDWARE], g_kindNames[NETWORK_HARDWARE], fragment.GetNetworkHardwares().at(i).name, this->m_added.GetNetworkHardwares().size(), fragment.GetFileName());
+    this->m_added.AddNetworkHardware(fragment.GetNetworkHardwares().at(i));
+    const std::vector<std::string> &nodes = fragment.GetConnectedNodes().at(i);
+    for(size_t j = 0; j < nodes.size(); j++)
+    {
+      this->m_added.InstallNode(nodes.at(j));
+    }
+  }
+  for(size_t i = 0; i < fragment.GetApplications().size(); i++)
+  {
+    AddName(this->m_addedIndex[APPLICATION], g_kindNames[APPLICATION], fragment.GetApplications().at(i).name, this->m_added.GetApplications().size(), fragment.GetFileName());
+    this->m_added.AddApplication(fragment.GetApplications().at(i));
+  }
+  for(size_t i = 0; i < fragment.GetFlows().size(); i++)
+  {
+    AddName(this->m_addedIndex[FLOW], g_kindNames[FLOW], fragment.GetFlows().at(i).name, this->m_added.GetFlows().size(), fragment.GetFileName());
+    this->m_added.AddFlow(fragment.GetFlows().at(i));
+  }
+
+  for(int kind = 0; kind < N_KINDS; kind++)
+  {
+    std::map<std::string, size_t>::const_iterator it;
+    for(it = this->m_addedIndex[kind].begin(); it != this->m_addedIndex[kind].end(); it++)
+    {
+      const Change *change = this->FindChange(static_cast<Kind>(kind), it->first);
+      if(change != 0 && change->remove)
+      {
+        throw std::logic_error("Patch failed! " + std::string(g_kindNames[kind]) + " (" + it->first + ") is removed and added.");
+      }
+    }
+  }
+}
+
+size_t TopologyPatch::GetNChanges() const
+{
+  return this->m_nLines + this->m_added.GetNodes().size() + this->m_added.GetNetworkHardwares().size() + this->m_added.GetApplications().size() + this->m_added.GetFlows().size();
+}
+
+bool TopologyPatch::IsNamed(const Kind kind, const std::string &name) const
+{
+  size_t index = 0;
+  return this->FindChange(kind, name) != 0 || this->FindAdded(kind, name, index);
+}
+
+const TopologyPatch::Change *TopologyPatch::FindChange(const Kind kind, const std::string &name) const
+{
+  const std::map<std::string, Change> &changes = this->m_changes[kind];
+  if(changes.empty())
+  {
+    return 0;
+  }
+  std::map<std::string, Change>::const_iterator it = changes.find(name);
+  return it == changes.end() ? 0 : &it->second;
+}
+
+bool TopologyPatch::FindAdded(const Kind kind, const std::string &name, size_t &index) const
+{
+  const std::map<std::string, size_t> &added = this->m_addedIndex[kind];
+  if(added.empty())
+  {
+    return false;
+  }
+  std::map<std::string, size_t>::const_iterator it = added.find(name);
+  if(it == added.end())
+  {
+    return false;
+  }
+  index = it->second;
+  return true;
+}
+
+void TopologyPatch::Locate(const Kind kind, const std::string &name, const size_t position, const size_t spec)
+{
+  Location location;
+  location.position = position;
+  location.spec = spec;
+  this->m_located[kind].insert(std::make_pair(name, location));
+}
+
+/**
+ * \brief Check if a node name is a member of a range.
+ * \param name node name
+ * \param prefix range prefix
+ * \param first first index of the range
+ * \param last last index of the range
+ * \return true if name is the prefix followed by an index of the range
+ */
+static bool IsMember(const std::string &name, const std::string &prefix, const size_t first, const size_t last)
+{
+  size_t size = prefix.size();
+  if(name.size() <= size || name.size() - size > 18 || name.compare(0, size, prefix) != 0 || (name[size] == '0' && name.size() > size + 1))
+  {
+    return false;
+  }
+
+  size_t number = 0;
+  for(size_t i = size; i < name.size(); i++)
+  {
+    if(name[i] < '0' || name[i] > '9')
+    {
+      return false;
+    }
+    number = number * 10 + (name[i] - '0');
+  }
+
+  return number >= first && number <= last;
+}
+
+/**
+ * \brief Check if a node name of the topology refers to a removed node.
+ * \param removed removed node name, a range for a population
+ * \param name node name, a range for a population or several nodes
+ * \return true if name is the removed node, one of its members or a range holding it
+ */
+static bool Refers(const std::string &removed, const std::string &name)
+{
+  if(name == removed)
+  {
+    return true;
+  }
+
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  if(utils::parseRange(removed, prefix, first, last))
+  {
+    std::string namePrefix;
+    size_t nameFirst = 0;
+    size_t nameLast = 0;
+    if(utils::parseRange(name, namePrefix, nameFirst, nameLast))
+    {
+      return namePrefix == prefix && nameFirst <= last && first <= nameLast;
+    }
+    return IsMember(name, prefix, first, last);
+  }
+
+  return utils::parseRange(name, prefix, first, last) && IsMember(removed, prefix, first, last);
+}
+
+void TopologyPatch::CheckReference(const char *kind, const std::string &name, const std::string &nodeName) const
+{
+  std::set<std::string>::const_iterator it;
+  for(it = this->m_removedNodes.begin(); it != this->m_removedNodes.end(); it++)
+  {
+    if(Refers(*it, nodeName))
+    {
+      throw std::logic_error("Patch failed! " + std::string(kind) + " " + name + " refers to the removed node " + nodeName + ".");
+    }
+  }
+}
+
+/**
+ * \brief Check the nodes named by a patch do not name a part of a population.
+ *
+ * A population is a single Node of the model, which is only removed or
+ * changed whole.
+ *
+ * \param names node names, keys of the changes or of the added nodes
+ * \param population population name, a range
+ */
+template <class T>
+static void CheckWhole(const std::map<std::string, T> &names, const std::string &population)
+{
+  typename std::map<std::string, T>::const_iterator it;
+  for(it = names.begin(); it != names.end(); it++)
+  {
+    if(it->first != population && Refers(population, it->first))
+    {
+      throw std::logic_error("Patch failed! node " + it->first + " is a part of the population " + population + ", only the whole population can be removed, changed or replaced.");
+    }
+  }
+}
+
+void TopologyPatch::AddNode(const NodeSpec &spec)
+{
+  std::string prefix;
+  size_t first = 0;
+  size_t last = 0;
+  if((!this->m_changes[NODE].empty() || !this->m_addedIndex[NODE].empty()) && utils::parseRange(spec.name, prefix, first, last))
+  {
+    CheckWhole(this->m_changes[NODE], spec.name);
+    CheckWhole(this->m_addedIndex[NODE], spec.name);
+  }
+  this->m_builder.AddNode(spec);
+}
+
+void TopologyPatch::AddNetworkHardware(const NetworkHardwareSpec &spec)
+{
+  this->m_builder.AddNetworkHardware(spec);
+  if(this->IsNamed(NETWORK_HARDWARE, spec.name))
+  {
+    this->Locate(NETWORK_HARDWARE, spec.name, this->m_nNetworkHardwares, this->m_read.GetNetworkHardwares().size());
+    this->m_read.AddNetworkHardware(spec);
+  }
+  this->m_nNetworkHardwares++;
+}
+
+void TopologyPatch::InstallNode(const std::string &nodeName)
+{
+  this->m_builder.InstallNode(nodeName);
+
+  /* the removed nodes are disconnected once the model is built. */
+  std::set<std::string>::const_iterator it;
+  for(it = this->m_removedNodes.begin(); it != this->m_removedNodes.end(); it++)
+  {
+    if(Refers(*it, nodeName))
+    {
+      this->m_removedInstalls.push_back(std::make_pair(this->m_nNetworkHardwares - 1, *it));
+    }
+  }
+}
+
+void TopologyPatch::AddApplication(const ApplicationSpec &spec)
+{
+  this->m_builder.AddApplication(spec);
+  if(this->IsNamed(APPLICATION, spec.name))
+  {
+    this->Locate(APPLICATION, spec.name, this->m_nApplications, this->m_read.GetApplications().size());
+    this->m_read.AddApplication(spec);
+  }
+  else
+  {
+    this->CheckReference(g_kindNames[APPLICATION], spec.name, spec.sender);
+    this->CheckReference(g_kindNames[APPLICATION], spec.name, spec.receiver);
+  }
+  this->m_nApplications++;
+}
+
+void TopologyPatch::AddFlow(const FlowSpec &spec)
+{
+  this->m_builder.AddFlow(spec);
+  if(this->IsNamed(FLOW, spec.name))
+  {
+    this->Locate(FLOW, spec.name, 0, this->m_read.GetFlows().size());
+    this->m_read.AddFlow(spec);
+  }
+  else
+  {
+    this->CheckReference(g_kindNames[FLOW], spec.name, spec.source);
+    this->CheckReference(g_kindNames[FLOW], spec.name, spec.destination);
+  }
+}
+
+void TopologyPatch::Apply()
+{
+  std::map<std::string, Node*> nodes;
+  this->Check(nodes);
+
+  /* the removed nodes leave their network hardwares while the positions are the ones of the read. */
+  for(size_t i = 0; i < this->m_removedInstalls.size(); i++)
+  {
+    this->m_builder.Disconnect(this->m_removedInstalls.at(i).first, this->m_removedInstalls.at(i).second);
+  }
+
+  /* the builder finds the nodes by position: the nodes are removed last. */
+  std::vector<std::pair<Node*, NodeSpec> > replaced;
+  this->ApplyNodes(nodes, replaced);
+  this->ApplyNetworkHardwares();
+  this->ApplyApplications();
+  this->ApplyFlows();
+  this->ReplaceNodes(nodes, replaced);
+}
+
+void TopologyPatch::Check(std::map<std::string, Node*> &nodes)
+{
+  std::map<std::string, Change>::const_iterator it;
+  for(it = this->m_changes[NODE].begin(); it != this->m_changes[NODE].end(); it++)
+  {
+    Node *node = this->m_builder.FindNode(it->first);
+    if(node == 0)
+    {
+      throw std::logic_error("Patch failed! " + std::string(g_kindNames[NODE]) + " (" + it->first + ") not found.");
+    }
+    nodes[it->first] = node;
+  }
+  for(size_t i = 0; i < this->m_added.GetNodes().size(); i++)
+  {
+    const std::string &name = this->m_added.GetNodes().at(i).name;
+    Node *node = this->m_builder.FindNode(name);
+    if(node != 0)
+    {
+      nodes[name] = node;
+    }
+  }
+
+  for(int kind = NETWORK_HARDWARE; kind < N_KINDS; kind++)
+  {
+    for(it = this->m_changes[kind].begin(); it != this->m_changes[kind].end(); it++)
+    {
+      if(this->m_located[kind].find(it->first) == this->m_located[kind].end())
+      {
+        throw std::logic_error("Patch failed! " + std::string(g_kindNames[kind]) + " (" + it->first + ") not found.");
+      }
+    }
+  }
+}
+
+/**
+ * \brief Get the description of a node of the model.
+ * \param name node name
+ * \param node node
+ * \return node description
+ */
+static NodeSpec DescribeNode(const std::string &name, Node *node)
+{
+  NodeSpec spec;
+  spec.name = name;
+  spec.type = node->GetNodeType();
+  spec.enableFlowmonitor = node->GetFlowmonitor() ? "true" : "false";
+  return spec;
+}
+
+void TopologyPatch::ApplyNodes(const std::map<std::string, Node*> &nodes, std::vector<std::pair<Node*, NodeSpec> > &replaced)
+{
+  std::map<std::string, Node*>::const_iterator found;
+  for(size_t i = 0; i < this->m_added.GetNodes().size(); i++)
+  {
+    NodeSpec spec(this->m_added.GetNodes().at(i));
+    const Change *change = this->FindChange(NODE, spec.name);
+    if(change != 0)
+    {
+      SetFields(spec, change->fields);
+    }
+
+    found = nodes.find(spec.name);
+    if(found == nodes.end())
+    {
+      this->m_builder.AddNode(spec);
+    }
+    else if(spec.type == found->second->GetNodeType())
+    {
+      this->m_builder.SetNodeFields(found->second, spec);
+    }
+    else
+    {
+      replaced.push_back(std::make_pair(found->second, spec));
+    }
+  }
+  this->m_builder.Finish();
+
+  std::map<std::string, Change>::const_iterator it;
+  for(it = this->m_changes[NODE].begin(); it != this->m_changes[NODE].end(); it++)
+  {
+    size_t index = 0;
+    if(it->second.remove || this->FindAdded(NODE, it->first, index))
+    {
+      continue;
+    }
+
+    Node *node = nodes.find(it->first)->second;
+    NodeSpec spec = DescribeNode(it->first, node);
+    SetFields(spec, it->second.fields);
+    if(spec.type == node->GetNodeType())
+    {
+      this->m_builder.SetNodeFields(node, spec);
+    }
+    else
+    {
+      replaced.push_back(std::make_pair(node, spec));
+    }
+  }
+}
+
+void TopologyPatch::ApplyNetworkHardwares()
+{
+  /* the network hardwares kept in place are changed first, while the positions are the ones of the read. */
+  std::vector<std::string> removed;
+  std::vector<NetworkHardwareSpec> retyped;
+  std::vector<std::vector<std::string> > retypedInstalls;
+  std::vector<const Change*> retypedChanges;
+  std::map<std::string, Location>::const_iterator it;
+  for(it = this->m_located[NETWORK_HARDWARE].begin(); it != this->m_located[NETWORK_HARDWARE].end(); it++)
+  {
+    NetworkHardware *hw = this->m_gen.GetNetworkHardware(it->second.position);
+    const NetworkHardwareSpec &read = this->m_read.GetNetworkHardwares().at(it->second.spec);
+    const Change *change = this->FindChange(NETWORK_HARDWARE, it->first);
+    size_t index = 0;
+    if(this->FindAdded(NETWORK_HARDWARE, it->first, index) || change->remove)
+    {
+      removed.push_back(hw->GetNetworkHardwareName());
+      continue;
+    }
+
+    NetworkHardwareSpec spec(read);
+    SetFields(spec, change->fields);
+    if(spec.type == read.type)
+    {
+      this->m_builder.SetNetworkHardwareFields(hw, spec);
+      this->Reconnect(it->second.position, change);
+      continue;
+    }
+
+    /* a network hardware whose type changes is added again with its installs. */
+    removed.push_back(hw->GetNetworkHardwareName());
+    retyped.push_back(spec);
+    retypedChanges.push_back(change);
+    retypedInstalls.push_back(std::vector<std::string>());
+    for(size_t i = 0; i < hw->GetInstalledNodes().size(); i++)
+    {
+      retypedInstalls.back().push_back(hw->GetInstalledNode(i));
+    }
+  }
+
+  for(size_t i = 0; i < removed.size(); i++)
+  {
+    this->m_gen.RemoveNetworkHardware(removed.at(i));
+  }
+
+  for(size_t i = 0; i < retyped.size(); i++)
+  {
+    this->m_builder.AddNetworkHardware(retyped.at(i));
+    size_t link = this->m_gen.GetNNetworkHardwares() - 1;
+    NetworkHardware *hw = this->m_gen.GetNetworkHardware(link);
+    for(size_t j = 0; j < retypedInstalls.at(i).size(); j++)
+    {
+      hw->Install(retypedInstalls.at(i).at(j));
+    }
+    this->Reconnect(link, retypedChanges.at(i));
+  }
+
+  for(size_t i = 0; i < this->m_added.GetNetworkHardwares().size(); i++)
+  {
+    NetworkHardwareSpec spec(this->m_added.GetNetworkHardwares().at(i));
+    const Change *change = this->FindChange(NETWORK_HARDWARE, spec.name);
+    if(change != 0)
+    {
+      SetFields(spec, change->fields);
+    }
+
+    this->m_builder.AddNetworkHardware(spec);
+    const std::vector<std::string> &nodes = this->m_added.GetConnectedNodes().at(i);
+    for(size_t j = 0; j < nodes.size(); j++)
+    {
+      this->m_builder.InstallNode(nodes.at(j));
+    }
+    this->Reconnect(this->m_gen.GetNNetworkHardwares() - 1, change);
+  }
+}
+
+void TopologyPatch::Reconnect(const size_t link, const Change *change)
+{
+  if(change == 0)
+  {
+    return;
+  }
+
+  for(size_t i = 0; i < change->disconnect.size(); i++)
+  {
+    if(this->m_builder.Disconnect(link, change->disconnect.at(i)) == 0)
+    {
+      throw std::logic_error("Disconnect failed! (" + change->disconnect.at(i) + ") not connected.");
+    }
+  }
+  for(size_t i = 0; i < change->connect.size(); i++)
+  {
+    this->m_builder.Connect(link, change->connect.at(i));
+  }
+}
+
+void TopologyPatch::ApplyApplications()
+{
+  /* every application named by the patch is removed, the modified ones are added again. */
+  std::vector<std::string> removed;
+  std::map<std::string, Location>::const_iterator it;
+  for(it = this->m_located[APPLICATION].begin(); it != this->m_located[APPLICATION].end(); it++)
+  {
+    removed.push_back(this->m_gen.GetApplication(it->second.position)->GetAppName());
+  }
+  for(size_t i = 0; i < removed.size(); i++)
+  {
+    this->m_gen.RemoveApplication(removed.at(i));
+  }
+
+  for(it = this->m_located[APPLICATION].begin(); it != this->m_located[APPLICATION].end(); it++)
+  {
+    const Change *change = this->FindChange(APPLICATION, it->first);
+    size_t index = 0;
+    if(this->FindAdded(APPLICATION, it->first, index) || change->remove)
+    {
+      continue;
+    }
+
+    ApplicationSpec spec(this->m_read.GetApplications().at(it->second.spec));
+    SetFields(spec, change->fields);
+    this->CheckReference(g_kindNames[APPLICATION], spec.name, spec.sender);
+    this->CheckReference(g_kindNames[APPLICATION], spec.name, spec.receiver);
+    this->m_builder.AddApplication(spec);
+  }
+
+  for(size_t i = 0; i < this->m_added.GetApplications().size(); i++)
+  {
+    ApplicationSpec spec(this->m_added.GetApplications().at(i));
+    const Change *change = this->FindChange(APPLICATION, spec.name);
+    if(change != 0)
+    {
+      SetFields(spec, change->fields);
+    }
+    this->CheckReference(g_kindNames[APPLICATION], spec.name, spec.sender);
+    this->CheckReference(g_kindNames[APPLICATION], spec.name, spec.receiver);
+    this->m_builder.AddApplication(spec);
+  }
+}
+
+void TopologyPatch::ApplyFlows()
+{
+  /* every flow named by the patch is removed, the modified ones are added again. */
+  std::map<std::string, Location>::const_iterator it;
+  for(it = this->m_located[FLOW].begin(); it != this->m_located[FLOW].end(); it++)
+  {
+    this->m_gen.RemoveFlow(it->first);
+  }
+
+  for(it = this->m_located[FLOW].begin(); it != this->m_located[FLOW].end(); it++)
+  {
+    const Change *change = this->FindChange(FLOW, it->first);
+    size_t index = 0;
+    if(this->FindAdded(FLOW, it->first, index) || change->remove)
+    {
+      continue;
+    }
+
+    FlowSpec spec(this->m_read.GetFlows().at(it->second.spec));
+    SetFields(spec, change->fields);
+    this->CheckReference(g_kindNames[FLOW], spec.name, spec.source);
+    this->CheckReference(g_kindNames[FLOW], spec.name, spec.destination);
+    this->m_builder.AddFlow(spec);
+  }
+
+  for(size_t i = 0; i < this->m_added.GetFlows().size(); i++)
+  {
+    FlowSpec spec(this->m_added.GetFlows().at(i));
+    const Change *change = this->FindChange(FLOW, spec.name);
+    if(change != 0)
+    {
+      SetFields(spec, change->fields);
+    }
+    this->CheckReference(g_kindNames[FLOW], spec.name, spec.source);
+    this->CheckReference(g_kindNames[FLOW], spec.name, spec.destination);
+    this->m_builder.AddFlow(spec);
+  }
+}
+
+void TopologyPatch::ReplaceNodes(const std::map<std::string, Node*> &nodes, const std::vector<std::pair<Node*, NodeSpec> > &replaced)
+{
+  for(size_t i = 0; i < replaced.size(); i++)
+  {
+    Node *node = replaced.at(i).first;
+    const NodeSpec &spec = replaced.at(i).second;
+    std::string name = node->GetNodeName();
+    size_t number = node->GetMachinesNumber();
+    bool population = node->IsPopulation();
+    std::string prefix = node->GetMemberPrefix();
+    std::string suffix = node->GetMemberSuffix();
+    size_t first = node->GetFirstMember();
+
+    this->m_gen.RemoveNode(name);
+    this->m_gen.AddNode(spec.type, name, number);
+    node = this->m_gen.FindNode(name);
+    if(population)
+    {
+      node->SetMemberNames(prefix, first, suffix);
+    }
+    this->m_builder.SetNodeFields(node, spec);
+  }
+
+  std::map<std::string, Change>::const_iterator it;
+  for(it = this->m_changes[NODE].begin(); it != this->m_changes[NODE].end(); it++)
+  {
+    if(it->second.remove)
+    {
+      this->m_gen.RemoveNode(nodes.find(it->first)->second->GetNodeName());
+    }
+  }
+}
@@ -0,0 +1,360 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-patch.h
+ * \brief Changes applied to a built topology model.
+ */
+
+#ifndef TOPOLOGY_PATCH_H
+#define TOPOLOGY_PATCH_H
+
+#include "topology-fragment.h"
+#include "topology-sink.h"
+
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Generator;
+class Node;
+class TopologyBuilder;
+
+/**
+ * \ingroup generator
+ * \brief Changes applied to a built topology model.
+ *
+ *  The topology (read, or replayed from a snapshot) goes through the patch
+ *  unchanged on its way to the builder, the patch only notes where the
+ *  elements it names are. Once the model is built, Apply() edits it in
+ *  place: the removed elements leave through the Generator Remove*, whose
+ *  empty slots are dropped by a single compaction before the generation,
+ *  the modified fields are set on the elements, an element whose type
+ *  changes is removed and added again, and the added elements go through
+ *  the builder. The work is proportional to the size of the patch, not to
+ *  the size of the model.
+ *
+ *  The patch file holds one change per line, empty lines and lines
+ *  starting with '#' are ignored:
+ *
+ *    remove <kind> <name>
+ *    set <kind> <name> <field> <value>
+ *    connect <network hardware name> <node name>
+ *    disconnect <network hardware name> <node name>
+ *    add <topology file>
+ *
+ *  The kind is node, networkHardware, application or flow, and the field
+ *  is the name of one of its elements in TopologySchema.xsd (dataRate,
+ *  endTime, ...). The elements of an added topology file replace the
+ *  elements of the same name, or are appended. Removing a node also
+ *  disconnects it from its network hardwares, an application or flow
+ *  still referring to it is an error.
+ *
+ *  The replaced elements, the applications and flows modified and the
+ *  nodes and network hardwares whose type changes come after the others
+ *  in the generated code. The nodes named by the patch are not grouped
+ *  in populations.
+ *
+ *  A node declared as a range (station_[0..8]) is a single population
+ *  Node of the model, it is only removed, changed, replaced or
+ *  disconnected whole: naming one of its members, or a part of its range,
+ *  is an error, splitting the population would rewrite every element
+ *  referring to it.
+ */
+class TopologyPatch : public TopologySink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param builder builder receiving the topology
+     * \param gen generator populated by the builder
+     */
+    TopologyPatch(TopologyBuilder &builder, Generator &gen);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~TopologyPatch();
+
+    /**
+     * \brief Read a patch file.
+     *
+     * The topology files of its add lines are not read, see GetAddedFiles().
+     *
+     * \param fileName patch file name
+     * \throw std::runtime_error if the file cannot be read or a line is invalid
+     */
+    void Read(const std::string &fileName);
+
+    /**
+     * \brief Get the topology files of the add lines.
+     *
+     * Relative names are relative to the directory of the patch file.
+     *
+     * \return topology file names, in patch order
+     */
+    const std::vector<std::string> &GetAddedFiles() const;
+
+    /**
+     * \brief Add the elements of a topology file.
+     * \param fragment elements read from an added file
+     * \throw std::logic_error if an element is already added or removed
+     */
+    void Add(const TopologyFragment &fragment);
+
+    /**
+     * \brief Get the number of changes.
+     * \return number of lines and added elements of the patch
+     */
+    size_t GetNChanges() const;
+
+    virtual void AddNode(const NodeSpec &spec);
+    virtual void AddNetworkHardware(const NetworkHardwareSpec &spec);
+    virtual void InstallNode(const std::string &nodeName);
+    virtual void AddApplication(const ApplicationSpec &spec);
+    virtual void AddFlow(const FlowSpec &spec);
+
+    /**
+     * \brief Apply the changes to the model.
+     *
+     * It must be called once the builder is finished.
+     *
+     * \throw std::logic_error if an element named by the patch was not read
+     */
+    void Apply();
+
+  private:
+    /**
+     * \brief Element kinds, in topology order.
+     */
+    enum Kind
+    {
+      NODE,
+      NETWORK_HARDWARE,
+      APPLICATION,
+      FLOW,
+      N_KINDS
+    };
+
+    /**
+     * \brief Changes of one element.
+     */
+    struct Change
+    {
+      Change();
+
+      /**
+       * \brief The element is removed.
+       */
+      bool remove;
+
+      /**
+       * \brief Fields set, in patch order.
+       */
+      std::vector<std::pair<std::string, std::string> > fields;
+
+      /**
+       * \brief Nodes connected to a network hardware.
+       */
+      std::vector<std::string> connect;
+
+      /**
+       * \brief Nodes disconnected from a network hardware.
+       */
+      std::vector<std::string> disconnect;
+    };
+
+    /**
+     * \brief Element read, named by the patch.
+     */
+    struct Location
+    {
+      /**
+       * \brief Position of the element in the Generator list of its kind.
+       */
+      size_t position;
+
+      /**
+       * \brief Index of its description in m_read.
+       */
+      size_t spec;
+    };
+
+    /**
+     * \brief Copy constructor (not implemented).
+     */
+    TopologyPatch(const TopologyPatch &);
+
+    /**
+     * \brief Assignment (not implemented).
+     */
+    TopologyPatch &operator=(const TopologyPatch &);
+
+    /**
+     * \brief Check if the patch names an element.
+     * \param kind element kind
+     * \param name element name
+     * \return true if the element is changed or replaced
+     */
+    bool IsNamed(const Kind kind, const std::string &name) const;
+
+    /**
+     * \brief Get the changes of an element.
+     * \param kind element kind
+     * \param name element name
+     * \return the changes, 0 if the element is not changed
+     */
+    const Change *FindChange(const Kind kind, const std::string &name) const;
+
+    /**
+     * \brief Get an added element.
+     * \param kind element kind
+     * \param name element name
+     * \param index index of the element in the added elements
+     * \return false if the element is not added
+     */
+    bool FindAdded(const Kind kind, const std::string &name, size_t &index) const;
+
+    /**
+     * \brief Note where an element named by the patch is.
+     * \param kind element kind
+     * \param name element name
+     * \param position position of the element in the Generator list of its kind
+     * \param spec index of its description in m_read
+     */
+    void Locate(const Kind kind, const std::string &name, const size_t position, const size_t spec);
+
+    /**
+     * \brief Check the changes name elements of the model and locate the nodes.
+     * \param nodes Generator nodes of the node changes and of the added nodes replacing one
+     */
+    void Check(std::map<std::string, Node*> &nodes);
+
+    /**
+     * \brief Apply the node changes but the removals and the type changes.
+     * \param nodes Generator nodes of the node changes and of the added nodes replacing one
+     * \param replaced nodes to remove and add again, with their new description
+     */
+    void ApplyNodes(const std::map<std::string, Node*> &nodes, std::vector<std::pair<Node*, NodeSpec> > &replaced);
+
+    /**
+     * \brief Apply the network hardware changes.
+     */
+    void ApplyNetworkHardwares();
+
+    /**
+     * \brief Apply the connect and disconnect lines of a network hardware.
+     * \param link index of the network hardware in the Generator
+     * \param change changes of the network hardware, or 0
+     */
+    void Reconnect(const size_t link, const Change *change);
+
+    /**
+     * \brief Apply the application changes.
+     */
+    void ApplyApplications();
+
+    /**
+     * \brief Apply the flow changes.
+     */
+    void ApplyFlows();
+
+    /**
+     * \brief Remove the removed nodes and add again the nodes whose type changes.
+     * \param nodes Generator nodes of the node changes and of the added nodes replacing one
+     * \param replaced nodes to remove and add again, with their new description
+     */
+    void ReplaceNodes(const std::map<std::string, Node*> &nodes, const std::vector<std::pair<Node*, NodeSpec> > &replaced);
+
+    /**
+     * \brief Check a node referred to by an element is not removed.
+     * \param kind referring element kind, for the error message
+     * \param name referring element name
+     * \param nodeName node name
+     */
+    void CheckReference(const char *kind, const std::string &name, const std::string &nodeName) const;
+
+    /**
+     * \brief Builder receiving the topology.
+     */
+    TopologyBuilder &m_builder;
+
+    /**
+     * \brief Generator populated by the builder.
+     */
+    Generator &m_gen;
+
+    /**
+     * \brief Topology files of the add lines.
+     */
+    std::vector<std::string> m_addedFiles;
+
+    /**
+     * \brief Changes of each kind, by element name.
+     */
+    std::map<std::string, Change> m_changes[N_KINDS];
+
+    /**
+     * \brief Added elements.
+     */
+    TopologyFragment m_added;
+
+    /**
+     * \brief Index of the added elements of each kind, by element name.
+     */
+    std::map<std::string, size_t> m_addedIndex[N_KINDS];
+
+    /**
+     * \brief Descriptions of the network hardwares, applications and flows read and named by the patch.
+     */
+    TopologyFragment m_read;
+
+    /**
+     * \brief Network hardwares, applications and flows read and named by the patch, by element name.
+     */
+    std::map<std::string, Location> m_located[N_KINDS];
+
+    /**
+     * \brief Names of the removed nodes.
+     */
+    std::set<std::string> m_removedNodes;
+
+    /**
+     * \brief Installs of the removed nodes: network hardware position and removed node name.
+     */
+    std::vector<std::pair<size_t, std::string> > m_removedInstalls;
+
+    /**
+     * \brief Number of network hardwares read.
+     */
+    size_t m_nNetworkHardwares;
+
+    /**
+     * \brief Number of applications read.
+     */
+    size_t m_nApplications;
+
+    /**
+     * \brief Number of lines of the patch.
+     */
+    size_t m_nLines;
+};
+
+#endif /* TOPOLOGY_PATCH_H */
@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-sink.cpp
+ * \brief Receiver of the topology elements read from an input.
+ */
+
+#include "topology-sink.h"
+
+TopologySink::~TopologySink()
+{
+}
+
+TopologyTee::TopologyTee(TopologySink &first, TopologySink &second) : m_first(first), m_second(second)
+{
+}
+
+TopologyTee::~TopologyTee()
+{
+}
+
+void TopologyTee::AddNode(const NodeSpec &spec)
+{
+  this->m_first.AddNode(spec);
+  this->m_second.AddNode(spec);
+}
+
+void TopologyTee::AddNetworkHardware(const NetworkHardwareSpec &spec)
+{
+  this->m_first.AddNetworkHardware(spec);
+  this->m_second.AddNetworkHardware(spec);
+}
+
+void TopologyTee::InstallNode(const std::string &nodeName)
+{
+  this->m_first.InstallNode(nodeName);
+  this->m_second.InstallNode(nodeName);
+}
+
+void TopologyTee::AddApplication(const ApplicationSpec &spec)
+{
+  this->m_first.AddApplication(spec);
+  this->m_second.AddApplication(spec);
+}
+
+void TopologyTee::AddFlow(const FlowSpec &spec)
+{
+  this->m_first.AddFlow(spec);
+  this->m_second.AddFlow(spec);
+}
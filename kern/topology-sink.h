@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-sink.h
+ * \brief Receiver of the topology elements read from an input.
+ */
+
+#ifndef TOPOLOGY_SINK_H
+#define TOPOLOGY_SINK_H
+
+#include "topology-spec.h"
+
+#include <string>
+
+/**
+ * \ingroup generator
+ * \brief Receiver of the topology elements read from an input.
+ *
+ *  Readers pass the elements in document order: nodes, then each network
+ *  hardware followed by its connected nodes, then applications and flows.
+ */
+class TopologySink
+{
+  public:
+    /**
+     * \brief Destructor.
+     */
+    virtual ~TopologySink();
+
+    /**
+     * \brief Add a node.
+     * \param spec node description
+     */
+    virtual void AddNode(const NodeSpec &spec) = 0;
+
+    /**
+     * \brief Add a network hardware.
+     *
+     * The hardware becomes the target of the following InstallNode calls.
+     *
+     * \param spec network hardware description
+     */
+    virtual void AddNetworkHardware(const NetworkHardwareSpec &spec) = 0;
+
+    /**
+     * \brief Connect a node to the last added network hardware.
+     * \param nodeName node name
+     */
+    virtual void InstallNode(const std::string &nodeName) = 0;
+
+    /**
+     * \brief Add an application.
+     * \param spec application description
+     */
+    virtual void AddApplication(const ApplicationSpec &spec) = 0;
+
+    /**
+     * \brief Add a flow.
+     * \param spec flow description
+     */
+    virtual void AddFlow(const FlowSpec &spec) = 0;
+};
+
+/**
+ * \ingroup generator
+ * \brief Pass the topology elements to two sinks.
+ */
+class TopologyTee : public TopologySink
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param first sink receiving the elements first
+     * \param second sink receiving the elements next
+     */
+    TopologyTee(TopologySink &first, TopologySink &second);
+
+    /**
+     * \brief Destructor.
+     */
+    virtual ~TopologyTee();
+
+    virtual void AddNode(const NodeSpec &spec);
+    virtual void AddNetworkHardware(const NetworkHardwareSpec &spec);
+    virtual void InstallNode(const std::string &nodeName);
+    virtual void AddApplication(const ApplicationSpec &spec);
+    virtual void AddFlow(const FlowSpec &spec);
+
+  private:
+    /**
+     * \brief First sink.
+     */
+    TopologySink &m_first;
+
+    /**
+     * \brief Second sink.
+     */
+    TopologySink &m_second;
+};
+
+#endif /* TOPOLOGY_SINK_H */
@@ -0,0 +1,435 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-snapshot.cpp
+ * \brief Binary snapshot of the topology elements of an input.
+ *
+ * A snapshot is a fixed header followed by the records. The header holds
+ * the format version, the byte order of the writer, the key of the input,
+ * the size and hash of the records. Each record is a kind byte followed
+ * by its fields: strings are a 32 bits length and the bytes, integers are
+ * 64 bits. Numbers are written in the byte order of the writer.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+#include "topology-snapshot.h"
+#include "utils.h"
+
+/**
+ * \brief Snapshot format version, to increase on any format change.
+ */
+static const uint32_t SNAPSHOT_VERSION = 1;
+
+/**
+ * \brief Written as is, tells the byte order of the writer.
+ */
+static const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+/**
+ * \brief Snapshot file header.
+ */
+struct SnapshotHeader
+{
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t key;
+  uint64_t payloadSize;
+  uint64_t payloadHash;
+  uint64_t nRecords;
+};
+
+static const char SNAPSHOT_MAGIC[8] = { 'G', 'E', 'N', 'S', 'N', 'A', 'P', '\0' };
+
+/**
+ * \brief Record kinds.
+ */
+enum SnapshotRecord
+{
+  RECORD_NODE = 1,
+  RECORD_NETWORK_HARDWARE,
+  RECORD_INSTALL_NODE,
+  RECORD_APPLICATION,
+  RECORD_FLOW
+};
+
+/**
+ * \brief Bits of the application parameters presence.
+ */
+enum ApplicationParameter
+{
+  PARAM_PORT = 1,
+  PARAM_INTERVAL = 2,
+  PARAM_READING_TIME = 4,
+  PARAM_PACKET_SIZE = 8,
+  PARAM_MAX_PACKET_COUNT = 16,
+  PARAM_PACKET_INTERVAL_TIME = 32
+};
+
+/**
+ * \brief Records buffered before being written.
+ */
+static const size_t SNAPSHOT_BUFFER_SIZE = 1 << 20;
+
+uint64_t ComputeSnapshotKey(const std::vector<std::string> &inputFiles, const char *schema, const size_t schemaSize)
+{
+  MappedFile file;
+  uint64_t key = utils::hashBytes(0, 0);
+  for(size_t i = 0; i < inputFiles.size(); i++)
+  {
+    file.Open(inputFiles.at(i));
+    key = utils::hashBytes(file.GetData(), file.GetSize(), key);
+  }
+
+  return utils::hashBytes(schema, schemaSize, key);
+}
+
+TopologySnapshotWriter::TopologySnapshotWriter()
+{
+  this->m_key = 0;
+  this->m_payloadHash = utils::hashBytes(0, 0);
+  this->m_payloadSize = 0;
+  this->m_nRecords = 0;
+}
+
+TopologySnapshotWriter::~TopologySnapshotWriter()
+{
+  if(this->m_file.is_open())
+  {
+    this->m_file.close();
+    unlink(this->m_tmpFileName.c_str());
+  }
+}
+
+void TopologySnapshotWriter::Open(const std::string &fileName, const uint64_t key)
+{
+  this->m_fileName = fileName;
+  this->m_tmpFileName = fileName + ".tmp." + utils::integerToString(getpid());
+  this->m_key = key;
+  this->m_payloadHash = utils::hashBytes(0, 0);
+  this->m_payloadSize = 0;
+  this->m_nRecords = 0;
+  this->m_buffer.clear();
+
+  this->m_file.open(this->m_tmpFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if(!this->m_file)
+  {
+    throw std::runtime_error("Cannot create snapshot " + this->m_tmpFileName);
+  }
+
+  /* the header is written by Commit(), once the records are known. */
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  this->m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void TopologySnapshotWriter::Commit()
+{
+  this->Flush();
+
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.byteOrder = SNAPSHOT_BYTE_ORDER;
+  header.key = this->m_key;
+  header.payloadSize = this->m_payloadSize;
+  header.payloadHash = this->m_payloadHash;
+  header.nRecords = this->m_nRecords;
+
+  this->m_file.seekp(0);
+  this->m_file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  this->m_file.close();
+  if(!this->m_file)
+  {
+    unlink(this->m_tmpFileName.c_str());
+    throw std::runtime_error("Cannot write snapshot " + this->m_tmpFileName);
+  }
+
+  if(rename(this->m_tmpFileName.c_str(), this->m_fileName.c_str()) != 0)
+  {
+    unlink(this->m_tmpFileName.c_str());
+    throw std::runtime_error("Cannot rename snapshot to " + this->m_fileName);
+  }
+}
+
+void TopologySnapshotWriter::BeginRecord(const unsigned char kind)
+{
+  if(this->m_buffer.size() >= SNAPSHOT_BUFFER_SIZE)
+  {
+    this->Flush();
+  }
+  this->m_buffer += static_cast<char>(kind);
+  this->m_nRecords++;
+}
+
+void TopologySnapshotWriter::PutString(const std::string &str)
+{
+  uint32_t length = str.size();
+  this->m_buffer.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  this->m_buffer.append(str);
+}
+
+void TopologySnapshotWriter::PutInteger(const uint64_t value)
+{
+  this->m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void TopologySnapshotWriter::Flush()
+{
+  if(!this->m_file.is_open())
+  {
+    throw std::logic_error("Snapshot not opened.");
+  }
+
+  this->m_payloadHash = utils::hashBytes(this->m_buffer.data(), this->m_buffer.size(), this->m_payloadHash);
+  this->m_payloadSize += this->m_buffer.size();
+  this->m_file.write(this->m_buffer.data(), this->m_buffer.size());
+  this->m_buffer.clear();
+}
+
+void TopologySnapshotWriter::AddNode(const NodeSpec &spec)
+{
+  this->BeginRecord(RECORD_NODE);
+  this->PutString(spec.type);
+  this->PutString(spec.name);
+  this->PutString(spec.enableFlowmonitor);
+}
+
+void TopologySnapshotWriter::AddNetworkHardware(const NetworkHardwareSpec &spec)
+{
+  this->BeginRecord(RECORD_NETWORK_HARDWARE);
+  this->PutString(spec.type);
+  this->PutString(spec.name);
+  this->PutString(spec.dataRate);
+  this->PutString(spec.linkDelay);
+  this->PutString(spec.enableTrace);
+}
+
+void TopologySnapshotWriter::InstallNode(const std::string &nodeName)
+{
+  this->BeginRecord(RECORD_INSTALL_NODE);
+  this->PutString(nodeName);
+}
+
+void TopologySnapshotWriter::AddApplication(const ApplicationSpec &spec)
+{
+  uint64_t params = 0;
+  params |= spec.hasPort ? PARAM_PORT : 0;
+  params |= spec.hasInterval ? PARAM_INTERVAL : 0;
+  params |= spec.hasReadingTime ? PARAM_READING_TIME : 0;
+  params |= spec.hasPacketSize ? PARAM_PACKET_SIZE : 0;
+  params |= spec.hasMaxPacketCount ? PARAM_MAX_PACKET_COUNT : 0;
+  params |= spec.hasPacketIntervalTime ? PARAM_PACKET_INTERVAL_TIME : 0;
+
+  this->BeginRecord(RECORD_APPLICATION);
+  this->PutString(spec.type);
+  this->PutString(spec.name);
+  this->PutString(spec.sender);
+  this->PutString(spec.receiver);
+  this->PutInteger(spec.startTime);
+  this->PutInteger(spec.endTime);
+  this->PutInteger(params);
+  this->PutInteger(spec.port);
+  this->PutInteger(spec.interval);
+  this->PutInteger(spec.readingTime);
+  this->PutInteger(spec.packetSize);
+  this->PutInteger(spec.maxPacketCount);
+  this->PutString(spec.packetIntervalTime);
+}
+
+void TopologySnapshotWriter::AddFlow(const FlowSpec &spec)
+{
+  this->BeginRecord(RECORD_FLOW);
+  this->PutString(spec.type);
+  this->PutString(spec.name);
+  this->PutString(spec.source);
+  this->PutString(spec.destination);
+  this->PutString(spec.expectedDelaySeconds);
+  this->PutString(spec.expectedReliabilityPercent);
+}
+
+/**
+ * \brief Read position in the records.
+ */
+struct SnapshotCursor
+{
+  const char *p;
+  const char *end;
+
+  void Need(const size_t size)
+  {
+    if(static_cast<size_t>(this->end - this->p) < size)
+    {
+      throw std::runtime_error("Damaged snapshot, unexpected end of records.");
+    }
+  }
+
+  uint64_t GetInteger()
+  {
+    uint64_t value;
+    this->Need(sizeof(value));
+    memcpy(&value, this->p, sizeof(value));
+    this->p += sizeof(value);
+    return value;
+  }
+
+  void GetString(std::string &str)
+  {
+    uint32_t length;
+    this->Need(sizeof(length));
+    memcpy(&length, this->p, sizeof(length));
+    this->p += sizeof(length);
+    this->Need(length);
+    str.assign(this->p, length);
+    this->p += length;
+  }
+};
+
+TopologySnapshot::TopologySnapshot()
+{
+  this->m_nRecords = 0;
+}
+
+TopologySnapshot::~TopologySnapshot()
+{
+}
+
+bool TopologySnapshot::Open(const std::string &fileName, const uint64_t key)
+{
+  this->m_file.Close();
+  this->m_nRecords = 0;
+
+  if(access(fileName.c_str(), R_OK) != 0)
+  {
+    return false;
+  }
+  this->m_file.Open(fileName);
+
+  SnapshotHeader header;
+  if(this->m_file.GetSize() < sizeof(header))
+  {
+    return false;
+  }
+  memcpy(&header, this->m_file.GetData(), sizeof(header));
+
+  const char *payload = this->m_file.GetData() + sizeof(header);
+  size_t payloadSize = this->m_file.GetSize() - sizeof(header);
+  if(memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != SNAPSHOT_VERSION ||
+     header.byteOrder != SNAPSHOT_BYTE_ORDER || header.key != key || header.payloadSize != payloadSize ||
+     header.payloadHash != utils::hashBytes(payload, payloadSize))
+  {
+    this->m_file.Close();
+    return false;
+  }
+
+  this->m_nRecords = header.nRecords;
+  return true;
+}
+
+uint64_t TopologySnapshot::GetNRecords() const
+{
+  return this->m_nRecords;
+}
+
+void TopologySnapshot::Replay(TopologySink &sink) const
+{
+  SnapshotCursor cursor;
+  cursor.p = this->m_file.GetData() + sizeof(SnapshotHeader);
+  cursor.end = this->m_file.GetData() + this->m_file.GetSize();
+
+  /* the descriptions are reused, their strings keep their buffers. */
+  NodeSpec node;
+  NetworkHardwareSpec networkHardware;
+  ApplicationSpec application;
+  FlowSpec flow;
+  std::string nodeName;
+
+  for(uint64_t i = 0; i < this->m_nRecords; i++)
+  {
+    cursor.Need(1);
+    unsigned char kind = *cursor.p++;
+    switch(kind)
+    {
+    case RECORD_NODE:
+      cursor.GetString(node.type);
+      cursor.GetString(node.name);
+      cursor.GetString(node.enableFlowmonitor);
+      sink.AddNode(node);
+      break;
+
+    case RECORD_NETWORK_HARDWARE:
+      cursor.GetString(networkHardware.type);
+      cursor.GetString(networkHardware.name);
+      cursor.GetString(networkHardware.dataRate);
+      cursor.GetString(networkHardware.linkDelay);
+      cursor.GetString(networkHardware.enableTrace);
+      sink.AddNetworkHardware(networkHardware);
+      break;
+
+    case RECORD_INSTALL_NODE:
+      cursor.GetString(nodeName);
+      sink.InstallNode(nodeName);
+      break;
+
+    case RECORD_APPLICATION:
+      {
+        cursor.GetString(application.type);
+        cursor.GetString(application.name);
+        cursor.GetString(application.sender);
+        cursor.GetString(application.receiver);
+        application.startTime = cursor.GetInteger();
+        application.endTime = cursor.GetInteger();
+        uint64_t params = cursor.GetInteger();
+        application.hasPort = (params & PARAM_PORT) != 0;
+        application.hasInterval = (params & PARAM_INTERVAL) != 0;
+        application.hasReadingTime = (params & PARAM_READING_TIME) != 0;
+        application.hasPacketSize = (params & PARAM_PACKET_SIZE) != 0;
+        application.hasMaxPacketCount = (params & PARAM_MAX_PACKET_COUNT) != 0;
+        application.hasPacketIntervalTime = (params & PARAM_PACKET_INTERVAL_TIME) != 0;
+        application.port = cursor.GetInteger();
+        application.interval = cursor.GetInteger();
+        application.readingTime = cursor.GetInteger();
+        application.packetSize = cursor.GetInteger();
+        application.maxPacketCount = cursor.GetInteger();
+        cursor.GetString(application.packetIntervalTime);
+        sink.AddApplication(application);
+      }
+      break;
+
+    case RECORD_FLOW:
+      cursor.GetString(flow.type);
+      cursor.GetString(flow.name);
+      cursor.GetString(flow.source);
+      cursor.GetString(flow.destination);
+      cursor.GetString(flow.expectedDelaySeconds);
+      cursor.GetString(flow.expectedReliabilityPercent);
+      sink.AddFlow(flow);
+      break;
+
+    default:
+      throw std::runtime_error("Damaged snapshot, unknown record.");
+    }
+  }
+}
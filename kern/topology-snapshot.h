@@ -0,0 +1,224 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-snapshot.h
+ * \brief Binary snapshot of the topology elements of an input.
+ */
+
+#ifndef TOPOLOGY_SNAPSHOT_H
+#define TOPOLOGY_SNAPSHOT_H
+
+#include <stdint.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mapped-file.h"
+#include "topology-sink.h"
+
+/**
+ * \ingroup generator
+ * \brief Compute the key of the snapshot of an input.
+ *
+ * The key is the hash of the input documents followed by the schema, a
+ * snapshot is only used if they are all unchanged.
+ *
+ * \param inputFiles topology file names (manifest and listed files)
+ * \param schema schema text
+ * \param schemaSize size of the schema text
+ * \return snapshot key
+ * \throw std::runtime_error if a file cannot be read
+ */
+uint64_t ComputeSnapshotKey(const std::vector<std::string> &inputFiles, const char *schema, const size_t schemaSize);
+
+/**
+ * \ingroup generator
+ * \brief Write the topology elements it receives to a snapshot file.
+ *
+ *  The snapshot holds the elements in the order they are received, so
+ *  replaying it into a TopologyBuilder populates the Generator exactly as
+ *  reading the input did. The configuration lines are not recorded, the
+ *  Generator derives them from the model when generating the code.
+ *
+ *  The file is written under a temporary name and renamed by Commit(), so
+ *  a process reading the snapshot never sees a partial file.
+ */
+class TopologySnapshotWriter : public TopologySink
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TopologySnapshotWriter();
+
+    /**
+     * \brief Destructor, the temporary file is removed if not committed.
+     */
+    virtual ~TopologySnapshotWriter();
+
+    /**
+     * \brief Start a snapshot.
+     * \param fileName snapshot file name
+     * \param key snapshot key (see ComputeSnapshotKey())
+     * \throw std::runtime_error if the file cannot be created
+     */
+    void Open(const std::string &fileName, const uint64_t key);
+
+    /**
+     * \brief Complete the snapshot and move it to its final name.
+     * \throw std::runtime_error if the file cannot be written
+     */
+    void Commit();
+
+    virtual void AddNode(const NodeSpec &spec);
+    virtual void AddNetworkHardware(const NetworkHardwareSpec &spec);
+    virtual void InstallNode(const std::string &nodeName);
+    virtual void AddApplication(const ApplicationSpec &spec);
+    virtual void AddFlow(const FlowSpec &spec);
+
+  private:
+    /**
+     * \brief Copy constructor (not implemented).
+     */
+    TopologySnapshotWriter(const TopologySnapshotWriter &);
+
+    /**
+     * \brief Assignment (not implemented).
+     */
+    TopologySnapshotWriter &operator=(const TopologySnapshotWriter &);
+
+    /**
+     * \brief Start a record.
+     * \param kind record kind
+     */
+    void BeginRecord(const unsigned char kind);
+
+    /**
+     * \brief Append a string to the current record.
+     * \param str string
+     */
+    void PutString(const std::string &str);
+
+    /**
+     * \brief Append an integer to the current record.
+     * \param value integer
+     */
+    void PutInteger(const uint64_t value);
+
+    /**
+     * \brief Write the buffered records.
+     */
+    void Flush();
+
+    /**
+     * \brief Final file name.
+     */
+    std::string m_fileName;
+
+    /**
+     * \brief Temporary file name.
+     */
+    std::string m_tmpFileName;
+
+    /**
+     * \brief Temporary file.
+     */
+    std::ofstream m_file;
+
+    /**
+     * \brief Records not written yet.
+     */
+    std::string m_buffer;
+
+    /**
+     * \brief Snapshot key.
+     */
+    uint64_t m_key;
+
+    /**
+     * \brief Hash of the records written.
+     */
+    uint64_t m_payloadHash;
+
+    /**
+     * \brief Size of the records written.
+     */
+    uint64_t m_payloadSize;
+
+    /**
+     * \brief Number of records.
+     */
+    uint64_t m_nRecords;
+};
+
+/**
+ * \ingroup generator
+ * \brief Memory mapped snapshot file.
+ *
+ *  The snapshot is mapped read-only, so any number of processes can load
+ *  it at once, sharing the same pages.
+ */
+class TopologySnapshot
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TopologySnapshot();
+
+    /**
+     * \brief Destructor.
+     */
+    ~TopologySnapshot();
+
+    /**
+     * \brief Map a snapshot file.
+     * \param fileName snapshot file name
+     * \param key expected key
+     * \return false if the file does not exist, has another version or
+     * another key, or is damaged
+     */
+    bool Open(const std::string &fileName, const uint64_t key);
+
+    /**
+     * \brief Get the number of records.
+     * \return number of records
+     */
+    uint64_t GetNRecords() const;
+
+    /**
+     * \brief Pass the recorded elements to a sink, in their original order.
+     * \param sink sink to feed
+     * \throw std::runtime_error if the snapshot is damaged
+     */
+    void Replay(TopologySink &sink) const;
+
+  private:
+    /**
+     * \brief Mapped file.
+     */
+    MappedFile m_file;
+
+    /**
+     * \brief Number of records.
+     */
+    uint64_t m_nRecords;
+};
+
+#endif /* TOPOLOGY_SNAPSHOT_H */
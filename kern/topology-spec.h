@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-spec.h
+ * \brief Plain descriptions of the topology elements read from an input.
+ */
+
+#ifndef TOPOLOGY_SPEC_H
+#define TOPOLOGY_SPEC_H
+
+#include <string>
+
+/**
+ * \ingroup generator
+ * \brief Description of a <node> element.
+ */
+struct NodeSpec
+{
+  /**
+   * \brief Node type (Pc, Router, Station, ...).
+   */
+  std::string type;
+
+  /**
+   * \brief Node name.
+   */
+  std::string name;
+
+  /**
+   * \brief Flowmonitor state, as written in the input ("true" enables it).
+   */
+  std::string enableFlowmonitor;
+};
+
+/**
+ * \ingroup generator
+ * \brief Description of a <networkHardware> element.
+ *
+ * The connected nodes are not part of the description, they are
+ * installed one by one on the last added network hardware.
+ */
+struct NetworkHardwareSpec
+{
+  /**
+   * \brief Network hardware type (Ap, Bridge, Hub, PointToPoint).
+   */
+  std::string type;
+
+  /**
+   * \brief Network hardware name.
+   */
+  std::string name;
+
+  /**
+   * \brief Data rate.
+   */
+  std::string dataRate;
+
+  /**
+   * \brief Link delay.
+   */
+  std::string linkDelay;
+
+  /**
+   * \brief Trace state, as written in the input ("true" enables it).
+   */
+  std::string enableTrace;
+};
+
+/**
+ * \ingroup generator
+ * \brief Description of an <application> element.
+ *
+ * The has* members tell which optional <special> parameters were given.
+ */
+struct ApplicationSpec
+{
+  ApplicationSpec ()
+    : startTime (0), endTime (0),
+      hasPort (false), port (0),
+      hasInterval (false), interval (0),
+      hasReadingTime (false), readingTime (0),
+      hasPacketSize (false), packetSize (0),
+      hasMaxPacketCount (false), maxPacketCount (0),
+      hasPacketIntervalTime (false)
+  {
+  }
+
+  std::string type;
+  std::string name;
+  std::string sender;
+  std::string receiver;
+  size_t startTime;
+  size_t endTime;
+
+  bool hasPort;
+  size_t port;
+  bool hasInterval;
+  size_t interval;
+  bool hasReadingTime;
+  size_t readingTime;
+  bool hasPacketSize;
+  size_t packetSize;
+  bool hasMaxPacketCount;
+  size_t maxPacketCount;
+  bool hasPacketIntervalTime;
+  std::string packetIntervalTime;
+};
+
+/**
+ * \ingroup generator
+ * \brief Description of a <flow> element.
+ */
+struct FlowSpec
+{
+  std::string type;
+  std::string name;
+  std::string source;
+  std::string destination;
+  std::string expectedDelaySeconds;
+  std::string expectedReliabilityPercent;
+};
+
+#endif /* TOPOLOGY_SPEC_H */
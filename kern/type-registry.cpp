@@ -0,0 +1,333 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file type-registry.cpp
+ * \brief Types of the nodes, network hardwares, applications and flows.
+ */
+
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "type-registry.h"
+#include "utils.h"
+
+#include "hub.h"
+#include "point-to-point.h"
+#include "bridge.h"
+#include "ap.h"
+#include "emu.h"
+#include "tap.h"
+#include "ping.h"
+#include "udp-echo.h"
+#include "udp.h"
+#include "udp-cosem.h"
+#include "tcp-large-transfer.h"
+#include "data-concentrator.h"
+#include "demand-response.h"
+#include "meter-data-management.h"
+
+/**
+ * \brief Create a network hardware without parameter.
+ */
+template <class T>
+static NetworkHardware *CreateNetworkHardware(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const NetworkHardwareParameters &)
+{
+  return new (arena) T(symbols, type, indice);
+}
+
+/**
+ * \brief Create a network hardware attached to a node.
+ */
+template <class T>
+static NetworkHardware *CreateNodeNetworkHardware(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const NetworkHardwareParameters &parameters)
+{
+  return new (arena) T(symbols, type, indice, parameters.linkNode);
+}
+
+/**
+ * \brief Create a network hardware attached to a node and an interface.
+ */
+template <class T>
+static NetworkHardware *CreateIfaceNetworkHardware(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const NetworkHardwareParameters &parameters)
+{
+  return new (arena) T(symbols, type, indice, parameters.linkNode, parameters.ifaceName);
+}
+
+/**
+ * \brief Create an application without parameter.
+ */
+template <class T>
+static Application *CreateApplication(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode)
+{
+  return new (arena) T(symbols, type, indice, senderNode, receiverNode, spec.startTime, spec.endTime);
+}
+
+/**
+ * \brief Create an application on a port.
+ */
+template <class T>
+static Application *CreatePortApplication(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode)
+{
+  return new (arena) T(symbols, type, indice, senderNode, receiverNode, spec.startTime, spec.endTime, spec.port);
+}
+
+/**
+ * \brief Create an udp application.
+ *
+ * The packet parameters of the SET bits given in the spec are set.
+ */
+template <class T, uint32_t SET>
+static Application *CreateUdpApplication(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode)
+{
+  T *app = new (arena) T(symbols, type, indice, senderNode, receiverNode, spec.startTime, spec.endTime, spec.port);
+  if((SET & PACKET_SIZE_PARAMETER) && spec.hasPacketSize)
+  {
+    app->SetPacketSize(spec.packetSize);
+  }
+  if((SET & PACKET_INTERVAL_TIME_PARAMETER) && spec.hasPacketIntervalTime)
+  {
+    app->SetPacketIntervalTime(spec.packetIntervalTime);
+  }
+  if((SET & MAX_PACKET_COUNT_PARAMETER) && spec.hasMaxPacketCount)
+  {
+    app->SetMaxPacketCount(spec.maxPacketCount);
+  }
+
+  return app;
+}
+
+/**
+ * \brief Create a meter data management application.
+ */
+static Application *CreateMeterDataManagement(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode)
+{
+  return new (arena) MeterDataManagement(symbols, type, indice, senderNode, receiverNode, spec.startTime, spec.endTime, spec.interval, spec.readingTime);
+}
+
+/**
+ * \brief Packet parameters of the udp applications.
+ */
+static const uint32_t PACKET_PARAMETERS = PACKET_SIZE_PARAMETER | PACKET_INTERVAL_TIME_PARAMETER | MAX_PACKET_COUNT_PARAMETER;
+
+/**
+ * \brief The types.
+ */
+static TypeInfo g_types[] =
+{
+  /* name, kind, counterOf, parameters, required, network hardware factory, application factory */
+  { "Pc", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+  { "Pc-group", NODE_KIND, "Pc", 0, 0, 0, 0, 0 },
+  { "Router", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+  { "AccessPoint", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+  { "Station", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+  { "Bridge", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+  { "Tap", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+  { "Emu", NODE_KIND, 0, 0, 0, 0, 0, 0 },
+
+  { "Hub", NETWORK_HARDWARE_KIND, 0, 0, 0, &CreateNetworkHardware<Hub>, 0, 0 },
+  { "PointToPoint", NETWORK_HARDWARE_KIND, 0, 0, 0, &CreateNetworkHardware<PointToPoint>, 0, 0 },
+  { "Bridge", NETWORK_HARDWARE_KIND, 0, LINK_NODE_PARAMETER, LINK_NODE_PARAMETER, &CreateNodeNetworkHardware<Bridge>, 0, 0 },
+  { "Ap", NETWORK_HARDWARE_KIND, 0, LINK_NODE_PARAMETER, LINK_NODE_PARAMETER, &CreateNodeNetworkHardware<Ap>, 0, 0 },
+  { "Emu", NETWORK_HARDWARE_KIND, 0, LINK_NODE_PARAMETER | IFACE_NAME_PARAMETER, LINK_NODE_PARAMETER | IFACE_NAME_PARAMETER, &CreateIfaceNetworkHardware<Emu>, 0, 0 },
+  { "Tap", NETWORK_HARDWARE_KIND, 0, LINK_NODE_PARAMETER | IFACE_NAME_PARAMETER, LINK_NODE_PARAMETER | IFACE_NAME_PARAMETER, &CreateIfaceNetworkHardware<Tap>, 0, 0 },
+
+  { "UdpEcho", APPLICATION_KIND, 0, PORT_PARAMETER, PORT_PARAMETER | PACKET_PARAMETERS, 0, &CreateUdpApplication<UdpEcho, PACKET_PARAMETERS>, 0 },
+  { "Udp", APPLICATION_KIND, 0, PORT_PARAMETER, PORT_PARAMETER, 0, &CreateUdpApplication<Udp, PACKET_PARAMETERS>, 0 },
+  { "UdpCosem", APPLICATION_KIND, 0, PORT_PARAMETER, PORT_PARAMETER | PACKET_INTERVAL_TIME_PARAMETER, 0, &CreateUdpApplication<UdpCosem, PACKET_INTERVAL_TIME_PARAMETER>, 0 },
+  { "TcpLargeTransfer", APPLICATION_KIND, 0, PORT_PARAMETER, PORT_PARAMETER, 0, &CreatePortApplication<TcpLargeTransfer>, 0 },
+  { "Ping", APPLICATION_KIND, 0, 0, 0, 0, &CreateApplication<Ping>, 0 },
+  { "DataConcentrator", APPLICATION_KIND, 0, 0, 0, 0, &CreateApplication<DataConcentrator>, 0 },
+  { "DemandResponse", APPLICATION_KIND, 0, 0, 0, 0, &CreateApplication<DemandResponse>, 0 },
+  { "MeterDataManagement", APPLICATION_KIND, 0, INTERVAL_PARAMETER | READING_TIME_PARAMETER, INTERVAL_PARAMETER | READING_TIME_PARAMETER, 0, &CreateMeterDataManagement, 0 },
+
+  { "WiredFlow", FLOW_KIND, 0, 0, 0, 0, 0, 0 },
+  { "WifiFlow", FLOW_KIND, "WiredFlow", 0, 0, 0, 0, 0 },
+  { "MultiHopFlow", FLOW_KIND, 0, 0, 0, 0, 0, 0 }
+};
+
+/**
+ * \brief Number of types.
+ */
+static const size_t N_TYPES = sizeof(g_types) / sizeof(g_types[0]);
+
+/**
+ * \brief Perfect hash tables of the type names, one per kind.
+ *
+ * Built before main(): the generators of a --batch run look types up from
+ * several threads without synchronization.
+ */
+class TypeTable
+{
+  public:
+    /**
+     * \brief Build the tables and resolve the shared counters.
+     */
+    TypeTable()
+    {
+      for(size_t i = 0; i < N_TYPES; i++)
+      {
+        g_types[i].counter = i;
+        if(g_types[i].counterOf)
+        {
+          g_types[i].counter = this->Index(g_types[i].kind, g_types[i].counterOf);
+        }
+      }
+
+      for(size_t kind = 0; kind < N_ELEMENT_KINDS; kind++)
+      {
+        this->Build(static_cast<ElementKind>(kind));
+      }
+    }
+
+    /**
+     * \brief Find a type.
+     * \param kind element kind
+     * \param name type name
+     * \return type, or null
+     */
+    const TypeInfo *Find(const ElementKind kind, const std::string &name) const
+    {
+      const std::vector<const TypeInfo *> &slots = this->m_slots[kind];
+      const TypeInfo *type = slots[Slot(utils::hashBytes(name.data(), name.size(), this->m_seeds[kind]), slots.size())];
+      if(type && name == type->name)
+      {
+        return type;
+      }
+
+      return 0;
+    }
+
+  private:
+    /**
+     * \brief Slot of a hash.
+     *
+     * The low bits of the hash only depend on the low bits of the seed, the
+     * high half is folded in so that every seed gives other slots.
+     */
+    static size_t Slot(const uint64_t hash, const size_t size)
+    {
+      return static_cast<size_t>(hash ^ (hash >> 32)) & (size - 1);
+    }
+
+    /**
+     * \brief Position of a type in g_types, by linear search.
+     */
+    static size_t Index(const ElementKind kind, const char *name)
+    {
+      for(size_t i = 0; i < N_TYPES; i++)
+      {
+        if(g_types[i].kind == kind && strcmp(g_types[i].name, name) == 0)
+        {
+          return i;
+        }
+      }
+
+      throw std::logic_error(std::string("Type registry: (") + name + ") is not a type.");
+    }
+
+    /**
+     * \brief Find a seed of the hash for which the names of a kind do not collide.
+     */
+    void Build(const ElementKind kind)
+    {
+      size_t nTypes = 0;
+      for(size_t i = 0; i < N_TYPES; i++)
+      {
+        nTypes += g_types[i].kind == kind;
+      }
+      size_t size = 1;
+      while(size < 2 * nTypes)
+      {
+        size *= 2;
+      }
+
+      std::vector<const TypeInfo *> &slots = this->m_slots[kind];
+      for(uint64_t seed = 0xcbf29ce484222325ULL; ; seed++)
+      {
+        slots.assign(size, 0);
+        bool collision = false;
+        for(size_t i = 0; i < N_TYPES && !collision; i++)
+        {
+          if(g_types[i].kind == kind)
+          {
+            const TypeInfo *&slot = slots[Slot(utils::hashBytes(g_types[i].name, strlen(g_types[i].name), seed), size)];
+            collision = slot != 0;
+            slot = &g_types[i];
+          }
+        }
+
+        if(!collision)
+        {
+          this->m_seeds[kind] = seed;
+          return;
+        }
+      }
+    }
+
+    /**
+     * \brief Slots of each kind, a power of 2 at least twice the number of types.
+     */
+    std::vector<const TypeInfo *> m_slots[N_ELEMENT_KINDS];
+
+    /**
+     * \brief Hash seed of each kind.
+     */
+    uint64_t m_seeds[N_ELEMENT_KINDS];
+};
+
+/**
+ * \brief The tables.
+ */
+static const TypeTable g_typeTable;
+
+const TypeInfo *TypeRegistry::Find(const ElementKind kind, const std::string &name)
+{
+  return g_typeTable.Find(kind, name);
+}
+
+size_t TypeRegistry::GetNCounters()
+{
+  return N_TYPES;
+}
+
+const char *TypeRegistry::GetParameterName(const TypeParameter parameter)
+{
+  switch(parameter)
+  {
+    case LINK_NODE_PARAMETER:
+      return "linkNode";
+    case IFACE_NAME_PARAMETER:
+      return "ifaceName";
+    case PORT_PARAMETER:
+      return "port";
+    case INTERVAL_PARAMETER:
+      return "interval";
+    case READING_TIME_PARAMETER:
+      return "readingTime";
+    case PACKET_SIZE_PARAMETER:
+      return "packetSize";
+    case PACKET_INTERVAL_TIME_PARAMETER:
+      return "packetIntervalTime";
+    case MAX_PACKET_COUNT_PARAMETER:
+      return "maxPacketCount";
+  }
+
+  return "";
+}
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file type-registry.h
+ * \brief Types of the nodes, network hardwares, applications and flows.
+ */
+
+#ifndef TYPE_REGISTRY_H
+#define TYPE_REGISTRY_H
+
+#include <stdint.h>
+#include <string>
+
+#include "arena.h"
+#include "symbol-table.h"
+#include "topology-spec.h"
+
+class NetworkHardware;
+class Application;
+
+/**
+ * \ingroup generator
+ * \brief Kind of topology element.
+ */
+enum ElementKind
+{
+  NODE_KIND,
+  NETWORK_HARDWARE_KIND,
+  APPLICATION_KIND,
+  FLOW_KIND,
+  N_ELEMENT_KINDS
+};
+
+/**
+ * \ingroup generator
+ * \brief Parameters of a type, bits of TypeInfo::parameters and TypeInfo::required.
+ */
+enum TypeParameter
+{
+  LINK_NODE_PARAMETER = 1 << 0,
+  IFACE_NAME_PARAMETER = 1 << 1,
+  PORT_PARAMETER = 1 << 2,
+  INTERVAL_PARAMETER = 1 << 3,
+  READING_TIME_PARAMETER = 1 << 4,
+  PACKET_SIZE_PARAMETER = 1 << 5,
+  PACKET_INTERVAL_TIME_PARAMETER = 1 << 6,
+  MAX_PACKET_COUNT_PARAMETER = 1 << 7
+};
+
+/**
+ * \ingroup generator
+ * \brief Parameters of a new network hardware.
+ */
+struct NetworkHardwareParameters
+{
+  /**
+   * \brief Node of the network hardware (access point, bridge, ...).
+   */
+  std::string linkNode;
+
+  /**
+   * \brief Interface name of an emu or tap.
+   */
+  std::string ifaceName;
+};
+
+/**
+ * \ingroup generator
+ * \brief Create a network hardware.
+ * \param arena memory of the object
+ * \param symbols table holding the names
+ * \param type type name
+ * \param indice number of the network hardware in its type
+ * \param parameters parameters, the ones of TypeInfo::parameters are given
+ * \return new network hardware
+ */
+typedef NetworkHardware *(*NetworkHardwareFactory)(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const NetworkHardwareParameters &parameters);
+
+/**
+ * \ingroup generator
+ * \brief Create an application.
+ *
+ * The application specific parameters given in the spec (has* flags) are
+ * set on the new application.
+ *
+ * \param arena memory of the object
+ * \param symbols table holding the names
+ * \param type type name
+ * \param indice number of the application in its type
+ * \param spec parameters, the ones of TypeInfo::required are given
+ * \param senderNode sender node
+ * \param receiverNode receiver node
+ * \return new application
+ */
+typedef Application *(*ApplicationFactory)(Arena &arena, SymbolTable &symbols, const std::string &type, const size_t indice, const ApplicationSpec &spec, const std::string &senderNode, const std::string &receiverNode);
+
+/**
+ * \ingroup generator
+ * \brief Type of a topology element.
+ *
+ *  Nodes and flows are all instances of Node and Flow, their types only
+ *  select a counter and have no factory.
+ */
+struct TypeInfo
+{
+  /**
+   * \brief Type name, as written in the topology.
+   */
+  const char *name;
+
+  /**
+   * \brief Element kind.
+   */
+  ElementKind kind;
+
+  /**
+   * \brief Name of the type whose counter numbers the elements of this one, null for its own.
+   */
+  const char *counterOf;
+
+  /**
+   * \brief TypeParameter bits of the constructor parameters.
+   */
+  uint32_t parameters;
+
+  /**
+   * \brief TypeParameter bits of the parameters a topology must give, the
+   * constructor ones included.
+   */
+  uint32_t required;
+
+  /**
+   * \brief Network hardware factory.
+   */
+  NetworkHardwareFactory createNetworkHardware;
+
+  /**
+   * \brief Application factory.
+   */
+  ApplicationFactory createApplication;
+
+  /**
+   * \brief Counter numbering the elements of the type, index of a type, set
+   * from counterOf when the program starts.
+   */
+  size_t counter;
+};
+
+/**
+ * \ingroup generator
+ * \brief Types of the nodes, network hardwares, applications and flows.
+ *
+ *  The types are listed in a constant table (type-registry.cpp): a new kind
+ *  of network hardware or application is added there with its factory,
+ *  Generator does not change. A type name is found with a perfect hash of
+ *  the names of its kind, computed once when the program starts: one hash
+ *  and one string comparison, whatever the number of types.
+ */
+class TypeRegistry
+{
+  public:
+    /**
+     * \brief Find a type.
+     * \param kind element kind
+     * \param name type name
+     * \return type, or null if the kind has no type of this name
+     */
+    static const TypeInfo *Find(const ElementKind kind, const std::string &name);
+
+    /**
+     * \brief Get the number of counters.
+     * \return bound of the TypeInfo::counter values
+     */
+    static size_t GetNCounters();
+
+    /**
+     * \brief Get the name of a parameter in the topology files.
+     * \param parameter parameter
+     * \return element name, "port" for instance
+     */
+    static const char *GetParameterName(const TypeParameter parameter);
+};
+
+#endif /* TYPE_REGISTRY_H */
@@ -30,14 +30,14 @@
 
 #include "utils.h"
 
-UdpCosem::UdpCosem(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+UdpCosem::UdpCosem(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->m_port = port;
   this->SetAppName(std::string("udpCosem_" + this->GetIndice()));
   /* default values */
   this->m_packetSize = 1024;
   this->m_maxPacketCount = 1;
-  this->m_packetIntervalTime = std::string("1.0");
+  this->m_packetIntervalTime = utils::NANOSECONDS_PER_SECOND;
 }
 
 UdpCosem::~UdpCosem()
@@ -76,10 +76,18 @@ size_t UdpCosem::GetMaxPacketCount()
 
 void UdpCosem::SetPacketIntervalTime(const std::string &packetIntervalTime)
 {
-  this->m_packetIntervalTime = packetIntervalTime;
+  if(!utils::parseTime(packetIntervalTime, utils::NANOSECONDS_PER_SECOND, this->m_packetIntervalTime))
+  {
+    throw std::logic_error("Invalid packet interval time <" + packetIntervalTime + "> for " + this->GetAppName() + ".");
+  }
 }
 
-std::string UdpCosem::GetPacketIntervalTime()
+void UdpCosem::SetPacketIntervalTime(const uint64_t nanoseconds)
+{
+  this->m_packetIntervalTime = nanoseconds;
+}
+
+uint64_t UdpCosem::GetPacketIntervalTime()
 {
   return this->m_packetIntervalTime;
 }
@@ -94,46 +102,27 @@ std::vector<std::string> UdpCosem::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> UdpCosem::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void UdpCosem::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
   (void)netDeviceContainer;
   (void)numberIntoNetDevice;
 
-  std::string getReceiverNode = this->GetReceiverNode();
-  std::string recNode;
-
-  std::string getSenderNode = this->GetSenderNode();
-  std::string sendNode;
-
-  apps.push_back("");
-  apps.push_back("UdpCosemServerHelper server_" + this->GetAppName() + " (iface_ndc_sta_" + this->GetIndice() + ");");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "UdpCosemServerHelper server_" << this->GetAppName() << " (iface_ndc_sta_" << this->GetIndice() << ");");
   
-  if (this->GetReceiverNode().find("term_") == 0)
-    recNode = "all_hub_" + this->GetIndice() + ".Get(" + getReceiverNode.substr(getReceiverNode.find("_") + 1) + ")";
-  else if (this->GetReceiverNode().find("station_") == 0)
-    recNode = "all_ap_" + this->GetIndice() + ".Get(" + getReceiverNode.substr(getReceiverNode.find("_") + 1) + ")";
-
-  apps.push_back("ApplicationContainer serverApps_" + this->GetAppName() + " = server_" + this->GetAppName() + ".Install (all_ap_" + this->GetIndice() + ");");
-
-  apps.push_back("serverApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("serverApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  apps.push_back("");
-  apps.push_back("Time interPacketInterval_" + this->GetAppName() + " = Seconds (" + this->m_packetIntervalTime + ");");
-  apps.push_back("");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer serverApps_" << this->GetAppName() << " = server_" << this->GetAppName() << ".Install (all_ap_" << this->GetIndice() << ");");
 
-  apps.push_back("UdpCosemClientHelper client_" + this->GetAppName() + " (serverApps_" + this->GetAppName() + ", iface_ndc_ap_" + this->GetIndice() + ", " + "interPacketInterval_" + this->GetAppName() + ");");
+  sink.WriteLine(CodeLine(sink) << "serverApps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "serverApps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 
-  apps.push_back("ApplicationContainer clientApps_" + this->GetAppName() + " = client_" + this->GetAppName() + ".Install (ap_" + this->GetIndice() + ");");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "Time interPacketInterval_" << this->GetAppName() << " = Seconds (" << CodeSeconds(this->m_packetIntervalTime) << ");");
+  sink.WriteLine("");
 
-  if (this->GetSenderNode().find("term_") == 0)
-    sendNode = "all_hub_" + this->GetIndice() + ".Get(" + getSenderNode.substr(getSenderNode.find("_") + 1) + ")";
-  else if (this->GetSenderNode().find("station_") == 0)
-    sendNode = "all_ap_" + this->GetIndice() + ".Get(" + getSenderNode.substr(getSenderNode.find("_") + 1) + ")";
+  sink.WriteLine(CodeLine(sink) << "UdpCosemClientHelper client_" << this->GetAppName() << " (serverApps_" << this->GetAppName() << ", iface_ndc_ap_" << this->GetIndice() << ", " << "interPacketInterval_" << this->GetAppName() << ");");
 
-  apps.push_back("clientApps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("clientApps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
+  sink.WriteLine(CodeLine(sink) << "ApplicationContainer clientApps_" << this->GetAppName() << " = client_" << this->GetAppName() << ".Install (ap_" << this->GetIndice() << ");");
 
-  return apps;
+  sink.WriteLine(CodeLine(sink) << "clientApps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "clientApps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
 }
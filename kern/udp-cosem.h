@@ -30,6 +30,7 @@
 
 #include "application.h"
 
+#include <stdint.h>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -66,13 +67,14 @@ class UdpCosem : public Application
     size_t m_maxPacketCount;
 
     /**
-     * \brief Packet interval time.
+     * \brief Packet interval time in nanoseconds.
      */
-    std::string m_packetIntervalTime;
+    uint64_t m_packetIntervalTime;
 
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param type application type
      * \param indice application number
      * \param senderNode sender node
@@ -81,7 +83,7 @@ class UdpCosem : public Application
      * \param endTime end time
      * \param port port
      */
-    UdpCosem(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port);
+    UdpCosem(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port);
 
     /**
      * \brief Destructor.
@@ -96,11 +98,11 @@ class UdpCosem : public Application
 
     /**
      * \brief Generate application C++ code.
+     * \param sink sink of the code
      * \param netDeviceContainer net device container
      * \param numberIntoNetDevice number into net device
-     * \return application code
      */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice);
+    virtual void GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice);
 
     /**
      * \brief Get port.
@@ -140,15 +142,22 @@ class UdpCosem : public Application
 
     /**
      * \brief Set packet interval time.
-     * \param packetIntervalTime packet interval time
+     * \param packetIntervalTime packet interval time, in seconds without unit ("0.25", "250ms")
+     * \throw std::logic_error if the text is not a duration
      */
     void SetPacketIntervalTime(const std::string &packetIntervalTime);
 
+    /**
+     * \brief Set packet interval time.
+     * \param nanoseconds packet interval time in nanoseconds
+     */
+    void SetPacketIntervalTime(const uint64_t nanoseconds);
+
     /**
      * \brief Get packet interval time.
-     * \return packet interval time
+     * \return packet interval time in nanoseconds
      */
-    std::string GetPacketIntervalTime();
+    uint64_t GetPacketIntervalTime();
 };
 
 #endif /* UDP_COSEM_H */
@@ -27,17 +27,18 @@
 
 #include "udp-echo.h"
 #include "generator.h"
+#include "code-table.h"
 
 #include "utils.h"
 
-UdpEcho::UdpEcho(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) : Application(type, indice, senderNode, receiverNode, startTime, endTime)
+UdpEcho::UdpEcho(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port) : Application(symbols, type, indice, senderNode, receiverNode, startTime, endTime)
 {
   this->m_port = port;
   this->SetAppName(std::string("udpEcho_" + this->GetIndice()));
   /* default values */
   this->m_packetSize = 1024;
   this->m_maxPacketCount = 1;
-  this->m_packetIntervalTime = std::string("1.0");
+  this->m_packetIntervalTime = utils::NANOSECONDS_PER_SECOND;
 }
 
 UdpEcho::~UdpEcho()
@@ -76,10 +77,18 @@ size_t UdpEcho::GetMaxPacketCount()
 
 void UdpEcho::SetPacketIntervalTime(const std::string &packetIntervalTime)
 {
-  this->m_packetIntervalTime = packetIntervalTime;
+  if(!utils::parseTime(packetIntervalTime, utils::NANOSECONDS_PER_SECOND, this->m_packetIntervalTime))
+  {
+    throw std::logic_error("Invalid packet interval time <" + packetIntervalTime + "> for " + this->GetAppName() + ".");
+  }
 }
 
-std::string UdpEcho::GetPacketIntervalTime()
+void UdpEcho::SetPacketIntervalTime(const uint64_t nanoseconds)
+{
+  this->m_packetIntervalTime = nanoseconds;
+}
+
+uint64_t UdpEcho::GetPacketIntervalTime()
 {
   return this->m_packetIntervalTime;
 }
@@ -92,50 +101,117 @@ std::vector<std::string> UdpEcho::GenerateHeader()
   return headers;
 }
 
-std::vector<std::string> UdpEcho::GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice)
+void UdpEcho::GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
 {
-  std::vector<std::string> apps;
-
-  std::string getReceiverNode = this->GetReceiverNode();
-  std::string recNode;
-
-  std::string getSenderNode = this->GetSenderNode();
-  std::string sendNode;
+  const std::string &getReceiverNode = this->GetReceiverNode();
+  const std::string &getSenderNode = this->GetSenderNode();
 
-  apps.push_back("uint16_t port_" + this->GetAppName() + " = " + utils::integerToString(this->m_port) + ";"); 
+  sink.WriteLine(CodeLine(sink) << "uint16_t port_" << this->GetAppName() << " = " << this->m_port << ";"); 
 
-  apps.push_back("");
-  apps.push_back("UdpEchoServerHelper server_" + this->GetAppName() + " (port_" + this->GetAppName() + ");");
-  apps.push_back("");
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "UdpEchoServerHelper server_" << this->GetAppName() << " (port_" << this->GetAppName() << ");");
+  sink.WriteLine("");
   
-  if (this->GetReceiverNode().find("term_") == 0)
-    recNode = "all_hub_0.Get(" + getReceiverNode.substr(getReceiverNode.find("_") + 1) + ")";
-  else if (this->GetReceiverNode().find("station_") == 0)
-    recNode = "all_ap_0.Get(" + getReceiverNode.substr(getReceiverNode.find("_") + 1) + ")";
-
-  apps.push_back("ApplicationContainer apps_" + this->GetAppName() + " = server_" + this->GetAppName() + ".Install (" + recNode + ");");
-
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".0));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
-
-  apps.push_back("");
-  apps.push_back("Time interPacketInterval_" + this->GetAppName() + " = Seconds (" + this->m_packetIntervalTime + ");");
-  apps.push_back("");
-
-  apps.push_back("UdpEchoClientHelper client_" + this->GetAppName() + " (iface_" + netDeviceContainer + ".GetAddress(" + utils::integerToString(numberIntoNetDevice) + "), " + utils::integerToString(this->m_port) + ");");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"MaxPackets\", UintegerValue (" + utils::integerToString(this->m_maxPacketCount) + "));");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"Interval\", TimeValue (interPacketInterval_" + this->GetAppName() + "));");
-  apps.push_back("client_" + this->GetAppName() + ".SetAttribute (\"PacketSize\", UintegerValue (" + utils::integerToString(this->m_packetSize) + "));");
-
-  if (this->GetSenderNode().find("term_") == 0)
-    sendNode = "all_hub_0.Get(" + getSenderNode.substr(getSenderNode.find("_") + 1) + ")";
-  else if (this->GetSenderNode().find("station_") == 0)
-    sendNode = "all_ap_0.Get(" + getSenderNode.substr(getSenderNode.find("_") + 1) + ")";
-
-  apps.push_back("apps_" + this->GetAppName() + " = client_" + this->GetAppName() + ".Install (" + sendNode + ");");
-
-  apps.push_back("apps_" + this->GetAppName() + ".Start (Seconds (" + this->GetStartTime() + ".1));");
-  apps.push_back("apps_" + this->GetAppName() + ".Stop (Seconds (" + this->GetEndTime() + ".0));");
+  CodeLine serverInstall(sink);
+  serverInstall << "ApplicationContainer apps_" << this->GetAppName() << " = server_" << this->GetAppName() << ".Install (";
+  if (getReceiverNode.find("NodeContainer(") == 0)
+    serverInstall << getReceiverNode;
+  else if (getReceiverNode.find("term_") == 0)
+    serverInstall << "all_hub_0.Get(" << getReceiverNode.c_str() + getReceiverNode.find("_") + 1 << ")";
+  else if (getReceiverNode.find("station_") == 0)
+    serverInstall << "all_ap_0.Get(" << getReceiverNode.c_str() + getReceiverNode.find("_") + 1 << ")";
+  serverInstall << ");";
+  sink.WriteLine(serverInstall);
+
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".0));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
+
+  sink.WriteLine("");
+  sink.WriteLine(CodeLine(sink) << "Time interPacketInterval_" << this->GetAppName() << " = Seconds (" << CodeSeconds(this->m_packetIntervalTime) << ");");
+  sink.WriteLine("");
+
+  sink.WriteLine(CodeLine(sink) << "UdpEchoClientHelper client_" << this->GetAppName() << " (iface_" << netDeviceContainer << ".GetAddress(" << numberIntoNetDevice << "), " << this->m_port << ");");
+  sink.WriteLine(CodeLine(sink) << "client_" << this->GetAppName() << ".SetAttribute (\"MaxPackets\", UintegerValue (" << this->m_maxPacketCount << "));");
+  sink.WriteLine(CodeLine(sink) << "client_" << this->GetAppName() << ".SetAttribute (\"Interval\", TimeValue (interPacketInterval_" << this->GetAppName() << "));");
+  sink.WriteLine(CodeLine(sink) << "client_" << this->GetAppName() << ".SetAttribute (\"PacketSize\", UintegerValue (" << this->m_packetSize << "));");
+
+  CodeLine clientInstall(sink);
+  clientInstall << "apps_" << this->GetAppName() << " = client_" << this->GetAppName() << ".Install (";
+  if (getSenderNode.find("NodeContainer(") == 0)
+    clientInstall << getSenderNode;
+  else if (getSenderNode.find("term_") == 0)
+    clientInstall << "all_hub_0.Get(" << getSenderNode.c_str() + getSenderNode.find("_") + 1 << ")";
+  else if (getSenderNode.find("station_") == 0)
+    clientInstall << "all_ap_0.Get(" << getSenderNode.c_str() + getSenderNode.find("_") + 1 << ")";
+  clientInstall << ");";
+  sink.WriteLine(clientInstall);
+
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Start (Seconds (" << this->GetStartTimeNumber() << ".1));");
+  sink.WriteLine(CodeLine(sink) << "apps_" << this->GetAppName() << ".Stop (Seconds (" << this->GetEndTimeNumber() << ".0));");
+}
 
-  return apps;
+/**
+ * \brief Table of the UdpEcho applications.
+ */
+static const CodeTableType UDP_ECHO_TABLE =
+{
+  "UdpEchoRow",
+  "struct UdpEchoRow\n"
+  "{\n"
+  "  uint32_t receiver;\n"
+  "  uint32_t receiverIndex;\n"
+  "  uint32_t sender;\n"
+  "  uint32_t senderIndex;\n"
+  "  uint32_t iface;\n"
+  "  uint32_t address;\n"
+  "  uint32_t port;\n"
+  "  uint32_t start;\n"
+  "  uint32_t stop;\n"
+  "  uint64_t interval;\n"
+  "  uint32_t maxPackets;\n"
+  "  uint32_t packetSize;\n"
+  "};\n",
+  "for (size_t i = 0; i < sizeof (table) / sizeof (table[0]); ++i)\n"
+  "  {\n"
+  "  const UdpEchoRow &row = table[i];\n"
+  "  UdpEchoServerHelper server (row.port);\n"
+  "  ApplicationContainer apps = server.Install (nodes[row.receiver]->Get (row.receiverIndex));\n"
+  "  apps.Start (Seconds (row.start));\n"
+  "  apps.Stop (Seconds (row.stop));\n"
+  "  UdpEchoClientHelper client (ifaces[row.iface]->GetAddress (row.address), row.port);\n"
+  "  client.SetAttribute (\"MaxPackets\", UintegerValue (row.maxPackets));\n"
+  "  client.SetAttribute (\"Interval\", TimeValue (NanoSeconds (row.interval)));\n"
+  "  client.SetAttribute (\"PacketSize\", UintegerValue (row.packetSize));\n"
+  "  apps = client.Install (nodes[row.sender]->Get (row.senderIndex));\n"
+  "  apps.Start (Seconds (row.start + 0.1));\n"
+  "  apps.Stop (Seconds (row.stop));\n"
+  "  }\n"
+};
+
+bool UdpEcho::GenerateTableRowCpp(CodeTable &table, const std::string &netDeviceContainer, size_t numberIntoNetDevice)
+{
+  std::string receiver;
+  size_t receiverIndex = 0;
+  std::string sender;
+  size_t senderIndex = 0;
+  if(netDeviceContainer.empty() || !FindInstallNode(this->GetReceiverNode(), receiver, receiverIndex)
+     || !FindInstallNode(this->GetSenderNode(), sender, senderIndex))
+  {
+    return false;
+  }
+
+  table.Begin(UDP_ECHO_TABLE);
+  CodeSink &sink = table.GetSink();
+  CodeLine row(sink);
+  row << "  { " << table.AddNodeContainer(receiver) << ", " << receiverIndex << ", " << table.AddNodeContainer(sender) << ", " << senderIndex;
+  row << ", " << table.AddInterfaces("iface_" + netDeviceContainer) << ", " << numberIntoNetDevice << ", " << this->m_port;
+  row << ", " << this->GetStartTimeNumber() << ", " << this->GetEndTimeNumber() << ", " << this->m_packetIntervalTime;
+  if(this->m_packetIntervalTime > 0xffffffffULL)
+  {
+    row << "ULL";
+  }
+  row << ", " << this->m_maxPacketCount << ", " << this->m_packetSize << " },";
+  sink.WriteLine(row);
+
+  return true;
 }
@@ -37,6 +37,7 @@
 
 #include "application.h"
 
+#include <stdint.h>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -73,13 +74,14 @@ class Udp : public Application
     size_t m_maxPacketCount;
 
     /**
-     * \brief Packet interval time.
+     * \brief Packet interval time in nanoseconds.
      */
-    std::string m_packetIntervalTime;
+    uint64_t m_packetIntervalTime;
 
   public:
     /**
      * \brief Constructor.
+     * \param symbols table holding the names
      * \param type application type
      * \param indice application number
      * \param senderNode sender node
@@ -88,7 +90,7 @@ class Udp : public Application
      * \param endTime end time
      * \param port port
      */
-    Udp(const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port);
+    Udp(SymbolTable &symbols, const std::string &type, const size_t &indice, const std::string &senderNode, const std::string &receiverNode, const size_t &startTime, const size_t &endTime, const size_t &port);
 
     /**
      * \brief Destructor.
@@ -103,11 +105,20 @@ class Udp : public Application
 
     /**
      * \brief Generate application C++ code.
+     * \param sink sink of the code
      * \param netDeviceContainer net device container
      * \param numberIntoNetDevice number into net device
-     * \return application code
      */
-    virtual std::vector<std::string> GenerateApplicationCpp(std::string netDeviceContainer, size_t numberIntoNetDevice);
+    virtual void GenerateApplicationCpp(CodeSink &sink, const std::string &netDeviceContainer, size_t numberIntoNetDevice);
+
+    /**
+     * \brief Generate the application as a row of the Udp table.
+     * \param table table of the applications
+     * \param netDeviceContainer net device container
+     * \param numberIntoNetDevice number into net device
+     * \return false if the nodes or the address of the application are not found
+     */
+    virtual bool GenerateTableRowCpp(CodeTable &table, const std::string &netDeviceContainer, size_t numberIntoNetDevice);
 
     /**
      * \brief Get port.
@@ -147,15 +158,22 @@ class Udp : public Application
 
     /**
      * \brief Set packet interval time.
-     * \param packetIntervalTime packet interval time
+     * \param packetIntervalTime packet interval time, in seconds without unit ("0.25", "250ms")
+     * \throw std::logic_error if the text is not a duration
      */
     void SetPacketIntervalTime(const std::string &packetIntervalTime);
 
+    /**
+     * \brief Set packet interval time.
+     * \param nanoseconds packet interval time in nanoseconds
+     */
+    void SetPacketIntervalTime(const uint64_t nanoseconds);
+
     /**
      * \brief Get packet interval time.
-     * \return packet interval time
+     * \return packet interval time in nanoseconds
      */
-    std::string GetPacketIntervalTime();
+    uint64_t GetPacketIntervalTime();
 };
 
 #endif /* UDP_H */
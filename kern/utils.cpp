@@ -23,6 +23,8 @@
 
 #include <stdint.h>
 #include <sstream>
+#include <string.h>
+#include <sys/time.h>
 
 #include "utils.h"
 
@@ -49,10 +51,25 @@ size_t split(std::vector<std::string> &res, std::string str, char separator)
 
 std::string integerToString(const size_t nb)
 {
-  std::ostringstream out;
-  out << nb;
+  char digits[INTEGER_CHARS];
+  return std::string(digits, integerToChars(nb, digits));
+}
+
+size_t integerToChars(const uint64_t nb, char *out)
+{
+  /* digits are written from the end of a local buffer then copied. */
+  char digits[INTEGER_CHARS];
+  size_t i = INTEGER_CHARS;
+  uint64_t value = nb;
+  do
+  {
+    digits[--i] = '0' + value % 10;
+    value /= 10;
+  }
+  while(value != 0);
 
-  return out.str();
+  memcpy(out, digits + i, INTEGER_CHARS - i);
+  return INTEGER_CHARS - i;
 }
 
 int stringToInteger(const std::string& str) throw(std::runtime_error)
@@ -68,5 +85,294 @@ int stringToInteger(const std::string& str) throw(std::runtime_error)
   return ret;
 }
 
+/**
+ * \brief Parse the decimal digits of a range bound.
+ * \param begin first digit
+ * \param end end of the digits
+ * \param value bound
+ * \return false if the bound is empty, not decimal or overflows a size_t
+ */
+static bool parseBound(const char *begin, const char *end, size_t &value)
+{
+  const size_t maxValue = static_cast<size_t>(-1);
+  value = 0;
+  if(begin == end)
+  {
+    return false;
+  }
+  for(const char *p = begin; p < end; p++)
+  {
+    if(*p < '0' || *p > '9' || value > (maxValue - (*p - '0')) / 10)
+    {
+      return false;
+    }
+    value = value * 10 + (*p - '0');
+  }
+
+  return true;
+}
+
+bool parseRange(const std::string &name, std::string &prefix, size_t &first, size_t &last)
+{
+  std::string::size_type open = name.find('[');
+  std::string::size_type dots = name.find("..", open);
+  if(open == std::string::npos || dots == std::string::npos || name.size() < 2 || name[name.size() - 1] != ']')
+  {
+    return false;
+  }
+
+  const char *text = name.c_str();
+  const char *close = text + name.size() - 1;
+  std::string::size_type bad = name.find_first_not_of("0123456789", open + 1);
+  if(bad != dots || dots == open + 1 || dots + 2 >= name.size() - 1 || name.find_first_not_of("0123456789", dots + 2) != name.size() - 1)
+  {
+    return false;
+  }
+
+  /* the populations are meant to be huge, a bound must not wrap around. */
+  if(!parseBound(text + open + 1, text + dots, first) || !parseBound(text + dots + 2, close, last)
+     || last == static_cast<size_t>(-1))
+  {
+    throw std::logic_error("Range bound out of range <" + name + ">.");
+  }
+
+  prefix = name.substr(0, open);
+  if(last < first)
+  {
+    throw std::logic_error("Empty range <" + name + ">.");
+  }
+
+  return true;
+}
+
+double currentTime()
+{
+  struct timeval tv;
+  gettimeofday(&tv, 0);
+
+  return tv.tv_sec + tv.tv_usec / 1e6;
+}
+
+uint64_t hashBytes(const void *data, const size_t size, uint64_t hash)
+{
+  const unsigned char *p = static_cast<const unsigned char*>(data);
+  for(size_t i = 0; i < size; i++)
+  {
+    hash ^= p[i];
+    hash *= 0x100000001b3ULL;
+  }
+
+  return hash;
+}
+
+/**
+ * \brief Unit of a quantity.
+ */
+struct Unit
+{
+  /**
+   * \brief Unit as written after the number.
+   */
+  const char *name;
+
+  /**
+   * \brief Value of the unit in the stored unit.
+   */
+  uint64_t scale;
+};
+
+/**
+ * \brief Data rate units, in bit/s.
+ */
+static const Unit DATA_RATE_UNITS[] =
+{
+  { "bps", 1ULL }, { "b/s", 1ULL },
+  { "kbps", 1000ULL }, { "kb/s", 1000ULL },
+  { "Mbps", 1000000ULL }, { "Mb/s", 1000000ULL },
+  { "Gbps", 1000000000ULL }, { "Gb/s", 1000000000ULL },
+  { "Bps", 8ULL }, { "B/s", 8ULL },
+  { "kBps", 8000ULL }, { "kB/s", 8000ULL },
+  { "MBps", 8000000ULL }, { "MB/s", 8000000ULL },
+  { "GBps", 8000000000ULL }, { "GB/s", 8000000000ULL },
+  { 0, 0 }
+};
+
+/**
+ * \brief Time units, in nanoseconds.
+ */
+static const Unit TIME_UNITS[] =
+{
+  { "ns", 1ULL },
+  { "us", 1000ULL },
+  { "ms", NANOSECONDS_PER_MILLISECOND },
+  { "s", NANOSECONDS_PER_SECOND },
+  { "min", 60 * NANOSECONDS_PER_SECOND },
+  { "h", 3600 * NANOSECONDS_PER_SECOND },
+  { 0, 0 }
+};
+
+/**
+ * \brief Largest quantity.
+ */
+static const uint64_t MAX_QUANTITY = static_cast<uint64_t>(-1);
+
+/**
+ * \brief Parse a decimal number followed by an optional unit.
+ *
+ * The integer part is exact, the fraction is rounded to the stored unit.
+ * Blanks are allowed around the number and before the unit.
+ *
+ * \param text text to parse
+ * \param units known units, ended by a null name
+ * \param defaultScale value of a number without unit
+ * \param value number times the value of its unit
+ * \return false if the text is not a number with a known unit, or overflows
+ */
+static bool parseQuantity(const std::string &text, const Unit *units, const uint64_t defaultScale, uint64_t &value)
+{
+  const char *p = text.c_str();
+  const char *end = p + text.size();
+  while(p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r'))
+  {
+    p++;
+  }
+  while(end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\n' || end[-1] == '\r'))
+  {
+    end--;
+  }
+
+  uint64_t integer = 0;
+  size_t nDigits = 0;
+  for(; p < end && *p >= '0' && *p <= '9'; p++, nDigits++)
+  {
+    if(integer > (MAX_QUANTITY - (*p - '0')) / 10)
+    {
+      return false;
+    }
+    integer = integer * 10 + (*p - '0');
+  }
+
+  double fraction = 0;
+  if(p < end && *p == '.')
+  {
+    double weight = 0.1;
+    for(p++; p < end && *p >= '0' && *p <= '9'; p++, nDigits++)
+    {
+      fraction += (*p - '0') * weight;
+      weight /= 10;
+    }
+  }
+  if(nDigits == 0)
+  {
+    return false;
+  }
+
+  while(p < end && *p == ' ')
+  {
+    p++;
+  }
+  uint64_t scale = defaultScale;
+  if(p < end)
+  {
+    size_t length = end - p;
+    const Unit *unit = units;
+    while(unit->name && (strlen(unit->name) != length || memcmp(unit->name, p, length) != 0))
+    {
+      unit++;
+    }
+    if(!unit->name)
+    {
+      return false;
+    }
+    scale = unit->scale;
+  }
+
+  if(integer > MAX_QUANTITY / scale)
+  {
+    return false;
+  }
+  value = integer * scale + static_cast<uint64_t>(fraction * scale + 0.5);
+  return true;
+}
+
+bool parseDataRate(const std::string &text, uint64_t &bitsPerSecond)
+{
+  return parseQuantity(text, DATA_RATE_UNITS, 1, bitsPerSecond);
+}
+
+bool parseTime(const std::string &text, const uint64_t defaultUnit, uint64_t &nanoseconds)
+{
+  return parseQuantity(text, TIME_UNITS, defaultUnit, nanoseconds);
+}
+
+bool parseBoolean(const std::string &text, bool &value)
+{
+  /* the schema types the flags as strings, anything but "true" is false. */
+  value = text == "true";
+  return value || text.empty() || text == "false";
+}
+
+std::string secondsToString(const uint64_t nanoseconds)
+{
+  char text[TIME_CHARS];
+  return std::string(text, secondsToChars(nanoseconds, text));
+}
+
+size_t secondsToChars(const uint64_t nanoseconds, char *out)
+{
+  size_t n = integerToChars(nanoseconds / NANOSECONDS_PER_SECOND, out);
+  out[n++] = '.';
+  uint64_t fraction = nanoseconds % NANOSECONDS_PER_SECOND;
+  if(fraction == 0)
+  {
+    out[n++] = '0';
+    return n;
+  }
+
+  /* nine digits, without the trailing zeros. */
+  char digits[10];
+  for(int i = 8; i >= 0; i--)
+  {
+    digits[i] = '0' + fraction % 10;
+    fraction /= 10;
+  }
+  size_t size = 9;
+  while(digits[size - 1] == '0')
+  {
+    size--;
+  }
+
+  memcpy(out + n, digits, size);
+  return n + size;
+}
+
+std::string timeToCpp(const uint64_t nanoseconds)
+{
+  char text[TIME_CHARS];
+  return std::string(text, timeToChars(nanoseconds, text));
+}
+
+size_t timeToChars(const uint64_t nanoseconds, char *out)
+{
+  const char *unit = "NanoSeconds (";
+  uint64_t value = nanoseconds;
+  if(nanoseconds % NANOSECONDS_PER_MILLISECOND == 0)
+  {
+    unit = "MilliSeconds (";
+    value = nanoseconds / NANOSECONDS_PER_MILLISECOND;
+  }
+  else if(nanoseconds % 1000 == 0)
+  {
+    unit = "MicroSeconds (";
+    value = nanoseconds / 1000;
+  }
+
+  size_t n = strlen(unit);
+  memcpy(out, unit, n);
+  n += integerToChars(value, out + n);
+  out[n++] = ')';
+  return n;
+}
+
 } /* namespace utils */
 
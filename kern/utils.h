@@ -24,6 +24,7 @@
 #ifndef UTILS_H
 #define UTILS_H
 
+#include <stdint.h>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -35,6 +36,16 @@
 namespace utils
 {
 
+/**
+ * \brief Nanoseconds in a millisecond.
+ */
+const uint64_t NANOSECONDS_PER_MILLISECOND = 1000000ULL;
+
+/**
+ * \brief Nanoseconds in a second.
+ */
+const uint64_t NANOSECONDS_PER_SECOND = 1000000000ULL;
+
 /**
  * \brief Split function as boost::split(...)
  * \param res the vector wich contain the splitted vector
@@ -51,6 +62,19 @@ size_t split(std::vector<std::string> &res, std::string str, char separator);
  */
 std::string integerToString(const size_t nb);
 
+/**
+ * \brief Size of the buffer of integerToChars.
+ */
+const size_t INTEGER_CHARS = 20;
+
+/**
+ * \brief Write an integer in decimal into a buffer, without allocation.
+ * \param nb the number to convert
+ * \param out buffer of INTEGER_CHARS chars at least, not null terminated
+ * \return number of chars written
+ */
+size_t integerToChars(const uint64_t nb, char *out);
+
 /**
  * \brief Convert strint to size_t (integer).
  * \param str string to convert
@@ -59,6 +83,107 @@ std::string integerToString(const size_t nb);
  */
 int stringToInteger(const std::string& str) throw (std::runtime_error);
 
+/**
+ * \brief Parse a name range "prefix[first..last]".
+ * \param name name to parse
+ * \param prefix the name prefix
+ * \param first first index
+ * \param last last index
+ * \return false if name is not a range
+ * \throw std::logic_error if the range is empty, or a bound does not fit in a size_t
+ */
+bool parseRange(const std::string &name, std::string &prefix, size_t &first, size_t &last);
+
+/**
+ * \brief Get the wall clock time.
+ * \return seconds since the epoch, with microsecond resolution
+ */
+double currentTime();
+
+/**
+ * \brief Hash bytes with 64 bits FNV-1a.
+ *
+ * Hashes can be chained by passing the previous hash as the initial value.
+ *
+ * \param data bytes to hash
+ * \param size number of bytes
+ * \param hash initial value
+ * \return hash value
+ */
+uint64_t hashBytes(const void *data, const size_t size, uint64_t hash = 0xcbf29ce484222325ULL);
+
+/**
+ * \brief Parse a data rate, "5000000", "5Mbps" or "625 kB/s" for instance.
+ *
+ * The units are the ones of ns-3 DataRate with decimal prefixes: bps, b/s,
+ * kbps, Mbps, Gbps and Bps, B/s, kBps, MBps, GBps for bytes. A number
+ * without unit is in bit/s.
+ *
+ * \param text text to parse
+ * \param bitsPerSecond data rate
+ * \return false if the text is not a data rate
+ */
+bool parseDataRate(const std::string &text, uint64_t &bitsPerSecond);
+
+/**
+ * \brief Parse a duration, "2", "2ms" or "0.25 s" for instance.
+ *
+ * The units are ns, us, ms, s, min and h.
+ *
+ * \param text text to parse
+ * \param defaultUnit nanoseconds in the unit of a number without unit
+ * \param nanoseconds duration
+ * \return false if the text is not a duration
+ */
+bool parseTime(const std::string &text, const uint64_t defaultUnit, uint64_t &nanoseconds);
+
+/**
+ * \brief Parse a flag of the topology, only "true" is true.
+ * \param text text to parse
+ * \param value boolean, false for any other text
+ * \return false if the text is neither "true", "false" nor empty
+ */
+bool parseBoolean(const std::string &text, bool &value);
+
+/**
+ * \brief Write a duration in seconds, with at least one decimal: "1.0", "0.25".
+ * \param nanoseconds duration
+ * \return seconds
+ */
+std::string secondsToString(const uint64_t nanoseconds);
+
+/**
+ * \brief Size of the buffer of secondsToChars and timeToChars.
+ */
+const size_t TIME_CHARS = 40;
+
+/**
+ * \brief Write a duration in seconds into a buffer, as secondsToString.
+ * \param nanoseconds duration
+ * \param out buffer of TIME_CHARS chars at least, not null terminated
+ * \return number of chars written
+ */
+size_t secondsToChars(const uint64_t nanoseconds, char *out);
+
+/**
+ * \brief Write a duration as an ns-3 Time expression.
+ *
+ * The unit is the millisecond when the duration is a whole number of them,
+ * else the microsecond or the nanosecond: "MilliSeconds (2)", "MicroSeconds (6560)".
+ *
+ * \param nanoseconds duration
+ * \return C++ expression
+ */
+std::string timeToCpp(const uint64_t nanoseconds);
+
+/**
+ * \brief Write a duration as an ns-3 Time expression into a buffer, as timeToCpp.
+ * \param nanoseconds duration
+ * \param out buffer of TIME_CHARS chars at least, not null terminated
+ * \return number of chars written
+ */
+size_t timeToChars(const uint64_t nanoseconds, char *out);
+
 } /* namespace utils */
 
 #endif /* UTILS_H */
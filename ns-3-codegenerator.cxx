@@ -5,229 +5,679 @@ using namespace std;
 
 #include <memory>   // std::auto_ptr
 #include <iostream>
+#include <cerrno>
 #include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+#include <xercesc/util/PlatformUtils.hpp>
 
 #include "TopologySchema.hxx"
+#include "topology-sax.hxx"
+#include "topology-fast-reader.hxx"
+#include "topology-grammar.hxx"
+#include "topology-sqlite.hxx"
 
 #include "kern/generator.h"
-#include "kern/ap.h"
-#include "kern/udp-echo.h"
-#include "kern/udp-cosem.h"
-#include "kern/data-concentrator.h"
-#include "kern/meter-data-management.h"
+#include "kern/thread-pool.h"
+#include "kern/topology-builder.h"
+#include "kern/topology-fragment.h"
+#include "kern/topology-patch.h"
+#include "kern/topology-snapshot.h"
+#include "kern/utils.h"
 
 ///using std::cerr;
 ///using std::endl;
 
-int
-main (int argc, char* argv[])
+static void
+usage (const char *name)
 {
-  /* avoid compile warnings */
-  argc = argc;
-  argv = argv;
-  
-  if (argc != 3)
-  {
-    cerr << "usage: " << argv[0] << " <file>.xml <filename>.cc" << endl;
-    return 1;
-  }
-
-  try
-  {
-    ///using namespace AMISimpleWireless;
-
-    // Read in the XML file and obtain its object model.
-    //
-
-  Generator *gen = new Generator(std::string(argv[1]));
-
-xml_schema::properties properties;
-properties.no_namespace_schema_location("TopologySchema.xsd");
-
-    std::auto_ptr<Gen> g = Gen_ (argv[1], 0, properties);
+  cerr << "usage: " << name << " [options] <file>.xml[.gz|.zst]|<file>.db <filename>.cc" << endl
+       << "options:" << endl
+       << "  --stream   read the topology with the streaming (SAX2) parser" << endl
+       << "             instead of building its object model" << endl
+       << "  --fast     read the topology with the memory mapped reader," << endl
+       << "             the document is not validated" << endl
+       << "  --validate validate the document before the --fast reader" << endl
+       << "  --stats    print the read and generation throughput and the" << endl
+       << "             memory of the model" << endl
+       << "  --snapshot=<file>" << endl
+       << "             load the topology from <file> if it was made from the" << endl
+       << "             same input and schema, otherwise read the input and" << endl
+       << "             save it to <file>" << endl
+       << "  --patch=<file>" << endl
+       << "             apply the changes listed in <file> to the model built" << endl
+       << "             from the topology read (or loaded from the snapshot)" << endl
+       << "  --manifest the input lists topology files which are read" << endl
+       << "             concurrently and merged" << endl
+       << "  --jobs=<n> number of threads of --manifest and --batch (default: one" << endl
+       << "             per processor)" << endl
+       << "  --batch    the arguments are a directory or a list of inputs" << endl
+       << "             and an output directory, every input is generated" << endl
+       << "             on a pool of --jobs threads" << endl
+       << "  --emit=lines|loops|tables" << endl
+       << "             with loops, the runs of Pc and Station nodes named by" << endl
+       << "             consecutive numbers are created as populations, by" << endl
+       << "             loops instead of one block per node; tables adds the" << endl
+       << "             Hub and PointToPoint links, the UdpEcho and Udp" << endl
+       << "             applications and the flows as rows of constant" << endl
+       << "             tables walked by loops, the other nodes, links" << endl
+       << "             and applications stay code (default: lines)" << endl
+       << "  --quiet    do not trace the generator calls" << endl;
+}
 
-    // Let's print what we've got.
-    //
+/// Build the model from the object model of the document ///
+static void
+buildFromTree (const char *fileName, const TopologyGrammar &grammar, TopologySink &sink)
+{
+    // The document is validated against the cached grammar, Xerces-C++
+    // is initialized once by main so documents may be read by several
+    // threads.
+    xml_schema::dom::auto_ptr<xercesc::DOMDocument> doc (grammar.ParseDocument (fileName));
+    std::auto_ptr<Gen> g = Gen_ (doc, xml_schema::flags::dont_initialize);
 
 /// Build nodes ///
-int i = 0;
 Gen::Nodes_type::node_const_iterator ni = g->Nodes().node().begin();
 for (; ni != g->Nodes().node().end(); ni++)
   {
-cerr << "gen->AddNode(" << (*ni).type() << ", " << (*ni).name() << ")" << endl;
-  gen->AddNode((*ni).type(), (*ni).name());
-cerr << "gem->GetNode(" << i << ")->SetFlowmonitor(" << (*ni).enableFlowmonitor() << ")" << endl;
-  if ((*ni).enableFlowmonitor() == "true")
-    gen->GetNode(i)->SetFlowmonitor(true);
-  else gen->GetNode(i)->SetFlowmonitor(false);
-  i++;
+  NodeSpec node;
+  node.type = (*ni).type();
+  node.name = (*ni).name();
+  node.enableFlowmonitor = (*ni).enableFlowmonitor();
+  sink.AddNode(node);
   }
 
 /// Add Network hardware ///
-///  Ap *ap = dynamic_cast<Ap*>(gen->GetNetworkHardware(0));
-char buffer[20];
-std::size_t length;
-
-i = 0;
 Gen::NetworkHardwares_type::networkHardware_const_iterator hi = g->NetworkHardwares().networkHardware().begin();
 Gen::NetworkHardwares_type::networkHardware_type::connectedNodes_type::name_const_iterator namei;
 for (; hi != g->NetworkHardwares().networkHardware().end(); hi++)
   {
-  if (((*hi).type() == "Ap") || ((*hi).type() == "Bridge"))
+  NetworkHardwareSpec hardware;
+  hardware.type = (*hi).type();
+  hardware.name = (*hi).name();
+  hardware.dataRate = (*hi).dataRate();
+  hardware.linkDelay = (*hi).linkDelay();
+  hardware.enableTrace = (*hi).enableTrace();
+  sink.AddNetworkHardware(hardware);
+
+    for (namei = (*hi).connectedNodes().name().begin(); namei != (*hi).connectedNodes().name().end(); namei++)
     {
-    if (((*hi).name().compare(0, 2, "hw") != 0) && ((*hi).type() == "Ap"))
-      {
-      cerr << "Error-> Improper AP hardware name <" << (*hi).name() << ">" << endl;
-      return 1;
-      }
+    sink.InstallNode(*namei);
+    }
+  }
 
-    length = (*hi).name().copy(buffer, (*hi).name().length(), 2);  //Trim off the first two characters
-    buffer[length] = '\0';
+/// Add Applications ///
+Gen::Applications_type::application_const_iterator ai = g->Applications().application().begin();
+for (; ai != g->Applications().application().end(); ai++)
+  {
+  ApplicationSpec app;
+  app.type = (*ai).type();
+  app.name = (*ai).name();
+  app.sender = (*ai).sender();
+  app.receiver = (*ai).receiver();
+  app.startTime = (*ai).startTime();
+  app.endTime = (*ai).endTime();
+
+  if (ai->special().present())
+    {
+    const Gen::Applications_type::application_type::special_type &special = *ai->special();
+    if ((app.hasPort = special.port().present()))
+      app.port = *special.port();
+    if ((app.hasInterval = special.interval().present()))
+      app.interval = *special.interval();
+    if ((app.hasReadingTime = special.readingTime().present()))
+      app.readingTime = *special.readingTime();
+    if ((app.hasPacketSize = special.packetSize().present()))
+      app.packetSize = *special.packetSize();
+    if ((app.hasMaxPacketCount = special.maxPacketCount().present()))
+      app.maxPacketCount = *special.maxPacketCount();
+    if ((app.hasPacketIntervalTime = special.packetIntervalTime().present()))
+      app.packetIntervalTime = *special.packetIntervalTime();
+    }
 
-cerr << "gen->AddNetworkHardware(" << (*hi).type() << ", " << buffer << ")" << endl;
-    gen->AddNetworkHardware((*hi).type(), buffer);
+  sink.AddApplication(app);
+  }
 
-cerr << "gen->GetNetworkHardware(" << i << ")->SetDataRate(" << (*hi).dataRate() << ")" << endl;
-    gen->GetNetworkHardware(i)->SetDataRate((*hi).dataRate());
-cerr << "gen->GetNetworkHardware(" << i << ")->SetNetworkHardwareDelay(" << (*hi).linkDelay() << ")" << endl;
-    gen->GetNetworkHardware(i)->SetNetworkHardwareDelay((*hi).linkDelay());
-cerr << "gen->GetNetworkHardware(" << i << ")->SetTrace(" << (*hi).enableTrace() << ")" << endl;
-    if ((*hi).enableTrace() == "true")
-      gen->GetNetworkHardware(i)->SetTrace(true);
-    else gen->GetNetworkHardware(i)->SetTrace(false);
+/// Flow information ///
+Gen::Flows_type::flow_const_iterator fi = g->Flows().flow().begin();
+for (; fi != g->Flows().flow().end(); fi++)
+  {
+  FlowSpec flow;
+  flow.type = (*fi).type();
+  flow.name = (*fi).name();
+  flow.source = (*fi).source();
+  flow.destination = (*fi).destination();
+  flow.expectedDelaySeconds = (*fi).expectedDelaySeconds();
+  flow.expectedReliabilityPercent = (*fi).expectedReliabilityPercent();
+  sink.AddFlow(flow);
+  }
+}
 
-    }
+/// Shape of the generated code ///
+enum EmitMode
+{
+  EMIT_LINES,
+  EMIT_LOOPS,
+  EMIT_TABLES
+};
+
+/// Read a topology file with the selected reader ///
+struct ReaderOptions
+{
+  bool stream;
+  bool fast;
+  bool validate;
+  EmitMode emit;
+  const TopologyGrammar *grammar;
+};
+
+static void
+readTopology (const std::string &fileName, const ReaderOptions &options, TopologySink &sink)
+{
+  // With --stream the elements go straight from the parser events to
+  // the generator, the object model of the document is never built.
+  // With --fast the document is scanned in place, names and texts are
+  // handed to the generator as slices of the mapping, --validate only
+  // checks it against the schema first. A database is read with
+  // cursors whatever the reader.
+  //
+  if (IsTopologyDatabase (fileName))
+    ParseTopologyDatabase (fileName, sink);
+  else if (options.stream)
+    ParseTopologyStream (fileName, *options.grammar, sink);
+  else if (options.fast)
+  {
+    if (options.validate)
+      ValidateTopology (fileName, *options.grammar);
+    ParseTopologyFast (fileName, sink);
+  }
   else
-    {
-cerr << "gen->AddNetworkHardware(" << (*hi).type() << ")" << endl;
-    gen->AddNetworkHardware((*hi).type());
+    buildFromTree (fileName.c_str (), *options.grammar, sink);
+}
 
-cerr << "gen->GetNetworkHardware(" << i << ")->SetDataRate(" << (*hi).dataRate() << ")" << endl;
-    gen->GetNetworkHardware(i)->SetDataRate((*hi).dataRate());
-cerr << "gen->GetNetworkHardware(" << i << ")->SetNetworkHardwareDelay(" << (*hi).linkDelay() << ")" << endl;
-    gen->GetNetworkHardware(i)->SetNetworkHardwareDelay((*hi).linkDelay());
-cerr << "gen->GetNetworkHardware(" << i << ")->SetTrace(" << (*hi).enableTrace() << ")" << endl;
-    if ((*hi).enableTrace() == "true")
-      gen->GetNetworkHardware(i)->SetTrace(true);
-    else gen->GetNetworkHardware(i)->SetTrace(false);
+/// Read one fragment of a modular topology ///
+class FragmentTask : public ThreadTask
+{
+public:
+  FragmentTask (const std::string &fileName, const ReaderOptions &options)
+    : m_fragment (fileName), m_options (options)
+  {
+  }
 
+  virtual void
+  Run ()
+  {
+    try
+    {
+      readTopology (m_fragment.GetFileName (), m_options, m_fragment);
     }
-
-    for (namei = (*hi).connectedNodes().name().begin(); namei != (*hi).connectedNodes().name().end(); namei++)
+    catch (const xml_schema::exception& e)
     {
-cerr << "gen->GetNetworkHardware(" << i << ")->Install(" << *namei << ")" << endl;
-    gen->GetNetworkHardware(i)->Install(*namei);
+      std::ostringstream os;
+      os << e;
+      throw std::runtime_error (os.str ());
     }
-
-  i++;
   }
 
-/// Add Applications ///
-i = 0;
-///int j = 0;
-Gen::Applications_type::application_const_iterator ai = g->Applications().application().begin();
-for (; ai != g->Applications().application().end(); ai++)
+  TopologyFragment m_fragment;
+  ReaderOptions m_options;
+};
+
+/// Size of the files read, in MB ///
+static double
+fileSize (const std::vector<std::string> &fileNames)
+{
+  double mb = 0;
+  for (size_t i = 0; i < fileNames.size (); i++)
   {
-///UDP Echo
-  if ((*ai).type() == "UdpEcho")
-    {
-cerr << "gen->AddApplication(" << (*ai).type() << ", " << (*ai).sender() << ", " << (*ai).receiver() << ", " << (*ai).startTime() << ", " << (*ai).endTime() << ", " << *ai->special()->port() << ")" << endl;
+    struct stat st;
+    if (stat (fileNames[i].c_str (), &st) == 0)
+      mb += st.st_size / 1e6;
+  }
+  return mb;
+}
 
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime(), *ai->special()->port());
+/// Options of a single scenario, beside the reader ones ///
+struct RunOptions
+{
+  bool stats;
+  bool quiet;
+  bool manifest;
+  size_t jobs;
+  std::string snapshotFile;
+  std::string patchFile;
+};
+
+/// One input of a batch and the code generated from it ///
+struct BatchItem
+{
+  std::string input;
+  std::string output;
+};
 
-    UdpEcho *app = dynamic_cast<UdpEcho*>(gen->GetApplication(i));
-    app->SetPacketSize(*ai->special()->packetSize());
-    app->SetPacketIntervalTime(*ai->special()->packetIntervalTime());
-    app->SetMaxPacketCount(*ai->special()->maxPacketCount());
+/// Name of the generated file of an input: its base name without the extensions ///
+static std::string
+batchOutputName (const std::string &input)
+{
+  std::string name = input.substr (input.rfind ('/') + 1);
+  const char *suffixes[] = {".gz", ".zst", ".xml", ".db"};
+  for (size_t i = 0; i < sizeof (suffixes) / sizeof (suffixes[0]); i++)
+  {
+    size_t length = strlen (suffixes[i]);
+    if (name.size () > length && name.compare (name.size () - length, length, suffixes[i]) == 0)
+      name.erase (name.size () - length);
+  }
+  return name + ".cc";
+}
 
-    i++;
-    }
+/// List the inputs of a batch: a directory or a list file ///
+static std::vector<BatchItem>
+readBatch (const std::string &source, const std::string &outputDir)
+{
+  std::vector<BatchItem> items;
+  struct stat st;
+  if (stat (source.c_str (), &st) != 0)
+    throw std::runtime_error (source + ": " + strerror (errno));
 
-///UDP cosem
-  if ((*ai).type() == "UdpCosem")
+  if (S_ISDIR (st.st_mode))
+  {
+    // Every topology of the directory, in name order.
+    //
+    DIR *dir = opendir (source.c_str ());
+    if (dir == 0)
+      throw std::runtime_error (source + ": " + strerror (errno));
+    std::vector<std::string> names;
+    for (struct dirent *e = readdir (dir); e != 0; e = readdir (dir))
     {
-cerr << "gen->AddApplication(" << (*ai).type() << ", " << (*ai).sender() << ", " << (*ai).receiver() << ", " << (*ai).startTime() << ", " << (*ai).endTime() << ", " << *ai->special()->port() << ")" << endl;
+      std::string name = e->d_name;
+      if (name[0] != '.' && batchOutputName (name) != name + ".cc")
+        names.push_back (name);
+    }
+    closedir (dir);
+    std::sort (names.begin (), names.end ());
 
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime(), *ai->special()->port());
+    for (size_t i = 0; i < names.size (); i++)
+    {
+      BatchItem item;
+      item.input = source + "/" + names[i];
+      item.output = outputDir + "/" + batchOutputName (names[i]);
+      items.push_back (item);
+    }
+    return items;
+  }
 
-    UdpCosem *appCosem = dynamic_cast<UdpCosem*>(gen->GetApplication(i));
-///    appCosem->SetPacketSize(*ai->special()->packetSize());
-    appCosem->SetPacketIntervalTime(*ai->special()->packetIntervalTime());
-///    appCosem->SetMaxPacketCount(*ai->special()->maxPacketCount());
+  // A list: "input [output]" per line, empty lines and lines starting
+  // with # are ignored. Inputs are relative to the list, outputs to the
+  // output directory.
+  //
+  std::ifstream list (source.c_str ());
+  if (!list)
+    throw std::runtime_error ("Cannot open batch list " + source);
+  std::string dir = source.rfind ('/') == std::string::npos ? "" : source.substr (0, source.rfind ('/') + 1);
+  std::string line;
+  while (std::getline (list, line))
+  {
+    std::istringstream is (line);
+    BatchItem item;
+    if (!(is >> item.input) || item.input[0] == '#')
+      continue;
+    if (!(is >> item.output))
+      item.output = batchOutputName (item.input);
+    if (item.input[0] != '/')
+      item.input = dir + item.input;
+    if (item.output[0] != '/')
+      item.output = outputDir + "/" + item.output;
+    items.push_back (item);
+  }
+  return items;
+}
 
+/// Parse, build and emit one scenario of a batch ///
+class ScenarioTask : public ThreadTask
+{
+public:
+  ScenarioTask (const BatchItem &item, const ReaderOptions &options)
+    : m_item (item), m_options (options)
+  {
+  }
 
-    i++;
+  virtual void
+  Run ()
+  {
+    // A failure stays with its scenario, the others go on.
+    //
+    try
+    {
+      Generator gen (m_item.input);
+      gen.SetEmitTables (m_options.emit == EMIT_TABLES);
+      TopologyBuilder builder (&gen);
+      builder.SetVerbose (false);
+      builder.SetNodeGrouping (m_options.emit != EMIT_LINES);
+      readTopology (m_item.input, m_options, builder);
+      builder.Finish ();
+      gen.GenerateCodeCpp (m_item.output);
     }
-
-///Data Concentrator
-  if ((*ai).type() == "DataConcentrator")
+    catch (const xml_schema::exception& e)
+    {
+      std::ostringstream os;
+      os << e;
+      m_error = os.str ();
+    }
+    catch (const std::exception& e)
+    {
+      m_error = e.what ();
+    }
+    catch (...)
     {
-cerr << "gen->AddApplication(" << (*ai).type() << ", " << (*ai).sender() << ", " << (*ai).receiver() << ", " << (*ai).startTime() << ", " << (*ai).endTime() << ")" << endl;
+      m_error = "unknown error";
+    }
+  }
 
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime());
+  BatchItem m_item;
+  ReaderOptions m_options;
+  std::string m_error;
+};
 
-///    DataConcentrator *appDC = dynamic_cast<UdpDC*>(gen->GetApplication(i));
-///    appCosem->SetPacketSize(*ai->special()->packetSize());
-///    appDC->SetPacketIntervalTime(*ai->special()->packetIntervalTime());
-///    appCosem->SetMaxPacketCount(*ai->special()->maxPacketCount());
+/// Run a batch and print its report ///
+static int
+runBatch (const std::vector<BatchItem> &items, const ReaderOptions &options, size_t jobs)
+{
+  double start = utils::currentTime ();
 
+  std::vector<ScenarioTask*> tasks;
+  std::vector<ThreadTask*> threadTasks;
+  for (size_t i = 0; i < items.size (); i++)
+  {
+    tasks.push_back (new ScenarioTask (items[i], options));
+    threadTasks.push_back (tasks.back ());
+  }
 
-    i++;
-    }
+  ThreadPool pool (jobs);
+  pool.Run (threadTasks);
+  double seconds = utils::currentTime () - start;
 
-///Meter Data Management
-  if ((*ai).type() == "MeterDataManagement")
+  size_t failed = 0;
+  std::vector<std::string> inputs;
+  for (size_t i = 0; i < tasks.size (); i++)
+  {
+    inputs.push_back (tasks[i]->m_item.input);
+    if (!tasks[i]->m_error.empty ())
     {
-cerr << "gen->AddApplication(" << (*ai).type() << ", " << (*ai).sender() << ", " << (*ai).receiver() << ", " << (*ai).startTime() << ", " << (*ai).endTime() << ", " << *ai->special()->interval() << ", " << *ai->special()->readingTime() << ")" << endl;
+      cerr << tasks[i]->m_item.input << ": " << tasks[i]->m_error << endl;
+      failed++;
+    }
+    delete tasks[i];
+  }
 
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime(), *ai->special()->interval(), *ai->special()->readingTime());
+  double mb = fileSize (inputs);
+  cerr << "batch: " << items.size () << " scenarios (" << failed << " failed), "
+       << mb << " MB in " << seconds << " s on " << pool.GetNThreads () << " threads";
+  if (seconds > 0)
+    cerr << " (" << items.size () / seconds << " scenarios/s, " << mb / seconds << " MB/s)";
+  cerr << endl;
 
-    i++;
-    }
+  return failed == 0 ? 0 : 1;
+}
+
+/// Print the throughput of a phase ///
+static void
+printStats (const char *phase, const char *fileName, double mb, double seconds)
+{
+  cerr << phase << " " << fileName << ": " << mb << " MB in " << seconds << " s";
+  if (seconds > 0)
+    cerr << " (" << mb / seconds << " MB/s)";
+  cerr << endl;
+}
 
-///Demand Response
-  if ((*ai).type() == "DemandResponse")
+/// Read, build and emit a single scenario ///
+static int
+runSingle (const char *input, const char *output, const ReaderOptions &options, const RunOptions &run)
+{
+  // Read in the XML file and build the generator model.
+  //
+  std::auto_ptr<Generator> gen (new Generator(std::string(input)));
+  gen->SetEmitTables (options.emit == EMIT_TABLES);
+  TopologyBuilder builder (gen.get ());
+  builder.SetVerbose (!run.quiet);
+  builder.SetNodeGrouping (options.emit != EMIT_LINES);
+
+  double start = utils::currentTime ();
+
+  // With --patch the topology goes through the patch on its way to the
+  // builder, the patch notes where the elements it changes are and edits
+  // the model once it is built. The snapshot keeps the topology of the
+  // input.
+  //
+  TopologyPatch patch (builder, *gen);
+  TopologySink &target = run.patchFile.empty () ? static_cast<TopologySink&> (builder) : patch;
+  if (!run.patchFile.empty ())
+  {
+    patch.Read (run.patchFile);
+    const std::vector<std::string> &added = patch.GetAddedFiles ();
+    for (size_t i = 0; i < added.size (); i++)
     {
-cerr << "gen->AddApplication(" << (*ai).type() << ", " << (*ai).sender() << ", " << (*ai).receiver() << ", " << (*ai).startTime() << ", " << (*ai).endTime() << ")" << endl;
+      TopologyFragment fragment (added[i]);
+      readTopology (added[i], options, fragment);
+      patch.Add (fragment);
+    }
+  }
 
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime());
+  // With --manifest the input lists the topology files to read.
+  //
+  std::vector<std::string> inputFiles (1, input);
+  if (run.manifest)
+  {
+    std::vector<std::string> fragments = ReadTopologyManifest (input);
+    inputFiles.insert (inputFiles.end (), fragments.begin (), fragments.end ());
+  }
 
-    i++;
+  // A snapshot made from the same input and schema replaces the read.
+  //
+  uint64_t snapshotKey = 0;
+  bool loaded = false;
+  if (!run.snapshotFile.empty ())
+  {
+    snapshotKey = ComputeSnapshotKey (inputFiles, TopologySchemaText, TopologySchemaTextSize);
+    TopologySnapshot snapshot;
+    if (snapshot.Open (run.snapshotFile, snapshotKey))
+    {
+      snapshot.Replay (target);
+      loaded = true;
+      if (!run.quiet)
+        cerr << "topology loaded from snapshot " << run.snapshotFile << endl;
     }
+  }
+
+  if (!loaded)
+  {
+    TopologySnapshotWriter writer;
+    TopologyTee tee (target, writer);
+    TopologySink &sink = run.snapshotFile.empty () ? target : tee;
+    if (!run.snapshotFile.empty ())
+      writer.Open (run.snapshotFile, snapshotKey);
 
-///TCP transfer
-  if ((*ai).type() == "TcpLargeTransfer")
+    if (run.manifest)
     {
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime(), *ai->special()->port());
+      // The fragments are read concurrently, then merged in manifest
+      // order so the generated code does not depend on the scheduling.
+      //
+      std::vector<FragmentTask*> tasks;
+      std::vector<ThreadTask*> threadTasks;
+      std::vector<TopologyFragment*> fragments;
+      try
+      {
+        for (size_t i = 1; i < inputFiles.size (); i++)
+        {
+          tasks.push_back (new FragmentTask (inputFiles[i], options));
+          threadTasks.push_back (tasks.back ());
+          fragments.push_back (&tasks.back ()->m_fragment);
+        }
+
+        ThreadPool pool (run.jobs);
+        pool.Run (threadTasks);
+        MergeTopologyFragments (fragments, sink);
+      }
+      catch (...)
+      {
+        for (size_t i = 0; i < tasks.size (); i++)
+          delete tasks[i];
+        throw;
+      }
+      for (size_t i = 0; i < tasks.size (); i++)
+        delete tasks[i];
     }
-
-///Ping
-  if ((*ai).type() == "Ping")
+    else
     {
-    gen->AddApplication((*ai).type(), (*ai).sender(), (*ai).receiver(), (*ai).startTime(), (*ai).endTime());
+      readTopology (input, options, sink);
     }
 
+    if (!run.snapshotFile.empty ())
+      writer.Commit ();
   }
 
-/// Flow information ///
-i = 0;
-Gen::Flows_type::flow_const_iterator fi = g->Flows().flow().begin();
-for (; fi != g->Flows().flow().end(); fi++)
+  // The builder holds the last run of nodes with --emit=loops or tables.
+  //
+  builder.Finish ();
+
+  if (!run.patchFile.empty ())
   {
-cerr << "gen->AddFlow(" << (*fi).type() << ", " << (*fi).name() << ", " << (*fi).source() << ", " << (*fi).destination() << ", " << (*fi).expectedDelaySeconds() << ", " << (*fi).expectedReliabilityPercent() << ")" << endl;
+    double patchStart = utils::currentTime ();
+    patch.Apply ();
+    if (!run.quiet || run.stats)
+      cerr << "patch " << run.patchFile << ": " << patch.GetNChanges () << " changes applied in "
+           << utils::currentTime () - patchStart << " s" << endl;
+  }
 
-  gen->AddFlow((*fi).type(), (*fi).name(), (*fi).source(), (*fi).destination(), (*fi).expectedDelaySeconds(), (*fi).expectedReliabilityPercent());
-  i++;
+  if (run.stats)
+  {
+    printStats ("read", input, fileSize (inputFiles), utils::currentTime () - start);
+    const Arena &arena = gen->GetArena ();
+    cerr << "model: " << arena.GetNAllocations () << " objects, " << arena.GetAllocatedSize () / 1e6 << " MB in "
+         << arena.GetNBlocks () << " blocks (" << arena.GetReservedSize () / 1e6 << " MB)" << endl;
   }
 
-/// Generate ns-3 cc file ///
-  gen->GenerateCodeCpp(argv[2]);
-  delete gen;
+  // Generate the ns-3 program.
+  //
+  start = utils::currentTime ();
+  gen->GenerateCodeCpp(output);
+  if (run.stats)
+    printStats ("generate", output, fileSize (std::vector<std::string> (1, output)), utils::currentTime () - start);
+
+  return 0;
+}
 
+int
+main (int argc, char* argv[])
+{
+  ReaderOptions options;
+  options.stream = false;
+  options.fast = false;
+  options.validate = false;
+  options.emit = EMIT_LINES;
+  options.grammar = 0;
+  RunOptions run;
+  run.stats = false;
+  run.quiet = false;
+  run.manifest = false;
+  run.jobs = 0;
+  bool batch = false;
+
+  int argi = 1;
+  for (; argi < argc && strncmp (argv[argi], "--", 2) == 0; argi++)
+  {
+    if (strcmp (argv[argi], "--stream") == 0)
+      options.stream = true;
+    else if (strcmp (argv[argi], "--fast") == 0)
+      options.fast = true;
+    else if (strcmp (argv[argi], "--validate") == 0)
+      options.validate = true;
+    else if (strcmp (argv[argi], "--emit=lines") == 0)
+      options.emit = EMIT_LINES;
+    else if (strcmp (argv[argi], "--emit=loops") == 0)
+      options.emit = EMIT_LOOPS;
+    else if (strcmp (argv[argi], "--emit=tables") == 0)
+      options.emit = EMIT_TABLES;
+    else if (strcmp (argv[argi], "--stats") == 0)
+      run.stats = true;
+    else if (strcmp (argv[argi], "--quiet") == 0)
+      run.quiet = true;
+    else if (strcmp (argv[argi], "--manifest") == 0)
+      run.manifest = true;
+    else if (strcmp (argv[argi], "--batch") == 0)
+      batch = true;
+    else if (strncmp (argv[argi], "--jobs=", 7) == 0 && atoi (argv[argi] + 7) > 0)
+      run.jobs = atoi (argv[argi] + 7);
+    else if (strncmp (argv[argi], "--snapshot=", 11) == 0)
+      run.snapshotFile = argv[argi] + 11;
+    else if (strncmp (argv[argi], "--patch=", 8) == 0)
+      run.patchFile = argv[argi] + 8;
+    else
+    {
+      cerr << "unknown option " << argv[argi] << endl;
+      usage (argv[0]);
+      return 1;
+    }
+  }
+
+  if (argc - argi != 2 || (options.stream && options.fast)
+      || (batch && (run.manifest || !run.snapshotFile.empty () || !run.patchFile.empty ())))
+  {
+    usage (argv[0]);
+    return 1;
+  }
+
+  const char *input = argv[argi];
+  const char *output = argv[argi + 1];
+
+  // Xerces-C++ is needed by every reader but the unvalidated --fast one.
+  //
+  bool xerces = !options.fast || options.validate;
+  if (xerces)
+    xercesc::XMLPlatformUtils::Initialize ();
+
+  int ret = 0;
+  std::auto_ptr<TopologyGrammar> grammar;
+  try
+  {
+    // The schema embedded in the generator is compiled once for all the
+    // documents read.
+    //
+    if (xerces)
+      grammar.reset (new TopologyGrammar);
+    options.grammar = grammar.get ();
+
+    // With --batch the arguments are the inputs and the output directory,
+    // all the scenarios share the Xerces-C++ initialization and the grammar.
+    //
+    if (batch)
+    {
+      ret = runBatch (readBatch (input, output), options, run.jobs);
+    }
+    else
+    {
+      ret = runSingle (input, output, options, run);
+    }
   }
   catch (const xml_schema::exception& e)
   {
     cerr << e << endl;
-    return 1;
+    ret = 1;
+  }
+  catch (const std::exception& e)
+  {
+    cerr << e.what () << endl;
+    ret = 1;
   }
+
+  grammar.reset ();
+  if (xerces)
+    xercesc::XMLPlatformUtils::Terminate ();
+  return ret;
 }
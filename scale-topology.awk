@@ -0,0 +1,44 @@
+# Scale a topology for benchmarking: the content of every section of the
+# Gen document is repeated "copies" times, the names of the copy k (k > 0)
+# get the "_ck" suffix so every copy is a disconnected replica of the
+# original topology.
+#
+#  $ awk -v copies=10000 -f scale-topology.awk AMISimpleWireless_xml > big.xml
+
+BEGIN {
+  if (copies < 1)
+    copies = 1
+}
+
+/<(Nodes|NetworkHardwares|Applications|Flows)>/ {
+  print
+  section = 1
+  n = 0
+  next
+}
+
+/<\/(Nodes|NetworkHardwares|Applications|Flows)>/ {
+  for (k = 0; k < copies; k++)
+  {
+    for (i = 0; i < n; i++)
+    {
+      line = lines[i]
+      # insert the suffix before the end tag of the name
+      if (k > 0 && match(line, /<(name|sender|receiver|source|destination)>[^<]*</))
+        line = substr(line, 1, RSTART + RLENGTH - 2) "_c" k substr(line, RSTART + RLENGTH - 1)
+      print line
+    }
+  }
+  print
+  section = 0
+  next
+}
+
+section {
+  lines[n++] = $0
+  next
+}
+
+{
+  print
+}
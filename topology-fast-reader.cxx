@@ -0,0 +1,483 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-fast-reader.cxx
+ * \brief Zero-copy reader of the Gen topology format.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#if defined (__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "topology-fast-reader.hxx"
+#include "kern/compressed-file.h"
+#include "kern/mapped-file.h"
+#include "kern/topology-element-handler.h"
+
+/**
+ * \brief Find the first occurrence of a byte.
+ * \return position of the byte, or end if it is not found
+ */
+static inline const char *
+FindChar (const char *p, const char *end, char c)
+{
+#if defined (__SSE2__)
+  // Compare 16 bytes at a time, the tags of a topology are a few
+  // tens of bytes apart.
+  const __m128i needle = _mm_set1_epi8 (c);
+  for (; end - p >= 16; p += 16)
+  {
+    __m128i chunk = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (p));
+    int mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (chunk, needle));
+    if (mask != 0)
+      return p + __builtin_ctz (mask);
+  }
+#endif
+  const void *res = memchr (p, c, end - p);
+  return res ? static_cast<const char*> (res) : end;
+}
+
+/**
+ * \brief Find the first occurrence of a string.
+ * \return position of the string, or end if it is not found
+ */
+static const char *
+FindString (const char *p, const char *end, const char *s)
+{
+  size_t length = strlen (s);
+  for (p = FindChar (p, end, s[0]); end - p >= static_cast<long> (length); p = FindChar (p + 1, end, s[0]))
+  {
+    if (memcmp (p, s, length) == 0)
+      return p;
+  }
+  return end;
+}
+
+static inline bool
+IsSpace (char c)
+{
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+static inline bool
+IsNameEnd (char c)
+{
+  return IsSpace (c) || c == '>' || c == '/';
+}
+
+/**
+ * \brief Fast reader state.
+ */
+class FastReader
+{
+  public:
+    FastReader (const char *data, size_t size, const std::string &systemId, TopologySink &sink);
+
+    void Parse ();
+
+  private:
+    /**
+     * \brief Element name, as a slice of the document.
+     */
+    struct Name
+    {
+      const char *data;
+      size_t length;
+    };
+
+    void Error (const char *at, const std::string &message) const;
+
+    const char *ReadName (const char *p, Name &name) const;
+    const char *ReadStartTag (const char *p, bool &empty);
+    const char *ReadEndTag (const char *p, Name &name);
+    const char *ReadMarkup (const char *p);
+    void CheckDeclaration (const char *begin, const char *end) const;
+    void AppendText (const char *begin, const char *end);
+
+    const char *m_begin;
+    const char *m_end;
+    std::string m_systemId;
+    TopologyElementHandler m_elements;
+
+    /**
+     * \brief Open elements.
+     */
+    std::vector<Name> m_open;
+
+    /**
+     * \brief True once the root element is closed.
+     */
+    bool m_done;
+
+    /**
+     * \brief Text with the character references replaced, or split by comments.
+     */
+    std::string m_text;
+};
+
+FastReader::FastReader (const char *data, size_t size, const std::string &systemId, TopologySink &sink)
+  : m_begin (data),
+    m_end (data + size),
+    m_systemId (systemId),
+    m_elements (sink),
+    m_done (false)
+{
+}
+
+void
+FastReader::Error (const char *at, const std::string &message) const
+{
+  // The position is only computed when reporting an error.
+  size_t line = 1;
+  const char *lineStart = m_begin;
+  for (const char *p = FindChar (m_begin, at, '\n'); p != at; p = FindChar (p + 1, at, '\n'))
+  {
+    line++;
+    lineStart = p + 1;
+  }
+
+  std::ostringstream os;
+  os << m_systemId << ":" << line << ":" << (at - lineStart + 1) << " error: " << message;
+  throw std::runtime_error (os.str ());
+}
+
+const char *
+FastReader::ReadName (const char *p, Name &name) const
+{
+  const char *begin = p;
+  while (p != m_end && !IsNameEnd (*p))
+    p++;
+  if (p == begin)
+    Error (begin, "expected an element name");
+
+  // The Gen format has no namespace, drop the prefix if any.
+  const char *colon = static_cast<const char*> (memchr (begin, ':', p - begin));
+  name.data = colon ? colon + 1 : begin;
+  name.length = p - name.data;
+  return p;
+}
+
+const char *
+FastReader::ReadStartTag (const char *p, bool &empty)
+{
+  if (m_done)
+    Error (p, "content after the root element");
+
+  Name name;
+  p = ReadName (p, name);
+  if (m_open.empty () && !(name.length == 3 && memcmp (name.data, "Gen", 3) == 0))
+    Error (name.data, "root element is not <Gen>");
+
+  // Attributes are skipped; their values may contain '>' so the quotes
+  // have to be followed.
+  for (;;)
+  {
+    while (p != m_end && IsSpace (*p))
+      p++;
+    if (p == m_end)
+      Error (p, "unterminated start tag");
+    if (*p == '>')
+    {
+      empty = false;
+      p++;
+      break;
+    }
+    if (*p == '/')
+    {
+      if (p + 1 == m_end || p[1] != '>')
+        Error (p, "expected '>'");
+      empty = true;
+      p += 2;
+      break;
+    }
+
+    const char *eq = FindChar (p, m_end, '=');
+    const char *quote = eq;
+    if (eq != m_end)
+    {
+      for (quote = eq + 1; quote != m_end && IsSpace (*quote); quote++)
+        ;
+    }
+    if (quote == m_end || (*quote != '"' && *quote != '\''))
+      Error (p, "malformed attribute");
+    const char *close = FindChar (quote + 1, m_end, *quote);
+    if (close == m_end)
+      Error (quote, "unterminated attribute value");
+    p = close + 1;
+  }
+
+  m_elements.StartElement (name.data, name.length);
+  if (empty)
+  {
+    m_elements.EndElement (name.data, name.length, "", 0);
+    if (m_open.empty ())
+      m_done = true;
+  }
+  else
+  {
+    m_open.push_back (name);
+  }
+  return p;
+}
+
+const char *
+FastReader::ReadEndTag (const char *p, Name &name)
+{
+  const char *begin = p;
+  p = ReadName (p, name);
+  while (p != m_end && IsSpace (*p))
+    p++;
+  if (p == m_end || *p != '>')
+    Error (p, "expected '>'");
+
+  if (m_open.empty ())
+    Error (begin, "unexpected end tag");
+  const Name &open = m_open.back ();
+  if (open.length != name.length || memcmp (open.data, name.data, name.length) != 0)
+    Error (begin, "end tag does not match <" + std::string (open.data, open.length) + ">");
+
+  m_open.pop_back ();
+  if (m_open.empty ())
+    m_done = true;
+  return p + 1;
+}
+
+const char *
+FastReader::ReadMarkup (const char *p)
+{
+  if (*p == '?')
+  {
+    const char *end = FindString (p, m_end, "?>");
+    if (end == m_end)
+      Error (p, "unterminated processing instruction");
+    if (p == m_begin + 1 && end - p >= 4 && memcmp (p, "?xml", 4) == 0 && IsSpace (p[4]))
+      CheckDeclaration (p + 4, end);
+    return end + 2;
+  }
+  if (m_end - p >= 3 && memcmp (p, "!--", 3) == 0)
+  {
+    const char *end = FindString (p + 3, m_end, "-->");
+    if (end == m_end)
+      Error (p, "unterminated comment");
+    return end + 3;
+  }
+  Error (p, "CDATA sections and document types are not supported, use the default reader");
+  return p;
+}
+
+void
+FastReader::CheckDeclaration (const char *begin, const char *end) const
+{
+  const char *p = FindString (begin, end, "encoding");
+  if (p == end)
+    return;
+
+  p = FindChar (p, end, '=');
+  for (p++; p < end && IsSpace (*p); p++)
+    ;
+  if (p >= end)
+    return;
+  const char *close = FindChar (p + 1, end, *p);
+  std::string encoding (p + 1, close);
+  for (size_t i = 0; i < encoding.size (); i++)
+  {
+    if (encoding[i] >= 'a' && encoding[i] <= 'z')
+      encoding[i] = encoding[i] - 'a' + 'A';
+  }
+  if (encoding != "UTF-8" && encoding != "US-ASCII" && encoding != "ASCII")
+    Error (p + 1, "encoding " + std::string (p + 1, close) + " is not supported, use the default reader");
+}
+
+void
+FastReader::AppendText (const char *begin, const char *end)
+{
+  for (const char *amp = FindChar (begin, end, '&'); begin != end; amp = FindChar (begin, end, '&'))
+  {
+    m_text.append (begin, amp);
+    if (amp == end)
+      break;
+
+    const char *semi = FindChar (amp, end, ';');
+    if (semi == end)
+      Error (amp, "unterminated character reference");
+
+    std::string ref (amp + 1, semi);
+    if (ref == "lt")
+      m_text += '<';
+    else if (ref == "gt")
+      m_text += '>';
+    else if (ref == "amp")
+      m_text += '&';
+    else if (ref == "quot")
+      m_text += '"';
+    else if (ref == "apos")
+      m_text += '\'';
+    else if (ref.size () > 1 && ref[0] == '#')
+    {
+      unsigned long c = strtoul (ref.c_str () + (ref[1] == 'x' ? 2 : 1), 0, ref[1] == 'x' ? 16 : 10);
+      if (c == 0 || c > 0x10FFFF)
+        Error (amp, "invalid character reference");
+      if (c < 0x80)
+        m_text += static_cast<char> (c);
+      else if (c < 0x800)
+      {
+        m_text += static_cast<char> (0xC0 | (c >> 6));
+        m_text += static_cast<char> (0x80 | (c & 0x3F));
+      }
+      else if (c < 0x10000)
+      {
+        m_text += static_cast<char> (0xE0 | (c >> 12));
+        m_text += static_cast<char> (0x80 | ((c >> 6) & 0x3F));
+        m_text += static_cast<char> (0x80 | (c & 0x3F));
+      }
+      else
+      {
+        m_text += static_cast<char> (0xF0 | (c >> 18));
+        m_text += static_cast<char> (0x80 | ((c >> 12) & 0x3F));
+        m_text += static_cast<char> (0x80 | ((c >> 6) & 0x3F));
+        m_text += static_cast<char> (0x80 | (c & 0x3F));
+      }
+    }
+    else
+      Error (amp, "unknown entity &" + ref + ";");
+
+    begin = semi + 1;
+  }
+}
+
+void
+FastReader::Parse ()
+{
+  const char *p = m_begin;
+
+  if (m_end - p >= 2 && ((p[0] == '\xFE' && p[1] == '\xFF') || (p[0] == '\xFF' && p[1] == '\xFE')))
+    Error (p, "UTF-16 documents are not supported, use the default reader");
+  if (m_end - p >= 3 && memcmp (p, "\xEF\xBB\xBF", 3) == 0)
+  {
+    // Skip the byte order mark, the declaration is expected right after it.
+    m_begin += 3;
+    p += 3;
+  }
+
+  // True while the current element has no child, its text is then the
+  // slice between its start tag and its end tag. The text is only copied
+  // when it holds character references or is split by comments.
+  bool leaf = false;
+  bool copied = false;
+
+  for (;;)
+  {
+    const char *lt = FindChar (p, m_end, '<');
+
+    if (m_open.empty ())
+    {
+      for (const char *c = p; c != lt; c++)
+      {
+        if (!IsSpace (*c))
+          Error (c, "text outside the root element");
+      }
+    }
+    if (lt == m_end)
+      break;
+
+    const char *text = p;
+    p = lt + 1;
+    if (p == m_end)
+      Error (lt, "unterminated tag");
+
+    if (*p == '/')
+    {
+      Name name;
+      p = ReadEndTag (p + 1, name);
+      if (!leaf)
+        m_elements.EndElement (name.data, name.length, "", 0);
+      else if (!copied && FindChar (text, lt, '&') == lt)
+        m_elements.EndElement (name.data, name.length, text, lt - text);
+      else
+      {
+        AppendText (text, lt);
+        m_elements.EndElement (name.data, name.length, m_text.data (), m_text.size ());
+      }
+      leaf = false;
+    }
+    else if (*p == '?' || *p == '!')
+    {
+      if (leaf)
+      {
+        AppendText (text, lt);
+        copied = true;
+      }
+      p = ReadMarkup (p);
+    }
+    else
+    {
+      bool empty;
+      p = ReadStartTag (p, empty);
+      leaf = !empty;
+      copied = false;
+      m_text.clear ();
+    }
+  }
+
+  if (!m_open.empty ())
+    Error (m_end, "unexpected end of document in <" + std::string (m_open.back ().data, m_open.back ().length) + ">");
+  if (!m_done)
+    Error (m_end, "no root element");
+}
+
+void
+ParseTopologyBuffer (const char *data, size_t size, const std::string &systemId, TopologySink &sink)
+{
+  FastReader reader (data, size, systemId, sink);
+  reader.Parse ();
+}
+
+void
+ParseTopologyFast (const std::string &fileName, TopologySink &sink)
+{
+  if (CompressedFile::Detect (fileName) != CompressedFile::NONE)
+  {
+    // The reader needs the whole document, it is decompressed in memory.
+    //
+    CompressedFile file;
+    file.Open (fileName);
+    std::string data;
+    size_t n;
+    do
+    {
+      size_t size = data.size ();
+      data.resize (size + (1 << 20));
+      n = file.Read (&data[size], 1 << 20);
+      data.resize (size + n);
+    }
+    while (n > 0);
+    ParseTopologyBuffer (data.data (), data.size (), fileName, sink);
+    return;
+  }
+
+  MappedFile file;
+  file.Open (fileName);
+  ParseTopologyBuffer (file.GetData (), file.GetSize (), fileName, sink);
+}
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-fast-reader.hxx
+ * \brief Zero-copy reader of the Gen topology format.
+ */
+
+#ifndef TOPOLOGY_FAST_READER_HXX
+#define TOPOLOGY_FAST_READER_HXX
+
+#include <string>
+
+class TopologySink;
+
+/**
+ * \brief Read a topology file with the fast reader.
+ *
+ * The file is memory mapped and scanned in place: tags are located with a
+ * vectorized byte search and element names and texts are handed to the
+ * sink as slices of the mapping. Only the UTF-8 subset of XML used by
+ * the Gen format is accepted (elements, attributes, comments, processing
+ * instructions and the predefined and numeric character references).
+ *
+ * The document must be well-formed but is not validated against the
+ * schema, see ValidateTopology() for that. A gzip or zstd compressed file
+ * is decompressed in memory first.
+ *
+ * \param fileName topology file name
+ * \param sink sink to feed
+ * \throw std::runtime_error if the document cannot be read
+ */
+void ParseTopologyFast (const std::string &fileName, TopologySink &sink);
+
+/**
+ * \brief Read a topology held in memory with the fast reader.
+ * \param data document bytes
+ * \param size document size
+ * \param systemId name of the document used in the error messages
+ * \param sink sink to feed
+ * \throw std::runtime_error if the document cannot be read
+ */
+void ParseTopologyBuffer (const char *data, size_t size, const std::string &systemId, TopologySink &sink);
+
+#endif /* TOPOLOGY_FAST_READER_HXX */
@@ -0,0 +1,275 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-grammar.cxx
+ * \brief Compiled topology schema shared by the Xerces-C++ parsers.
+ */
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <xercesc/dom/DOMConfiguration.hpp>
+#include <xercesc/dom/DOMError.hpp>
+#include <xercesc/dom/DOMErrorHandler.hpp>
+#include <xercesc/dom/DOMImplementation.hpp>
+#include <xercesc/dom/DOMImplementationRegistry.hpp>
+#include <xercesc/dom/DOMLocator.hpp>
+#include <xercesc/dom/DOMLSParser.hpp>
+#include <xercesc/framework/LocalFileInputSource.hpp>
+#include <xercesc/framework/MemBufInputSource.hpp>
+#include <xercesc/framework/Wrapper4InputSource.hpp>
+#include <xercesc/framework/XMLGrammarPoolImpl.hpp>
+#include <xercesc/sax/ErrorHandler.hpp>
+#include <xercesc/sax/SAXParseException.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/util/BinInputStream.hpp>
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/validators/common/Grammar.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUniDefs.hpp>
+#include <xercesc/util/XMLUni.hpp>
+
+#include "topology-grammar.hxx"
+#include "kern/compressed-file.h"
+
+using namespace xercesc;
+
+/**
+ * \brief Convert a Xerces string for an error message.
+ */
+static std::string
+ToString (const XMLCh *s)
+{
+  if (s == 0)
+    return std::string ();
+  char *c = XMLString::transcode (s);
+  std::string res (c);
+  XMLString::release (&c);
+  return res;
+}
+
+/**
+ * \brief Xerces input stream decompressing a file on the fly.
+ */
+class CompressedInputStream : public BinInputStream
+{
+public:
+  CompressedInputStream (const std::string &fileName)
+  {
+    m_file.Open (fileName);
+  }
+
+  virtual XMLFilePos
+  curPos () const
+  {
+    return m_file.GetPosition ();
+  }
+
+  virtual XMLSize_t
+  readBytes (XMLByte* const toFill, const XMLSize_t maxToRead)
+  {
+    return m_file.Read (reinterpret_cast<char*> (toFill), maxToRead);
+  }
+
+  virtual const XMLCh*
+  getContentType () const
+  {
+    return 0;
+  }
+
+private:
+  CompressedFile m_file;
+};
+
+/**
+ * \brief Xerces input source of a gzip or zstd compressed file.
+ */
+class CompressedInputSource : public InputSource
+{
+public:
+  CompressedInputSource (const std::string &fileName)
+    : InputSource (fileName.c_str ()), m_fileName (fileName)
+  {
+  }
+
+  virtual BinInputStream*
+  makeStream () const
+  {
+    return new CompressedInputStream (m_fileName);
+  }
+
+private:
+  std::string m_fileName;
+};
+
+/**
+ * \brief Error handler of the schema compilation.
+ */
+class SchemaErrorHandler : public ErrorHandler
+{
+public:
+  virtual void
+  warning (const SAXParseException& /* e */)
+  {
+  }
+
+  virtual void
+  error (const SAXParseException& e)
+  {
+    fatalError (e);
+  }
+
+  virtual void
+  fatalError (const SAXParseException& e)
+  {
+    std::ostringstream os;
+    os << "TopologySchema.xsd:" << e.getLineNumber () << ":" << e.getColumnNumber ()
+       << " error: " << ToString (e.getMessage ());
+    throw std::runtime_error (os.str ());
+  }
+
+  virtual void
+  resetErrors ()
+  {
+  }
+};
+
+/**
+ * \brief Error handler of the DOM parser, keeps the first error.
+ */
+class DocumentErrorHandler : public DOMErrorHandler
+{
+public:
+  virtual bool
+  handleError (const DOMError& e)
+  {
+    if (e.getSeverity () == DOMError::DOM_SEVERITY_WARNING)
+      return true;
+
+    if (m_message.empty ())
+    {
+      std::ostringstream os;
+      const DOMLocator *loc = e.getLocation ();
+      os << ToString (loc->getURI ()) << ":" << loc->getLineNumber () << ":" << loc->getColumnNumber ()
+         << " error: " << ToString (e.getMessage ());
+      m_message = os.str ();
+    }
+    return false;
+  }
+
+  std::string m_message;
+};
+
+InputSource *
+CreateTopologyInput (const std::string &fileName)
+{
+  if (CompressedFile::Detect (fileName) != CompressedFile::NONE)
+    return new CompressedInputSource (fileName);
+
+  XMLCh *name = XMLString::transcode (fileName.c_str ());
+  InputSource *source = new LocalFileInputSource (name);
+  XMLString::release (&name);
+  return source;
+}
+
+TopologyGrammar::TopologyGrammar ()
+{
+  m_pool = new XMLGrammarPoolImpl (XMLPlatformUtils::fgMemoryManager);
+
+  try
+  {
+    std::auto_ptr<SAX2XMLReader> reader (XMLReaderFactory::createXMLReader (XMLPlatformUtils::fgMemoryManager, m_pool));
+    reader->setFeature (XMLUni::fgSAX2CoreNameSpaces, true);
+    reader->setFeature (XMLUni::fgXercesSchema, true);
+    reader->setFeature (XMLUni::fgXercesSchemaFullChecking, true);
+
+    SchemaErrorHandler handler;
+    reader->setErrorHandler (&handler);
+
+    MemBufInputSource source (reinterpret_cast<const XMLByte*> (TopologySchemaText), TopologySchemaTextSize, "TopologySchema.xsd");
+    if (!reader->loadGrammar (source, Grammar::SchemaGrammarType, true))
+      throw std::runtime_error ("TopologySchema.xsd: cannot compile the schema");
+  }
+  catch (...)
+  {
+    delete m_pool;
+    throw;
+  }
+
+  // From now on the pool is shared read-only.
+  //
+  m_pool->lockPool ();
+}
+
+TopologyGrammar::~TopologyGrammar ()
+{
+  delete m_pool;
+}
+
+XMLGrammarPool *
+TopologyGrammar::GetPool () const
+{
+  return m_pool;
+}
+
+DOMDocument *
+TopologyGrammar::ParseDocument (const std::string &fileName) const
+{
+  static const XMLCh ls[] = {chLatin_L, chLatin_S, chNull};
+  DOMImplementation *impl = DOMImplementationRegistry::getDOMImplementation (ls);
+  DOMLSParser *parser = impl->createLSParser (DOMImplementationLS::MODE_SYNCHRONOUS, 0, XMLPlatformUtils::fgMemoryManager, m_pool);
+
+  DocumentErrorHandler handler;
+  DOMConfiguration *conf = parser->getDomConfig ();
+  conf->setParameter (XMLUni::fgDOMComments, false);
+  conf->setParameter (XMLUni::fgDOMDatatypeNormalization, true);
+  conf->setParameter (XMLUni::fgDOMEntities, false);
+  conf->setParameter (XMLUni::fgDOMNamespaces, true);
+  conf->setParameter (XMLUni::fgDOMElementContentWhitespace, false);
+  conf->setParameter (XMLUni::fgDOMValidate, true);
+  conf->setParameter (XMLUni::fgXercesSchema, true);
+  conf->setParameter (XMLUni::fgXercesSchemaFullChecking, false);
+  conf->setParameter (XMLUni::fgXercesUseCachedGrammarInParse, true);
+  conf->setParameter (XMLUni::fgXercesLoadSchema, false);
+  conf->setParameter (XMLUni::fgXercesUserAdoptsDOMDocument, true);
+  conf->setParameter (XMLUni::fgDOMErrorHandler, &handler);
+
+  DOMDocument *doc = 0;
+  try
+  {
+    Wrapper4InputSource input (CreateTopologyInput (fileName), true);
+    doc = parser->parse (&input);
+  }
+  catch (...)
+  {
+    parser->release ();
+    throw;
+  }
+  parser->release ();
+
+  if (!handler.m_message.empty () || doc == 0)
+  {
+    if (doc)
+      doc->release ();
+    throw std::runtime_error (handler.m_message.empty () ? fileName + ": cannot parse the document" : handler.m_message);
+  }
+  return doc;
+}
@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-grammar.hxx
+ * \brief Compiled topology schema shared by the Xerces-C++ parsers.
+ */
+
+#ifndef TOPOLOGY_GRAMMAR_HXX
+#define TOPOLOGY_GRAMMAR_HXX
+
+#include <string>
+
+#include <xercesc/dom/DOMDocument.hpp>
+#include <xercesc/framework/XMLGrammarPool.hpp>
+#include <xercesc/sax/InputSource.hpp>
+
+/**
+ * \brief Text of TopologySchema.xsd, embedded at build time.
+ */
+extern const char TopologySchemaText[];
+
+/**
+ * \brief Size of TopologySchemaText.
+ */
+extern const size_t TopologySchemaTextSize;
+
+/**
+ * \brief Compiled topology schema shared by the Xerces-C++ parsers.
+ *
+ *  The embedded schema is compiled once into a locked grammar pool; every
+ *  parser created afterwards validates against the cached grammar instead
+ *  of looking for TopologySchema.xsd and compiling it again. The pool is
+ *  read-only once locked, so parsers of several threads may share it.
+ *
+ *  Xerces-C++ must be initialized before the grammar is created and
+ *  terminated after it is destroyed.
+ */
+class TopologyGrammar
+{
+  public:
+    /**
+     * \brief Constructor, compile the embedded schema.
+     * \throw std::runtime_error if the schema is not valid
+     */
+    TopologyGrammar ();
+
+    /**
+     * \brief Destructor.
+     */
+    ~TopologyGrammar ();
+
+    /**
+     * \brief Get the grammar pool.
+     * \return locked grammar pool holding the topology grammar
+     */
+    xercesc::XMLGrammarPool *GetPool () const;
+
+    /**
+     * \brief Parse and validate a topology file into a DOM document.
+     * \param fileName topology file name, may be gzip or zstd compressed
+     * \return document, owned by the caller
+     * \throw std::runtime_error if the document is not well-formed or not valid
+     */
+    xercesc::DOMDocument *ParseDocument (const std::string &fileName) const;
+
+  private:
+    TopologyGrammar (const TopologyGrammar &);
+    TopologyGrammar &operator= (const TopologyGrammar &);
+
+    xercesc::XMLGrammarPool *m_pool;
+};
+
+/**
+ * \brief Create the input source of a topology file.
+ * \param fileName topology file name, compressed files are decompressed on the fly
+ * \return input source, owned by the caller
+ */
+xercesc::InputSource *CreateTopologyInput (const std::string &fileName);
+
+#endif /* TOPOLOGY_GRAMMAR_HXX */
@@ -0,0 +1,208 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-sax.cxx
+ * \brief Streaming (SAX2) reader of the Gen topology format.
+ */
+
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/sax/SAXParseException.hpp>
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUni.hpp>
+
+#include "topology-sax.hxx"
+
+using namespace xercesc;
+
+/**
+ * \brief Append a UTF-16 Xerces string to an UTF-8 std::string.
+ */
+static void
+AppendUtf8 (std::string &out, const XMLCh *s, XMLSize_t length)
+{
+  for (XMLSize_t i = 0; i < length; i++)
+  {
+    unsigned long c = s[i];
+
+    if (c >= 0xD800 && c <= 0xDBFF && i + 1 < length)
+    {
+      unsigned long low = s[i + 1];
+      if (low >= 0xDC00 && low <= 0xDFFF)
+      {
+        c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+        i++;
+      }
+    }
+
+    if (c < 0x80)
+    {
+      out += static_cast<char> (c);
+    }
+    else if (c < 0x800)
+    {
+      out += static_cast<char> (0xC0 | (c >> 6));
+      out += static_cast<char> (0x80 | (c & 0x3F));
+    }
+    else if (c < 0x10000)
+    {
+      out += static_cast<char> (0xE0 | (c >> 12));
+      out += static_cast<char> (0x80 | ((c >> 6) & 0x3F));
+      out += static_cast<char> (0x80 | (c & 0x3F));
+    }
+    else
+    {
+      out += static_cast<char> (0xF0 | (c >> 18));
+      out += static_cast<char> (0x80 | ((c >> 12) & 0x3F));
+      out += static_cast<char> (0x80 | ((c >> 6) & 0x3F));
+      out += static_cast<char> (0x80 | (c & 0x3F));
+    }
+  }
+}
+
+static std::string
+ToUtf8 (const XMLCh *s)
+{
+  std::string res;
+  if (s != 0)
+    AppendUtf8 (res, s, XMLString::stringLen (s));
+  return res;
+}
+
+/**
+ * \brief Throw a parse error as a std::runtime_error.
+ */
+static void
+ReportError (const SAXParseException& e)
+{
+  std::ostringstream os;
+  os << ToUtf8 (e.getSystemId ()) << ":" << e.getLineNumber () << ":" << e.getColumnNumber ()
+     << " error: " << ToUtf8 (e.getMessage ());
+  throw std::runtime_error (os.str ());
+}
+
+TopologySaxHandler::TopologySaxHandler (TopologySink &sink)
+  : m_elements (sink)
+{
+}
+
+void
+TopologySaxHandler::startElement (const XMLCh* const /* uri */, const XMLCh* const localname, const XMLCh* const /* qname */, const Attributes& /* attrs */)
+{
+  m_name.clear ();
+  AppendUtf8 (m_name, localname, XMLString::stringLen (localname));
+  m_text.clear ();
+
+  m_elements.StartElement (m_name.data (), m_name.size ());
+}
+
+void
+TopologySaxHandler::endElement (const XMLCh* const /* uri */, const XMLCh* const localname, const XMLCh* const /* qname */)
+{
+  m_name.clear ();
+  AppendUtf8 (m_name, localname, XMLString::stringLen (localname));
+
+  m_elements.EndElement (m_name.data (), m_name.size (), m_text.data (), m_text.size ());
+  m_text.clear ();
+}
+
+void
+TopologySaxHandler::characters (const XMLCh* const chars, const XMLSize_t length)
+{
+  AppendUtf8 (m_text, chars, length);
+}
+
+void
+TopologySaxHandler::warning (const SAXParseException& /* e */)
+{
+}
+
+void
+TopologySaxHandler::error (const SAXParseException& e)
+{
+  fatalError (e);
+}
+
+void
+TopologySaxHandler::fatalError (const SAXParseException& e)
+{
+  ReportError (e);
+}
+
+/**
+ * \brief Error handler of the validation only pass.
+ */
+class ValidationHandler : public DefaultHandler
+{
+  public:
+    virtual void error (const SAXParseException& e)
+    {
+      ReportError (e);
+    }
+
+    virtual void fatalError (const SAXParseException& e)
+    {
+      ReportError (e);
+    }
+};
+
+/**
+ * \brief Parse a topology file, validated against the cached grammar.
+ *
+ * Compressed files are decompressed while being parsed.
+ */
+static void
+Parse (const std::string &fileName, const TopologyGrammar &grammar, DefaultHandler &handler)
+{
+  std::auto_ptr<SAX2XMLReader> reader (XMLReaderFactory::createXMLReader (XMLPlatformUtils::fgMemoryManager, grammar.GetPool ()));
+
+  reader->setFeature (XMLUni::fgSAX2CoreNameSpaces, true);
+  reader->setFeature (XMLUni::fgSAX2CoreValidation, true);
+  reader->setFeature (XMLUni::fgXercesDynamic, false);
+  reader->setFeature (XMLUni::fgXercesSchema, true);
+  reader->setFeature (XMLUni::fgXercesValidationErrorAsFatal, true);
+  reader->setFeature (XMLUni::fgXercesUseCachedGrammarInParse, true);
+  reader->setFeature (XMLUni::fgXercesLoadSchema, false);
+
+  reader->setContentHandler (&handler);
+  reader->setErrorHandler (&handler);
+
+  std::auto_ptr<InputSource> source (CreateTopologyInput (fileName));
+  reader->parse (*source);
+}
+
+void
+ParseTopologyStream (const std::string &fileName, const TopologyGrammar &grammar, TopologySink &sink)
+{
+  TopologySaxHandler handler (sink);
+  Parse (fileName, grammar, handler);
+}
+
+void
+ValidateTopology (const std::string &fileName, const TopologyGrammar &grammar)
+{
+  ValidationHandler handler;
+  Parse (fileName, grammar, handler);
+}
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-sax.hxx
+ * \brief Streaming (SAX2) reader of the Gen topology format.
+ */
+
+#ifndef TOPOLOGY_SAX_HXX
+#define TOPOLOGY_SAX_HXX
+
+#include <string>
+
+#include <xercesc/sax2/DefaultHandler.hpp>
+
+#include "kern/topology-element-handler.h"
+#include "topology-grammar.hxx"
+
+/**
+ * \brief SAX2 handler feeding a TopologySink.
+ *
+ *  The element names and texts are converted to UTF-8 and passed to a
+ *  TopologyElementHandler, which hands each element of the topology to the
+ *  sink as soon as it is read, so no object model of the document is
+ *  kept in memory.
+ */
+class TopologySaxHandler : public xercesc::DefaultHandler
+{
+  public:
+    /**
+     * \brief Constructor.
+     * \param sink sink fed with the topology elements
+     */
+    TopologySaxHandler (TopologySink &sink);
+
+    virtual void startElement (const XMLCh* const uri, const XMLCh* const localname, const XMLCh* const qname, const xercesc::Attributes& attrs);
+
+    virtual void endElement (const XMLCh* const uri, const XMLCh* const localname, const XMLCh* const qname);
+
+    virtual void characters (const XMLCh* const chars, const XMLSize_t length);
+
+    virtual void warning (const xercesc::SAXParseException& e);
+
+    virtual void error (const xercesc::SAXParseException& e);
+
+    virtual void fatalError (const xercesc::SAXParseException& e);
+
+  private:
+    TopologyElementHandler m_elements;
+
+    /**
+     * \brief Local name of the current element (UTF-8).
+     */
+    std::string m_name;
+
+    /**
+     * \brief Text of the current leaf element (UTF-8).
+     */
+    std::string m_text;
+};
+
+/**
+ * \brief Parse and validate a topology file, streaming its elements into a sink.
+ *
+ * Xerces-C++ must have been initialized by the caller. A gzip or zstd
+ * compressed file is decompressed while being parsed.
+ *
+ * \param fileName topology file name
+ * \param grammar compiled topology schema
+ * \param sink sink to feed
+ * \throw std::runtime_error if the document is not well-formed or not valid
+ */
+void ParseTopologyStream (const std::string &fileName, const TopologyGrammar &grammar, TopologySink &sink);
+
+/**
+ * \brief Validate a topology file against the schema without building anything.
+ *
+ * Xerces-C++ must have been initialized by the caller.
+ *
+ * \param fileName topology file name
+ * \param grammar compiled topology schema
+ * \throw std::runtime_error if the document is not well-formed or not valid
+ */
+void ValidateTopology (const std::string &fileName, const TopologyGrammar &grammar);
+
+#endif /* TOPOLOGY_SAX_HXX */
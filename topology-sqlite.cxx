@@ -0,0 +1,280 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-sqlite.cxx
+ * \brief Reader of topologies stored in an SQLite database.
+ */
+
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <sqlite3.h>
+
+#include "topology-sqlite.hxx"
+#include "kern/topology-sink.h"
+
+/**
+ * \brief Prepared statement, finalized on destruction.
+ */
+class Statement
+{
+  public:
+    Statement (sqlite3 *db, const char *sql)
+      : m_db (db), m_stmt (0)
+    {
+      if (sqlite3_prepare_v2 (db, sql, -1, &m_stmt, 0) != SQLITE_OK)
+        throw std::runtime_error (sqlite3_errmsg (db));
+    }
+
+    ~Statement ()
+    {
+      sqlite3_finalize (m_stmt);
+    }
+
+    /**
+     * \brief Fetch the next row.
+     * \return false when there is no more row
+     */
+    bool
+    Step ()
+    {
+      int ret = sqlite3_step (m_stmt);
+      if (ret == SQLITE_ROW)
+        return true;
+      if (ret != SQLITE_DONE)
+        throw std::runtime_error (sqlite3_errmsg (m_db));
+      return false;
+    }
+
+    bool
+    IsNull (int column) const
+    {
+      return sqlite3_column_type (m_stmt, column) == SQLITE_NULL;
+    }
+
+    /**
+     * \brief Get a text column, NULL gives an empty string.
+     */
+    void
+    GetText (int column, std::string &text) const
+    {
+      const unsigned char *data = sqlite3_column_text (m_stmt, column);
+      if (data)
+        text.assign (reinterpret_cast<const char*> (data), sqlite3_column_bytes (m_stmt, column));
+      else
+        text.clear ();
+    }
+
+    size_t
+    GetSize (int column) const
+    {
+      sqlite3_int64 value = sqlite3_column_int64 (m_stmt, column);
+      if (value < 0)
+        throw std::runtime_error ("negative value in column " + std::string (sqlite3_column_name (m_stmt, column)));
+      return value;
+    }
+
+    sqlite3_int64
+    GetInteger (int column) const
+    {
+      return sqlite3_column_int64 (m_stmt, column);
+    }
+
+  private:
+    Statement (const Statement &);
+    Statement &operator= (const Statement &);
+
+    sqlite3 *m_db;
+    sqlite3_stmt *m_stmt;
+};
+
+/**
+ * \brief Read-only database connection, closed on destruction.
+ */
+class Database
+{
+  public:
+    Database (const std::string &fileName)
+      : m_db (0)
+    {
+      if (sqlite3_open_v2 (fileName.c_str (), &m_db, SQLITE_OPEN_READONLY, 0) != SQLITE_OK)
+      {
+        std::string message = m_db ? sqlite3_errmsg (m_db) : "out of memory";
+        sqlite3_close (m_db);
+        throw std::runtime_error (fileName + ": " + message);
+      }
+      // The tables are scanned once, from start to end.
+      //
+      sqlite3_exec (m_db, "PRAGMA mmap_size = 1073741824", 0, 0, 0);
+    }
+
+    ~Database ()
+    {
+      sqlite3_close (m_db);
+    }
+
+    sqlite3 *
+    Get () const
+    {
+      return m_db;
+    }
+
+  private:
+    Database (const Database &);
+    Database &operator= (const Database &);
+
+    sqlite3 *m_db;
+};
+
+/// Read the nodes ///
+static void
+ReadNodes (sqlite3 *db, TopologySink &sink)
+{
+  Statement stmt (db, "SELECT type, name, enable_flowmonitor FROM node ORDER BY id");
+  NodeSpec node;
+  while (stmt.Step ())
+  {
+    stmt.GetText (0, node.type);
+    stmt.GetText (1, node.name);
+    stmt.GetText (2, node.enableFlowmonitor);
+    sink.AddNode (node);
+  }
+}
+
+/// Read the network hardwares with their connected nodes ///
+static void
+ReadNetworkHardwares (sqlite3 *db, TopologySink &sink)
+{
+  // One pass over the join: the rows of a hardware are consecutive, its
+  // connected nodes come from the primary key index in position order.
+  //
+  Statement stmt (db,
+                  "SELECT h.id, h.type, h.name, h.data_rate, h.link_delay, h.enable_trace, c.node_name"
+                  " FROM network_hardware h LEFT JOIN connected_node c ON c.hardware_id = h.id"
+                  " ORDER BY h.id, c.position");
+  NetworkHardwareSpec hardware;
+  std::string nodeName;
+  sqlite3_int64 id = 0;
+  bool first = true;
+  while (stmt.Step ())
+  {
+    if (first || stmt.GetInteger (0) != id)
+    {
+      id = stmt.GetInteger (0);
+      first = false;
+      stmt.GetText (1, hardware.type);
+      stmt.GetText (2, hardware.name);
+      stmt.GetText (3, hardware.dataRate);
+      stmt.GetText (4, hardware.linkDelay);
+      stmt.GetText (5, hardware.enableTrace);
+      sink.AddNetworkHardware (hardware);
+    }
+    if (!stmt.IsNull (6))
+    {
+      stmt.GetText (6, nodeName);
+      sink.InstallNode (nodeName);
+    }
+  }
+}
+
+/// Read the applications ///
+static void
+ReadApplications (sqlite3 *db, TopologySink &sink)
+{
+  Statement stmt (db,
+                  "SELECT type, name, sender, receiver, start_time, end_time, port, interval,"
+                  " reading_time, packet_size, max_packet_count, packet_interval_time"
+                  " FROM application ORDER BY id");
+  ApplicationSpec app;
+  while (stmt.Step ())
+  {
+    stmt.GetText (0, app.type);
+    stmt.GetText (1, app.name);
+    stmt.GetText (2, app.sender);
+    stmt.GetText (3, app.receiver);
+    app.startTime = stmt.GetSize (4);
+    app.endTime = stmt.GetSize (5);
+    if ((app.hasPort = !stmt.IsNull (6)))
+      app.port = stmt.GetSize (6);
+    if ((app.hasInterval = !stmt.IsNull (7)))
+      app.interval = stmt.GetSize (7);
+    if ((app.hasReadingTime = !stmt.IsNull (8)))
+      app.readingTime = stmt.GetSize (8);
+    if ((app.hasPacketSize = !stmt.IsNull (9)))
+      app.packetSize = stmt.GetSize (9);
+    if ((app.hasMaxPacketCount = !stmt.IsNull (10)))
+      app.maxPacketCount = stmt.GetSize (10);
+    if ((app.hasPacketIntervalTime = !stmt.IsNull (11)))
+      stmt.GetText (11, app.packetIntervalTime);
+    else
+      app.packetIntervalTime.clear ();
+    sink.AddApplication (app);
+  }
+}
+
+/// Read the flows ///
+static void
+ReadFlows (sqlite3 *db, TopologySink &sink)
+{
+  Statement stmt (db,
+                  "SELECT type, name, source, destination, expected_delay_seconds,"
+                  " expected_reliability_percent FROM flow ORDER BY id");
+  FlowSpec flow;
+  while (stmt.Step ())
+  {
+    stmt.GetText (0, flow.type);
+    stmt.GetText (1, flow.name);
+    stmt.GetText (2, flow.source);
+    stmt.GetText (3, flow.destination);
+    stmt.GetText (4, flow.expectedDelaySeconds);
+    stmt.GetText (5, flow.expectedReliabilityPercent);
+    sink.AddFlow (flow);
+  }
+}
+
+bool
+IsTopologyDatabase (const std::string &fileName)
+{
+  static const char header[16] = "SQLite format 3";
+  char buffer[16];
+  std::ifstream file (fileName.c_str (), std::ios::binary);
+  return file.read (buffer, sizeof (buffer)) && memcmp (buffer, header, sizeof (header)) == 0;
+}
+
+void
+ParseTopologyDatabase (const std::string &fileName, TopologySink &sink)
+{
+  Database db (fileName);
+  try
+  {
+    // A single read transaction gives a consistent view of the tables.
+    //
+    Statement begin (db.Get (), "BEGIN");
+    begin.Step ();
+    ReadNodes (db.Get (), sink);
+    ReadNetworkHardwares (db.Get (), sink);
+    ReadApplications (db.Get (), sink);
+    ReadFlows (db.Get (), sink);
+  }
+  catch (const std::runtime_error& e)
+  {
+    throw std::runtime_error (fileName + ": " + e.what ());
+  }
+}
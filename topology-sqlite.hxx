@@ -0,0 +1,52 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Idaho National Laboratory
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/**
+ * \file topology-sqlite.hxx
+ * \brief Reader of topologies stored in an SQLite database.
+ */
+
+#ifndef TOPOLOGY_SQLITE_HXX
+#define TOPOLOGY_SQLITE_HXX
+
+#include <string>
+
+class TopologySink;
+
+/**
+ * \brief Tell whether a file is an SQLite 3 database.
+ * \param fileName file name
+ * \return true if the file starts with the SQLite 3 header
+ */
+bool IsTopologyDatabase (const std::string &fileName);
+
+/**
+ * \brief Read a topology from an SQLite database.
+ *
+ * The database follows TopologySchema.sql. Each table is read with one
+ * cursor in id order and every row is handed to the sink as soon as it is
+ * fetched, so the size of the topology does not matter.
+ *
+ * \param fileName database file name
+ * \param sink sink to feed
+ * \throw std::runtime_error if the database cannot be read or does not
+ * follow the schema
+ */
+void ParseTopologyDatabase (const std::string &fileName, TopologySink &sink);
+
+#endif /* TOPOLOGY_SQLITE_HXX */